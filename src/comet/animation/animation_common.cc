@@ -10,133 +10,562 @@
 #include "animation_common.h"
 ////////////////////////////////////////////////////////////////////////////////
 
+#include "comet/animation/pose_buffer.h"
 #include "comet/core/compression.h"
+#include "comet/core/memory/memory_utils.h"
 #include "comet/core/frame/frame_utils.h"
+#include "comet/math/geometry.h"
 #include "comet/math/math_common.h"
-#include "comet/math/math_compression.h"
 #include "comet/math/math_interpolation.h"
 #include "comet/math/quaternion.h"
 #include "comet/math/vector.h"
 
 namespace comet {
 namespace animation {
-CompressedJointPose CompressJointPose(const JointPose& pose) {
-  CompressedJointPose compressed_pose{};
+usize GetJointPoseChannelStride(usize joint_count) {
+  return (joint_count + kJointPoseLaneCount - 1) / kJointPoseLaneCount *
+         kJointPoseLaneCount;
+}
 
-#ifndef COMET_COMPRESS_ANIMATIONS
-  compressed_pose.translation = pose.translation;
-  compressed_pose.rotation = pose.rotation;
-  compressed_pose.scale = pose.scale;
-#else
-  u32 translation_x;
-  u32 translation_y;
-  u32 translation_z;
+u8 GetAnimationTrackComponentCount(AnimationTrackType type) {
+  switch (type) {
+    case kAnimationTrackTypeRotation:
+    case kAnimationTrackTypeTranslation:
+      return 3;
+    case kAnimationTrackTypeScale:
+      return 1;
+    default:
+      COMET_ASSERT(false, "Unknown animation track type: ",
+                   static_cast<u32>(type), "!");
+      return 0;
+  }
+}
+
+const AnimationTrack& GetAnimationTrack(const CompressedAnimationClip& clip,
+                                        usize joint_index,
+                                        AnimationTrackType type) {
+  COMET_ASSERT(joint_index < clip.joint_count, "Joint index ", joint_index,
+               " is out of bounds: ", clip.joint_count, "!");
+  return clip.tracks[joint_index * kAnimationTrackTypeCount + type];
+}
+
+u16 FindAnimationKey(const u16* key_frames, u16 key_count, f32 frame) {
+  COMET_ASSERT(key_count > 1, "Tried to find a key in a constant track!");
+  u16 low{0};
+  u16 high{static_cast<u16>(key_count - 1)};
+
+  while (high - low > 1) {
+    const auto middle{static_cast<u16>((low + high) / 2)};
+
+    if (key_frames[middle] <= frame) {
+      low = middle;
+    } else {
+      high = middle;
+    }
+  }
+
+  return low;
+}
+
+u16 SeekAnimationKey(const u16* key_frames, u16 key_count, f32 frame,
+                     u16& cursor) {
+  COMET_ASSERT(key_count > 1, "Tried to seek a key in a constant track!");
+  // Same bounds as FindAnimationKey(): the last key is never returned.
+  const auto last_key{static_cast<u16>(key_count - 2)};
+  const auto key{math::Min(cursor, last_key)};
+
+  // Playback usually stays between the same keys, or moves to the next ones.
+  if (key_frames[key] <= frame) {
+    if (key == last_key || frame < key_frames[key + 1]) {
+      cursor = key;
+      return cursor;
+    }
+
+    if (key + 1 == last_key || frame < key_frames[key + 2]) {
+      cursor = static_cast<u16>(key + 1);
+      return cursor;
+    }
+  }
+
+  cursor = FindAnimationKey(key_frames, key_count, frame);
+  return cursor;
+}
+
+namespace internal {
+u32 ReadAnimationKeyBits(const u8* key_data, u64 bit_offset, u8 bit_count) {
+  u64 bits;
+  memory::CopyMemory(&bits, key_data + (bit_offset >> 3), sizeof(bits));
+  bits >>= bit_offset & 7;
+  return static_cast<u32>(bits & ((u64{1} << bit_count) - 1));
+}
 
-  math::CompressVec3Rl(pose.translation, -kMaxTranslation, kMaxTranslation,
-                       kCompressionBitCount, translation_x, translation_y,
-                       translation_z);
+math::Quat ToRotation(const f32* values) {
+  const auto squared_magnitude{values[0] * values[0] + values[1] * values[1] +
+                               values[2] * values[2]};
+  math::Quat rotation{math::Sqrt(math::Max(1.0f - squared_magnitude, 0.0f)),
+                      values[0], values[1], values[2]};
+  return math::Normalize(rotation);
+}
+
+// Resolves the keys around frame and the interpolation factor between them,
+// seeking from the key cursor if it is set. Returns false on constant tracks.
+bool ResolveAnimationKeys(const CompressedAnimationClip& clip,
+                          const AnimationTrack& track, f32 frame,
+                          u16* key_cursor, u16& key, f32& alpha) {
+  if (track.key_count == 0) {
+    return false;
+  }
+
+  const auto* key_frames{clip.key_frames.GetData() + track.key_offset};
+  key = key_cursor != nullptr
+            ? SeekAnimationKey(key_frames, track.key_count, frame, *key_cursor)
+            : FindAnimationKey(key_frames, track.key_count, frame);
+  const auto frame_a{static_cast<f32>(key_frames[key])};
+  const auto frame_b{static_cast<f32>(key_frames[key + 1])};
+  alpha = math::Clamp((frame - frame_a) / (frame_b - frame_a), 0.0f, 1.0f);
+  return true;
+}
+
+u16* GetAnimationKeyCursor(u16* key_cursors, usize joint_index,
+                           AnimationTrackType type) {
+  return key_cursors != nullptr
+             ? key_cursors + joint_index * kAnimationTrackTypeCount + type
+             : nullptr;
+}
+}  // namespace internal
+
+void DecompressAnimationKey(const CompressedAnimationClip& clip,
+                            const AnimationTrack& track, u16 key_index,
+                            u8 component_count, f32* values) {
+  if (track.key_count == 0) {
+    for (u8 i{0}; i < component_count; ++i) {
+      values[i] = track.range_min[i];
+    }
+
+    return;
+  }
+
+  COMET_ASSERT(key_index < track.key_count, "Key index ", key_index,
+               " is out of bounds: ", track.key_count, "!");
+  const auto* key_data{clip.key_data.GetData()};
+  auto bit_offset{track.bit_offset + static_cast<u64>(key_index) *
+                                         component_count * track.bit_count};
+
+  for (u8 i{0}; i < component_count; ++i) {
+    const auto bits{
+        internal::ReadAnimationKeyBits(key_data, bit_offset, track.bit_count)};
+    bit_offset += track.bit_count;
+
+    if (track.bit_count == kAnimationRawKeyBitCount) {
+      memory::CopyMemory(&values[i], &bits, sizeof(f32));
+    } else {
+      values[i] = track.range_min[i] +
+                  DecompressF32Rl(bits, track.bit_count) *
+                      track.range_extent[i];
+    }
+  }
+}
+
+math::Quat SampleRotationTrack(const CompressedAnimationClip& clip,
+                               const AnimationTrack& track, f32 frame,
+                               u16* key_cursor) {
+  constexpr auto kComponentCount{3};
+  f32 values[kComponentCount];
+  u16 key;
+  f32 alpha;
+
+  if (!internal::ResolveAnimationKeys(clip, track, frame, key_cursor, key,
+                                      alpha)) {
+    DecompressAnimationKey(clip, track, 0, kComponentCount, values);
+    return internal::ToRotation(values);
+  }
+
+  DecompressAnimationKey(clip, track, key, kComponentCount, values);
+  const auto rotation_a{internal::ToRotation(values)};
+  DecompressAnimationKey(clip, track, key + 1, kComponentCount, values);
+  return math::Nlerp(rotation_a, internal::ToRotation(values), alpha);
+}
+
+math::Vec3 SampleTranslationTrack(const CompressedAnimationClip& clip,
+                                  const AnimationTrack& track, f32 frame,
+                                  u16* key_cursor) {
+  constexpr auto kComponentCount{3};
+  f32 values[kComponentCount];
+  u16 key;
+  f32 alpha;
+
+  if (!internal::ResolveAnimationKeys(clip, track, frame, key_cursor, key,
+                                      alpha)) {
+    DecompressAnimationKey(clip, track, 0, kComponentCount, values);
+    return math::Vec3{values[0], values[1], values[2]};
+  }
 
-  compressed_pose.translation_x = static_cast<u16>(translation_x);
-  compressed_pose.translation_y = static_cast<u16>(translation_y);
-  compressed_pose.translation_z = static_cast<u16>(translation_z);
+  DecompressAnimationKey(clip, track, key, kComponentCount, values);
+  const math::Vec3 translation_a{values[0], values[1], values[2]};
+  DecompressAnimationKey(clip, track, key + 1, kComponentCount, values);
+  return math::Lerp(translation_a, math::Vec3{values[0], values[1], values[2]},
+                    alpha);
+}
 
-  // Only store x/y/z of quaternion: w is reconstructed on decompression.
-  compressed_pose.rotation_x = static_cast<u16>(
-      CompressF32Rl(pose.rotation.x, -1.0f, 1.0f, kCompressionBitCount));
-  compressed_pose.rotation_y = static_cast<u16>(
-      CompressF32Rl(pose.rotation.y, -1.0f, 1.0f, kCompressionBitCount));
-  compressed_pose.rotation_z = static_cast<u16>(
-      CompressF32Rl(pose.rotation.z, -1.0f, 1.0f, kCompressionBitCount));
+f32 SampleScaleTrack(const CompressedAnimationClip& clip,
+                     const AnimationTrack& track, f32 frame,
+                     u16* key_cursor) {
+  f32 scale_a;
+  u16 key;
+  f32 alpha;
+
+  if (!internal::ResolveAnimationKeys(clip, track, frame, key_cursor, key,
+                                      alpha)) {
+    DecompressAnimationKey(clip, track, 0, 1, &scale_a);
+    return scale_a;
+  }
 
-  compressed_pose.scale =
-      static_cast<u16>(CompressF32Rl(pose.scale, kCompressionBitCount));
-#endif  // !COMET_COMPRESS_ANIMATIONS
-  return compressed_pose;
+  f32 scale_b;
+  DecompressAnimationKey(clip, track, key, 1, &scale_a);
+  DecompressAnimationKey(clip, track, key + 1, 1, &scale_b);
+  return math::Lerp(scale_a, scale_b, alpha);
 }
 
-JointPose DecompressJointPose(const CompressedJointPose& compressed_pose) {
+JointPose SampleJointPose(const CompressedAnimationClip& clip,
+                          usize joint_index, f32 frame, u16* key_cursors) {
   JointPose pose{};
-#ifndef COMET_COMPRESS_ANIMATIONS
-  pose.translation = compressed_pose.translation;
-  pose.rotation = compressed_pose.rotation;
-  pose.scale = compressed_pose.scale;
-#else
-  pose.translation = math::DecompressVec3Rl(
-      compressed_pose.translation_x, compressed_pose.translation_y,
-      compressed_pose.translation_z, -kMaxTranslation, kMaxTranslation,
-      kCompressionBitCount);
-
-  auto rotation_vec{math::DecompressVec3Rl(
-      compressed_pose.rotation_x, compressed_pose.rotation_y,
-      compressed_pose.rotation_z, -1.0f, 1.0f, kCompressionBitCount)};
-  auto rotation_vec_mag{math::GetSquaredMagnitude(rotation_vec)};
-  auto w{math::Sqrt(math::Max(1.0f - rotation_vec_mag, 0.0f))};
-  pose.rotation = math::Quat{w, rotation_vec.x, rotation_vec.y, rotation_vec.z};
-  math::Normalize(pose.rotation);
-
-  pose.scale = DecompressF32Rl(compressed_pose.scale, kCompressionBitCount);
-#endif  // !COMET_COMPRESS_ANIMATIONS
+  pose.rotation = SampleRotationTrack(
+      clip, GetAnimationTrack(clip, joint_index, kAnimationTrackTypeRotation),
+      frame,
+      internal::GetAnimationKeyCursor(key_cursors, joint_index,
+                                      kAnimationTrackTypeRotation));
+  pose.translation = SampleTranslationTrack(
+      clip,
+      GetAnimationTrack(clip, joint_index, kAnimationTrackTypeTranslation),
+      frame,
+      internal::GetAnimationKeyCursor(key_cursors, joint_index,
+                                      kAnimationTrackTypeTranslation));
+  pose.scale = SampleScaleTrack(
+      clip, GetAnimationTrack(clip, joint_index, kAnimationTrackTypeScale),
+      frame,
+      internal::GetAnimationKeyCursor(key_cursors, joint_index,
+                                      kAnimationTrackTypeScale));
   return pose;
 }
 
-AnimationPose PopulatePoseFromSample(const CompressedAnimationClip& clip,
-                                     FrameIndex frame) {
-  const auto& sample{clip.samples[frame]};
-  auto joint_pose_count{sample.joint_poses.GetSize()};
+void SampleJointPoses(const CompressedAnimationClip& clip, FrameIndex frame_a,
+                      FrameIndex frame_b, f32 alpha, PoseBuffer& pose,
+                      u16* key_cursors) {
+#ifdef COMET_ARCH_X86
+  SSESampleJointPoses(clip, frame_a, frame_b, alpha, pose, key_cursors);
+#else
+  ScalarSampleJointPoses(clip, frame_a, frame_b, alpha, pose, key_cursors);
+#endif  // COMET_ARCH_X86
+}
 
-  AnimationPose out_pose{};
-  out_pose.local_pose =
-      COMET_DOUBLE_FRAME_ARRAY(animation::JointPose, joint_pose_count);
+void ScalarSampleJointPoses(const CompressedAnimationClip& clip,
+                            FrameIndex frame_a, FrameIndex frame_b, f32 alpha,
+                            PoseBuffer& pose, u16* key_cursors) {
+  const auto joint_count{pose.GetJointCount()};
+  COMET_ASSERT(clip.joint_count >= joint_count,
+               "Pose has more joints than animation clip ",
+               COMET_STRING_ID_LABEL(clip.id), "!");
+
+  // Keys are seeked once per track: the time in between is sampled directly,
+  // except when looping back to the first frame. Past the last frame, tracks
+  // hold their last key.
+  if (frame_b >= frame_a || alpha <= 0.0f) {
+    const auto frame{static_cast<f32>(frame_a) + math::Max(alpha, 0.0f)};
+
+    for (usize i{0}; i < joint_count; ++i) {
+      pose.SetJointPose(i, SampleJointPose(clip, i, frame, key_cursors));
+    }
 
-  for (usize i{0}; i < joint_pose_count; ++i) {
-    auto pose{DecompressJointPose(sample.joint_poses[i])};
-    out_pose.local_pose->PushBack(pose);
+    return;
   }
 
-  return out_pose;
+  // Cursors would be moved to the end of the tracks, and back: they are only
+  // useful on forward playback.
+  for (usize i{0}; i < joint_count; ++i) {
+    auto joint_pose{SampleJointPose(clip, i, static_cast<f32>(frame_a))};
+    const auto pose_b{SampleJointPose(clip, i, static_cast<f32>(frame_b))};
+    joint_pose.translation =
+        math::Lerp(joint_pose.translation, pose_b.translation, alpha);
+    joint_pose.scale = math::Lerp(joint_pose.scale, pose_b.scale, alpha);
+    joint_pose.rotation =
+        math::Nlerp(joint_pose.rotation, pose_b.rotation, alpha);
+    pose.SetJointPose(i, joint_pose);
+  }
 }
 
-AnimationPose PopulatePoseFromSamples(const CompressedAnimationClip& clip,
-                                      FrameIndex frame_a, FrameIndex frame_b,
-                                      f32 alpha) {
-  if (alpha <= 0.0f) {
-    return PopulatePoseFromSample(clip, frame_a);
+#ifdef COMET_ARCH_X86
+namespace internal {
+struct JointPoseLanes {
+  __m128 rotation_x;
+  __m128 rotation_y;
+  __m128 rotation_z;
+  __m128 rotation_w;
+  __m128 translation_x;
+  __m128 translation_y;
+  __m128 translation_z;
+  __m128 scale;
+};
+
+// Reads the components of the key at bit_offset into the first lanes.
+__m128i ReadAnimationKeyLanes(const u8* key_data, u64 bit_offset,
+                              u8 bit_count, u8 component_count) {
+  s32 values[kMaxAnimationTrackComponentCount]{};
+  const auto shift{bit_offset & 7};
+
+  // Most keys fit in the 64-bit load of their first component.
+  if (shift + static_cast<u64>(component_count) * bit_count <= 64) {
+    const auto* bytes{key_data + (bit_offset >> 3)};
+    const auto bits{static_cast<u64>(_mm_cvtsi128_si64(_mm_loadl_epi64(
+                        reinterpret_cast<const __m128i*>(bytes)))) >>
+                    shift};
+    const auto mask{(u64{1} << bit_count) - 1};
+
+    for (u8 i{0}; i < component_count; ++i) {
+      values[i] = static_cast<s32>((bits >> (i * bit_count)) & mask);
+    }
+  } else {
+    for (u8 i{0}; i < component_count; ++i) {
+      values[i] = static_cast<s32>(ReadAnimationKeyBits(
+          key_data, bit_offset + static_cast<u64>(i) * bit_count, bit_count));
+    }
   }
 
-  if (alpha >= 1.0f) {
-    return PopulatePoseFromSample(clip, frame_b);
+  return _mm_setr_epi32(values[0], values[1], values[2], 0);
+}
+
+// Same as DecompressAnimationKey(), on the first lanes.
+__m128 DecompressAnimationKeyLanes(const AnimationTrack& track, __m128i bits,
+                                   __m128 interval_size) {
+  if (track.bit_count == kAnimationRawKeyBitCount) {
+    return _mm_castsi128_ps(bits);
+  }
+
+  return _mm_add_ps(_mm_loadu_ps(track.range_min),
+                    _mm_mul_ps(_mm_mul_ps(_mm_cvtepi32_ps(bits), interval_size),
+                               _mm_loadu_ps(track.range_extent)));
+}
+
+// Decompresses the keys around frame of the tracks of type of
+// kJointPoseLaneCount joints, one lane per joint and one vector per component,
+// along with the interpolation factors between them. When looping back, keys
+// are the last and the first ones, blended with loop_alpha.
+void DecompressTrackLanes(const CompressedAnimationClip& clip,
+                          AnimationTrackType type, usize joint_offset,
+                          usize joint_count, f32 frame, bool is_looping_back,
+                          f32 loop_alpha, u16* key_cursors, __m128* values_a,
+                          __m128* values_b, __m128& alpha) {
+  const auto component_count{GetAnimationTrackComponentCount(type)};
+  const auto* key_data{clip.key_data.GetData()};
+  f32 alphas[kJointPoseLaneCount]{};
+
+  for (usize i{0}; i < kJointPoseLaneCount; ++i) {
+    // Padding lanes repeat the last joint: they are stored, but never read.
+    const auto joint_index{math::Min(joint_offset + i, joint_count - 1)};
+    const auto& track{GetAnimationTrack(clip, joint_index, type)};
+
+    if (track.key_count == 0) {
+      values_a[i] = _mm_loadu_ps(track.range_min);
+      values_b[i] = values_a[i];
+      continue;
+    }
+
+    u16 key{static_cast<u16>(track.key_count - 1)};
+    u16 next_key{0};
+    alphas[i] = loop_alpha;
+
+    if (!is_looping_back) {
+      auto* key_cursor{GetAnimationKeyCursor(key_cursors, joint_index, type)};
+      ResolveAnimationKeys(clip, track, frame, key_cursor, key, alphas[i]);
+      next_key = static_cast<u16>(key + 1);
+    }
+
+    const auto key_bit_count{static_cast<u64>(component_count) *
+                             track.bit_count};
+    const auto interval_size{_mm_set1_ps(
+        1.0f / static_cast<f32>((u64{1} << track.bit_count) - 1))};
+    values_a[i] = DecompressAnimationKeyLanes(
+        track,
+        ReadAnimationKeyLanes(key_data, track.bit_offset + key * key_bit_count,
+                              track.bit_count, component_count),
+        interval_size);
+    values_b[i] = DecompressAnimationKeyLanes(
+        track,
+        ReadAnimationKeyLanes(key_data,
+                              track.bit_offset + next_key * key_bit_count,
+                              track.bit_count, component_count),
+        interval_size);
   }
 
-  const auto& a_sample{clip.samples[frame_a]};
-  const auto& b_sample{clip.samples[frame_b]};
-  COMET_ASSERT(a_sample.joint_poses.GetSize() == b_sample.joint_poses.GetSize(),
-               "Joint count mismatch on animation clip ",
-               COMET_STRING_ID_LABEL(clip.id), " at frames ", frame_a, "/",
-               frame_b, ": ", a_sample.joint_poses.GetSize(),
-               " != ", b_sample.joint_poses.GetSize(), "!");
-  auto joint_pose_count{a_sample.joint_poses.GetSize()};
+  // Joints are turned from rows into lanes.
+  _MM_TRANSPOSE4_PS(values_a[0], values_a[1], values_a[2], values_a[3]);
+  _MM_TRANSPOSE4_PS(values_b[0], values_b[1], values_b[2], values_b[3]);
+  alpha = _mm_loadu_ps(alphas);
+}
+
+void NormalizeRotationLanes(JointPoseLanes& lanes) {
+  const auto inv_length{_mm_div_ps(
+      _mm_set1_ps(1.0f),
+      _mm_sqrt_ps(_mm_add_ps(
+          _mm_add_ps(_mm_mul_ps(lanes.rotation_x, lanes.rotation_x),
+                     _mm_mul_ps(lanes.rotation_y, lanes.rotation_y)),
+          _mm_add_ps(_mm_mul_ps(lanes.rotation_z, lanes.rotation_z),
+                     _mm_mul_ps(lanes.rotation_w, lanes.rotation_w)))))};
+  lanes.rotation_x = _mm_mul_ps(lanes.rotation_x, inv_length);
+  lanes.rotation_y = _mm_mul_ps(lanes.rotation_y, inv_length);
+  lanes.rotation_z = _mm_mul_ps(lanes.rotation_z, inv_length);
+  lanes.rotation_w = _mm_mul_ps(lanes.rotation_w, inv_length);
+}
+
+// Same as ToRotation(), for kJointPoseLaneCount joints, without normalizing:
+// reconstructed rotations only deviate from a length of one by their
+// quantization error, which the normalized lerp they go through absorbs.
+void ToRotationLanes(JointPoseLanes& lanes) {
+  const auto squared_magnitude{_mm_add_ps(
+      _mm_add_ps(_mm_mul_ps(lanes.rotation_x, lanes.rotation_x),
+                 _mm_mul_ps(lanes.rotation_y, lanes.rotation_y)),
+      _mm_mul_ps(lanes.rotation_z, lanes.rotation_z))};
+  lanes.rotation_w = _mm_sqrt_ps(_mm_max_ps(
+      _mm_sub_ps(_mm_set1_ps(1.0f), squared_magnitude), _mm_setzero_ps()));
+}
+
+__m128 LerpLanes(__m128 a, __m128 b, __m128 alpha) {
+  return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), alpha));
+}
 
-  AnimationPose out_pose{};
-  out_pose.local_pose =
-      COMET_DOUBLE_FRAME_ARRAY(animation::JointPose, joint_pose_count);
+// Same as math::Nlerp(), for kJointPoseLaneCount joints.
+void NlerpRotationLanes(JointPoseLanes& lanes, const JointPoseLanes& lanes_b,
+                        __m128 alpha) {
+  const auto dot{_mm_add_ps(
+      _mm_add_ps(_mm_mul_ps(lanes.rotation_x, lanes_b.rotation_x),
+                 _mm_mul_ps(lanes.rotation_y, lanes_b.rotation_y)),
+      _mm_add_ps(_mm_mul_ps(lanes.rotation_z, lanes_b.rotation_z),
+                 _mm_mul_ps(lanes.rotation_w, lanes_b.rotation_w)))};
+
+  // Flipping the sign bit of b when the dot product is negative takes the
+  // shortest path.
+  const auto sign{_mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()),
+                             _mm_set1_ps(-0.0f))};
+  const auto b{_mm_xor_ps(alpha, sign)};
+  const auto a{_mm_sub_ps(_mm_set1_ps(1.0f), alpha)};
+
+  lanes.rotation_x = _mm_add_ps(_mm_mul_ps(lanes.rotation_x, a),
+                                _mm_mul_ps(lanes_b.rotation_x, b));
+  lanes.rotation_y = _mm_add_ps(_mm_mul_ps(lanes.rotation_y, a),
+                                _mm_mul_ps(lanes_b.rotation_y, b));
+  lanes.rotation_z = _mm_add_ps(_mm_mul_ps(lanes.rotation_z, a),
+                                _mm_mul_ps(lanes_b.rotation_z, b));
+  lanes.rotation_w = _mm_add_ps(_mm_mul_ps(lanes.rotation_w, a),
+                                _mm_mul_ps(lanes_b.rotation_w, b));
+  NormalizeRotationLanes(lanes);
+}
 
-  for (usize i{0}; i < joint_pose_count; ++i) {
-    auto pose_a{DecompressJointPose(a_sample.joint_poses[i])};
-    auto pose_b{DecompressJointPose(b_sample.joint_poses[i])};
-    auto& joint{out_pose.local_pose->EmplaceBack()};
-    joint.translation =
-        math::Lerp(pose_a.translation, pose_b.translation, alpha);
-    joint.scale = math::Lerp(pose_a.scale, pose_b.scale, alpha);
-    joint.rotation = math::Slerp(pose_a.rotation, pose_b.rotation, alpha);
+void StoreJointPoseLanes(const JointPoseLanes& lanes, usize offset,
+                         PoseBuffer& pose) {
+  _mm_storeu_ps(pose.GetChannel(kJointPoseChannelRotationX) + offset,
+                lanes.rotation_x);
+  _mm_storeu_ps(pose.GetChannel(kJointPoseChannelRotationY) + offset,
+                lanes.rotation_y);
+  _mm_storeu_ps(pose.GetChannel(kJointPoseChannelRotationZ) + offset,
+                lanes.rotation_z);
+  _mm_storeu_ps(pose.GetChannel(kJointPoseChannelRotationW) + offset,
+                lanes.rotation_w);
+  _mm_storeu_ps(pose.GetChannel(kJointPoseChannelTranslationX) + offset,
+                lanes.translation_x);
+  _mm_storeu_ps(pose.GetChannel(kJointPoseChannelTranslationY) + offset,
+                lanes.translation_y);
+  _mm_storeu_ps(pose.GetChannel(kJointPoseChannelTranslationZ) + offset,
+                lanes.translation_z);
+  _mm_storeu_ps(pose.GetChannel(kJointPoseChannelScale) + offset,
+                lanes.scale);
+}
+}  // namespace internal
+
+void SSESampleJointPoses(const CompressedAnimationClip& clip,
+                         FrameIndex frame_a, FrameIndex frame_b, f32 alpha,
+                         PoseBuffer& pose, u16* key_cursors) {
+  const auto joint_count{pose.GetJointCount()};
+  COMET_ASSERT(clip.joint_count >= joint_count,
+               "Pose has more joints than animation clip ",
+               COMET_STRING_ID_LABEL(clip.id), "!");
+
+  // Same cases as ScalarSampleJointPoses(). When looping back, both frames are
+  // keys: they are blended directly.
+  const auto is_looping_back{frame_b < frame_a && alpha > 0.0f};
+  COMET_ASSERT(!is_looping_back ||
+                   (frame_a == clip.frame_count - 1 && frame_b == 0),
+               "Animation clip ", COMET_STRING_ID_LABEL(clip.id),
+               " can only loop back from its last frame to its first one!");
+  const auto frame{static_cast<f32>(frame_a) + math::Max(alpha, 0.0f)};
+  __m128 values_a[kJointPoseLaneCount];
+  __m128 values_b[kJointPoseLaneCount];
+  __m128 alpha_lanes;
+  internal::JointPoseLanes lanes{};
+  internal::JointPoseLanes lanes_b{};
+
+  // Channels are padded: the last lanes can be processed as full ones.
+  for (usize i{0}; i < joint_count; i += kJointPoseLaneCount) {
+    internal::DecompressTrackLanes(clip, kAnimationTrackTypeRotation, i,
+                                   joint_count, frame, is_looping_back, alpha,
+                                   key_cursors, values_a, values_b,
+                                   alpha_lanes);
+    lanes.rotation_x = values_a[0];
+    lanes.rotation_y = values_a[1];
+    lanes.rotation_z = values_a[2];
+    lanes_b.rotation_x = values_b[0];
+    lanes_b.rotation_y = values_b[1];
+    lanes_b.rotation_z = values_b[2];
+    internal::ToRotationLanes(lanes);
+    internal::ToRotationLanes(lanes_b);
+    internal::NlerpRotationLanes(lanes, lanes_b, alpha_lanes);
+
+    internal::DecompressTrackLanes(clip, kAnimationTrackTypeTranslation, i,
+                                   joint_count, frame, is_looping_back, alpha,
+                                   key_cursors, values_a, values_b,
+                                   alpha_lanes);
+    lanes.translation_x =
+        internal::LerpLanes(values_a[0], values_b[0], alpha_lanes);
+    lanes.translation_y =
+        internal::LerpLanes(values_a[1], values_b[1], alpha_lanes);
+    lanes.translation_z =
+        internal::LerpLanes(values_a[2], values_b[2], alpha_lanes);
+
+    internal::DecompressTrackLanes(clip, kAnimationTrackTypeScale, i,
+                                   joint_count, frame, is_looping_back, alpha,
+                                   key_cursors, values_a, values_b,
+                                   alpha_lanes);
+    lanes.scale = internal::LerpLanes(values_a[0], values_b[0], alpha_lanes);
+
+    internal::StoreJointPoseLanes(lanes, i, pose);
   }
+}
+#endif  // COMET_ARCH_X86
 
-  return out_pose;
+void PopulatePoseFromSample(const CompressedAnimationClip& clip,
+                            FrameIndex frame, PoseBuffer& pose,
+                            u16* key_cursors) {
+  SampleJointPoses(clip, frame, frame, 0.0f, pose, key_cursors);
 }
 
-AnimationPose DecompressClipAndExtractPose(const CompressedAnimationClip& clip,
-                                           f64 time, f32 speed,
-                                           AnimationOverrideFlags overrides,
-                                           bool is_loop) {
+void PopulatePoseFromSamples(const CompressedAnimationClip& clip,
+                             FrameIndex frame_a, FrameIndex frame_b, f32 alpha,
+                             PoseBuffer& pose, u16* key_cursors) {
+  if (alpha <= 0.0f) {
+    PopulatePoseFromSample(clip, frame_a, pose, key_cursors);
+    return;
+  }
+
+  if (alpha >= 1.0f) {
+    PopulatePoseFromSample(clip, frame_b, pose, key_cursors);
+    return;
+  }
+
+  SampleJointPoses(clip, frame_a, frame_b, alpha, pose, key_cursors);
+}
+
+void DecompressClipAndExtractPose(const CompressedAnimationClip& clip,
+                                  f64 time, PoseBuffer& pose, f32 speed,
+                                  AnimationOverrideFlags overrides,
+                                  bool is_loop, u16* key_cursors) {
   const auto ticks_per_frame{1.0 / clip.frames_per_second};
   const auto duration{clip.frame_count * ticks_per_frame};
 
@@ -156,34 +585,26 @@ AnimationPose DecompressClipAndExtractPose(const CompressedAnimationClip& clip,
   auto alpha{
       static_cast<f32>((time - (frame * ticks_per_frame)) / ticks_per_frame)};
 
-  return PopulatePoseFromSamples(clip, frame, next_frame, alpha);
+  PopulatePoseFromSamples(clip, frame, next_frame, alpha, pose, key_cursors);
 }
 
-void PopulateGlobalPose(const geometry::Skeleton& skeleton,
-                        animation::AnimationPose& pose) {
-  auto joint_count{skeleton.joints.GetSize()};
-  COMET_ASSERT(joint_count == pose.local_pose->GetSize(),
-               "Joint count mismatch with skeleton #", skeleton.id, "!");
+void PopulateGlobalPose(const geometry::Skeleton& skeleton, PoseBuffer& pose) {
+  auto joint_count{pose.GetJointCount()};
+  COMET_ASSERT(joint_count <= skeleton.joints.GetSize(),
+               "Pose has more joints than skeleton #", skeleton.id, "!");
 
-  pose.global_pose =
-      COMET_DOUBLE_FRAME_ARRAY(math::Mat4, pose.local_pose->GetSize());
+  auto* global_pose{pose.GetGlobalMatrices()};
+  math::ComposeTransforms(pose.GetTransformChannels(), global_pose,
+                          joint_count);
 
+  // Parents come first: each global matrix holds the local one until its
+  // joint is reached.
   for (usize i{0}; i < joint_count; ++i) {
-    const auto& local_pose{pose.local_pose->Get(i)};
-    const auto& joint{skeleton.joints[i]};
+    const auto parent_index{skeleton.joints[i].parent_index};
 
-    auto local_matrix{math::ComposeTransform(
-        local_pose.translation, local_pose.rotation, local_pose.scale)};
-
-    auto translation{math::ToTranslateMatrix(local_pose.translation)};
-    auto rotation{math::ToRotationMatrix(local_pose.rotation)};
-    auto scale{math::ToScaleMatrix(local_pose.scale)};
-
-    if (joint.parent_index == geometry::kInvalidSkeletonJointIndex) {
-      pose.global_pose->PushBack(local_matrix);
-    } else {
-      auto& parent{pose.global_pose->Get(joint.parent_index)};
-      pose.global_pose->PushBack(parent * local_matrix);
+    if (parent_index != geometry::kInvalidSkeletonJointIndex) {
+      math::MultiplyMatrix(global_pose[parent_index], global_pose[i],
+                           global_pose[i]);
     }
   }
 }
@@ -196,19 +617,34 @@ void PopulateSkinningBinding(entity::EntityId entity_id, u32 joint_count,
 }
 
 void PopulateMatrixPalette(const geometry::Skeleton* skeleton,
-                           const Array<math::Mat4>* global_pose,
+                           const PoseBuffer& pose,
                            MatrixPalette& matrix_palette) {
   auto joint_count{skeleton->joints.GetSize()};
-  COMET_ASSERT(joint_count == global_pose->GetSize(),
-               "Joint count mismatch with skeleton #", skeleton->id, "!");
+  auto pose_joint_count{pose.GetJointCount()};
+  COMET_ASSERT(pose_joint_count <= joint_count,
+               "Pose has more joints than skeleton #", skeleton->id, "!");
   matrix_palette.skinning_matrix_count = joint_count;
   matrix_palette.skinning_matrices = COMET_DOUBLE_FRAME_ALLOC_MANY(
       math::Mat4, matrix_palette.skinning_matrix_count);
-  auto* skinning_matrices{matrix_palette.skinning_matrices};
 
-  for (usize i{0}; i < matrix_palette.skinning_matrix_count; ++i) {
-    const auto& joint{skeleton->joints[i]};
-    skinning_matrices[i] = global_pose->Get(i) * joint.bind_pose_inv;
+  if (pose_joint_count == 0) {
+    return;
+  }
+
+  // Inverse bind poses are read in place from the joints.
+  math::MultiplyMatrices(pose.GetGlobalMatrices(),
+                         &skeleton->joints[0].bind_pose_inv,
+                         sizeof(geometry::SkeletonJoint),
+                         matrix_palette.skinning_matrices, pose_joint_count);
+
+  // Joints which are not evaluated keep their bind pose relative to their
+  // parent, which gives them the same skinning matrix.
+  for (auto i{pose_joint_count}; i < joint_count; ++i) {
+    const auto parent_index{skeleton->joints[i].parent_index};
+    matrix_palette.skinning_matrices[i] =
+        parent_index != geometry::kInvalidSkeletonJointIndex
+            ? matrix_palette.skinning_matrices[parent_index]
+            : math::Mat4{1.0f};
   }
 }
 }  // namespace animation
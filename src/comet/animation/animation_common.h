@@ -15,6 +15,8 @@
 
 namespace comet {
 namespace animation {
+class PoseBuffer;
+
 using AnimationClipId = resource::ResourceId;
 constexpr auto kInvalidAnimationClipId{resource::kInvalidResourceId};
 
@@ -27,34 +29,44 @@ enum AnimationOverrideFlagBits {
 
 using AnimationOverrideFlags = u8;
 
-struct JointPose {
-  math::Quat rotation{};
-  math::Vec3 translation{};
-  f32 scale{1.0f};
-};
+// SIMD kernels process this many joints at a time.
+constexpr usize kJointPoseLaneCount{4};
 
-struct CompressedJointPose {
-#ifndef COMET_COMPRESS_ANIMATIONS
+struct JointPose {
   math::Quat rotation{};
   math::Vec3 translation{};
   f32 scale{1.0f};
-#else
-  u16 rotation_x{0};
-  u16 rotation_y{0};
-  u16 rotation_z{0};
-  u16 translation_x{0};
-  u16 translation_y{0};
-  u16 translation_z{0};
-  u16 scale{0};
-#endif  // !COMET_COMPRESS_ANIMATIONS
 };
 
 struct AnimationSample {
   Array<JointPose> joint_poses{};
 };
 
-struct CompressedAnimationSample {
-  Array<CompressedJointPose> joint_poses{};
+enum AnimationTrackType : u8 {
+  kAnimationTrackTypeRotation = 0,
+  kAnimationTrackTypeTranslation,
+  kAnimationTrackTypeScale,
+  kAnimationTrackTypeCount
+};
+
+// Rotations only store x/y/z: w is reconstructed as positive.
+constexpr u8 kMaxAnimationTrackComponentCount{3};
+// Keys stored with this bit count hold raw floats instead of quantized values.
+constexpr u8 kAnimationRawKeyBitCount{32};
+// Key data is padded so that any key can be read with one unaligned 64-bit
+// load.
+constexpr usize kAnimationKeyDataPadding{sizeof(u64)};
+
+// Keys of a track are quantized on the range of each of its components, with
+// bit_count bits per component. Constant tracks have no keys: their value is
+// stored in range_min. Otherwise, the first and last frames are always keys.
+struct AnimationTrack {
+  f32 range_min[kMaxAnimationTrackComponentCount]{};
+  f32 range_extent[kMaxAnimationTrackComponentCount]{};
+  u32 key_offset{0};
+  u32 bit_offset{0};
+  u16 key_count{0};
+  u8 bit_count{0};
 };
 
 struct AnimationClip {
@@ -65,21 +77,34 @@ struct AnimationClip {
   bool is_loop{false};
 };
 
+// Each joint has kAnimationTrackTypeCount tracks, stored joint after joint.
+// Key frames of all the tracks are stored in key_frames, and their values are
+// bit-packed in key_data.
 struct CompressedAnimationClip {
   AnimationClipId id{kInvalidAnimationClipId};
   FrameIndex frames_per_second{0};
   FrameIndex frame_count{0};
-  Array<CompressedAnimationSample> samples{};
+  usize joint_count{0};
+  Array<AnimationTrack> tracks{};
+  Array<u16> key_frames{};
+  Array<u8> key_data{};
   bool is_loop{false};
 };
 
-struct AnimationPose {
-  Array<animation::JointPose>* local_pose{nullptr};
-  Array<math::Mat4>* global_pose{nullptr};
+constexpr usize kMaxAnimationLayerCount{4};
+
+enum class AnimationBlendMode : u8 {
+  // Blends towards the layer pose.
+  Override = 0,
+  // Adds the difference between the layer pose and the first sample of its
+  // clip.
+  Additive
 };
 
-constexpr f32 kMaxTranslation{500.0f};
-constexpr u8 kCompressionBitCount{16};
+// Weights of the joints of a skeleton, from 0 to 1.
+struct AnimationMask {
+  Array<f32> joint_weights{};
+};
 
 struct SkinningBinding {
   entity::EntityId entity_id{entity::kInvalidEntityId};
@@ -92,23 +117,71 @@ struct MatrixPalette {
   math::Mat4* skinning_matrices{nullptr};
 };
 
-CompressedJointPose CompressJointPose(const JointPose& pose);
-JointPose DecompressJointPose(const CompressedJointPose& compressed_pose);
-AnimationPose PopulatePoseFromSample(const CompressedAnimationClip& clip,
-                                     FrameIndex frame);
-AnimationPose PopulatePoseFromSamples(const CompressedAnimationClip& clip,
-                                      FrameIndex frame_a, FrameIndex frame_b,
-                                      f32 alpha);
-AnimationPose DecompressClipAndExtractPose(
-    const CompressedAnimationClip& clip, f64 time, f32 speed = 1.0f,
+usize GetJointPoseChannelStride(usize joint_count);
+u8 GetAnimationTrackComponentCount(AnimationTrackType type);
+const AnimationTrack& GetAnimationTrack(const CompressedAnimationClip& clip,
+                                        usize joint_index,
+                                        AnimationTrackType type);
+// Returns the index of the last key at or before frame, among the keys of a
+// track which has some.
+u16 FindAnimationKey(const u16* key_frames, u16 key_count, f32 frame);
+// Same as FindAnimationKey(), starting from the key found by the previous
+// seek, which is stored in cursor. Moving forward by at most one key is O(1).
+u16 SeekAnimationKey(const u16* key_frames, u16 key_count, f32 frame,
+                     u16& cursor);
+void DecompressAnimationKey(const CompressedAnimationClip& clip,
+                            const AnimationTrack& track, u16 key_index,
+                            u8 component_count, f32* values);
+// Frames can be fractional: values are interpolated between the surrounding
+// keys. Rotations are interpolated with normalized lerps.
+// Key cursors hold one key per track of the clip, indexed like its tracks. When
+// set, keys are seeked from them with SeekAnimationKey() instead of being
+// searched.
+math::Quat SampleRotationTrack(const CompressedAnimationClip& clip,
+                               const AnimationTrack& track, f32 frame,
+                               u16* key_cursor = nullptr);
+math::Vec3 SampleTranslationTrack(const CompressedAnimationClip& clip,
+                                  const AnimationTrack& track, f32 frame,
+                                  u16* key_cursor = nullptr);
+f32 SampleScaleTrack(const CompressedAnimationClip& clip,
+                     const AnimationTrack& track, f32 frame,
+                     u16* key_cursor = nullptr);
+JointPose SampleJointPose(const CompressedAnimationClip& clip,
+                          usize joint_index, f32 frame,
+                          u16* key_cursors = nullptr);
+// Populates the first joint poses of the clip into pose, which must not have
+// more joints, blended between frame_a and frame_b. Frame b is either the next
+// frame or, on loops, the first one, in which case frame a is the last one.
+void SampleJointPoses(const CompressedAnimationClip& clip, FrameIndex frame_a,
+                      FrameIndex frame_b, f32 alpha, PoseBuffer& pose,
+                      u16* key_cursors = nullptr);
+void ScalarSampleJointPoses(const CompressedAnimationClip& clip,
+                            FrameIndex frame_a, FrameIndex frame_b, f32 alpha,
+                            PoseBuffer& pose, u16* key_cursors = nullptr);
+#ifdef COMET_ARCH_X86
+void SSESampleJointPoses(const CompressedAnimationClip& clip,
+                         FrameIndex frame_a, FrameIndex frame_b, f32 alpha,
+                         PoseBuffer& pose, u16* key_cursors = nullptr);
+#endif  // COMET_ARCH_X86
+void PopulatePoseFromSample(const CompressedAnimationClip& clip,
+                            FrameIndex frame, PoseBuffer& pose,
+                            u16* key_cursors = nullptr);
+void PopulatePoseFromSamples(const CompressedAnimationClip& clip,
+                             FrameIndex frame_a, FrameIndex frame_b, f32 alpha,
+                             PoseBuffer& pose, u16* key_cursors = nullptr);
+void DecompressClipAndExtractPose(
+    const CompressedAnimationClip& clip, f64 time, PoseBuffer& pose,
+    f32 speed = 1.0f,
     AnimationOverrideFlags overrides = kAnimationOverrideFlagBitsNone,
-    bool is_loop = false);
-void PopulateGlobalPose(const geometry::Skeleton& skeleton,
-                        animation::AnimationPose& pose);
+    bool is_loop = false, u16* key_cursors = nullptr);
+// Poses may only hold the first joints of the skeleton: joints come after their
+// parents.
+void PopulateGlobalPose(const geometry::Skeleton& skeleton, PoseBuffer& pose);
 void PopulateSkinningBinding(entity::EntityId entity_id, u32 joint_count,
                              u32 matrix_offset, SkinningBinding& binding);
+// Joints past the ones of the pose reuse the skinning matrix of their parent.
 void PopulateMatrixPalette(const geometry::Skeleton* skeleton,
-                           const Array<math::Mat4>* global_pose,
+                           const PoseBuffer& pose,
                            MatrixPalette& matrix_palette);
 }  // namespace animation
 }  // namespace comet
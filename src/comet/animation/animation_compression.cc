@@ -0,0 +1,371 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Header. /////////////////////////////////////////////////////////////////////
+#include "animation_compression.h"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/compression.h"
+#include "comet/core/memory/memory_utils.h"
+#include "comet/math/math_common.h"
+#include "comet/math/math_interpolation.h"
+#include "comet/math/quaternion.h"
+#include "comet/math/vector.h"
+
+namespace comet {
+namespace animation {
+namespace internal {
+// Part of the tolerance spent on removing keys. The rest is left to
+// quantization.
+constexpr f32 kKeyReductionToleranceRatio{0.8f};
+
+const JointPose& GetRawJointPose(const AnimationClip& clip, FrameIndex frame,
+                                 usize joint_index) {
+  return clip.samples[frame].joint_poses[joint_index];
+}
+
+f32 GetJointPoseError(AnimationTrackType type, const JointPose& a,
+                      const JointPose& b) {
+  switch (type) {
+    case kAnimationTrackTypeRotation: {
+      // Quaternions q and -q are the same rotation.
+      const auto dot{a.rotation.x * b.rotation.x + a.rotation.y * b.rotation.y +
+                     a.rotation.z * b.rotation.z +
+                     a.rotation.w * b.rotation.w};
+      const auto sign{dot < 0.0f ? -1.0f : 1.0f};
+      return math::Max(
+          math::Max(math::Abs(a.rotation.x - b.rotation.x * sign),
+                    math::Abs(a.rotation.y - b.rotation.y * sign)),
+          math::Max(math::Abs(a.rotation.z - b.rotation.z * sign),
+                    math::Abs(a.rotation.w - b.rotation.w * sign)));
+    }
+    case kAnimationTrackTypeTranslation:
+      return math::Max(math::Abs(a.translation.x - b.translation.x),
+                       math::Max(math::Abs(a.translation.y - b.translation.y),
+                                 math::Abs(a.translation.z - b.translation.z)));
+    case kAnimationTrackTypeScale:
+      return math::Abs(a.scale - b.scale);
+    default:
+      COMET_ASSERT(false, "Unknown animation track type: ",
+                   static_cast<u32>(type), "!");
+      return 0.0f;
+  }
+}
+
+// Rotations are flipped to a positive w, which is not stored.
+void GetAnimationTrackValues(const JointPose& pose, AnimationTrackType type,
+                             f32* values) {
+  switch (type) {
+    case kAnimationTrackTypeRotation: {
+      const auto sign{pose.rotation.w < 0.0f ? -1.0f : 1.0f};
+      values[0] = pose.rotation.x * sign;
+      values[1] = pose.rotation.y * sign;
+      values[2] = pose.rotation.z * sign;
+      break;
+    }
+    case kAnimationTrackTypeTranslation:
+      values[0] = pose.translation.x;
+      values[1] = pose.translation.y;
+      values[2] = pose.translation.z;
+      break;
+    case kAnimationTrackTypeScale:
+      values[0] = pose.scale;
+      break;
+    default:
+      COMET_ASSERT(false, "Unknown animation track type: ",
+                   static_cast<u32>(type), "!");
+      break;
+  }
+}
+
+JointPose SampleAnimationTrack(const CompressedAnimationClip& clip,
+                               usize joint_index, AnimationTrackType type,
+                               f32 frame) {
+  const auto& track{GetAnimationTrack(clip, joint_index, type)};
+  JointPose pose{};
+
+  switch (type) {
+    case kAnimationTrackTypeRotation:
+      pose.rotation = SampleRotationTrack(clip, track, frame);
+      break;
+    case kAnimationTrackTypeTranslation:
+      pose.translation = SampleTranslationTrack(clip, track, frame);
+      break;
+    case kAnimationTrackTypeScale:
+      pose.scale = SampleScaleTrack(clip, track, frame);
+      break;
+    default:
+      COMET_ASSERT(false, "Unknown animation track type: ",
+                   static_cast<u32>(type), "!");
+      break;
+  }
+
+  return pose;
+}
+
+bool IsAnimationSegmentWithinTolerance(const AnimationClip& clip,
+                                       usize joint_index,
+                                       AnimationTrackType type,
+                                       FrameIndex frame_a, FrameIndex frame_b,
+                                       f32 tolerance) {
+  const auto& pose_a{GetRawJointPose(clip, frame_a, joint_index)};
+  const auto& pose_b{GetRawJointPose(clip, frame_b, joint_index)};
+  const auto frame_count{static_cast<f32>(frame_b - frame_a)};
+
+  for (auto frame{frame_a + 1}; frame < frame_b; ++frame) {
+    const auto alpha{static_cast<f32>(frame - frame_a) / frame_count};
+    JointPose pose{};
+    pose.rotation = math::Nlerp(pose_a.rotation, pose_b.rotation, alpha);
+    pose.translation =
+        math::Lerp(pose_a.translation, pose_b.translation, alpha);
+    pose.scale = math::Lerp(pose_a.scale, pose_b.scale, alpha);
+
+    if (GetJointPoseError(type, pose,
+                          GetRawJointPose(clip, frame, joint_index)) >
+        tolerance) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Greedy: each segment is extended as long as the frames it skips can be
+// interpolated from its ends.
+void ReduceAnimationKeys(const AnimationClip& clip, usize joint_index,
+                         AnimationTrackType type, f32 tolerance,
+                         Array<u16>& key_frames) {
+  const auto last_frame{clip.frame_count - 1};
+  FrameIndex key{0};
+  key_frames.PushBack(static_cast<u16>(key));
+
+  while (key < last_frame) {
+    auto next_key{key + 1};
+
+    while (next_key < last_frame &&
+           IsAnimationSegmentWithinTolerance(clip, joint_index, type, key,
+                                             next_key + 1, tolerance)) {
+      ++next_key;
+    }
+
+    key_frames.PushBack(static_cast<u16>(next_key));
+    key = next_key;
+  }
+}
+
+void WriteAnimationKeyBits(u8* key_data, u64 bit_offset, u32 bits,
+                           u8 bit_count) {
+  u64 word;
+  auto* cursor{key_data + (bit_offset >> 3)};
+  memory::CopyMemory(&word, cursor, sizeof(word));
+  const auto shift{bit_offset & 7};
+  const auto mask{((u64{1} << bit_count) - 1) << shift};
+  word = (word & ~mask) | ((static_cast<u64>(bits) << shift) & mask);
+  memory::CopyMemory(cursor, &word, sizeof(word));
+}
+
+void PopulateAnimationTrackRange(const AnimationClip& clip,
+                                 const CompressedAnimationClip& compressed_clip,
+                                 usize joint_index, AnimationTrackType type,
+                                 AnimationTrack& track) {
+  const auto component_count{GetAnimationTrackComponentCount(type)};
+  const auto* key_frames{compressed_clip.key_frames.GetData() +
+                         track.key_offset};
+  f32 range_max[kMaxAnimationTrackComponentCount];
+  f32 values[kMaxAnimationTrackComponentCount];
+
+  for (u16 i{0}; i < track.key_count; ++i) {
+    GetAnimationTrackValues(GetRawJointPose(clip, key_frames[i], joint_index),
+                            type, values);
+
+    for (u8 j{0}; j < component_count; ++j) {
+      track.range_min[j] =
+          i == 0 ? values[j] : math::Min(track.range_min[j], values[j]);
+      range_max[j] = i == 0 ? values[j] : math::Max(range_max[j], values[j]);
+    }
+  }
+
+  for (u8 i{0}; i < component_count; ++i) {
+    track.range_extent[i] = range_max[i] - track.range_min[i];
+  }
+}
+
+// Writes the keys of the track with its current bit count and range.
+void PackAnimationTrackKeys(const AnimationClip& clip, usize joint_index,
+                            AnimationTrackType type,
+                            const AnimationTrack& track,
+                            CompressedAnimationClip& compressed_clip) {
+  const auto component_count{GetAnimationTrackComponentCount(type)};
+  const auto bit_count{track.bit_count};
+  const auto end_bit_offset{track.bit_offset +
+                            static_cast<u64>(track.key_count) *
+                                component_count * bit_count};
+  compressed_clip.key_data.Resize((end_bit_offset + 7) / 8 +
+                                  kAnimationKeyDataPadding);
+
+  auto* key_data{compressed_clip.key_data.GetData()};
+  const auto* key_frames{compressed_clip.key_frames.GetData() +
+                         track.key_offset};
+  u64 bit_offset{track.bit_offset};
+  f32 values[kMaxAnimationTrackComponentCount];
+
+  for (u16 i{0}; i < track.key_count; ++i) {
+    GetAnimationTrackValues(GetRawJointPose(clip, key_frames[i], joint_index),
+                            type, values);
+
+    for (u8 j{0}; j < component_count; ++j) {
+      u32 bits;
+
+      if (bit_count == kAnimationRawKeyBitCount) {
+        memory::CopyMemory(&bits, &values[j], sizeof(bits));
+      } else {
+        const auto extent{track.range_extent[j]};
+        const auto normalized{
+            extent > 0.0f ? (values[j] - track.range_min[j]) / extent : 0.0f};
+        bits = CompressF32Rl(math::Max(normalized, 0.0f), bit_count);
+      }
+
+      WriteAnimationKeyBits(key_data, bit_offset, bits, bit_count);
+      bit_offset += bit_count;
+    }
+  }
+}
+
+void CompressAnimationTrack(const AnimationClip& clip, usize joint_index,
+                            AnimationTrackType type, f32 tolerance,
+                            u64& bit_cursor,
+                            CompressedAnimationClip& compressed_clip) {
+  auto& track{
+      compressed_clip.tracks[joint_index * kAnimationTrackTypeCount + type]};
+  track = AnimationTrack{};
+  GetAnimationTrackValues(GetRawJointPose(clip, 0, joint_index), type,
+                          track.range_min);
+
+  if (clip.frame_count < 2 ||
+      GetAnimationTrackError(clip, compressed_clip, joint_index, type) <=
+          tolerance) {
+    return;
+  }
+
+  auto& key_frames{compressed_clip.key_frames};
+  track.key_offset = static_cast<u32>(key_frames.GetSize());
+
+#ifdef COMET_COMPRESS_ANIMATIONS
+  ReduceAnimationKeys(clip, joint_index, type,
+                      tolerance * kKeyReductionToleranceRatio, key_frames);
+#else
+  for (FrameIndex frame{0}; frame < clip.frame_count; ++frame) {
+    key_frames.PushBack(static_cast<u16>(frame));
+  }
+#endif  // COMET_COMPRESS_ANIMATIONS
+
+  track.key_count = static_cast<u16>(key_frames.GetSize() - track.key_offset);
+  COMET_ASSERT(bit_cursor <= static_cast<u64>(kU32Max),
+               "Animation clip ", COMET_STRING_ID_LABEL(compressed_clip.id),
+               " has too many keys!");
+  track.bit_offset = static_cast<u32>(bit_cursor);
+
+#ifdef COMET_COMPRESS_ANIMATIONS
+  PopulateAnimationTrackRange(clip, compressed_clip, joint_index, type, track);
+
+  // Variable bit rate: the smallest bit count within the tolerance is kept.
+  for (auto bit_count{kMinAnimationKeyBitCount};; ++bit_count) {
+    track.bit_count = bit_count;
+    PackAnimationTrackKeys(clip, joint_index, type, track, compressed_clip);
+
+    if (bit_count == kMaxAnimationKeyBitCount ||
+        GetAnimationTrackError(clip, compressed_clip, joint_index, type) <=
+            tolerance) {
+      break;
+    }
+  }
+#else
+  track.bit_count = kAnimationRawKeyBitCount;
+  PackAnimationTrackKeys(clip, joint_index, type, track, compressed_clip);
+#endif  // COMET_COMPRESS_ANIMATIONS
+
+  bit_cursor += static_cast<u64>(track.key_count) *
+                GetAnimationTrackComponentCount(type) * track.bit_count;
+}
+}  // namespace internal
+
+void CompressAnimationClip(const AnimationClip& clip,
+                           CompressedAnimationClip& compressed_clip,
+                           const AnimationCompressionDescr& descr) {
+  COMET_ASSERT(clip.samples.GetSize() == clip.frame_count,
+               "Animation clip ", COMET_STRING_ID_LABEL(clip.id), " has ",
+               clip.samples.GetSize(), " samples for ", clip.frame_count,
+               " frames!");
+  COMET_ASSERT(clip.frame_count <= static_cast<FrameIndex>(kU16Max) + 1,
+               "Animation clip ", COMET_STRING_ID_LABEL(clip.id),
+               " has too many frames: ", clip.frame_count, "!");
+  compressed_clip.id = clip.id;
+  compressed_clip.frames_per_second = clip.frames_per_second;
+  compressed_clip.frame_count = clip.frame_count;
+  compressed_clip.is_loop = clip.is_loop;
+  compressed_clip.joint_count =
+      clip.samples.IsEmpty() ? 0 : clip.samples[0].joint_poses.GetSize();
+  compressed_clip.tracks.Clear();
+  compressed_clip.tracks.Resize(compressed_clip.joint_count *
+                                kAnimationTrackTypeCount);
+  compressed_clip.key_frames.Clear();
+  compressed_clip.key_data.Clear();
+  u64 bit_cursor{0};
+
+  for (usize i{0}; i < compressed_clip.joint_count; ++i) {
+    for (u8 j{0}; j < kAnimationTrackTypeCount; ++j) {
+      const auto type{static_cast<AnimationTrackType>(j)};
+      internal::CompressAnimationTrack(clip, i, type,
+                                       GetAnimationTrackTolerance(descr, type),
+                                       bit_cursor, compressed_clip);
+    }
+  }
+}
+
+f32 GetAnimationTrackTolerance(const AnimationCompressionDescr& descr,
+                               AnimationTrackType type) {
+  switch (type) {
+    case kAnimationTrackTypeRotation:
+      return descr.rotation_tolerance;
+    case kAnimationTrackTypeTranslation:
+      return descr.translation_tolerance;
+    case kAnimationTrackTypeScale:
+      return descr.scale_tolerance;
+    default:
+      COMET_ASSERT(false, "Unknown animation track type: ",
+                   static_cast<u32>(type), "!");
+      return 0.0f;
+  }
+}
+
+f32 GetAnimationTrackError(const AnimationClip& clip,
+                           const CompressedAnimationClip& compressed_clip,
+                           usize joint_index, AnimationTrackType type) {
+  f32 error{0.0f};
+
+  for (FrameIndex frame{0}; frame < clip.frame_count; ++frame) {
+    const auto pose{internal::SampleAnimationTrack(
+        compressed_clip, joint_index, type, static_cast<f32>(frame))};
+    error = math::Max(
+        error, internal::GetJointPoseError(
+                   type, pose,
+                   internal::GetRawJointPose(clip, frame, joint_index)));
+  }
+
+  return error;
+}
+
+usize GetCompressedAnimationClipMemorySize(
+    const CompressedAnimationClip& clip) {
+  return sizeof(CompressedAnimationClip) +
+         clip.tracks.GetSize() * sizeof(AnimationTrack) +
+         clip.key_frames.GetSize() * sizeof(u16) +
+         clip.key_data.GetSize() * sizeof(u8);
+}
+}  // namespace animation
+}  // namespace comet
@@ -0,0 +1,48 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+#ifndef COMET_COMET_ANIMATION_ANIMATION_COMPRESSION_H_
+#define COMET_COMET_ANIMATION_ANIMATION_COMPRESSION_H_
+
+#include "comet/animation/animation_common.h"
+#include "comet/core/essentials.h"
+
+namespace comet {
+namespace animation {
+constexpr f32 kDefaultAnimationRotationTolerance{1e-3f};
+constexpr f32 kDefaultAnimationTranslationTolerance{5e-3f};
+constexpr f32 kDefaultAnimationScaleTolerance{1e-3f};
+constexpr u8 kMinAnimationKeyBitCount{3};
+constexpr u8 kMaxAnimationKeyBitCount{16};
+
+// Maximum errors of the sampled local poses at every frame of a clip, per
+// track type. Rotation errors are measured on quaternion components.
+struct AnimationCompressionDescr {
+  f32 rotation_tolerance{kDefaultAnimationRotationTolerance};
+  f32 translation_tolerance{kDefaultAnimationTranslationTolerance};
+  f32 scale_tolerance{kDefaultAnimationScaleTolerance};
+};
+
+// Tracks which stay within the tolerance of their first value are stored once.
+// Other ones only keep the keys which cannot be interpolated from their
+// neighbors, quantized with the fewest bits that keep them within the
+// tolerance. Without COMET_COMPRESS_ANIMATIONS, every frame is kept as a raw
+// key.
+// The arrays of the compressed clip must have an allocator. All the samples of
+// the clip must have the same joint count.
+void CompressAnimationClip(
+    const AnimationClip& clip, CompressedAnimationClip& compressed_clip,
+    const AnimationCompressionDescr& descr = AnimationCompressionDescr{});
+f32 GetAnimationTrackTolerance(const AnimationCompressionDescr& descr,
+                               AnimationTrackType type);
+// Returns the largest error of the track of the joint over every frame of the
+// uncompressed clip.
+f32 GetAnimationTrackError(const AnimationClip& clip,
+                           const CompressedAnimationClip& compressed_clip,
+                           usize joint_index, AnimationTrackType type);
+usize GetCompressedAnimationClipMemorySize(const CompressedAnimationClip& clip);
+}  // namespace animation
+}  // namespace comet
+
+#endif  // COMET_COMET_ANIMATION_ANIMATION_COMPRESSION_H_
@@ -0,0 +1,93 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Header. /////////////////////////////////////////////////////////////////////
+#include "animation_lod.h"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/animation/component/animation_component.h"
+#include "comet/math/math_common.h"
+#include "comet/math/vector.h"
+
+namespace comet {
+namespace animation {
+AnimationLodIndex SelectAnimationLod(const AnimationLodLevel* levels,
+                                     usize level_count, f32 distance) {
+  AnimationLodIndex lod_index{0};
+
+  for (usize i{1}; i < level_count; ++i) {
+    if (distance < levels[i].min_distance) {
+      break;
+    }
+
+    lod_index = static_cast<AnimationLodIndex>(i);
+  }
+
+  return lod_index;
+}
+
+usize GetLodJointCount(const AnimationLodLevel& level, usize joint_count) {
+  if (joint_count == 0) {
+    return 0;
+  }
+
+  const auto lod_joint_count{static_cast<usize>(
+      math::Ceil(static_cast<f32>(joint_count) * level.joint_ratio))};
+  return math::Clamp(lod_joint_count, static_cast<usize>(1), joint_count);
+}
+
+bool IsLodPoseEvaluated(const AnimationLodLevel& level, usize lod_joint_count,
+                        u64 update_index, AnimationLodState& lod) {
+  // Poses are only recorded by levels which extrapolate: the history is
+  // outdated once the entity changes level, or goes through a level which
+  // evaluates every frame.
+  if (level.update_interval <= 1 || lod.lod_index != lod.previous_lod_index) {
+    lod.history_count = 0;
+  }
+
+  lod.previous_lod_index = lod.lod_index;
+  return level.update_interval <= 1 || lod.history_count < 2 ||
+         lod.history_joint_count != lod_joint_count ||
+         update_index % level.update_interval == 0;
+}
+
+f32 GetSkeletonRadius(const geometry::Skeleton& skeleton) {
+  auto radius{.0f};
+
+  // The inverse of a global bind pose [R * s | p] is [R^T / s | -R^T * p / s]:
+  // the joint position is retrieved without inverting the matrix.
+  for (const auto& joint : skeleton.joints) {
+    const auto& bind_pose_inv{joint.bind_pose_inv};
+    const auto inv_scale{math::GetMagnitude(math::Vec3{bind_pose_inv[0]})};
+
+    if (inv_scale <= .0f) {
+      continue;
+    }
+
+    radius = math::Max(
+        radius, math::GetMagnitude(math::Vec3{bind_pose_inv[3]}) / inv_scale);
+  }
+
+  return radius;
+}
+
+AnimationStats operator+(const AnimationStats& a, const AnimationStats& b) {
+  AnimationStats stats{};
+  stats.entity_count = a.entity_count + b.entity_count;
+  stats.evaluated_entity_count =
+      a.evaluated_entity_count + b.evaluated_entity_count;
+  stats.extrapolated_entity_count =
+      a.extrapolated_entity_count + b.extrapolated_entity_count;
+  stats.culled_entity_count = a.culled_entity_count + b.culled_entity_count;
+  stats.evaluated_joint_count =
+      a.evaluated_joint_count + b.evaluated_joint_count;
+  stats.joint_count = a.joint_count + b.joint_count;
+  return stats;
+}
+}  // namespace animation
+}  // namespace comet
@@ -0,0 +1,59 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+#ifndef COMET_COMET_ANIMATION_ANIMATION_LOD_H_
+#define COMET_COMET_ANIMATION_ANIMATION_LOD_H_
+
+#include "comet/core/essentials.h"
+#include "comet/geometry/geometry_common.h"
+
+namespace comet {
+namespace animation {
+using AnimationLodIndex = u8;
+constexpr usize kAnimationLodLevelCount{4};
+
+struct AnimationLodState;
+
+// Animations of entities far from the camera are updated less often, and only
+// for the joints closest to the root.
+struct AnimationLodLevel {
+  // Camera distance from which the level applies.
+  f32 min_distance{.0f};
+  // Poses are evaluated every update_interval frames and extrapolated in
+  // between.
+  u8 update_interval{1};
+  // Ratio of the joints which are evaluated. Joints come after their parents:
+  // the other ones follow their closest evaluated ancestor.
+  f32 joint_ratio{1.0f};
+};
+
+// Counters of the last animation update.
+struct AnimationStats {
+  usize entity_count{0};
+  usize evaluated_entity_count{0};
+  usize extrapolated_entity_count{0};
+  usize culled_entity_count{0};
+  // Joints sampled and blended, out of the ones of every animated entity.
+  usize evaluated_joint_count{0};
+  usize joint_count{0};
+};
+
+// Levels must be sorted by increasing distance.
+AnimationLodIndex SelectAnimationLod(const AnimationLodLevel* levels,
+                                     usize level_count, f32 distance);
+usize GetLodJointCount(const AnimationLodLevel& level, usize joint_count);
+// Discards the pose history of the entity when it is outdated, and returns
+// whether its pose must be evaluated at the given level rather than
+// extrapolated from the history. The update index spreads evaluations over
+// frames between entities of the same level.
+bool IsLodPoseEvaluated(const AnimationLodLevel& level, usize lod_joint_count,
+                        u64 update_index, AnimationLodState& lod);
+// Returns the radius of the sphere containing the joints of the skeleton in
+// bind pose, around its origin.
+f32 GetSkeletonRadius(const geometry::Skeleton& skeleton);
+AnimationStats operator+(const AnimationStats& a, const AnimationStats& b);
+}  // namespace animation
+}  // namespace comet
+
+#endif  // COMET_COMET_ANIMATION_ANIMATION_LOD_H_
@@ -10,12 +10,16 @@
 #include "animation_manager.h"
 ////////////////////////////////////////////////////////////////////////////////
 
-#include "comet/core/concurrency/fiber/fiber.h"
-#include "comet/core/concurrency/job/job_utils.h"
-#include "comet/core/concurrency/job/scheduler.h"
+#include "comet/animation/pose_blend.h"
+#include "comet/core/concurrency/job/parallel.h"
+#include "comet/core/memory/memory_utils.h"
 #include "comet/entity/entity_id.h"
 #include "comet/entity/entity_manager.h"
 #include "comet/geometry/component/skeleton_component.h"
+#include "comet/math/bounding_volume.h"
+#include "comet/math/math_common.h"
+#include "comet/math/vector.h"
+#include "comet/physics/component/transform_component.h"
 #include "comet/resource/animation_resource.h"
 #include "comet/resource/resource_manager.h"
 #include "comet/scene/scene_manager.h"
@@ -27,6 +31,22 @@ AnimationManager& AnimationManager::Get() {
   return singleton;
 }
 
+AnimationManager::AnimationManager()
+    : pose_allocator_{memory::kEngineMemoryTagAnimation},
+      pose_buffer_pool_{&pose_allocator_} {}
+
+void AnimationManager::Initialize() {
+  Manager::Initialize();
+  pose_allocator_.Initialize();
+  pose_buffer_pool_.Initialize();
+}
+
+void AnimationManager::Shutdown() {
+  pose_buffer_pool_.Destroy();
+  pose_allocator_.Destroy();
+  Manager::Shutdown();
+}
+
 void AnimationManager::Update(frame::FramePacket* packet) {
   last_time_ = packet->time + packet->lag;
 
@@ -34,91 +54,198 @@ void AnimationManager::Update(frame::FramePacket* packet) {
   auto* entity_ids{COMET_FRAME_ARRAY(
       entity::EntityId, scene::SceneManager::Get().GetExpectedEntityCount())};
 
-  entity_manager.Each<geometry::SkeletonComponent, AnimationComponent>(
+  // The entity manager is initialized after this manager.
+  if (!animation_query_.IsRegistered()) {
+    entity_manager
+        .RegisterQuery<geometry::SkeletonComponent, AnimationComponent>(
+            animation_query_);
+  }
+
+  animation_query_.Each(
       [&](auto entity_id) { entity_ids->PushBack(entity_id); });
 
   auto entity_count{entity_ids->GetSize()};
   packet->skinning_bindings->Resize(entity_count);
   packet->matrix_palettes->Resize(entity_count);
 
-  auto* jobs{COMET_FRAME_ARRAY(internal::AnimationJob, entity_count)};
-  auto& scheduler{job::Scheduler::Get()};
-  job::CounterGuard guard{};
-
-  for (usize i{0}; i < entity_count; ++i) {
-    auto entity_id{entity_ids->Get(i)};
-
+  // Clips are not unloaded from animation jobs: finished crossfades are
+  // cleared beforehand, along with the selection of the levels of detail.
+  for (auto entity_id : *entity_ids) {
     auto* animation_cmp{
         entity_manager.GetComponent<AnimationComponent>(entity_id)};
 
-    if (animation_cmp->clip_resource == nullptr) {
-      continue;
+    if (animation_cmp->previous_state.clip_resource != nullptr &&
+        last_time_ - animation_cmp->crossfade_start_time >=
+            animation_cmp->crossfade_duration) {
+      DestroyAnimationState(animation_cmp->previous_state);
+      animation_cmp->crossfade_duration = .0f;
     }
 
-#ifdef COMET_FIBER_DEBUG_LABEL
-    schar debug_label[fiber::Fiber::kDebugLabelMaxLen_ + 1];
-    auto anim_entity_id_len{GetLength("anim_entity_id_")};
-    Copy(debug_label, "anim_entity_id_", anim_entity_id_len);
-    ConvertToStr(entity_id, debug_label + anim_entity_id_len,
-                 fiber::Fiber::kDebugLabelMaxLen_ - anim_entity_id_len);
-#else
-    const schar* debug_label{nullptr};
-#endif  // COMET_FIBER_DEBUG_LABEL
+    UpdateLod(entity_id, *packet, *animation_cmp);
+  }
+
+  const auto batch_count{
+      (entity_count + internal::kAnimationBatchSize - 1) /
+      internal::kAnimationBatchSize};
+
+  const auto map_func{[&](usize batch_index) {
+    AnimationStats batch_stats{};
+
+    // Buffers are resized for each entity: a batch uses the same memory
+    // whatever the number of layers and joints.
+    auto* pose{pose_buffer_pool_.Acquire(0)};
+    auto* layer_scratch{pose_buffer_pool_.Acquire(0)};
+    auto* reference_scratch{pose_buffer_pool_.Acquire(0)};
+
+    const auto batch_begin{batch_index * internal::kAnimationBatchSize};
+    const auto batch_end{
+        math::Min(entity_count, batch_begin + internal::kAnimationBatchSize)};
+
+    for (auto index{batch_begin}; index < batch_end; ++index) {
+      auto entity_id{entity_ids->Get(index)};
+
+      auto* animation_cmp{
+          entity_manager.GetComponent<AnimationComponent>(entity_id)};
+
+      if (animation_cmp->state.clip_resource == nullptr) {
+        continue;
+      }
+
+      internal::AnimationJob job{};
+      job.index = index;
+      job.entity_id = entity_id;
+      job.time = last_time_;
+      job.frame_count = packet->frame_count;
+      job.skinning_bindings = packet->skinning_bindings;
+      job.matrix_palettes = packet->matrix_palettes;
+      job.pose = pose;
+      job.layer_scratch = layer_scratch;
+      job.reference_scratch = reference_scratch;
+      job.stats = &batch_stats;
+      ProcessAnimation(job);
+    }
 
-    auto& job{jobs->EmplaceBack()};
-    job.index = i;
-    job.entity_id = entity_id;
-    job.time = last_time_;
-    job.skinning_bindings = packet->skinning_bindings;
-    job.matrix_palettes = packet->matrix_palettes;
+    pose_buffer_pool_.Release(reference_scratch);
+    pose_buffer_pool_.Release(layer_scratch);
+    pose_buffer_pool_.Release(pose);
+    return batch_stats;
+  }};
 
-    scheduler.Kick(job::GenerateJobDescr(
-        job::JobPriority::High, OnAnimationProcessing, &job,
-        job::JobStackSize::Normal, guard.GetCounter(), debug_label));
-  }
+  const auto stats{job::ParallelReduce(
+      {0, batch_count}, 1, AnimationStats{}, map_func,
+      [](const AnimationStats& a, const AnimationStats& b) { return a + b; })};
 
-  guard.Wait();
+  fiber::FiberSpinLockGuard guard{stats_lock_};
+  stats_ = stats;
 }
 
 void AnimationManager::Play(entity::EntityId entity_id, const schar* name,
-                            f32 speed, std::optional<bool> is_loop) {
-  Play(entity_id, COMET_STRING_ID(name), speed, is_loop);
+                            f32 speed, std::optional<bool> is_loop,
+                            f32 blend_duration) {
+  Play(entity_id, COMET_STRING_ID(name), speed, is_loop, blend_duration);
 }
 
 void AnimationManager::Play(entity::EntityId entity_id, const wchar* name,
-                            f32 speed, std::optional<bool> is_loop) {
-  Play(entity_id, COMET_STRING_ID(name), speed, is_loop);
+                            f32 speed, std::optional<bool> is_loop,
+                            f32 blend_duration) {
+  Play(entity_id, COMET_STRING_ID(name), speed, is_loop, blend_duration);
 }
 
 void AnimationManager::Play(entity::EntityId entity_id, AnimationClipId id,
-                            f32 speed, std::optional<bool> is_loop) {
+                            f32 speed, std::optional<bool> is_loop,
+                            f32 blend_duration) {
+  // Every state holds its own reference to its clip, which is released when
+  // the state is replaced.
+  const auto* resource{
+      resource::ResourceManager::Get().GetAnimationClips()->Load(
+          static_cast<resource::ResourceId>(id))};
+
+  if (resource == nullptr) {
+    return;
+  }
+
+  PlayInternal(entity_id, resource, speed, is_loop, blend_duration);
+}
+
+usize AnimationManager::AddLayer(entity::EntityId entity_id,
+                                 AnimationClipId id,
+                                 AnimationBlendMode blend_mode, f32 weight,
+                                 const AnimationMask* mask, f32 speed,
+                                 std::optional<bool> is_loop) {
   auto* animation_cmp{
       entity::EntityManager::Get().GetComponent<AnimationComponent>(entity_id)};
-  const resource::AnimationClipResource* resource{nullptr};
-
-  const auto* existing_resource{
-      animation_cmp != nullptr ? animation_cmp->clip_resource : nullptr};
-  auto* resource_animation_clips_handler{
-      resource::ResourceManager::Get().GetAnimationClips()};
+  COMET_ASSERT(animation_cmp != nullptr, "No animation component for entity #",
+               entity_id, "!");
 
-  if (existing_resource == nullptr) {
-    resource = resource_animation_clips_handler->Load(
-        static_cast<resource::ResourceId>(id));
-  } else {
-    if (existing_resource->id == id) {
-      resource = existing_resource;
-    } else {
-      resource_animation_clips_handler->Unload(existing_resource->id);
-      resource = resource_animation_clips_handler->Load(
-          static_cast<resource::ResourceId>(id));
-    }
+  if (animation_cmp->layer_count >= kMaxAnimationLayerCount) {
+    COMET_LOG_ANIMATION_ERROR("Too many animation layers on entity #",
+                              entity_id, ": max is ", kMaxAnimationLayerCount,
+                              ".");
+    return kInvalidIndex;
   }
 
+  const auto* resource{
+      resource::ResourceManager::Get().GetAnimationClips()->Load(
+          static_cast<resource::ResourceId>(id))};
+
   if (resource == nullptr) {
-    return;
+    return kInvalidIndex;
   }
 
-  PlayInternal(entity_id, resource, speed, is_loop);
+  const auto layer_index{animation_cmp->layer_count++};
+  animation_cmp->lod.history_count = 0;
+  auto& layer{animation_cmp->layers[layer_index]};
+  layer.state = GenerateAnimationState(resource, speed, is_loop);
+  layer.mask = mask;
+  layer.weight = weight;
+  layer.blend_mode = blend_mode;
+  return layer_index;
+}
+
+void AnimationManager::SetLayerWeight(entity::EntityId entity_id,
+                                      usize layer_index, f32 weight) {
+  auto* animation_cmp{
+      entity::EntityManager::Get().GetComponent<AnimationComponent>(entity_id)};
+  COMET_ASSERT(animation_cmp != nullptr, "No animation component for entity #",
+               entity_id, "!");
+  COMET_ASSERT(layer_index < animation_cmp->layer_count, "Layer index ",
+               layer_index, " is out of bounds: ", animation_cmp->layer_count,
+               "!");
+  animation_cmp->layers[layer_index].weight = weight;
+}
+
+void AnimationManager::RemoveLayer(entity::EntityId entity_id,
+                                   usize layer_index) {
+  auto* animation_cmp{
+      entity::EntityManager::Get().GetComponent<AnimationComponent>(entity_id)};
+  COMET_ASSERT(animation_cmp != nullptr, "No animation component for entity #",
+               entity_id, "!");
+  COMET_ASSERT(layer_index < animation_cmp->layer_count, "Layer index ",
+               layer_index, " is out of bounds: ", animation_cmp->layer_count,
+               "!");
+  DestroyAnimationState(animation_cmp->layers[layer_index].state);
+  animation_cmp->lod.history_count = 0;
+
+  for (auto i{layer_index + 1}; i < animation_cmp->layer_count; ++i) {
+    animation_cmp->layers[i - 1] = animation_cmp->layers[i];
+  }
+
+  animation_cmp->layers[--animation_cmp->layer_count] = {};
+}
+
+AnimationMask* AnimationManager::GenerateAnimationMask(
+    const geometry::Skeleton& skeleton,
+    geometry::SkeletonJointIndex root_joint_index, f32 weight) {
+  auto* mask{pose_allocator_.AllocateOneAndPopulate<AnimationMask>()};
+  mask->joint_weights = Array<f32>{&pose_allocator_};
+  PopulateAnimationMask(skeleton, root_joint_index, *mask, weight);
+  return mask;
+}
+
+void AnimationManager::DestroyAnimationMask(AnimationMask* mask) {
+  mask->joint_weights.Destroy();
+  mask->~AnimationMask();
+  pose_allocator_.Deallocate(mask);
 }
 
 AnimationComponent AnimationManager::GenerateAnimationComponent(
@@ -138,55 +265,62 @@ AnimationComponent AnimationManager::GenerateAnimationComponent(
 AnimationComponent AnimationManager::GenerateAnimationComponent(
     AnimationClipId id, f32 speed, std::optional<bool> is_loop,
     resource::ResourceLifeSpan life_span) {
-  AnimationComponent animation_cmp{};
+  const resource::AnimationClipResource* resource{nullptr};
 
   if (id != kInvalidAnimationClipId) {
-    animation_cmp.clip_resource =
+    resource =
         resource::ResourceManager::Get().GetAnimationClips()->Load(id,
                                                                    life_span);
-  } else {
-    animation_cmp.clip_resource = nullptr;
-  }
-
-  animation_cmp.start_time = .0f;
-  animation_cmp.frame = 0;
-  animation_cmp.speed = speed;
-
-  if (is_loop.has_value()) {
-    animation_cmp.override_flags |= kAnimationOverrideFlagBitsIsLoop;
-    animation_cmp.is_loop = is_loop.value();
-  } else {
-    animation_cmp.is_loop = false;
-    animation_cmp.override_flags = kAnimationOverrideFlagBitsNone;
   }
 
+  AnimationComponent animation_cmp{};
+  animation_cmp.state = GenerateAnimationState(resource, speed, is_loop);
+  animation_cmp.state.start_time = .0f;
   return animation_cmp;
 }
 
 void AnimationManager::DestroyAnimationComponent(
     AnimationComponent* animation_cmp) {
-  if (animation_cmp->clip_resource != nullptr) {
-    resource::ResourceManager::Get().GetAnimationClips()->Unload(
-        animation_cmp->clip_resource->id);
-    animation_cmp->clip_resource = nullptr;
+  DestroyAnimationState(animation_cmp->state);
+  DestroyAnimationState(animation_cmp->previous_state);
+
+  for (usize i{0}; i < animation_cmp->layer_count; ++i) {
+    DestroyAnimationState(animation_cmp->layers[i].state);
   }
 
-  animation_cmp->start_time = .0f;
-  animation_cmp->frame = 0;
-  animation_cmp->speed = 1.0f;
-  animation_cmp->is_loop = false;
-  animation_cmp->override_flags = kAnimationOverrideFlagBitsNone;
+  DestroyPoseHistory(animation_cmp->lod);
+  *animation_cmp = AnimationComponent{};
+}
+
+void AnimationManager::SetLodLevel(AnimationLodIndex lod_index,
+                                   const AnimationLodLevel& level) {
+  COMET_ASSERT(lod_index < kAnimationLodLevelCount, "LOD index ", lod_index,
+               " is out of bounds: ", kAnimationLodLevelCount, "!");
+  COMET_ASSERT(level.update_interval > 0,
+               "Animation update interval must be positive!");
+  lod_levels_[lod_index] = level;
 }
 
-void AnimationManager::OnAnimationProcessing(
-    job::JobParamsHandle params_handle) {
+const AnimationLodLevel& AnimationManager::GetLodLevel(
+    AnimationLodIndex lod_index) const {
+  COMET_ASSERT(lod_index < kAnimationLodLevelCount, "LOD index ", lod_index,
+               " is out of bounds: ", kAnimationLodLevelCount, "!");
+  return lod_levels_[lod_index];
+}
+
+AnimationStats AnimationManager::GetStats() const {
+  fiber::FiberSpinLockGuard guard{stats_lock_};
+  return stats_;
+}
+
+void AnimationManager::ProcessAnimation(const internal::AnimationJob& job) {
   auto& entity_manager{entity::EntityManager::Get()};
-  auto* job{static_cast<internal::AnimationJob*>(params_handle)};
-  auto index{job->index};
-  auto time{job->time};
-  auto entity_id{job->entity_id};
-  auto* skinning_bindings{job->skinning_bindings};
-  auto* matrix_palettes{job->matrix_palettes};
+  auto index{job.index};
+  auto time{job.time};
+  auto entity_id{job.entity_id};
+  auto* skinning_bindings{job.skinning_bindings};
+  auto* matrix_palettes{job.matrix_palettes};
+  auto& pose{*job.pose};
 
   auto* skeleton_cmp{
       entity_manager.GetComponent<geometry::SkeletonComponent>(entity_id)};
@@ -194,31 +328,146 @@ void AnimationManager::OnAnimationProcessing(
   auto* animation_cmp{
       entity_manager.GetComponent<AnimationComponent>(entity_id)};
 
-  auto animation_time{time - animation_cmp->start_time};
+  const auto& skeleton{skeleton_cmp->resource->skeleton};
+  const auto joint_count{skeleton.joints.GetSize()};
+  auto& binding{skinning_bindings->Get(index)};
+  auto& matrix_palette{matrix_palettes->Get(index)};
+  auto& lod{animation_cmp->lod};
+  auto& stats{*job.stats};
+  ++stats.entity_count;
+  stats.joint_count += joint_count;
+
+  // Culled entities are not drawn: they need neither poses nor palettes.
+  if (lod.is_culled) {
+    binding = {};
+    matrix_palette = {};
+    ++stats.culled_entity_count;
+    return;
+  }
 
-  auto pose{DecompressClipAndExtractPose(
-      animation_cmp->clip_resource->clip, animation_time, animation_cmp->speed,
-      animation_cmp->override_flags, animation_cmp->is_loop)};
+  const auto& lod_level{lod_levels_[lod.lod_index]};
+  const auto lod_joint_count{GetLodJointCount(lod_level, joint_count)};
+  pose.Resize(lod_joint_count);
 
-  // TODO(m4jr0): Support pose blending.
+  const auto is_evaluated{IsLodPoseEvaluated(
+      lod_level, lod_joint_count, job.frame_count + entity_id, lod)};
 
-  const auto& skeleton{skeleton_cmp->resource->skeleton};
-  PopulateGlobalPose(skeleton, pose);
+  if (is_evaluated) {
+    job.layer_scratch->Resize(lod_joint_count);
+    job.reference_scratch->Resize(lod_joint_count);
+    EvaluateAnimation(*animation_cmp, time, pose, *job.layer_scratch,
+                      *job.reference_scratch);
 
-  auto& binding{skinning_bindings->Get(index)};
-  PopulateSkinningBinding(entity_id,
-                          static_cast<u32>(skeleton.joints.GetSize()),
+    if (lod_level.update_interval > 1) {
+      RecordPose(pose, time, lod);
+    }
+
+    ++stats.evaluated_entity_count;
+    stats.evaluated_joint_count += lod_joint_count;
+  } else {
+    ExtrapolatePoses(*lod.history[0], lod.history_times[0], *lod.history[1],
+                     lod.history_times[1], time, pose);
+    ++stats.extrapolated_entity_count;
+  }
+
+  PopulateGlobalPose(skeleton, pose);
+  PopulateSkinningBinding(entity_id, static_cast<u32>(joint_count),
                           static_cast<u32>(index), binding);
 
   // TODO(m4jr0): Support some post-process poses.
 
-  auto& matrix_palette{matrix_palettes->Get(index)};
-  PopulateMatrixPalette(&skeleton, pose.global_pose, matrix_palette);
+  PopulateMatrixPalette(&skeleton, pose, matrix_palette);
+}
+
+void AnimationManager::UpdateLod(entity::EntityId entity_id,
+                                 const frame::FramePacket& packet,
+                                 AnimationComponent& animation_cmp) const {
+  auto& entity_manager{entity::EntityManager::Get()};
+  auto& lod{animation_cmp.lod};
+
+  if (lod.bounding_radius < .0f) {
+    const auto* skeleton_cmp{
+        entity_manager.GetComponent<geometry::SkeletonComponent>(entity_id)};
+    lod.bounding_radius = GetSkeletonRadius(skeleton_cmp->resource->skeleton) *
+                          internal::kAnimationBoundingRadiusScale;
+  }
+
+  math::Sphere bounding_sphere{};
+  bounding_sphere.radius = lod.bounding_radius;
+
+  const auto* transform_cmp{
+      entity_manager.GetComponent<physics::TransformComponent>(entity_id)};
+
+  if (transform_cmp != nullptr) {
+    const auto& global{transform_cmp->global};
+    bounding_sphere.center = math::Vec3{global[3]};
+    bounding_sphere.radius *=
+        math::Max(math::GetMagnitude(math::Vec3{global[0]}),
+                  math::Max(math::GetMagnitude(math::Vec3{global[1]}),
+                            math::GetMagnitude(math::Vec3{global[2]})));
+  }
+
+  // Skeletons without extents are never culled.
+  const auto is_culled{
+      bounding_sphere.radius > .0f &&
+      !packet.camera_frustum.IsSphereContained(bounding_sphere)};
+
+  // Poses recorded before the entity was culled are outdated.
+  if (lod.is_culled && !is_culled) {
+    lod.history_count = 0;
+  }
+
+  lod.is_culled = is_culled;
+  lod.lod_index = SelectAnimationLod(
+      lod_levels_, kAnimationLodLevelCount,
+      math::GetMagnitude(bounding_sphere.center - packet.camera_position));
+}
+
+void AnimationManager::RecordPose(const PoseBuffer& pose, f64 time,
+                                  AnimationLodState& lod) {
+  if (lod.history_joint_count != pose.GetJointCount()) {
+    lod.history_count = 0;
+    lod.history_joint_count = pose.GetJointCount();
+  }
+
+  for (auto*& buffer : lod.history) {
+    if (buffer == nullptr) {
+      buffer =
+          pose_allocator_.AllocateOneAndPopulate<PoseBuffer>(&pose_allocator_);
+    }
+  }
+
+  // The oldest pose is overwritten.
+  auto* buffer{lod.history[0]};
+  lod.history[0] = lod.history[1];
+  lod.history_times[0] = lod.history_times[1];
+  lod.history[1] = buffer;
+  lod.history[1]->CopyLocalPoses(pose);
+  lod.history_times[1] = time;
+
+  if (lod.history_count < 2) {
+    ++lod.history_count;
+  }
+}
+
+void AnimationManager::DestroyPoseHistory(AnimationLodState& lod) {
+  for (auto*& buffer : lod.history) {
+    if (buffer == nullptr) {
+      continue;
+    }
+
+    buffer->Destroy();
+    buffer->~PoseBuffer();
+    pose_allocator_.Deallocate(buffer);
+    buffer = nullptr;
+  }
+
+  lod.history_count = 0;
 }
 
 void AnimationManager::PlayInternal(
     entity::EntityId entity_id, const resource::AnimationClipResource* resource,
-    f32 speed, std::optional<bool> is_loop) {
+    f32 speed, std::optional<bool> is_loop, f32 blend_duration) {
   COMET_ASSERT(resource != nullptr,
                "Tried to play a non-existent animation clip for entity #",
                entity_id, "!");
@@ -227,20 +476,59 @@ void AnimationManager::PlayInternal(
   COMET_ASSERT(animation_cmp != nullptr, "No animation component for entity #",
                entity_id, "!");
 
-  if (animation_cmp->clip_resource != nullptr) {
-    resource::ResourceManager::Get().GetAnimationClips()->Unload(
-        animation_cmp->clip_resource->id);
+  // Poses recorded from the previous clip must not be extrapolated.
+  animation_cmp->lod.history_count = 0;
+
+  // A crossfade which is still running is cut short.
+  DestroyAnimationState(animation_cmp->previous_state);
+  animation_cmp->crossfade_duration = .0f;
+
+  if (blend_duration > .0f && animation_cmp->state.clip_resource != nullptr) {
+    animation_cmp->previous_state = animation_cmp->state;
+    animation_cmp->crossfade_start_time = last_time_;
+    animation_cmp->crossfade_duration = blend_duration;
+  } else {
+    DestroyAnimationState(animation_cmp->state);
   }
 
-  animation_cmp->clip_resource = resource;
-  animation_cmp->start_time = last_time_;
-  animation_cmp->speed = speed;
-  animation_cmp->override_flags = kAnimationOverrideFlagBitsNone;
+  animation_cmp->state = GenerateAnimationState(resource, speed, is_loop);
+}
+
+AnimationState AnimationManager::GenerateAnimationState(
+    const resource::AnimationClipResource* resource, f32 speed,
+    std::optional<bool> is_loop) {
+  AnimationState state{};
+  state.clip_resource = resource;
+  state.start_time = last_time_;
+  state.speed = speed;
 
   if (is_loop.has_value()) {
-    animation_cmp->override_flags |= kAnimationOverrideFlagBitsIsLoop;
-    animation_cmp->is_loop = is_loop.value();
+    state.override_flags |= kAnimationOverrideFlagBitsIsLoop;
+    state.is_loop = is_loop.value();
   }
+
+  const auto track_count{resource != nullptr ? resource->clip.tracks.GetSize()
+                                             : 0};
+
+  if (track_count > 0) {
+    state.key_cursors = pose_allocator_.AllocateMany<u16>(track_count);
+    memory::ClearMemory(state.key_cursors, sizeof(u16) * track_count);
+  }
+
+  return state;
+}
+
+void AnimationManager::DestroyAnimationState(AnimationState& state) {
+  if (state.clip_resource != nullptr) {
+    resource::ResourceManager::Get().GetAnimationClips()->Unload(
+        state.clip_resource->id);
+  }
+
+  if (state.key_cursors != nullptr) {
+    pose_allocator_.Deallocate(state.key_cursors);
+  }
+
+  state = {};
 }
 }  // namespace animation
 }  // namespace comet
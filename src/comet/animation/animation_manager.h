@@ -8,24 +8,40 @@
 #include <optional>
 
 #include "comet/animation/animation_common.h"
+#include "comet/animation/animation_lod.h"
 #include "comet/animation/component/animation_component.h"
+#include "comet/animation/pose_buffer.h"
+#include "comet/core/concurrency/fiber/fiber_primitive.h"
 #include "comet/core/concurrency/job/job.h"
 #include "comet/core/essentials.h"
 #include "comet/core/frame/frame_packet.h"
 #include "comet/core/manager.h"
+#include "comet/core/memory/allocator/size_class_allocator.h"
 #include "comet/entity/entity_id.h"
+#include "comet/entity/entity_query.h"
+#include "comet/geometry/geometry_common.h"
 #include "comet/resource/animation_resource.h"
 #include "comet/resource/resource.h"
 
 namespace comet {
 namespace animation {
 namespace internal {
+// Entities are evaluated in batches, which share their pose buffers.
+constexpr usize kAnimationBatchSize{16};
+// Meshes extend past the joints of their skeleton.
+constexpr f32 kAnimationBoundingRadiusScale{1.5f};
+
 struct AnimationJob {
   usize index{kInvalidIndex};
   f64 time{.0f};
+  frame::FrameCount frame_count{0};
   entity::EntityId entity_id{entity::kInvalidEntityId};
   frame::SkinningBindings* skinning_bindings{nullptr};
   frame::MatrixPalettes* matrix_palettes{nullptr};
+  PoseBuffer* pose{nullptr};
+  PoseBuffer* layer_scratch{nullptr};
+  PoseBuffer* reference_scratch{nullptr};
+  AnimationStats* stats{nullptr};
 };
 }  // namespace internal
 
@@ -33,21 +49,44 @@ class AnimationManager : public Manager {
  public:
   static AnimationManager& Get();
 
-  AnimationManager() = default;
+  AnimationManager();
   AnimationManager(const AnimationManager&) = delete;
   AnimationManager(AnimationManager&&) = delete;
   AnimationManager& operator=(const AnimationManager&) = delete;
   AnimationManager& operator=(AnimationManager&&) = delete;
   virtual ~AnimationManager() = default;
 
+  void Initialize() override;
+  void Shutdown() override;
   void Update(frame::FramePacket* packet);
 
+  // If blend_duration is positive, the clip being played fades out over that
+  // duration, in seconds.
   void Play(entity::EntityId entity_id, const schar* name, f32 speed = 1.0f,
-            std::optional<bool> is_loop = std::nullopt);
+            std::optional<bool> is_loop = std::nullopt,
+            f32 blend_duration = .0f);
   void Play(entity::EntityId entity_id, const wchar* name, f32 speed = 1.0f,
-            std::optional<bool> is_loop = std::nullopt);
+            std::optional<bool> is_loop = std::nullopt,
+            f32 blend_duration = .0f);
   void Play(entity::EntityId entity_id, AnimationClipId id, f32 speed = 1.0f,
-            std::optional<bool> is_loop = std::nullopt);
+            std::optional<bool> is_loop = std::nullopt,
+            f32 blend_duration = .0f);
+
+  // Returns the index of the new layer, or kInvalidIndex if the entity has
+  // too many layers or the clip cannot be loaded.
+  usize AddLayer(entity::EntityId entity_id, AnimationClipId id,
+                 AnimationBlendMode blend_mode = AnimationBlendMode::Override,
+                 f32 weight = 1.0f, const AnimationMask* mask = nullptr,
+                 f32 speed = 1.0f, std::optional<bool> is_loop = std::nullopt);
+  void SetLayerWeight(entity::EntityId entity_id, usize layer_index,
+                      f32 weight);
+  // Layers after the removed one move down by one index.
+  void RemoveLayer(entity::EntityId entity_id, usize layer_index);
+
+  AnimationMask* GenerateAnimationMask(
+      const geometry::Skeleton& skeleton,
+      geometry::SkeletonJointIndex root_joint_index, f32 weight = 1.0f);
+  void DestroyAnimationMask(AnimationMask* mask);
 
   AnimationComponent GenerateAnimationComponent(
       const schar* name, f32 speed = 1.0f,
@@ -67,15 +106,36 @@ class AnimationManager : public Manager {
 
   void DestroyAnimationComponent(AnimationComponent* animation_cmp);
 
+  // Levels must stay sorted by increasing distance.
+  void SetLodLevel(AnimationLodIndex lod_index, const AnimationLodLevel& level);
+  const AnimationLodLevel& GetLodLevel(AnimationLodIndex lod_index) const;
+  AnimationStats GetStats() const;
+
  private:
-  static void OnAnimationProcessing(job::JobParamsHandle params_handle);
+  void ProcessAnimation(const internal::AnimationJob& job);
+  void UpdateLod(entity::EntityId entity_id, const frame::FramePacket& packet,
+                 AnimationComponent& animation_cmp) const;
+  void RecordPose(const PoseBuffer& pose, f64 time, AnimationLodState& lod);
+  void DestroyPoseHistory(AnimationLodState& lod);
 
   void PlayInternal(entity::EntityId entity_id,
                     const resource::AnimationClipResource* resource,
                     f32 speed = 1.0f,
-                    std::optional<bool> is_loop = std::nullopt);
+                    std::optional<bool> is_loop = std::nullopt,
+                    f32 blend_duration = .0f);
+  AnimationState GenerateAnimationState(
+      const resource::AnimationClipResource* resource, f32 speed,
+      std::optional<bool> is_loop);
+  void DestroyAnimationState(AnimationState& state);
 
   f64 last_time_{.0f};
+  entity::EntityQuery animation_query_{};
+  memory::FiberSizeClassAllocator pose_allocator_;
+  PoseBufferPool pose_buffer_pool_;
+  AnimationLodLevel lod_levels_[kAnimationLodLevelCount]{
+      {.0f, 1, 1.0f}, {20.0f, 2, 1.0f}, {50.0f, 4, .5f}, {100.0f, 8, .25f}};
+  mutable fiber::FiberSpinLock stats_lock_{};
+  AnimationStats stats_{};
 };
 }  // namespace animation
 }  // namespace comet
@@ -6,18 +6,61 @@
 #define COMET_COMET_ANIMATION_COMPONENT_ANIMATION_COMPONENT_H_
 
 #include "comet/animation/animation_common.h"
+#include "comet/animation/animation_lod.h"
+#include "comet/animation/pose_buffer.h"
 #include "comet/core/essentials.h"
 #include "comet/resource/animation_resource.h"
 
 namespace comet {
 namespace animation {
-struct AnimationComponent {
+// Playback of a single clip.
+struct AnimationState {
   const resource::AnimationClipResource* clip_resource{nullptr};
   f64 start_time{.0f};
-  FrameIndex frame{0};
   f32 speed{1.0f};
   bool is_loop{false};
   AnimationOverrideFlags override_flags{kAnimationOverrideFlagBitsNone};
+  // Key of each track of the clip found by the last evaluation, owned by the
+  // animation manager.
+  u16* key_cursors{nullptr};
+};
+
+// Layers are applied in order on top of the base state. Masks are owned by
+// the caller and must outlive the layer.
+struct AnimationLayer {
+  AnimationState state{};
+  const AnimationMask* mask{nullptr};
+  f32 weight{1.0f};
+  AnimationBlendMode blend_mode{AnimationBlendMode::Override};
+};
+
+// Level of detail of an entity, selected at every update. Pose history buffers
+// are owned by the animation manager.
+struct AnimationLodState {
+  AnimationLodIndex lod_index{0};
+  // Level of the last processed update, at which the history was recorded.
+  AnimationLodIndex previous_lod_index{0};
+  bool is_culled{false};
+  // Radius of the skeleton in bind pose, computed on the first update.
+  f32 bounding_radius{-1.0f};
+  // Number of poses in the history: extrapolation needs two of them.
+  u8 history_count{0};
+  usize history_joint_count{0};
+  f64 history_times[2]{.0f, .0f};
+  // The second pose is the most recent one.
+  PoseBuffer* history[2]{nullptr, nullptr};
+};
+
+struct AnimationComponent {
+  AnimationState state{};
+  // State faded out during crossfades.
+  AnimationState previous_state{};
+  f64 crossfade_start_time{.0f};
+  f32 crossfade_duration{.0f};
+  FrameIndex frame{0};
+  u8 layer_count{0};
+  AnimationLayer layers[kMaxAnimationLayerCount]{};
+  AnimationLodState lod{};
 };
 }  // namespace animation
 }  // namespace comet
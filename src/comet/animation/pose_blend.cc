@@ -0,0 +1,289 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Header. /////////////////////////////////////////////////////////////////////
+#include "pose_blend.h"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/math/math_common.h"
+
+namespace comet {
+namespace animation {
+namespace internal {
+constexpr f32 kMaxPoseExtrapolationWeight{2.0f};
+
+// Channels of a pose buffer. Kernels below work on one channel at a time, in
+// loops simple enough for compilers to vectorize.
+struct PoseChannels {
+  f32* rotation_x{nullptr};
+  f32* rotation_y{nullptr};
+  f32* rotation_z{nullptr};
+  f32* rotation_w{nullptr};
+  f32* translation_x{nullptr};
+  f32* translation_y{nullptr};
+  f32* translation_z{nullptr};
+  f32* scale{nullptr};
+};
+
+struct ConstPoseChannels {
+  const f32* rotation_x{nullptr};
+  const f32* rotation_y{nullptr};
+  const f32* rotation_z{nullptr};
+  const f32* rotation_w{nullptr};
+  const f32* translation_x{nullptr};
+  const f32* translation_y{nullptr};
+  const f32* translation_z{nullptr};
+  const f32* scale{nullptr};
+};
+
+PoseChannels GetPoseChannels(PoseBuffer& pose) {
+  PoseChannels channels{};
+  channels.rotation_x = pose.GetChannel(kJointPoseChannelRotationX);
+  channels.rotation_y = pose.GetChannel(kJointPoseChannelRotationY);
+  channels.rotation_z = pose.GetChannel(kJointPoseChannelRotationZ);
+  channels.rotation_w = pose.GetChannel(kJointPoseChannelRotationW);
+  channels.translation_x = pose.GetChannel(kJointPoseChannelTranslationX);
+  channels.translation_y = pose.GetChannel(kJointPoseChannelTranslationY);
+  channels.translation_z = pose.GetChannel(kJointPoseChannelTranslationZ);
+  channels.scale = pose.GetChannel(kJointPoseChannelScale);
+  return channels;
+}
+
+ConstPoseChannels GetPoseChannels(const PoseBuffer& pose) {
+  ConstPoseChannels channels{};
+  channels.rotation_x = pose.GetChannel(kJointPoseChannelRotationX);
+  channels.rotation_y = pose.GetChannel(kJointPoseChannelRotationY);
+  channels.rotation_z = pose.GetChannel(kJointPoseChannelRotationZ);
+  channels.rotation_w = pose.GetChannel(kJointPoseChannelRotationW);
+  channels.translation_x = pose.GetChannel(kJointPoseChannelTranslationX);
+  channels.translation_y = pose.GetChannel(kJointPoseChannelTranslationY);
+  channels.translation_z = pose.GetChannel(kJointPoseChannelTranslationZ);
+  channels.scale = pose.GetChannel(kJointPoseChannelScale);
+  return channels;
+}
+
+const f32* GetMaskWeights(const AnimationMask* mask, usize joint_count) {
+  if (mask == nullptr) {
+    return nullptr;
+  }
+
+  COMET_ASSERT(mask->joint_weights.GetSize() >= joint_count,
+               "Animation mask is too small: ",
+               mask->joint_weights.GetSize(), " < ", joint_count, "!");
+  return mask->joint_weights.GetData();
+}
+
+f32 GetJointWeight(f32 weight, const f32* mask_weights, usize joint_index) {
+  return mask_weights != nullptr ? weight * mask_weights[joint_index] : weight;
+}
+
+void NormalizeRotation(PoseChannels& channels, usize joint_index) {
+  const auto x{channels.rotation_x[joint_index]};
+  const auto y{channels.rotation_y[joint_index]};
+  const auto z{channels.rotation_z[joint_index]};
+  const auto w{channels.rotation_w[joint_index]};
+  const auto inv_length{1.0f / math::Sqrt(x * x + y * y + z * z + w * w)};
+  channels.rotation_x[joint_index] = x * inv_length;
+  channels.rotation_y[joint_index] = y * inv_length;
+  channels.rotation_z[joint_index] = z * inv_length;
+  channels.rotation_w[joint_index] = w * inv_length;
+}
+}  // namespace internal
+
+void BlendPoses(const PoseBuffer& a, const PoseBuffer& b, f32 weight,
+                const AnimationMask* mask, PoseBuffer& out) {
+  const auto joint_count{out.GetJointCount()};
+  COMET_ASSERT(a.GetJointCount() == joint_count &&
+                   b.GetJointCount() == joint_count,
+               "Joint count mismatch between blended poses!");
+  const auto src_a{internal::GetPoseChannels(a)};
+  const auto src_b{internal::GetPoseChannels(b)};
+  auto dst{internal::GetPoseChannels(out)};
+  const auto* mask_weights{internal::GetMaskWeights(mask, joint_count)};
+
+  for (usize i{0}; i < joint_count; ++i) {
+    const auto t{internal::GetJointWeight(weight, mask_weights, i)};
+    dst.translation_x[i] =
+        src_a.translation_x[i] +
+        (src_b.translation_x[i] - src_a.translation_x[i]) * t;
+    dst.translation_y[i] =
+        src_a.translation_y[i] +
+        (src_b.translation_y[i] - src_a.translation_y[i]) * t;
+    dst.translation_z[i] =
+        src_a.translation_z[i] +
+        (src_b.translation_z[i] - src_a.translation_z[i]) * t;
+    dst.scale[i] = src_a.scale[i] + (src_b.scale[i] - src_a.scale[i]) * t;
+
+    // Same as math::Nlerp().
+    const auto dot{src_a.rotation_x[i] * src_b.rotation_x[i] +
+                   src_a.rotation_y[i] * src_b.rotation_y[i] +
+                   src_a.rotation_z[i] * src_b.rotation_z[i] +
+                   src_a.rotation_w[i] * src_b.rotation_w[i]};
+    const auto t_b{dot < 0.0f ? -t : t};
+    const auto t_a{1.0f - t};
+    dst.rotation_x[i] = src_a.rotation_x[i] * t_a + src_b.rotation_x[i] * t_b;
+    dst.rotation_y[i] = src_a.rotation_y[i] * t_a + src_b.rotation_y[i] * t_b;
+    dst.rotation_z[i] = src_a.rotation_z[i] * t_a + src_b.rotation_z[i] * t_b;
+    dst.rotation_w[i] = src_a.rotation_w[i] * t_a + src_b.rotation_w[i] * t_b;
+    internal::NormalizeRotation(dst, i);
+  }
+}
+
+void ExtrapolatePoses(const PoseBuffer& a, f64 time_a, const PoseBuffer& b,
+                      f64 time_b, f64 time, PoseBuffer& out) {
+  const auto interval{time_b - time_a};
+  auto weight{1.0f};
+
+  if (interval > .0f) {
+    weight = math::Clamp(static_cast<f32>((time - time_a) / interval), .0f,
+                         internal::kMaxPoseExtrapolationWeight);
+  }
+
+  BlendPoses(a, b, weight, nullptr, out);
+}
+
+void AddPoses(const PoseBuffer& base, const PoseBuffer& additive,
+              const PoseBuffer& reference, f32 weight,
+              const AnimationMask* mask, PoseBuffer& out) {
+  const auto joint_count{out.GetJointCount()};
+  COMET_ASSERT(base.GetJointCount() == joint_count &&
+                   additive.GetJointCount() == joint_count &&
+                   reference.GetJointCount() == joint_count,
+               "Joint count mismatch between added poses!");
+  const auto src_base{internal::GetPoseChannels(base)};
+  const auto src_add{internal::GetPoseChannels(additive)};
+  const auto src_ref{internal::GetPoseChannels(reference)};
+  auto dst{internal::GetPoseChannels(out)};
+  const auto* mask_weights{internal::GetMaskWeights(mask, joint_count)};
+
+  for (usize i{0}; i < joint_count; ++i) {
+    const auto t{internal::GetJointWeight(weight, mask_weights, i)};
+    dst.translation_x[i] =
+        src_base.translation_x[i] +
+        (src_add.translation_x[i] - src_ref.translation_x[i]) * t;
+    dst.translation_y[i] =
+        src_base.translation_y[i] +
+        (src_add.translation_y[i] - src_ref.translation_y[i]) * t;
+    dst.translation_z[i] =
+        src_base.translation_z[i] +
+        (src_add.translation_z[i] - src_ref.translation_z[i]) * t;
+    dst.scale[i] = src_base.scale[i] *
+                   (1.0f + (src_add.scale[i] / src_ref.scale[i] - 1.0f) * t);
+
+    // Delta rotation: additive * conjugate(reference).
+    const auto add_x{src_add.rotation_x[i]};
+    const auto add_y{src_add.rotation_y[i]};
+    const auto add_z{src_add.rotation_z[i]};
+    const auto add_w{src_add.rotation_w[i]};
+    const auto ref_x{-src_ref.rotation_x[i]};
+    const auto ref_y{-src_ref.rotation_y[i]};
+    const auto ref_z{-src_ref.rotation_z[i]};
+    const auto ref_w{src_ref.rotation_w[i]};
+    auto delta_w{add_w * ref_w - add_x * ref_x - add_y * ref_y - add_z * ref_z};
+    auto delta_x{add_w * ref_x + add_x * ref_w + add_y * ref_z - add_z * ref_y};
+    auto delta_y{add_w * ref_y - add_x * ref_z + add_y * ref_w + add_z * ref_x};
+    auto delta_z{add_w * ref_z + add_x * ref_y - add_y * ref_x + add_z * ref_w};
+
+    // Weighted delta: normalized lerp from identity, along the shortest path.
+    const auto t_delta{delta_w < 0.0f ? -t : t};
+    const auto t_identity{1.0f - t};
+    delta_x *= t_delta;
+    delta_y *= t_delta;
+    delta_z *= t_delta;
+    delta_w = t_identity + delta_w * t_delta;
+
+    // Result rotation: delta * base. Normalization covers the weighted delta.
+    const auto base_x{src_base.rotation_x[i]};
+    const auto base_y{src_base.rotation_y[i]};
+    const auto base_z{src_base.rotation_z[i]};
+    const auto base_w{src_base.rotation_w[i]};
+    dst.rotation_w[i] = delta_w * base_w - delta_x * base_x -
+                        delta_y * base_y - delta_z * base_z;
+    dst.rotation_x[i] = delta_w * base_x + delta_x * base_w +
+                        delta_y * base_z - delta_z * base_y;
+    dst.rotation_y[i] = delta_w * base_y - delta_x * base_z +
+                        delta_y * base_w + delta_z * base_x;
+    dst.rotation_z[i] = delta_w * base_z + delta_x * base_y -
+                        delta_y * base_x + delta_z * base_w;
+    internal::NormalizeRotation(dst, i);
+  }
+}
+
+void PopulateAnimationMask(const geometry::Skeleton& skeleton,
+                           geometry::SkeletonJointIndex root_joint_index,
+                           AnimationMask& mask, f32 weight) {
+  const auto joint_count{skeleton.joints.GetSize()};
+  COMET_ASSERT(root_joint_index < joint_count, "Root joint index ",
+               root_joint_index, " is out of bounds: ", joint_count, "!");
+  mask.joint_weights.Resize(joint_count);
+
+  // Parents come first: children inherit the weights of their parents.
+  for (usize i{0}; i < joint_count; ++i) {
+    const auto parent_index{skeleton.joints[i].parent_index};
+
+    if (i == root_joint_index) {
+      mask.joint_weights[i] = weight;
+    } else if (parent_index != geometry::kInvalidSkeletonJointIndex) {
+      mask.joint_weights[i] = mask.joint_weights[parent_index];
+    } else {
+      mask.joint_weights[i] = 0.0f;
+    }
+  }
+}
+
+void SampleAnimationState(const AnimationState& state, f64 time,
+                          PoseBuffer& pose) {
+  COMET_ASSERT(state.clip_resource != nullptr,
+               "Tried to sample an animation state without a clip!");
+  DecompressClipAndExtractPose(state.clip_resource->clip,
+                               time - state.start_time, pose, state.speed,
+                               state.override_flags, state.is_loop,
+                               state.key_cursors);
+}
+
+void EvaluateAnimation(const AnimationComponent& animation_cmp, f64 time,
+                       PoseBuffer& pose, PoseBuffer& layer_scratch,
+                       PoseBuffer& reference_scratch) {
+  SampleAnimationState(animation_cmp.state, time, pose);
+
+  if (animation_cmp.previous_state.clip_resource != nullptr &&
+      animation_cmp.crossfade_duration > 0.0f) {
+    const auto alpha{static_cast<f32>(
+        (time - animation_cmp.crossfade_start_time) /
+        animation_cmp.crossfade_duration)};
+
+    if (alpha < 1.0f) {
+      SampleAnimationState(animation_cmp.previous_state, time, layer_scratch);
+      BlendPoses(layer_scratch, pose, math::Max(alpha, 0.0f), nullptr, pose);
+    }
+  }
+
+  for (usize i{0}; i < animation_cmp.layer_count; ++i) {
+    const auto& layer{animation_cmp.layers[i]};
+
+    if (layer.state.clip_resource == nullptr || layer.weight <= 0.0f) {
+      continue;
+    }
+
+    SampleAnimationState(layer.state, time, layer_scratch);
+
+    switch (layer.blend_mode) {
+      case AnimationBlendMode::Override:
+        BlendPoses(pose, layer_scratch, layer.weight, layer.mask, pose);
+        break;
+      case AnimationBlendMode::Additive:
+        PopulatePoseFromSample(layer.state.clip_resource->clip, 0,
+                               reference_scratch);
+        AddPoses(pose, layer_scratch, reference_scratch, layer.weight,
+                 layer.mask, pose);
+        break;
+    }
+  }
+}
+}  // namespace animation
+}  // namespace comet
@@ -0,0 +1,48 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+#ifndef COMET_COMET_ANIMATION_POSE_BLEND_H_
+#define COMET_COMET_ANIMATION_POSE_BLEND_H_
+
+#include "comet/animation/animation_common.h"
+#include "comet/animation/component/animation_component.h"
+#include "comet/animation/pose_buffer.h"
+#include "comet/core/essentials.h"
+#include "comet/geometry/geometry_common.h"
+
+namespace comet {
+namespace animation {
+// Blends the local poses of a towards the ones of b into out, which can be a
+// or b. Joints are weighted by weight, times their mask weight if mask is not
+// null. Weights above 1 extrapolate the poses.
+void BlendPoses(const PoseBuffer& a, const PoseBuffer& b, f32 weight,
+                const AnimationMask* mask, PoseBuffer& out);
+// Adds the difference between additive and reference to base into out, which
+// can be base. Weights are the same as BlendPoses().
+void AddPoses(const PoseBuffer& base, const PoseBuffer& additive,
+              const PoseBuffer& reference, f32 weight,
+              const AnimationMask* mask, PoseBuffer& out);
+// Extrapolates the poses at time from pose a at time_a and pose b at time_b,
+// into out. Extrapolation stops at twice the interval between both poses.
+void ExtrapolatePoses(const PoseBuffer& a, f64 time_a, const PoseBuffer& b,
+                      f64 time_b, f64 time, PoseBuffer& out);
+
+// The mask weighs the joints from root_joint_index and their children. The
+// joint weights of the mask must have an allocator.
+void PopulateAnimationMask(const geometry::Skeleton& skeleton,
+                           geometry::SkeletonJointIndex root_joint_index,
+                           AnimationMask& mask, f32 weight = 1.0f);
+
+void SampleAnimationState(const AnimationState& state, f64 time,
+                          PoseBuffer& pose);
+// Samples the base state, the crossfade, and the layers of the component into
+// pose. Scratch buffers hold intermediate poses: memory does not depend on the
+// number of layers. Every buffer must be sized to the same joint count.
+void EvaluateAnimation(const AnimationComponent& animation_cmp, f64 time,
+                       PoseBuffer& pose, PoseBuffer& layer_scratch,
+                       PoseBuffer& reference_scratch);
+}  // namespace animation
+}  // namespace comet
+
+#endif  // COMET_COMET_ANIMATION_POSE_BLEND_H_
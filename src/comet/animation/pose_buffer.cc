@@ -0,0 +1,161 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Header. /////////////////////////////////////////////////////////////////////
+#include "pose_buffer.h"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/memory/memory_utils.h"
+
+namespace comet {
+namespace animation {
+PoseBuffer::PoseBuffer(memory::Allocator* allocator)
+    : channels_{allocator}, global_matrices_{allocator} {}
+
+void PoseBuffer::Resize(usize joint_count) {
+  joint_count_ = joint_count;
+  channel_stride_ = GetJointPoseChannelStride(joint_count);
+  channels_.Resize(channel_stride_ * kJointPoseChannelCount);
+  global_matrices_.Resize(joint_count);
+
+  // Padding joints hold identity poses, so that kernels never compute on
+  // garbage.
+  for (auto i{joint_count}; i < channel_stride_; ++i) {
+    SetJointPose(i, JointPose{math::Quat{1.0f, 0.0f, 0.0f, 0.0f},
+                              math::Vec3{0.0f}, 1.0f});
+  }
+}
+
+void PoseBuffer::CopyLocalPoses(const PoseBuffer& other) {
+  Resize(other.joint_count_);
+  memory::CopyMemory(channels_.GetData(), other.channels_.GetData(),
+                     channels_.GetSize() * sizeof(f32));
+}
+
+void PoseBuffer::Destroy() {
+  joint_count_ = 0;
+  channel_stride_ = 0;
+  channels_.Destroy();
+  global_matrices_.Destroy();
+}
+
+JointPose PoseBuffer::GetJointPose(usize joint_index) const {
+  COMET_ASSERT(joint_index < channel_stride_, "Joint index ", joint_index,
+               " is out of bounds: ", channel_stride_, "!");
+  JointPose pose{};
+  pose.rotation =
+      math::Quat{GetChannel(kJointPoseChannelRotationW)[joint_index],
+                 GetChannel(kJointPoseChannelRotationX)[joint_index],
+                 GetChannel(kJointPoseChannelRotationY)[joint_index],
+                 GetChannel(kJointPoseChannelRotationZ)[joint_index]};
+  pose.translation =
+      math::Vec3{GetChannel(kJointPoseChannelTranslationX)[joint_index],
+                 GetChannel(kJointPoseChannelTranslationY)[joint_index],
+                 GetChannel(kJointPoseChannelTranslationZ)[joint_index]};
+  pose.scale = GetChannel(kJointPoseChannelScale)[joint_index];
+  return pose;
+}
+
+void PoseBuffer::SetJointPose(usize joint_index, const JointPose& pose) {
+  COMET_ASSERT(joint_index < channel_stride_, "Joint index ", joint_index,
+               " is out of bounds: ", channel_stride_, "!");
+  GetChannel(kJointPoseChannelRotationX)[joint_index] = pose.rotation.x;
+  GetChannel(kJointPoseChannelRotationY)[joint_index] = pose.rotation.y;
+  GetChannel(kJointPoseChannelRotationZ)[joint_index] = pose.rotation.z;
+  GetChannel(kJointPoseChannelRotationW)[joint_index] = pose.rotation.w;
+  GetChannel(kJointPoseChannelTranslationX)[joint_index] = pose.translation.x;
+  GetChannel(kJointPoseChannelTranslationY)[joint_index] = pose.translation.y;
+  GetChannel(kJointPoseChannelTranslationZ)[joint_index] = pose.translation.z;
+  GetChannel(kJointPoseChannelScale)[joint_index] = pose.scale;
+}
+
+f32* PoseBuffer::GetChannel(JointPoseChannel channel) {
+  return channels_.GetData() + channel * channel_stride_;
+}
+
+const f32* PoseBuffer::GetChannel(JointPoseChannel channel) const {
+  return channels_.GetData() + channel * channel_stride_;
+}
+
+math::TransformChannels PoseBuffer::GetTransformChannels() const {
+  math::TransformChannels channels{};
+  channels.translations_x = GetChannel(kJointPoseChannelTranslationX);
+  channels.translations_y = GetChannel(kJointPoseChannelTranslationY);
+  channels.translations_z = GetChannel(kJointPoseChannelTranslationZ);
+  channels.rotations_x = GetChannel(kJointPoseChannelRotationX);
+  channels.rotations_y = GetChannel(kJointPoseChannelRotationY);
+  channels.rotations_z = GetChannel(kJointPoseChannelRotationZ);
+  channels.rotations_w = GetChannel(kJointPoseChannelRotationW);
+  channels.scales = GetChannel(kJointPoseChannelScale);
+  return channels;
+}
+
+math::Mat4* PoseBuffer::GetGlobalMatrices() {
+  return global_matrices_.GetData();
+}
+
+const math::Mat4* PoseBuffer::GetGlobalMatrices() const {
+  return global_matrices_.GetData();
+}
+
+usize PoseBuffer::GetJointCount() const noexcept { return joint_count_; }
+
+usize PoseBuffer::GetChannelStride() const noexcept { return channel_stride_; }
+
+PoseBufferPool::PoseBufferPool(memory::Allocator* allocator)
+    : allocator_{allocator} {}
+
+void PoseBufferPool::Initialize() {
+  buffers_ = Array<PoseBuffer*>{allocator_};
+  free_buffers_ = Array<PoseBuffer*>{allocator_};
+}
+
+void PoseBufferPool::Destroy() {
+  COMET_ASSERT(free_buffers_.GetSize() == buffers_.GetSize(),
+               "Some pose buffers were not released: ",
+               buffers_.GetSize() - free_buffers_.GetSize(), "!");
+
+  for (auto* buffer : buffers_) {
+    buffer->Destroy();
+    buffer->~PoseBuffer();
+    allocator_->Deallocate(buffer);
+  }
+
+  buffers_.Destroy();
+  free_buffers_.Destroy();
+}
+
+PoseBuffer* PoseBufferPool::Acquire(usize joint_count) {
+  PoseBuffer* buffer{nullptr};
+
+  {
+    fiber::FiberSpinLockGuard lock{lock_};
+
+    if (!free_buffers_.IsEmpty()) {
+      buffer = free_buffers_.GetLast();
+      free_buffers_.Resize(free_buffers_.GetSize() - 1);
+    } else {
+      buffer = allocator_->AllocateOneAndPopulate<PoseBuffer>(allocator_);
+      buffers_.PushBack(buffer);
+    }
+  }
+
+  buffer->Resize(joint_count);
+  return buffer;
+}
+
+void PoseBufferPool::Release(PoseBuffer* buffer) {
+  fiber::FiberSpinLockGuard lock{lock_};
+  free_buffers_.PushBack(buffer);
+}
+
+usize PoseBufferPool::GetBufferCount() const noexcept {
+  return buffers_.GetSize();
+}
+}  // namespace animation
+}  // namespace comet
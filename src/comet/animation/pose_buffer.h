@@ -0,0 +1,96 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+#ifndef COMET_COMET_ANIMATION_POSE_BUFFER_H_
+#define COMET_COMET_ANIMATION_POSE_BUFFER_H_
+
+#include "comet/animation/animation_common.h"
+#include "comet/core/concurrency/fiber/fiber_primitive.h"
+#include "comet/core/essentials.h"
+#include "comet/core/memory/allocator/allocator.h"
+#include "comet/core/type/array.h"
+#include "comet/math/geometry.h"
+#include "comet/math/matrix.h"
+
+namespace comet {
+namespace animation {
+enum JointPoseChannel : u8 {
+  kJointPoseChannelRotationX = 0,
+  kJointPoseChannelRotationY,
+  kJointPoseChannelRotationZ,
+  kJointPoseChannelRotationW,
+  kJointPoseChannelTranslationX,
+  kJointPoseChannelTranslationY,
+  kJointPoseChannelTranslationZ,
+  kJointPoseChannelScale,
+  kJointPoseChannelCount
+};
+
+// Local joint poses stored as structure of arrays, with the global matrices
+// computed from them. Channels are padded to a multiple of kJointPoseLaneCount
+// joints. Resizing a buffer keeps the memory it already has.
+class PoseBuffer {
+ public:
+  PoseBuffer() = default;
+  explicit PoseBuffer(memory::Allocator* allocator);
+  PoseBuffer(const PoseBuffer&) = delete;
+  PoseBuffer(PoseBuffer&&) noexcept = default;
+  PoseBuffer& operator=(const PoseBuffer&) = delete;
+  PoseBuffer& operator=(PoseBuffer&&) noexcept = default;
+  ~PoseBuffer() = default;
+
+  void Resize(usize joint_count);
+  // Resizes the buffer to the joint count of other and copies its local poses.
+  void CopyLocalPoses(const PoseBuffer& other);
+  void Destroy();
+
+  JointPose GetJointPose(usize joint_index) const;
+  void SetJointPose(usize joint_index, const JointPose& pose);
+
+  f32* GetChannel(JointPoseChannel channel);
+  const f32* GetChannel(JointPoseChannel channel) const;
+  math::TransformChannels GetTransformChannels() const;
+  math::Mat4* GetGlobalMatrices();
+  const math::Mat4* GetGlobalMatrices() const;
+  usize GetJointCount() const noexcept;
+  usize GetChannelStride() const noexcept;
+
+ private:
+  usize joint_count_{0};
+  usize channel_stride_{0};
+  Array<f32> channels_{};
+  Array<math::Mat4> global_matrices_{};
+};
+
+// Pose buffers are acquired for the duration of a job, and released for other
+// jobs to reuse them. Memory only grows with the number of buffers used at the
+// same time.
+class PoseBufferPool {
+ public:
+  PoseBufferPool() = default;
+  explicit PoseBufferPool(memory::Allocator* allocator);
+  PoseBufferPool(const PoseBufferPool&) = delete;
+  PoseBufferPool(PoseBufferPool&&) = delete;
+  PoseBufferPool& operator=(const PoseBufferPool&) = delete;
+  PoseBufferPool& operator=(PoseBufferPool&&) = delete;
+  ~PoseBufferPool() = default;
+
+  void Initialize();
+  void Destroy();
+
+  PoseBuffer* Acquire(usize joint_count);
+  void Release(PoseBuffer* buffer);
+
+  usize GetBufferCount() const noexcept;
+
+ private:
+  memory::Allocator* allocator_{nullptr};
+  fiber::FiberSpinLock lock_{};
+  Array<PoseBuffer*> buffers_{};
+  Array<PoseBuffer*> free_buffers_{};
+};
+}  // namespace animation
+}  // namespace comet
+
+#endif  // COMET_COMET_ANIMATION_POSE_BUFFER_H_
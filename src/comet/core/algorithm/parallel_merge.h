@@ -0,0 +1,98 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+#ifndef COMET_COMET_CORE_ALGORITHM_PARALLEL_MERGE_H_
+#define COMET_COMET_CORE_ALGORITHM_PARALLEL_MERGE_H_
+
+#include "comet/core/algorithm/algorithm_common.h"
+#include "comet/core/concurrency/job/parallel.h"
+#include "comet/core/essentials.h"
+#include "comet/math/math_common.h"
+
+namespace comet {
+namespace internal {
+// Below this count, fanning out costs more than it saves.
+constexpr usize kParallelMergeMinCount{65536};
+
+// Returns how many elements of a are among the first output_index elements
+// of the merge of a and b. Elements of a come first on ties.
+template <typename T, typename Comparer>
+usize ResolveMergeSplit(const T* a, usize a_count, const T* b, usize b_count,
+                        usize output_index, Comparer& comparer) {
+  auto low{output_index > b_count ? output_index - b_count : 0};
+  auto high{math::Min(output_index, a_count)};
+
+  while (low < high) {
+    const auto a_index{low + (high - low) / 2};
+
+    if (comparer(b[output_index - a_index - 1], a[a_index])) {
+      high = a_index;
+    } else {
+      low = a_index + 1;
+    }
+  }
+
+  return low;
+}
+}  // namespace internal
+
+// Merges the sorted ranges a and b into output, which must not overlap them.
+// Elements of a come first on ties.
+template <typename T, typename Comparer = Less>
+void Merge(const T* a, usize a_count, const T* b, usize b_count, T* output,
+           Comparer comparer = Comparer{}) {
+  const auto* a_end{a + a_count};
+  const auto* b_end{b + b_count};
+
+  while (a != a_end && b != b_end) {
+    if (comparer(*b, *a)) {
+      *output++ = *b++;
+    } else {
+      *output++ = *a++;
+    }
+  }
+
+  while (a != a_end) {
+    *output++ = *a++;
+  }
+
+  while (b != b_end) {
+    *output++ = *b++;
+  }
+}
+
+// Same as Merge(), but the output is split into chunks which are merged from
+// several workers. Each chunk finds its inputs with a binary search along its
+// first output index. Small ranges are merged on the calling thread.
+template <typename T, typename Comparer = Less>
+void ParallelMerge(const T* a, usize a_count, const T* b, usize b_count,
+                   T* output, Comparer comparer = Comparer{},
+                   usize grain_size = 0) {
+  const auto count{a_count + b_count};
+
+  if (count < internal::kParallelMergeMinCount) {
+    Merge(a, a_count, b, b_count, output, comparer);
+    return;
+  }
+
+  grain_size = job::internal::ResolveGrainSize(count, grain_size);
+  const auto chunk_count{(count + grain_size - 1) / grain_size};
+
+  job::ParallelFor({0, chunk_count}, 1, [&](usize chunk_index) {
+    const auto output_begin{chunk_index * grain_size};
+    const auto output_end{math::Min(count, output_begin + grain_size)};
+    const auto a_begin{internal::ResolveMergeSplit(a, a_count, b, b_count,
+                                                   output_begin, comparer)};
+    const auto a_end{internal::ResolveMergeSplit(a, a_count, b, b_count,
+                                                 output_end, comparer)};
+    const auto b_begin{output_begin - a_begin};
+    const auto b_end{output_end - a_end};
+
+    Merge(a + a_begin, a_end - a_begin, b + b_begin, b_end - b_begin,
+          output + output_begin, comparer);
+  });
+}
+}  // namespace comet
+
+#endif  // COMET_COMET_CORE_ALGORITHM_PARALLEL_MERGE_H_
@@ -0,0 +1,213 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+#ifndef COMET_COMET_CORE_ALGORITHM_RADIX_SORT_H_
+#define COMET_COMET_CORE_ALGORITHM_RADIX_SORT_H_
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <type_traits>
+#include <utility>
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/concurrency/job/parallel.h"
+#include "comet/core/essentials.h"
+#include "comet/core/frame/frame_utils.h"
+#include "comet/core/memory/memory_utils.h"
+#include "comet/math/math_common.h"
+
+namespace comet {
+namespace internal {
+constexpr usize kRadixDigitBitCount{8};
+constexpr usize kRadixBucketCount{usize{1} << kRadixDigitBitCount};
+constexpr usize kRadixDigitMask{kRadixBucketCount - 1};
+// Below this count, fanning out costs more than it saves.
+constexpr usize kParallelRadixSortMinCount{65536};
+
+struct IdentityRadixKey {
+  template <typename T>
+  constexpr const T& operator()(const T& value) const {
+    return value;
+  }
+};
+
+// Signed keys have their sign bit flipped, so that negative keys come first.
+template <typename Key>
+constexpr std::make_unsigned_t<Key> ToRadixKey(Key key) {
+  static_assert(std::is_integral_v<Key>, "Radix sort keys must be integers!");
+  using UnsignedKey = std::make_unsigned_t<Key>;
+  auto radix_key{static_cast<UnsignedKey>(key)};
+
+  if constexpr (std::is_signed_v<Key>) {
+    radix_key ^= UnsignedKey{1} << (sizeof(Key) * kCharBit - 1);
+  }
+
+  return radix_key;
+}
+
+template <typename T, typename KeyGetter>
+using RadixKey = std::decay_t<decltype(std::declval<const KeyGetter&>()(
+    std::declval<const T&>()))>;
+
+template <typename T, typename KeyGetter>
+usize GetRadixDigit(const T& value, const KeyGetter& key_getter, usize pass) {
+  return static_cast<usize>(ToRadixKey(key_getter(value)) >>
+                            (pass * kRadixDigitBitCount)) &
+         kRadixDigitMask;
+}
+
+// Turns digit counts into the offsets at which digits start.
+inline void GenerateRadixOffsets(usize* histogram) {
+  usize offset{0};
+
+  for (usize i{0}; i < kRadixBucketCount; ++i) {
+    const auto count{histogram[i]};
+    histogram[i] = offset;
+    offset += count;
+  }
+}
+}  // namespace internal
+
+// Stable LSD radix sort on the integer returned by key_getter. scratch must
+// hold as many elements as the range. Passes on digits shared by all the keys
+// are skipped.
+template <typename T, typename KeyGetter = internal::IdentityRadixKey>
+void RadixSort(T* begin, T* end, T* scratch, KeyGetter key_getter = {}) {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Radix sort requires trivially copyable elements!");
+  const auto count{static_cast<usize>(end - begin)};
+
+  if (count <= 1) {
+    return;
+  }
+
+  constexpr auto kPassCount{sizeof(internal::RadixKey<T, KeyGetter>)};
+  auto* src{begin};
+  auto* dst{scratch};
+
+  for (usize pass{0}; pass < kPassCount; ++pass) {
+    usize histogram[internal::kRadixBucketCount]{};
+
+    for (usize i{0}; i < count; ++i) {
+      ++histogram[internal::GetRadixDigit(src[i], key_getter, pass)];
+    }
+
+    if (histogram[internal::GetRadixDigit(src[0], key_getter, pass)] ==
+        count) {
+      continue;
+    }
+
+    internal::GenerateRadixOffsets(histogram);
+
+    for (usize i{0}; i < count; ++i) {
+      dst[histogram[internal::GetRadixDigit(src[i], key_getter, pass)]++] =
+          src[i];
+    }
+
+    std::swap(src, dst);
+  }
+
+  if (src != begin) {
+    memory::CopyMemory(begin, src, count * sizeof(T));
+  }
+}
+
+template <typename T, typename KeyGetter = internal::IdentityRadixKey>
+void RadixSort(T* begin, T* end, KeyGetter key_getter = {}) {
+  frame::FrameArray<T> scratch{};
+  scratch.Resize(static_cast<usize>(end - begin));
+  RadixSort(begin, end, scratch.GetData(), key_getter);
+}
+
+// Same as RadixSort(), but each pass counts and scatters chunks of the range
+// from several workers. Small ranges are sorted on the calling thread.
+template <typename T, typename KeyGetter = internal::IdentityRadixKey>
+void ParallelRadixSort(T* begin, T* end, T* scratch, KeyGetter key_getter = {},
+                       usize grain_size = 0) {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Radix sort requires trivially copyable elements!");
+  const auto count{static_cast<usize>(end - begin)};
+
+  if (count < internal::kParallelRadixSortMinCount) {
+    RadixSort(begin, end, scratch, key_getter);
+    return;
+  }
+
+  grain_size = job::internal::ResolveGrainSize(count, grain_size);
+  const auto chunk_count{(count + grain_size - 1) / grain_size};
+  constexpr auto kPassCount{sizeof(internal::RadixKey<T, KeyGetter>)};
+
+  // One histogram per chunk, which becomes the offsets of its digits.
+  frame::FrameArray<usize> histograms{};
+  histograms.Resize(chunk_count * internal::kRadixBucketCount);
+
+  auto* src{begin};
+  auto* dst{scratch};
+
+  for (usize pass{0}; pass < kPassCount; ++pass) {
+    job::ParallelFor({0, chunk_count}, 1, [&](usize chunk_index) {
+      auto* histogram{&histograms[chunk_index * internal::kRadixBucketCount]};
+      const auto chunk_end{math::Min(count, (chunk_index + 1) * grain_size)};
+
+      for (usize i{0}; i < internal::kRadixBucketCount; ++i) {
+        histogram[i] = 0;
+      }
+
+      for (auto i{chunk_index * grain_size}; i < chunk_end; ++i) {
+        ++histogram[internal::GetRadixDigit(src[i], key_getter, pass)];
+      }
+    });
+
+    const auto first_digit{internal::GetRadixDigit(src[0], key_getter, pass)};
+    usize first_digit_count{0};
+
+    for (usize i{0}; i < chunk_count; ++i) {
+      first_digit_count +=
+          histograms[i * internal::kRadixBucketCount + first_digit];
+    }
+
+    if (first_digit_count == count) {
+      continue;
+    }
+
+    // Chunks write each digit one after the other, which keeps the sort
+    // stable.
+    usize offset{0};
+
+    for (usize digit{0}; digit < internal::kRadixBucketCount; ++digit) {
+      for (usize i{0}; i < chunk_count; ++i) {
+        auto& chunk_offset{histograms[i * internal::kRadixBucketCount + digit]};
+        const auto digit_count{chunk_offset};
+        chunk_offset = offset;
+        offset += digit_count;
+      }
+    }
+
+    job::ParallelFor({0, chunk_count}, 1, [&](usize chunk_index) {
+      auto* offsets{&histograms[chunk_index * internal::kRadixBucketCount]};
+      const auto chunk_end{math::Min(count, (chunk_index + 1) * grain_size)};
+
+      for (auto i{chunk_index * grain_size}; i < chunk_end; ++i) {
+        dst[offsets[internal::GetRadixDigit(src[i], key_getter, pass)]++] =
+            src[i];
+      }
+    });
+
+    std::swap(src, dst);
+  }
+
+  if (src != begin) {
+    memory::CopyMemory(begin, src, count * sizeof(T));
+  }
+}
+
+template <typename T, typename KeyGetter = internal::IdentityRadixKey>
+void ParallelRadixSort(T* begin, T* end, KeyGetter key_getter = {},
+                       usize grain_size = 0) {
+  frame::FrameArray<T> scratch{};
+  scratch.Resize(static_cast<usize>(end - begin));
+  ParallelRadixSort(begin, end, scratch.GetData(), key_getter, grain_size);
+}
+}  // namespace comet
+
+#endif  // COMET_COMET_CORE_ALGORITHM_RADIX_SORT_H_
@@ -165,6 +165,14 @@ bool Fiber::IsStackOverflow() const {
 const schar* Fiber::GetDebugLabel() const noexcept { return debug_label_; }
 #endif  // COMET_FIBER_DEBUG_LABEL
 
+#ifdef COMET_PROFILING
+void* Fiber::GetProfiledScope() const noexcept { return profiled_scope_; }
+
+void Fiber::SetProfiledScope(void* profiled_scope) noexcept {
+  profiled_scope_ = profiled_scope;
+}
+#endif  // COMET_PROFILING
+
 #ifdef COMET_POISON_FIBER_STACKS
 void Fiber::PoisonStack() {
   COMET_ASSERT(stack_ != nullptr, "Stack is null!");
@@ -108,6 +108,11 @@ class Fiber {
   sptrdiff GetCurrentStackSizeLeft() const;
   bool IsStackOverflow() const;
 
+#ifdef COMET_PROFILING
+  void* GetProfiledScope() const noexcept;
+  void SetProfiledScope(void* profiled_scope) noexcept;
+#endif  // COMET_PROFILING
+
 #ifdef COMET_FIBER_DEBUG_LABEL
   const schar* GetDebugLabel() const noexcept;
 
@@ -142,6 +147,12 @@ class Fiber {
   Stack stack_{nullptr};
   uptr* stack_top_{nullptr};
   ExecutionContext context_{};
+
+#ifdef COMET_PROFILING
+  // Innermost profiled scope opened by the fiber. Fibers can be resumed on any
+  // worker: their scopes cannot be tracked per thread.
+  void* profiled_scope_{nullptr};
+#endif  // COMET_PROFILING
 };
 
 constexpr auto kMicroStackSize{2048};       // 2 KiB.
@@ -135,6 +135,8 @@ bool IsFiber() {
   return tls_current_fiber != nullptr;
 }
 
+bool IsThreadFiber() { return tls_current_fiber == &tls_thread_fiber; }
+
 FiberId GetFiberId() {
   return tls_current_fiber != nullptr ? tls_current_fiber->GetId()
                                       : kInvalidFiberId;
@@ -23,6 +23,9 @@ void ResumeWorker();
 }  // namespace internal
 
 bool IsFiber();
+// Returns whether the current fiber is the one of the thread itself: it cannot
+// be suspended.
+bool IsThreadFiber();
 FiberId GetFiberId();
 Fiber* GetFiber();
 void Yield();
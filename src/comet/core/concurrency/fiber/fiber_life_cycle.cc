@@ -54,6 +54,8 @@ Fiber* FiberLifeCycleQueue::TryPop() {
   queue_.TryPop();
   return fiber;
 }
+
+bool FiberLifeCycleQueue::IsEmpty() const noexcept { return queue_.IsEmpty(); }
 }  // namespace internal
 
 FiberLifeCycleHandler& FiberLifeCycleHandler::Get() {
@@ -80,6 +82,10 @@ Fiber* FiberLifeCycleHandler::TryWakingUp() {
   return sleeping_fibers_.TryPop();
 }
 
+bool FiberLifeCycleHandler::HasSleepingFibers() const noexcept {
+  return !sleeping_fibers_.IsEmpty();
+}
+
 void FiberLifeCycleHandler::PutToCompleted(Fiber* fiber) {
   completed_fibers_.Push(fiber);
 }
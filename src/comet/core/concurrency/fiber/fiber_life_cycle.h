@@ -26,6 +26,7 @@ class FiberLifeCycleQueue {
 
   void Push(Fiber* fiber);
   Fiber* TryPop();
+  bool IsEmpty() const noexcept;
 
  private:
   memory::Allocator* allocator_{nullptr};
@@ -51,6 +52,7 @@ class FiberLifeCycleHandler {
   void DetachWorkerFiber();
   void PutToSleep(Fiber* fiber);
   Fiber* TryWakingUp();
+  bool HasSleepingFibers() const noexcept;
 
   void PutToCompleted(Fiber* fiber);
   Fiber* TryGetCompleted();
@@ -11,32 +11,110 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "comet/core/concurrency/fiber/fiber_context.h"
+#include "comet/core/concurrency/job/scheduler.h"
 
 namespace comet {
 namespace job {
-CounterWaiter::CounterWaiter(Counter& counter) : counter_{counter} {
+CounterWaiter::CounterWaiter(Counter& counter, CounterCount target)
+    : counter_{counter} {
   // Case: blockable thread (no fiber is being executed).
-  if (!fiber::IsFiber()) {
-    while (!counter.IsZero());
+  if (!fiber::IsFiber() || fiber::IsThreadFiber()) {
+    while (!counter.IsReached(target));
     return;
   }
 
-  while (!counter.IsZero()) {
-    fiber::Yield();
+  if (counter.IsReached(target)) {
+    return;
   }
+
+  CounterWaitNode node{};
+  node.fiber = fiber::GetFiber();
+  node.target = target;
+  Scheduler::Get().Suspend(counter, node);
 }
 
-void Counter::Reset() { value_ = 0; }
+void Counter::Reset() {
+  COMET_ASSERT(waiters_ == nullptr,
+               "Counter cannot be reset! Its wait list is not empty!");
+  value_ = 0;
+}
 
 void Counter::Increment() { ++value_; }
 
 void Counter::Decrement() {
   COMET_ASSERT(!IsZero(), "Counter cannot be decremented! Value is 0!");
   --value_;
+
+  // Both the decrement and the registration of a waiter are sequentially
+  // consistent: either the waiter sees the new value, or the decrement sees the
+  // waiter.
+  if (waiter_count_.load() == 0) {
+    return;
+  }
+
+  CounterWaitNode* to_resume{nullptr};
+
+  {
+    fiber::SimpleLockGuard guard{waiter_lock_};
+    auto** node{&waiters_};
+    // The current value is used: if the counter went up again in the meantime,
+    // the next decrement resumes the waiters.
+    const auto current_value{value_.load()};
+
+    while (*node != nullptr) {
+      auto* waiter{*node};
+
+      if (current_value > waiter->target) {
+        node = &waiter->next;
+        continue;
+      }
+
+      *node = waiter->next;
+      waiter->next = to_resume;
+      to_resume = waiter;
+      --waiter_count_;
+    }
+  }
+
+  // The counter is not accessed anymore: a resumed fiber may destroy it.
+  auto& scheduler{Scheduler::Get()};
+
+  while (to_resume != nullptr) {
+    // The node is destroyed as soon as its fiber is resumed or its job is
+    // kicked.
+    auto* next{to_resume->next};
+
+    if (to_resume->continuation != nullptr) {
+      scheduler.ResolvePredecessor(to_resume->continuation);
+    } else {
+      scheduler.Resume(to_resume->fiber);
+    }
+
+    to_resume = next;
+  }
 }
 
 bool Counter::IsZero() const noexcept { return value_ == 0; }
 
+bool Counter::IsReached(CounterCount target) const noexcept {
+  return value_ <= target;
+}
+
+bool Counter::TryAddWaiter(CounterWaitNode* node) {
+  COMET_ASSERT(node != nullptr, "Wait node provided is null!");
+  fiber::SimpleLockGuard guard{waiter_lock_};
+  ++waiter_count_;
+
+  if (IsReached(node->target)) {
+    --waiter_count_;
+    return false;
+  }
+
+  node->next = waiters_;
+  waiters_ = node;
+  return true;
+}
+
 usize Counter::GetValue() const noexcept { return value_; }
 
 const schar* GetJobStackSizeLabel(JobStackSize stack_size) {
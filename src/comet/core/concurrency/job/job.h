@@ -10,6 +10,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "comet/core/concurrency/fiber/fiber.h"
+#include "comet/core/concurrency/fiber/fiber_primitive.h"
 #include "comet/core/essentials.h"
 
 namespace comet {
@@ -19,6 +20,18 @@ enum class JobPriority { Unknown = 0, Low, Normal, High };
 using CounterCount = usize;
 constexpr auto kInvalidCounterCount{static_cast<CounterCount>(-1)};
 
+struct JobContinuation;
+
+// Fiber suspended, or job pending, until a counter goes down to its target
+// value. Nodes of suspended fibers live on their stack, while the ones of
+// pending jobs live in their continuation.
+struct CounterWaitNode {
+  fiber::Fiber* fiber{nullptr};
+  JobContinuation* continuation{nullptr};
+  CounterCount target{0};
+  CounterWaitNode* next{nullptr};
+};
+
 class Counter {
  public:
   Counter() = default;
@@ -30,13 +43,22 @@ class Counter {
 
   void Reset();
   void Increment();
+  // Fibers waiting for the new value are made runnable again.
   void Decrement();
   bool IsZero() const noexcept;
+  bool IsReached(CounterCount target) const noexcept;
+  // Adds the node to the wait list, unless its target is already reached.
+  // Returns whether the node was added.
+  bool TryAddWaiter(CounterWaitNode* node);
 
   usize GetValue() const noexcept;
 
  private:
   std::atomic<CounterCount> value_{kInvalidCounterCount};
+  // Lets decrements skip the lock when nobody waits.
+  std::atomic<usize> waiter_count_{0};
+  fiber::SimpleLock waiter_lock_{};
+  CounterWaitNode* waiters_{nullptr};
 };
 
 enum class JobStackSize {
@@ -75,6 +97,19 @@ struct IOJobDescr {
   Counter* counter{nullptr};
 };
 
+constexpr usize kMaxJobPredecessorCount{4};
+
+// Job kicked once all its predecessor counters reach zero. See
+// Scheduler::KickAfter().
+struct JobContinuation {
+  JobDescr job_descr{};
+  IOJobDescr io_job_descr{};
+  bool is_io_job{false};
+  // Predecessors which are not done yet, plus one while they are registered.
+  std::atomic<usize> pending_count{0};
+  CounterWaitNode wait_nodes[kMaxJobPredecessorCount]{};
+};
+
 using MainThreadJobDescr = IOJobDescr;
 using MainThreadEntryPoint = IOEntryPoint;
 using MainThreadParamsHandle = IOJobParamsHandle;
@@ -88,7 +123,10 @@ constexpr auto kInvalidJobPrimitiveDebugId{
 class CounterWaiter {
  public:
   CounterWaiter() = delete;
-  explicit CounterWaiter(Counter& counter);
+  // Returns once the value of the counter is lower or equal to the target.
+  // From a fiber, the current fiber is suspended until then and may be resumed
+  // by any fiber worker.
+  explicit CounterWaiter(Counter& counter, CounterCount target = 0);
   CounterWaiter(const CounterWaiter&) = delete;
   CounterWaiter(CounterWaiter&&) = delete;
   CounterWaiter& operator=(const CounterWaiter&) = delete;
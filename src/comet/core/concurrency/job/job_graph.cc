@@ -0,0 +1,146 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Header. /////////////////////////////////////////////////////////////////////
+#include "job_graph.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <atomic>
+#include <utility>
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/concurrency/job/scheduler.h"
+
+namespace comet {
+namespace job {
+JobGraph::JobGraph(memory::Allocator* allocator)
+    : allocator_{allocator},
+      nodes_{allocator},
+      remaining_predecessor_counts_{allocator} {}
+
+JobGraph::~JobGraph() {
+  COMET_ASSERT(counter_ == nullptr,
+               "Destructor called for job graph, but it is still allocated!");
+}
+
+JobGraphNodeId JobGraph::AddNode(const JobDescr& job_descr) {
+  COMET_ASSERT(!IsRunning(), "Cannot add a node to a running job graph!");
+  COMET_ASSERT(job_descr.entry_point != nullptr,
+               "Entry point of job graph node is null!");
+  const auto node_id{static_cast<JobGraphNodeId>(nodes_.GetSize())};
+
+  internal::JobGraphNode node{};
+  node.graph = this;
+  node.id = node_id;
+  node.job_descr = job_descr;
+  node.job_descr.counter = nullptr;
+  node.successors = Array<JobGraphNodeId>{allocator_};
+  nodes_.PushBack(std::move(node));
+  remaining_predecessor_counts_.PushBack(0);
+  return node_id;
+}
+
+void JobGraph::AddDependency(JobGraphNodeId predecessor_id,
+                             JobGraphNodeId successor_id) {
+  COMET_ASSERT(!IsRunning(), "Cannot add a dependency to a running job graph!");
+  COMET_ASSERT(successor_id < nodes_.GetSize(), "Unknown job graph node #",
+               successor_id, "!");
+  COMET_ASSERT(predecessor_id < successor_id, "Job graph node #",
+               successor_id, " depends on node #", predecessor_id,
+               ", which must be added first!");
+  nodes_[predecessor_id].successors.PushBack(successor_id);
+  ++nodes_[successor_id].predecessor_count;
+}
+
+void JobGraph::Kick() {
+  COMET_ASSERT(!IsRunning(), "Job graph is already running!");
+
+  if (nodes_.IsEmpty()) {
+    return;
+  }
+
+  if (counter_ == nullptr) {
+    counter_ = Scheduler::Get().GenerateCounter();
+  }
+
+  const auto node_count{nodes_.GetSize()};
+
+  for (usize i{0}; i < node_count; ++i) {
+    remaining_predecessor_counts_[i] = nodes_[i].predecessor_count;
+  }
+
+  for (usize i{0}; i < node_count; ++i) {
+    if (nodes_[i].predecessor_count == 0) {
+      KickNode(i);
+    }
+  }
+}
+
+void JobGraph::Wait() { Scheduler::Get().Wait(counter_); }
+
+void JobGraph::KickAndWait() {
+  Kick();
+  Wait();
+}
+
+void JobGraph::Clear() {
+  COMET_ASSERT(!IsRunning(), "Cannot clear a running job graph!");
+
+  for (auto& node : nodes_) {
+    node.successors.Destroy();
+  }
+
+  nodes_.Clear();
+  remaining_predecessor_counts_.Clear();
+}
+
+void JobGraph::Destroy() {
+  Clear();
+  nodes_.Destroy();
+  remaining_predecessor_counts_.Destroy();
+
+  if (counter_ != nullptr) {
+    Scheduler::Get().DestroyCounter(counter_);
+    counter_ = nullptr;
+  }
+}
+
+bool JobGraph::IsRunning() const {
+  return counter_ != nullptr && !counter_->IsZero();
+}
+
+usize JobGraph::GetNodeCount() const noexcept { return nodes_.GetSize(); }
+
+void JobGraph::OnNode(JobParamsHandle params_handle) {
+  const auto* node{static_cast<const internal::JobGraphNode*>(params_handle)};
+  node->job_descr.entry_point(node->job_descr.params_handle);
+  auto* graph{node->graph};
+
+  // The last predecessor to finish kicks the successor. The counter of the
+  // current job is not released yet, so the graph cannot be done in between.
+  for (auto successor_id : node->successors) {
+    std::atomic_ref<usize> remaining_count{
+        graph->remaining_predecessor_counts_[successor_id]};
+
+    if (remaining_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      graph->KickNode(successor_id);
+    }
+  }
+}
+
+void JobGraph::KickNode(JobGraphNodeId node_id) {
+  auto& node{nodes_[node_id]};
+  auto job_descr{node.job_descr};
+  job_descr.entry_point = OnNode;
+  job_descr.params_handle = &node;
+  job_descr.counter = counter_;
+  Scheduler::Get().Kick(job_descr);
+}
+}  // namespace job
+}  // namespace comet
@@ -0,0 +1,73 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+#ifndef COMET_COMET_CORE_CONCURRENCY_JOB_JOB_GRAPH_H_
+#define COMET_COMET_CORE_CONCURRENCY_JOB_JOB_GRAPH_H_
+
+#include "comet/core/concurrency/job/job.h"
+#include "comet/core/essentials.h"
+#include "comet/core/memory/allocator/allocator.h"
+#include "comet/core/type/array.h"
+
+namespace comet {
+namespace job {
+using JobGraphNodeId = usize;
+constexpr auto kInvalidJobGraphNodeId{static_cast<JobGraphNodeId>(-1)};
+
+class JobGraph;
+
+namespace internal {
+struct JobGraphNode {
+  JobGraph* graph{nullptr};
+  JobGraphNodeId id{kInvalidJobGraphNodeId};
+  JobDescr job_descr{};
+  Array<JobGraphNodeId> successors{};
+  usize predecessor_count{0};
+};
+}  // namespace internal
+
+// Jobs with dependencies, built once and kicked as many times as needed (e.g.,
+// every frame). A node is only kicked once all its predecessors are done, by
+// the last one to finish: no fiber is blocked while the graph runs, except the
+// one waiting for the whole graph.
+class JobGraph {
+ public:
+  JobGraph() = default;
+  explicit JobGraph(memory::Allocator* allocator);
+  JobGraph(const JobGraph&) = delete;
+  JobGraph(JobGraph&&) = delete;
+  JobGraph& operator=(const JobGraph&) = delete;
+  JobGraph& operator=(JobGraph&&) = delete;
+  ~JobGraph();
+
+  // The counter of the job is ignored: the one of the graph is used instead.
+  JobGraphNodeId AddNode(const JobDescr& job_descr);
+  // Predecessors must be added before their successors, which keeps the graph
+  // acyclic.
+  void AddDependency(JobGraphNodeId predecessor_id,
+                     JobGraphNodeId successor_id);
+  // Nodes must not be added while the graph is running.
+  void Kick();
+  void Wait();
+  void KickAndWait();
+  void Clear();
+  void Destroy();
+
+  bool IsRunning() const;
+  usize GetNodeCount() const noexcept;
+
+ private:
+  static void OnNode(JobParamsHandle params_handle);
+  void KickNode(JobGraphNodeId node_id);
+
+  memory::Allocator* allocator_{nullptr};
+  Array<internal::JobGraphNode> nodes_{};
+  // Reset on every kick.
+  Array<usize> remaining_predecessor_counts_{};
+  Counter* counter_{nullptr};
+};
+}  // namespace job
+}  // namespace comet
+
+#endif  // COMET_COMET_CORE_CONCURRENCY_JOB_JOB_GRAPH_H_
@@ -0,0 +1,35 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Header. /////////////////////////////////////////////////////////////////////
+#include "parallel.h"
+////////////////////////////////////////////////////////////////////////////////
+
+namespace comet {
+namespace job {
+namespace internal {
+usize ResolveGrainSize(usize count, usize grain_size) {
+  if (grain_size != 0) {
+    return grain_size;
+  }
+
+  // A few chunks per worker give thieves something to steal when the cost of
+  // each index is uneven, without drowning the scheduler in tiny jobs.
+  constexpr usize kChunkCountPerWorker{4};
+  auto worker_count{Scheduler::Get().GetFiberWorkerCount()};
+
+  if (worker_count == 0) {
+    worker_count = 1;
+  }
+
+  grain_size = count / (worker_count * kChunkCountPerWorker);
+  return grain_size > 0 ? grain_size : 1;
+}
+}  // namespace internal
+}  // namespace job
+}  // namespace comet
@@ -0,0 +1,184 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+#ifndef COMET_COMET_CORE_CONCURRENCY_JOB_PARALLEL_H_
+#define COMET_COMET_CORE_CONCURRENCY_JOB_PARALLEL_H_
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <type_traits>
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/concurrency/job/job.h"
+#include "comet/core/concurrency/job/job_utils.h"
+#include "comet/core/concurrency/job/scheduler.h"
+#include "comet/core/essentials.h"
+#include "comet/core/frame/frame_allocator.h"
+#include "comet/core/frame/frame_utils.h"
+
+namespace comet {
+namespace job {
+struct IndexRange {
+  usize begin{0};
+  usize end{0};
+};
+
+namespace internal {
+// Returns the number of indices processed by a single chunk. If grain_size is
+// 0, it is chosen so that every fiber worker gets a few chunks to balance the
+// load.
+usize ResolveGrainSize(usize count, usize grain_size);
+
+template <typename ChunkFunc>
+struct ParallelContext {
+  ChunkFunc* chunk_func{nullptr};
+  IndexRange range{};
+  usize grain_size{0};
+  JobPriority priority{JobPriority::Unknown};
+  JobStackSize stack_size{JobStackSize::Unknown};
+  Counter* counter{nullptr};
+};
+
+template <typename ChunkFunc>
+struct ParallelJobParams {
+  const ParallelContext<ChunkFunc>* context{nullptr};
+  usize chunk_begin{0};
+  usize chunk_end{0};
+};
+
+template <typename ChunkFunc>
+void OnParallelJob(JobParamsHandle params_handle) {
+  const auto* params{
+      static_cast<const ParallelJobParams<ChunkFunc>*>(params_handle)};
+  const auto* context{params->context};
+  auto chunk_begin{params->chunk_begin};
+  auto chunk_end{params->chunk_end};
+  auto& scheduler{Scheduler::Get()};
+
+  // Split recursively: the right half is kicked, so that idle workers can
+  // steal big ranges first, and the left half is processed by this job.
+  while (chunk_end - chunk_begin > 1) {
+    auto chunk_middle{chunk_begin + (chunk_end - chunk_begin) / 2};
+
+    auto* right_params{COMET_FRAME_ALLOC_ONE_AND_POPULATE(
+        ParallelJobParams<ChunkFunc>, context, chunk_middle, chunk_end)};
+
+    scheduler.Kick(GenerateJobDescr(
+        context->priority, OnParallelJob<ChunkFunc>, right_params,
+        context->stack_size, context->counter, "parallel_chunk"));
+
+    chunk_end = chunk_middle;
+  }
+
+  auto begin{context->range.begin + chunk_begin * context->grain_size};
+  auto end{begin + context->grain_size};
+
+  if (end > context->range.end) {
+    end = context->range.end;
+  }
+
+  (*context->chunk_func)(chunk_begin, begin, end);
+}
+
+// Calls chunk_func(chunk_index, begin, end) for every chunk of the range, and
+// waits until all of them are processed.
+template <typename ChunkFunc>
+void ParallelChunks(IndexRange range, usize grain_size, usize chunk_count,
+                    ChunkFunc& chunk_func, JobPriority priority,
+                    JobStackSize stack_size) {
+  if (chunk_count == 1) {
+    chunk_func(0, range.begin, range.end);
+    return;
+  }
+
+  CounterGuard guard{};
+  ParallelContext<ChunkFunc> context{};
+  context.chunk_func = &chunk_func;
+  context.range = range;
+  context.grain_size = grain_size;
+  context.priority = priority;
+  context.stack_size = stack_size;
+  context.counter = guard.GetCounter();
+  ParallelJobParams<ChunkFunc> params{&context, 0, chunk_count};
+
+  Scheduler::Get().Kick(GenerateJobDescr(priority, OnParallelJob<ChunkFunc>,
+                                         &params, stack_size,
+                                         guard.GetCounter(), "parallel_root"));
+  guard.Wait();
+}
+}  // namespace internal
+
+// Calls func(index) for each index of the range, from several workers. The
+// range is split into chunks of grain_size indices (0 picks a size
+// automatically), which are subdivided recursively so that idle workers can
+// steal them. The function returns once every index has been processed.
+// Jobs have a normal priority by default: they go to the local queue of the
+// worker which kicks them, which keeps them hot in cache.
+template <typename Func>
+void ParallelFor(IndexRange range, usize grain_size, Func&& func,
+                 JobPriority priority = JobPriority::Normal,
+                 JobStackSize stack_size = JobStackSize::Normal) {
+  if (range.end <= range.begin) {
+    return;
+  }
+
+  auto count{range.end - range.begin};
+  grain_size = internal::ResolveGrainSize(count, grain_size);
+  auto chunk_count{(count + grain_size - 1) / grain_size};
+
+  auto chunk_func{[&func](usize, usize begin, usize end) {
+    for (auto i{begin}; i < end; ++i) {
+      func(i);
+    }
+  }};
+
+  internal::ParallelChunks(range, grain_size, chunk_count, chunk_func, priority,
+                           stack_size);
+}
+
+// Computes reduce_func(...reduce_func(identity, map_func(begin))...,
+// map_func(end - 1)) from several workers, with the same chunking policy as
+// ParallelFor(). Partial results are combined in chunk order, so the result
+// is deterministic as long as the grain size is. T must be default
+// constructible.
+template <typename T, typename MapFunc, typename ReduceFunc>
+T ParallelReduce(IndexRange range, usize grain_size, const T& identity,
+                 MapFunc&& map_func, ReduceFunc&& reduce_func,
+                 JobPriority priority = JobPriority::Normal,
+                 JobStackSize stack_size = JobStackSize::Normal) {
+  if (range.end <= range.begin) {
+    return identity;
+  }
+
+  auto count{range.end - range.begin};
+  grain_size = internal::ResolveGrainSize(count, grain_size);
+  auto chunk_count{(count + grain_size - 1) / grain_size};
+
+  frame::FrameArray<T> partial_results{};
+  partial_results.Resize(chunk_count);
+
+  auto chunk_func{[&](usize chunk_index, usize begin, usize end) {
+    T result{identity};
+
+    for (auto i{begin}; i < end; ++i) {
+      result = reduce_func(result, map_func(i));
+    }
+
+    partial_results[chunk_index] = result;
+  }};
+
+  internal::ParallelChunks(range, grain_size, chunk_count, chunk_func, priority,
+                           stack_size);
+
+  T result{identity};
+
+  for (const auto& partial_result : partial_results) {
+    result = reduce_func(result, partial_result);
+  }
+
+  return result;
+}
+}  // namespace job
+}  // namespace comet
+
+#endif  // COMET_COMET_CORE_CONCURRENCY_JOB_PARALLEL_H_
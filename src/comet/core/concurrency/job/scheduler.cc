@@ -117,8 +117,46 @@ Counter* CounterPool::TryGet() {
 }
 
 void CounterPool::Push(Counter* counter) { counters_.Push(counter); }
+
+void JobContinuationPool::Initialize() {
+  continuations_ = LockFreeMPMCRingQueue<JobContinuation*>{
+      &queue_allocator_,
+      static_cast<usize>(COMET_CONF_U16(conf::kCoreJobContinuationCount))};
+
+  auto capacity{continuations_.GetCapacity()};
+  continuation_allocator_ = memory::PlatformStackAllocator{
+      sizeof(JobContinuation) * capacity + alignof(JobContinuation),
+      memory::kEngineMemoryTagFiber};
+  continuation_allocator_.Initialize();
+
+  for (usize i{0}; i < capacity; ++i) {
+    auto* continuation{
+        continuation_allocator_.AllocateOneAndPopulate<JobContinuation>()};
+    new (continuation) JobContinuation{};
+    continuations_.Push(continuation);
+  }
+}
+
+void JobContinuationPool::Destroy() {
+  continuations_.Destroy();
+  continuation_allocator_.Destroy();
+}
+
+JobContinuation* JobContinuationPool::TryGet() {
+  auto continuation_box{continuations_.TryPop()};
+  return continuation_box.value_or(nullptr);
+}
+
+void JobContinuationPool::Push(JobContinuation* continuation) {
+  continuations_.Push(continuation);
+}
 }  // namespace internal
 
+#ifdef COMET_ALLOW_DISABLED_MAIN_THREAD_WORKER
+static LockFreeMPMCRingQueue<MainThreadJobDescr> main_thread_queue{};
+static WorkerParker main_thread_parker{};
+#endif  // COMET_ALLOW_DISABLED_MAIN_THREAD_WORKER
+
 Scheduler& Scheduler::Get() {
   static Scheduler singleton{};
   return singleton;
@@ -137,6 +175,15 @@ void Scheduler::Initialize() {
   io_queue_ = LockFreeMPMCRingQueue<IOJobDescr>{
       &job_queue_allocator_,
       static_cast<usize>(COMET_CONF_U16(conf::kCoreJobQueueCount))};
+  // A fiber is never ready more than once at a time.
+  ready_fibers_ = LockFreeMPMCRingQueue<fiber::Fiber*>{
+      &job_queue_allocator_,
+      static_cast<usize>(COMET_CONF_U16(conf::kCoreLargeFiberCount)) +
+          COMET_CONF_U16(conf::kCoreGiganticFiberCount)
+#ifdef COMET_FIBER_EXTERNAL_LIBRARY_SUPPORT
+          + COMET_CONF_U16(conf::kCoreExternalLibraryFiberCount)
+#endif  // COMET_FIBER_EXTERNAL_LIBRARY_SUPPORT
+  };
 
   fiber::AllocateFiberStackMemory(
       large_stack_fibers_.GetTotalAllocatedStackSize() +
@@ -153,7 +200,10 @@ void Scheduler::Initialize() {
 #endif  // COMET_FIBER_EXTERNAL_LIBRARY_SUPPORT
 
   counters_.Initialize();
+  continuations_.Initialize();
   is_shutdown_required_.store(false, std::memory_order_release);
+  idle_spin_count_ =
+      static_cast<usize>(COMET_CONF_U16(conf::kCoreJobIdleSpinCount));
 
   auto concurrent_thread_count{thread::GetConcurrentThreadCountLeft()};
   fiber_worker_count_ = COMET_CONF_U8(conf::kCoreForcedFiberWorkerCount);
@@ -180,6 +230,12 @@ void Scheduler::Initialize() {
                       ", I/O worker count: ", io_worker_count_, ".");
   fiber_workers_ = Array<FiberWorker>{&worker_allocator};
   fiber_workers_.Resize(fiber_worker_count_);
+  const auto local_queue_capacity{
+      static_cast<usize>(COMET_CONF_U16(conf::kCoreJobLocalQueueCount))};
+
+  for (auto& fiber_worker : fiber_workers_) {
+    fiber_worker.InitializeQueue(&job_queue_allocator_, local_queue_capacity);
+  }
   io_workers_ = Array<IOWorker>{&worker_allocator};
   io_workers_.Resize(io_worker_count_);
 }
@@ -189,6 +245,7 @@ void Scheduler::Shutdown() {
   normal_priority_queue_.Destroy();
   high_priority_queue_.Destroy();
   io_queue_.Destroy();
+  ready_fibers_.Destroy();
 
   for (auto& fiber_worker : fiber_workers_) {
     fiber_worker.Stop();
@@ -198,6 +255,10 @@ void Scheduler::Shutdown() {
     io_worker.Stop();
   }
 
+  for (auto& fiber_worker : fiber_workers_) {
+    fiber_worker.DestroyQueue();
+  }
+
   large_stack_fibers_.Destroy();
   gigantic_stack_fibers_.Destroy();
 #ifdef COMET_FIBER_EXTERNAL_LIBRARY_SUPPORT
@@ -205,6 +266,7 @@ void Scheduler::Shutdown() {
 #endif  // COMET_FIBER_EXTERNAL_LIBRARY_SUPPORT
 
   counters_.Destroy();
+  continuations_.Destroy();
   fiber::DestroyFiberStackMemory();
 }
 
@@ -260,6 +322,11 @@ void Scheduler::Run(const JobDescr& callback_descr,
 
 void Scheduler::RequestShutdown() {
   is_shutdown_required_.store(true, std::memory_order_release);
+  fiber_worker_parker_.NotifyAll();
+  io_worker_parker_.NotifyAll();
+#ifdef COMET_ALLOW_DISABLED_MAIN_THREAD_WORKER
+  main_thread_parker.NotifyAll();
+#endif  // COMET_ALLOW_DISABLED_MAIN_THREAD_WORKER
 }
 
 Counter* Scheduler::GenerateCounter() {
@@ -299,6 +366,76 @@ void Scheduler::Wait(Counter* counter) {
   CounterWaiter waiter{*counter};
 }
 
+void Scheduler::Suspend(Counter& counter, CounterWaitNode& node) {
+  COMET_ASSERT(fiber::IsFiber() && !fiber::IsThreadFiber(),
+               "Only fibers running a job can be suspended!");
+  COMET_ASSERT(node.fiber == fiber::GetFiber(),
+               "Wait node does not belong to the current fiber!");
+  COMET_ASSERT(tls_pending_wait_.counter == nullptr,
+               "A wait is already pending on this worker!");
+  tls_pending_wait_.counter = &counter;
+  tls_pending_wait_.node = &node;
+  fiber::internal::ResumeWorker();
+  // From this point onward, the fiber may run on another worker.
+}
+
+void Scheduler::Resume(fiber::Fiber* fiber) {
+  COMET_ASSERT(fiber != nullptr, "Fiber to resume is null!");
+  ready_fibers_.Push(fiber);
+  fiber_worker_parker_.NotifyOne();
+}
+
+void Scheduler::KickAfter(const JobDescr& job_descr, Counter* predecessor) {
+  KickAfter(job_descr, 1, &predecessor);
+}
+
+void Scheduler::KickAfter(const JobDescr& job_descr, usize predecessor_count,
+                          Counter* const* predecessors) {
+  if (job_descr.counter != nullptr) {
+    job_descr.counter->Increment();
+  }
+
+  auto* continuation{continuations_.TryGet()};
+  COMET_ASSERT(continuation != nullptr,
+               "No job continuation is available anymore!");
+  continuation->job_descr = job_descr;
+  continuation->is_io_job = false;
+  KickAfter(continuation, predecessor_count, predecessors);
+}
+
+void Scheduler::KickAfter(const IOJobDescr& job_descr, Counter* predecessor) {
+  KickAfter(job_descr, 1, &predecessor);
+}
+
+void Scheduler::KickAfter(const IOJobDescr& job_descr, usize predecessor_count,
+                          Counter* const* predecessors) {
+  if (job_descr.counter != nullptr) {
+    job_descr.counter->Increment();
+  }
+
+  auto* continuation{continuations_.TryGet()};
+  COMET_ASSERT(continuation != nullptr,
+               "No job continuation is available anymore!");
+  continuation->io_job_descr = job_descr;
+  continuation->is_io_job = true;
+  KickAfter(continuation, predecessor_count, predecessors);
+}
+
+void Scheduler::ResolvePredecessor(JobContinuation* continuation) {
+  if (continuation->pending_count.fetch_sub(1, std::memory_order_acq_rel) !=
+      1) {
+    return;
+  }
+
+  if (continuation->is_io_job) {
+    EnqueueJob(continuation->io_job_descr);
+  } else {
+    EnqueueJob(continuation->job_descr);
+  }
+
+  continuations_.Push(continuation);
+}
+
 void Scheduler::KickAndWait(const JobDescr& job_descr) {
   Kick(job_descr);
   Wait(job_descr.counter);
@@ -325,14 +462,11 @@ void Scheduler::KickAndWait(usize job_count, const IOJobDescr* job_descrs) {
   }
 }
 
-#ifdef COMET_ALLOW_DISABLED_MAIN_THREAD_WORKER
-static LockFreeMPMCRingQueue<MainThreadJobDescr> main_thread_queue{};
-#endif  // COMET_ALLOW_DISABLED_MAIN_THREAD_WORKER
-
 void Scheduler::KickOnMainThread(const MainThreadJobDescr& descr) {
 #ifdef COMET_ALLOW_DISABLED_MAIN_THREAD_WORKER
   descr.counter->Increment();
   main_thread_queue.Push(descr);
+  main_thread_parker.NotifyOne();
 #endif  // COMET_ALLOW_DISABLED_MAIN_THREAD_WORKER
 }
 
@@ -342,6 +476,24 @@ usize Scheduler::GetFiberWorkerCount() const noexcept {
 
 usize Scheduler::GetIOWorkerCount() const noexcept { return io_worker_count_; }
 
+FiberWorkerStats Scheduler::GetFiberWorkerStats() const {
+  FiberWorkerStats total_stats{};
+
+  for (const auto& fiber_worker : fiber_workers_) {
+    auto stats{fiber_worker.GetStats()};
+    total_stats.local_job_count += stats.local_job_count;
+    total_stats.global_job_count += stats.global_job_count;
+    total_stats.stolen_job_count += stats.stolen_job_count;
+    total_stats.steal_attempt_count += stats.steal_attempt_count;
+  }
+
+  return total_stats;
+}
+
+WorkerParkerStats Scheduler::GetFiberWorkerParkerStats() const {
+  return fiber_worker_parker_.GetStats();
+}
+
 void Scheduler::Work(Worker* worker, WorkFunc work_func) {
   COMET_ASSERT(worker != nullptr, "Worker provided is null!");
   COMET_ASSERT(work_func != nullptr, "Work function provided is null!");
@@ -353,6 +505,9 @@ void Scheduler::Work(Worker* worker, WorkFunc work_func) {
 void Scheduler::WorkOnFibers() {
   time::Chrono chrono{};
   chrono.Start(promotion_interval_);
+  auto& worker{fiber_workers_[GetWorkerTypeIndex()]};
+  auto& life_cycle_handler{fiber::FiberLifeCycleHandler::Get()};
+  usize spin_count{0};
 
   while (!is_shutdown_required_.load(std::memory_order_relaxed)) {
     if (chrono.IsFinished()) {
@@ -360,20 +515,52 @@ void Scheduler::WorkOnFibers() {
       chrono.Restart();
     }
 
-    std::optional<JobDescr> job_box{high_priority_queue_.TryPop()};
+    auto job_box{TryGetNextJob(worker)};
 
     if (!job_box.has_value()) {
-      job_box = normal_priority_queue_.TryPop();
-    }
+      CleanCompletedAndTryResumeNext();
 
-    if (!job_box.has_value()) {
-      job_box = low_priority_queue_.TryPop();
+      if (spin_count < idle_spin_count_) {
+        ++spin_count;
+        thread::Pause();
+        continue;
+      }
+
+      // Fibers which yielded (fiber primitives, etc.) are polled by this worker
+      // only: it cannot park until they are all resumed. Fibers waiting for a
+      // counter do not prevent it.
+      if (life_cycle_handler.HasSleepingFibers()) {
+        thread::Yield();
+        continue;
+      }
+
+      auto ticket{fiber_worker_parker_.PrepareToPark()};
+      job_box = TryGetNextJob(worker);
+
+      if (!job_box.has_value()) {
+        if (is_shutdown_required_.load(std::memory_order_acquire)) {
+          fiber_worker_parker_.CancelPark();
+          break;
+        }
+
+        auto* ready_fiber{ready_fibers_.TryPop().value_or(nullptr)};
+
+        if (ready_fiber != nullptr) {
+          fiber_worker_parker_.CancelPark();
+          RunFiber(ready_fiber);
+          spin_count = 0;
+          continue;
+        }
+
+        fiber_worker_parker_.Park(ticket);
+        spin_count = 0;
+        continue;
+      }
+
+      fiber_worker_parker_.CancelPark();
     }
 
-    if (!job_box.has_value()) {
-      CleanCompletedAndTryResumeNext();
-      continue;
-    }
+    spin_count = 0;
 
     auto& job_descr{job_box.value()};
     auto* fibers{ResolveFiberPool(job_descr)};
@@ -393,19 +580,43 @@ void Scheduler::WorkOnFibers() {
 #endif  // COMET_FIBER_DEBUG_LABEL
     );
 
-    fiber::internal::RunOrResume(fiber);
+    RunFiber(fiber);
     CleanCompletedAndTryResumeNext();
   }
 }
 
 void Scheduler::WorkOnIO() {
+  usize spin_count{0};
+
   while (!is_shutdown_required_.load(std::memory_order_relaxed)) {
     auto job_box{io_queue_.TryPop()};
 
     if (!job_box.has_value()) {
-      continue;
+      if (spin_count < idle_spin_count_) {
+        ++spin_count;
+        thread::Pause();
+        continue;
+      }
+
+      auto ticket{io_worker_parker_.PrepareToPark()};
+      job_box = io_queue_.TryPop();
+
+      if (!job_box.has_value()) {
+        if (is_shutdown_required_.load(std::memory_order_acquire)) {
+          io_worker_parker_.CancelPark();
+          break;
+        }
+
+        io_worker_parker_.Park(ticket);
+        spin_count = 0;
+        continue;
+      }
+
+      io_worker_parker_.CancelPark();
     }
 
+    spin_count = 0;
+
     auto& job{job_box.value()};
     job.entry_point(job.params_handle);
 
@@ -415,6 +626,80 @@ void Scheduler::WorkOnIO() {
   }
 }
 
+std::optional<JobDescr> Scheduler::TryGetNextJob(FiberWorker& worker) {
+  std::optional<JobDescr> job_box{high_priority_queue_.TryPop()};
+
+  if (job_box.has_value()) {
+    worker.RecordGlobalJob();
+    return job_box;
+  }
+
+  // Local jobs are popped in LIFO order: they are the most likely to be hot in
+  // cache.
+  job_box = worker.TryPopJob();
+
+  if (job_box.has_value()) {
+    return job_box;
+  }
+
+  job_box = normal_priority_queue_.TryPop();
+
+  if (!job_box.has_value()) {
+    job_box = low_priority_queue_.TryPop();
+  }
+
+  if (job_box.has_value()) {
+    worker.RecordGlobalJob();
+    return job_box;
+  }
+
+  return TryStealJob(worker);
+}
+
+std::optional<JobDescr> Scheduler::TryStealJob(FiberWorker& thief) {
+  const auto worker_count{fiber_workers_.GetSize()};
+
+  if (worker_count < 2) {
+    return std::nullopt;
+  }
+
+  // Start from a pseudo-random victim to spread contention between thieves.
+  static thread_local u32 tls_steal_seed{0};
+
+  if (tls_steal_seed == 0) {
+    tls_steal_seed = static_cast<u32>(GetWorkerTypeIndex()) * 2654435761u + 1;
+  }
+
+  tls_steal_seed ^= tls_steal_seed << 13;
+  tls_steal_seed ^= tls_steal_seed >> 17;
+  tls_steal_seed ^= tls_steal_seed << 5;
+  const auto start_index{static_cast<usize>(tls_steal_seed) % worker_count};
+
+  for (usize i{0}; i < worker_count; ++i) {
+    auto& victim{fiber_workers_[(start_index + i) % worker_count]};
+
+    if (&victim == &thief) {
+      continue;
+    }
+
+    auto job_box{thief.TryStealJob(victim)};
+
+    if (job_box.has_value()) {
+      return job_box;
+    }
+  }
+
+  return std::nullopt;
+}
+
+FiberWorker* Scheduler::TryGetCurrentFiberWorker() {
+  if (GetWorkerTag() != FiberWorker::kTag_ || !fiber::IsFiber()) {
+    return nullptr;
+  }
+
+  return &fiber_workers_[GetWorkerTypeIndex()];
+}
+
 internal::FiberPool* Scheduler::ResolveFiberPool(const JobDescr& job_descr) {
   internal::FiberPool* fibers{nullptr};
 
@@ -441,6 +726,27 @@ internal::FiberPool* Scheduler::ResolveFiberPool(const JobDescr& job_descr) {
   return fibers;
 }
 
+void Scheduler::RunFiber(fiber::Fiber* fiber) {
+  fiber::internal::RunOrResume(fiber);
+  CommitPendingWait();
+}
+
+void Scheduler::CommitPendingWait() {
+  auto pending_wait{tls_pending_wait_};
+
+  if (pending_wait.counter == nullptr) {
+    return;
+  }
+
+  tls_pending_wait_ = {};
+
+  // Once added, the node may be resumed and destroyed at any time.
+  if (!pending_wait.counter->TryAddWaiter(pending_wait.node)) {
+    // Case: the counter was reached while the fiber was switching back.
+    Resume(pending_wait.node->fiber);
+  }
+}
+
 void Scheduler::CleanCompletedAndTryResumeNext() {
   fiber::Fiber* completed_fiber;
   auto& life_cycle_handler{fiber::FiberLifeCycleHandler::Get()};
@@ -471,10 +777,16 @@ void Scheduler::CleanCompletedAndTryResumeNext() {
     fibers->Push(completed_fiber);
   }
 
-  auto* sleeping_fiber{life_cycle_handler.TryWakingUp()};
+  // Fibers whose counter was reached come first: unlike sleeping fibers, they
+  // are known to have work to do.
+  auto* next_fiber{ready_fibers_.TryPop().value_or(nullptr)};
 
-  if (sleeping_fiber != nullptr) {
-    fiber::internal::RunOrResume(sleeping_fiber);
+  if (next_fiber == nullptr) {
+    next_fiber = life_cycle_handler.TryWakingUp();
+  }
+
+  if (next_fiber != nullptr) {
+    RunFiber(next_fiber);
   }
 }
 
@@ -496,6 +808,28 @@ void Scheduler::SubmitJob(const JobDescr& job_descr) {
     job_descr.counter->Increment();
   }
 
+  EnqueueJob(job_descr);
+}
+
+void Scheduler::EnqueueJob(const JobDescr& job_descr) {
+  // High-priority jobs stay global so that any idle worker can pick them up
+  // right away. Low-priority jobs stay global too: local jobs are popped
+  // before the global normal-priority ones, which would run them first.
+  if (job_descr.priority == JobPriority::Normal) {
+    auto* worker{TryGetCurrentFiberWorker()};
+
+    if (worker != nullptr && worker->TryPushJob(job_descr)) {
+      // Wake up an idle worker so that it can steal from the local queue.
+      fiber_worker_parker_.NotifyOne();
+      return;
+    }
+  }
+
+  SubmitGlobalJob(job_descr);
+  fiber_worker_parker_.NotifyOne();
+}
+
+void Scheduler::SubmitGlobalJob(const JobDescr& job_descr) {
   switch (job_descr.priority) {
     case JobPriority::High:
       high_priority_queue_.Push(job_descr);
@@ -520,7 +854,39 @@ void Scheduler::SubmitJob(const IOJobDescr& job_descr) {
     job_descr.counter->Increment();
   }
 
+  EnqueueJob(job_descr);
+}
+
+void Scheduler::EnqueueJob(const IOJobDescr& job_descr) {
   io_queue_.Push(job_descr);
+  io_worker_parker_.NotifyOne();
+}
+
+void Scheduler::KickAfter(JobContinuation* continuation,
+                          usize predecessor_count,
+                          Counter* const* predecessors) {
+  COMET_ASSERT(predecessor_count <= kMaxJobPredecessorCount,
+               "Too many predecessors: ", predecessor_count, " > ",
+               kMaxJobPredecessorCount, "!");
+  // The extra count keeps the job from being kicked while its predecessors are
+  // registered.
+  continuation->pending_count.store(predecessor_count + 1,
+                                    std::memory_order_relaxed);
+
+  for (usize i{0}; i < predecessor_count; ++i) {
+    auto* predecessor{predecessors[i]};
+    auto& node{continuation->wait_nodes[i]};
+    node.fiber = nullptr;
+    node.continuation = continuation;
+    node.target = 0;
+    node.next = nullptr;
+
+    if (predecessor == nullptr || !predecessor->TryAddWaiter(&node)) {
+      ResolvePredecessor(continuation);
+    }
+  }
+
+  ResolvePredecessor(continuation);
 }
 
 void Scheduler::PromoteJobs() {
@@ -548,13 +914,37 @@ void Scheduler::WorkFromMainThread() {
   main_thread_queue = LockFreeMPMCRingQueue<MainThreadJobDescr>{
       &allocator, kMaxMainThreadJobCount};
 
+  usize spin_count{0};
+
   while (!is_shutdown_required_.load(std::memory_order_relaxed)) {
     auto job_box{main_thread_queue.TryPop()};
 
     if (!job_box.has_value()) {
-      continue;
+      if (spin_count < idle_spin_count_) {
+        ++spin_count;
+        thread::Pause();
+        continue;
+      }
+
+      auto ticket{main_thread_parker.PrepareToPark()};
+      job_box = main_thread_queue.TryPop();
+
+      if (!job_box.has_value()) {
+        if (is_shutdown_required_.load(std::memory_order_acquire)) {
+          main_thread_parker.CancelPark();
+          break;
+        }
+
+        main_thread_parker.Park(ticket);
+        spin_count = 0;
+        continue;
+      }
+
+      main_thread_parker.CancelPark();
     }
 
+    spin_count = 0;
+
     auto& job{job_box.value()};
     job.entry_point(job.params_handle);
 
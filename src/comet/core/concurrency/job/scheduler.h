@@ -7,11 +7,13 @@
 
 // External. ///////////////////////////////////////////////////////////////////
 #include <atomic>
+#include <optional>
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "comet/core/concurrency/fiber/fiber.h"
 #include "comet/core/concurrency/job/job.h"
 #include "comet/core/concurrency/job/worker.h"
+#include "comet/core/concurrency/job/worker_parker.h"
 #include "comet/core/conf/configuration_manager.h"
 #include "comet/core/conf/configuration_value.h"
 #include "comet/core/essentials.h"
@@ -68,6 +70,35 @@ class CounterPool {
   memory::PlatformStackAllocator counter_allocator_{};
   LockFreeMPMCRingQueue<Counter*> counters_{};
 };
+
+class JobContinuationPool {
+ public:
+  JobContinuationPool() = default;
+  JobContinuationPool(const JobContinuationPool&) = delete;
+  JobContinuationPool(JobContinuationPool&&) = delete;
+  JobContinuationPool& operator=(const JobContinuationPool&) = delete;
+  JobContinuationPool& operator=(JobContinuationPool&&) = delete;
+  ~JobContinuationPool() = default;
+
+  void Initialize();
+  void Destroy();
+
+  JobContinuation* TryGet();
+  void Push(JobContinuation* continuation);
+
+ private:
+  memory::PlatformAllocator queue_allocator_{memory::kEngineMemoryTagFiber};
+  memory::PlatformStackAllocator continuation_allocator_{};
+  LockFreeMPMCRingQueue<JobContinuation*> continuations_{};
+};
+
+// Wait which the current fiber requested before switching back to its worker.
+// It is only registered once the context of the fiber is saved, so that no
+// other worker can resume it too early.
+struct PendingCounterWait {
+  Counter* counter{nullptr};
+  CounterWaitNode* node{nullptr};
+};
 }  // namespace internal
 
 class Scheduler {
@@ -95,6 +126,24 @@ class Scheduler {
   void Kick(usize job_count, const IOJobDescr* job_descrs);
 
   void Wait(Counter* counter);
+  // Suspends the current fiber until the counter goes down to the target of
+  // the node. The fiber is not polled in the meantime.
+  void Suspend(Counter& counter, CounterWaitNode& node);
+  // Makes a suspended fiber runnable again, on any fiber worker.
+  void Resume(fiber::Fiber* fiber);
+
+  // Kicks the job once every predecessor counter reaches zero, without
+  // blocking the calling fiber. The counter of the job is incremented right
+  // away: it can be waited for, or be the predecessor of another job. Jobs
+  // with more predecessors can share the counter of several ones.
+  void KickAfter(const JobDescr& job_descr, Counter* predecessor);
+  void KickAfter(const JobDescr& job_descr, usize predecessor_count,
+                 Counter* const* predecessors);
+  void KickAfter(const IOJobDescr& job_descr, Counter* predecessor);
+  void KickAfter(const IOJobDescr& job_descr, usize predecessor_count,
+                 Counter* const* predecessors);
+  // Called when one of the predecessors of the continuation reaches zero.
+  void ResolvePredecessor(JobContinuation* continuation);
 
   void KickAndWait(const JobDescr& job_descr);
   void KickAndWait(usize job_count, const JobDescr* job_descrs);
@@ -105,6 +154,8 @@ class Scheduler {
 
   usize GetFiberWorkerCount() const noexcept;
   usize GetIOWorkerCount() const noexcept;
+  FiberWorkerStats GetFiberWorkerStats() const;
+  WorkerParkerStats GetFiberWorkerParkerStats() const;
 
  private:
   static constexpr usize kDefaultIOWorkerCount{2};
@@ -112,6 +163,8 @@ class Scheduler {
   usize fiber_worker_count_{0};
   usize io_worker_count_{0};
   u32 promotion_interval_{1000};
+  // Number of unfruitful attempts before an idle worker parks.
+  usize idle_spin_count_{0};
 
   internal::FiberPool large_stack_fibers_{
       COMET_CONF_U16(conf::kCoreLargeFiberCount), fiber::kLargeStackSize};
@@ -124,6 +177,9 @@ class Scheduler {
 #endif  // COMET_FIBER_EXTERNAL_LIBRARY_SUPPORT
 
   internal::CounterPool counters_{};
+  internal::JobContinuationPool continuations_{};
+
+  static inline thread_local internal::PendingCounterWait tls_pending_wait_{};
 
   memory::PlatformAllocator worker_allocator{memory::kEngineMemoryTagFiber};
   Array<FiberWorker> fiber_workers_{};
@@ -137,21 +193,40 @@ class Scheduler {
   memory::PlatformAllocator job_queue_allocator_{memory::kEngineMemoryTagFiber};
   // Platform allocator is used because queues only allocated once, during
   // engine startup.
+  // Global queues only receive jobs kicked from outside a fiber worker (main
+  // thread, I/O workers, etc.), high and low-priority jobs, and jobs
+  // overflowing a worker's local queue.
   LockFreeMPMCRingQueue<JobDescr> low_priority_queue_{};
   LockFreeMPMCRingQueue<JobDescr> normal_priority_queue_{};
   LockFreeMPMCRingQueue<JobDescr> high_priority_queue_{};
   LockFreeMPMCRingQueue<IOJobDescr> io_queue_{};
+  // Suspended fibers whose counter was reached. Any fiber worker can resume
+  // them.
+  LockFreeMPMCRingQueue<fiber::Fiber*> ready_fibers_{};
+
+  WorkerParker fiber_worker_parker_{};
+  WorkerParker io_worker_parker_{};
 
   using WorkFunc = void (Scheduler::*)();
 
   void Work(Worker* worker, WorkFunc work_func);
   void WorkOnFibers();
   void WorkOnIO();
+  std::optional<JobDescr> TryGetNextJob(FiberWorker& worker);
+  std::optional<JobDescr> TryStealJob(FiberWorker& thief);
+  FiberWorker* TryGetCurrentFiberWorker();
   internal::FiberPool* ResolveFiberPool(const JobDescr& job_descr);
+  void RunFiber(fiber::Fiber* fiber);
+  void CommitPendingWait();
   void CleanCompletedAndTryResumeNext();
   static void OnFiberEnd(fiber::Fiber* fiber, void* data);
   void SubmitJob(const JobDescr& job_descr);
   void SubmitJob(const IOJobDescr& job_descr);
+  void EnqueueJob(const JobDescr& job_descr);
+  void EnqueueJob(const IOJobDescr& job_descr);
+  void KickAfter(JobContinuation* continuation, usize predecessor_count,
+                 Counter* const* predecessors);
+  void SubmitGlobalJob(const JobDescr& job_descr);
   void PromoteJobs();
 
 #ifdef COMET_ALLOW_DISABLED_MAIN_THREAD_WORKER
@@ -77,7 +77,8 @@ FiberWorker::FiberWorker()
 FiberWorker::FiberWorker(FiberWorker&& other) noexcept
     : Worker{std::move(other)},
       worker_fiber_{other.worker_fiber_},
-      current_fiber_{other.current_fiber_} {
+      current_fiber_{other.current_fiber_},
+      queue_{std::move(other.queue_)} {
   other.worker_fiber_ = nullptr;
   other.current_fiber_ = nullptr;
 }
@@ -90,6 +91,7 @@ FiberWorker& FiberWorker::operator=(FiberWorker&& other) noexcept {
   Worker::operator=(std::move(other));
   worker_fiber_ = other.worker_fiber_;
   current_fiber_ = other.current_fiber_;
+  queue_ = std::move(other.queue_);
   other.worker_fiber_ = nullptr;
   other.current_fiber_ = nullptr;
   return *this;
@@ -110,6 +112,61 @@ void FiberWorker::Detach() {
   internal::DetachFiberWorker();
 }
 
+void FiberWorker::InitializeQueue(memory::Allocator* allocator,
+                                  usize capacity) {
+  queue_ = LockFreeWorkStealingDeque<JobDescr>{allocator, capacity};
+}
+
+void FiberWorker::DestroyQueue() { queue_.Destroy(); }
+
+bool FiberWorker::TryPushJob(const JobDescr& job_descr) {
+  return queue_.TryPush(job_descr);
+}
+
+std::optional<JobDescr> FiberWorker::TryPopJob() {
+  auto job_box{queue_.TryPop()};
+
+  if (job_box.has_value()) {
+    IncrementCounter(counters_.local_job_count);
+  }
+
+  return job_box;
+}
+
+std::optional<JobDescr> FiberWorker::TryStealJob(FiberWorker& victim) {
+  IncrementCounter(counters_.steal_attempt_count);
+  auto job_box{victim.queue_.TrySteal()};
+
+  if (job_box.has_value()) {
+    IncrementCounter(counters_.stolen_job_count);
+  }
+
+  return job_box;
+}
+
+void FiberWorker::RecordGlobalJob() {
+  IncrementCounter(counters_.global_job_count);
+}
+
+FiberWorkerStats FiberWorker::GetStats() const {
+  FiberWorkerStats stats{};
+  stats.local_job_count =
+      counters_.local_job_count.load(std::memory_order_relaxed);
+  stats.global_job_count =
+      counters_.global_job_count.load(std::memory_order_relaxed);
+  stats.stolen_job_count =
+      counters_.stolen_job_count.load(std::memory_order_relaxed);
+  stats.steal_attempt_count =
+      counters_.steal_attempt_count.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void FiberWorker::IncrementCounter(std::atomic<usize>& counter) {
+  // Single writer: no need for a read-modify-write operation.
+  counter.store(counter.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+}
+
 IOWorker::IOWorker()
     : Worker{kTag_, index_counter_.fetch_add(1, std::memory_order_acq_rel)} {}
 
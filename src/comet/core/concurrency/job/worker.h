@@ -7,11 +7,15 @@
 
 // External. ///////////////////////////////////////////////////////////////////
 #include <atomic>
+#include <optional>
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "comet/core/concurrency/fiber/fiber.h"
+#include "comet/core/concurrency/job/job.h"
 #include "comet/core/concurrency/thread/thread.h"
 #include "comet/core/essentials.h"
+#include "comet/core/memory/allocator/allocator.h"
+#include "comet/core/type/work_stealing_deque.h"
 
 namespace comet {
 namespace job {
@@ -24,6 +28,27 @@ constexpr auto kInvalidWorkerTypeIndex{static_cast<WorkerTypeIndex>(-1)};
 using WorkerTag = u32;
 constexpr auto kInvalidWorkerTag{static_cast<WorkerTag>(-1)};
 
+struct FiberWorkerStats {
+  usize local_job_count{0};
+  usize global_job_count{0};
+  usize stolen_job_count{0};
+  usize steal_attempt_count{0};
+};
+
+namespace internal {
+// Counters are only written by their owning worker, but may be read by any
+// thread. Aligned to avoid false sharing between neighboring workers.
+struct alignas(64) FiberWorkerCounters {
+  static_assert(std::atomic<usize>::is_always_lock_free,
+                "std::atomic<usize> needs to be always lock-free. Unsupported "
+                "architecture");
+  std::atomic<usize> local_job_count{0};
+  std::atomic<usize> global_job_count{0};
+  std::atomic<usize> stolen_job_count{0};
+  std::atomic<usize> steal_attempt_count{0};
+};
+}  // namespace internal
+
 class Worker {
  public:
   ~Worker() = default;
@@ -70,6 +95,17 @@ class FiberWorker : public Worker {
   void Attach() override;
   void Detach() override;
 
+  void InitializeQueue(memory::Allocator* allocator, usize capacity);
+  void DestroyQueue();
+
+  // Must only be called from the worker's own thread.
+  bool TryPushJob(const JobDescr& job_descr);
+  std::optional<JobDescr> TryPopJob();
+  std::optional<JobDescr> TryStealJob(FiberWorker& victim);
+  void RecordGlobalJob();
+
+  FiberWorkerStats GetStats() const;
+
  private:
   static_assert(
       std::atomic<WorkerTypeIndex>::is_always_lock_free,
@@ -78,8 +114,12 @@ class FiberWorker : public Worker {
 
   inline static std::atomic<WorkerTypeIndex> index_counter_{0};
 
+  static void IncrementCounter(std::atomic<usize>& counter);
+
   fiber::Fiber* worker_fiber_{nullptr};
   fiber::Fiber* current_fiber_{nullptr};
+  LockFreeWorkStealingDeque<JobDescr> queue_{};
+  internal::FiberWorkerCounters counters_{};
 };
 
 class IOWorker : public Worker {
@@ -0,0 +1,100 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Header. /////////////////////////////////////////////////////////////////////
+#include "worker_parker.h"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/date.h"
+
+namespace comet {
+namespace job {
+ParkTicket WorkerParker::PrepareToPark() {
+  parked_count_.fetch_add(1, std::memory_order_seq_cst);
+  // Pairs with the fence in Notify(): either the notifier sees this worker as
+  // parked, or this worker sees the published work when checking one last
+  // time.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  return epoch_.load(std::memory_order_acquire);
+}
+
+void WorkerParker::CancelPark() {
+  parked_count_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void WorkerParker::Park(ParkTicket ticket) {
+  const auto park_time_ns{GetTimestampNanoSeconds()};
+  park_count_.fetch_add(1, std::memory_order_relaxed);
+
+  // Returns immediately if a notification happened since PrepareToPark().
+  epoch_.wait(ticket, std::memory_order_acquire);
+  parked_count_.fetch_sub(1, std::memory_order_relaxed);
+
+  const auto wake_time_ns{GetTimestampNanoSeconds()};
+  const auto notify_time_ns{
+      last_notify_time_ns_.load(std::memory_order_relaxed)};
+  const auto wake_latency_ns{
+      wake_time_ns > notify_time_ns ? wake_time_ns - notify_time_ns : 0};
+
+  wake_count_.fetch_add(1, std::memory_order_relaxed);
+  total_wake_latency_ns_.fetch_add(wake_latency_ns, std::memory_order_relaxed);
+  total_parked_time_ns_.fetch_add(
+      wake_time_ns > park_time_ns ? wake_time_ns - park_time_ns : 0,
+      std::memory_order_relaxed);
+
+  auto max_wake_latency_ns{
+      max_wake_latency_ns_.load(std::memory_order_relaxed)};
+
+  while (wake_latency_ns > max_wake_latency_ns &&
+         !max_wake_latency_ns_.compare_exchange_weak(
+             max_wake_latency_ns, wake_latency_ns, std::memory_order_relaxed,
+             std::memory_order_relaxed)) {
+  }
+}
+
+void WorkerParker::NotifyOne() { Notify(false); }
+
+void WorkerParker::NotifyAll() { Notify(true); }
+
+usize WorkerParker::GetParkedCount() const noexcept {
+  return parked_count_.load(std::memory_order_relaxed);
+}
+
+WorkerParkerStats WorkerParker::GetStats() const {
+  WorkerParkerStats stats{};
+  stats.park_count = park_count_.load(std::memory_order_relaxed);
+  stats.wake_count = wake_count_.load(std::memory_order_relaxed);
+  stats.total_wake_latency_ns =
+      total_wake_latency_ns_.load(std::memory_order_relaxed);
+  stats.max_wake_latency_ns =
+      max_wake_latency_ns_.load(std::memory_order_relaxed);
+  stats.total_parked_time_ns =
+      total_parked_time_ns_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void WorkerParker::Notify(bool is_all) {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  // Fast path: nobody to wake up, which is the common case under load.
+  if (!is_all && parked_count_.load(std::memory_order_relaxed) == 0) {
+    return;
+  }
+
+  last_notify_time_ns_.store(GetTimestampNanoSeconds(),
+                             std::memory_order_relaxed);
+  epoch_.fetch_add(1, std::memory_order_release);
+
+  if (is_all) {
+    epoch_.notify_all();
+  } else {
+    epoch_.notify_one();
+  }
+}
+}  // namespace job
+}  // namespace comet
@@ -0,0 +1,74 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+#ifndef COMET_COMET_CORE_CONCURRENCY_JOB_WORKER_PARKER_H_
+#define COMET_COMET_CORE_CONCURRENCY_JOB_WORKER_PARKER_H_
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <atomic>
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/essentials.h"
+
+namespace comet {
+namespace job {
+struct WorkerParkerStats {
+  usize park_count{0};
+  usize wake_count{0};
+  u64 total_wake_latency_ns{0};
+  u64 max_wake_latency_ns{0};
+  u64 total_parked_time_ns{0};
+};
+
+using ParkTicket = u32;
+
+// Event count used by idle workers to sleep until new work is submitted.
+// Usage, on the worker side:
+// 1. Call PrepareToPark().
+// 2. Check for work one last time.
+// 3. Call CancelPark() if some work was found, or Park() otherwise.
+// Submitters call NotifyOne() after publishing their work. This ordering
+// guarantees that no wake-up is lost.
+class WorkerParker {
+ public:
+  WorkerParker() = default;
+  WorkerParker(const WorkerParker&) = delete;
+  WorkerParker(WorkerParker&&) = delete;
+  WorkerParker& operator=(const WorkerParker&) = delete;
+  WorkerParker& operator=(WorkerParker&&) = delete;
+  ~WorkerParker() = default;
+
+  ParkTicket PrepareToPark();
+  void CancelPark();
+  void Park(ParkTicket ticket);
+  void NotifyOne();
+  void NotifyAll();
+
+  usize GetParkedCount() const noexcept;
+  WorkerParkerStats GetStats() const;
+
+ private:
+  static_assert(std::atomic<ParkTicket>::is_always_lock_free,
+                "std::atomic<ParkTicket> needs to be always lock-free. "
+                "Unsupported architecture");
+  static_assert(std::atomic<u64>::is_always_lock_free,
+                "std::atomic<u64> needs to be always lock-free. Unsupported "
+                "architecture");
+
+  void Notify(bool is_all);
+
+  std::atomic<ParkTicket> epoch_{0};
+  std::atomic<usize> parked_count_{0};
+  std::atomic<u64> last_notify_time_ns_{0};
+
+  std::atomic<usize> park_count_{0};
+  std::atomic<usize> wake_count_{0};
+  std::atomic<u64> total_wake_latency_ns_{0};
+  std::atomic<u64> max_wake_latency_ns_{0};
+  std::atomic<u64> total_parked_time_ns_{0};
+};
+}  // namespace job
+}  // namespace comet
+
+#endif  // COMET_COMET_CORE_CONCURRENCY_JOB_WORKER_PARKER_H_
@@ -12,6 +12,12 @@
 
 // External. ///////////////////////////////////////////////////////////////////
 #include <thread>
+
+#ifdef COMET_ARCH_X86
+#include <immintrin.h>
+#elif defined(COMET_ARCH_ARM) && defined(COMET_MSVC)
+#include <intrin.h>
+#endif  // COMET_ARCH_X86
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace comet {
@@ -45,6 +51,19 @@ Thread* GetThread() { return tls_current_thread; }
 
 void Yield() { std::this_thread::yield(); }
 
+void Pause() {
+#ifdef COMET_ARCH_X86
+  _mm_pause();
+#elif defined(COMET_ARCH_ARM) && defined(COMET_MSVC)
+  __yield();
+#elif defined(COMET_ARCH_ARM)
+  __asm__ __volatile__("yield");
+#else
+  // No spin-wait hint: give the core away instead.
+  std::this_thread::yield();
+#endif  // COMET_ARCH_X86
+}
+
 usize GetMaxConcurrentThreadCount() {
   auto max_thread_count{std::thread::hardware_concurrency()};
   COMET_CASSERT(max_thread_count > internal::kReservedThreadCount,
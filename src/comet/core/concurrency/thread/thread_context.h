@@ -32,6 +32,8 @@ bool IsThreadAttached();
 ThreadId GetThreadId();
 Thread* GetThread();
 void Yield();
+// Hints the CPU that the calling thread is spinning.
+void Pause();
 usize GetMaxConcurrentThreadCount();
 usize GetConcurrentThreadCountLeft();
 usize GetCurrentThreadCount();
@@ -47,7 +47,13 @@ void ConfigurationManager::Initialize() {
   values_.Emplace(kCoreExternalLibraryFiberCount,
                   GetDefaultValue(kCoreExternalLibraryFiberCount));
   values_.Emplace(kCoreJobCounterCount, GetDefaultValue(kCoreJobCounterCount));
+  values_.Emplace(kCoreJobContinuationCount,
+                  GetDefaultValue(kCoreJobContinuationCount));
   values_.Emplace(kCoreJobQueueCount, GetDefaultValue(kCoreJobQueueCount));
+  values_.Emplace(kCoreJobLocalQueueCount,
+                  GetDefaultValue(kCoreJobLocalQueueCount));
+  values_.Emplace(kCoreJobIdleSpinCount,
+                  GetDefaultValue(kCoreJobIdleSpinCount));
   values_.Emplace(kCoreIsMainThreadWorkerDisabled,
                   GetDefaultValue(kCoreIsMainThreadWorkerDisabled));
   values_.Emplace(kCoreTaggedHeapCapacity,
@@ -97,6 +103,8 @@ void ConfigurationManager::Initialize() {
   values_.Emplace(kRenderingVulkanMaxFramesInFlight,
                   GetDefaultValue(kRenderingVulkanMaxFramesInFlight));
   values_.Emplace(kResourceRootPath, GetDefaultValue(kResourceRootPath));
+  values_.Emplace(kResourceIsMemoryMapped,
+                  GetDefaultValue(kResourceIsMemoryMapped));
 
   ParseConfFile();
 }
@@ -374,7 +382,9 @@ void ConfigurationManager::ParseKeyValuePair(schar* raw_key,
              key == kApplicationPatchVersion || key == kCoreLargeFiberCount ||
              key == kCoreGiganticFiberCount ||
              key == kCoreExternalLibraryFiberCount ||
-             key == kCoreJobCounterCount || key == kCoreJobQueueCount ||
+             key == kCoreJobCounterCount ||
+             key == kCoreJobContinuationCount || key == kCoreJobQueueCount ||
+             key == kCoreJobLocalQueueCount || key == kCoreJobIdleSpinCount ||
              key == kRenderingWindowWidth || key == kRenderingWindowHeight ||
              key == kRenderingFpsCap || key == kRenderingOpenGlMajorVersion ||
              key == kRenderingOpenGlMinorVersion ||
@@ -398,7 +408,8 @@ void ConfigurationManager::ParseKeyValuePair(schar* raw_key,
   } else if (key == kCoreIsMainThreadWorkerDisabled ||
              key == kRenderingIsVsync || key == kRenderingIsTripleBuffering ||
              key == kRenderingIsSamplerAnisotropy ||
-             key == kRenderingIsSampleRateShading) {
+             key == kRenderingIsSampleRateShading ||
+             key == kResourceIsMemoryMapped) {
     SetBool(key, ParseBool(value));
   } else if (key == kResourceRootPath) {
 #ifdef COMET_WIDE_TCHAR
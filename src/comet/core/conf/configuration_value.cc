@@ -43,8 +43,14 @@ ConfValue GetDefaultValue(ConfKey key) {
     default_value.u16_value = 32;
   } else if (key == kCoreJobCounterCount) {
     default_value.u16_value = 2048;
+  } else if (key == kCoreJobContinuationCount) {
+    default_value.u16_value = 1024;
   } else if (key == kCoreJobQueueCount) {
     default_value.u16_value = 256;
+  } else if (key == kCoreJobLocalQueueCount) {
+    default_value.u16_value = 512;
+  } else if (key == kCoreJobIdleSpinCount) {
+    default_value.u16_value = 1024;
   } else if (key == kCoreIsMainThreadWorkerDisabled) {
     default_value.bool_value = false;
   } else if (key == kCoreTaggedHeapCapacity) {
@@ -105,6 +111,8 @@ ConfValue GetDefaultValue(ConfKey key) {
 #else
     Copy(default_value.str_value, COMET_TCHAR("resources\0"), 10);
 #endif  // COMET_WIDE_TCHAR
+  } else if (key == kResourceIsMemoryMapped) {
+    default_value.bool_value = true;
   }
 
   return default_value;
@@ -42,8 +42,14 @@ static const ConfKey kCoreExternalLibraryFiberCount{
     COMET_STRING_ID("core_external_library_fiber_count")};
 static const ConfKey kCoreJobCounterCount{
     COMET_STRING_ID("core_job_counter_count")};
+static const ConfKey kCoreJobContinuationCount{
+    COMET_STRING_ID("core_job_continuation_count")};
 static const ConfKey kCoreJobQueueCount{
     COMET_STRING_ID("core_job_queue_count")};
+static const ConfKey kCoreJobLocalQueueCount{
+    COMET_STRING_ID("core_job_local_queue_count")};
+static const ConfKey kCoreJobIdleSpinCount{
+    COMET_STRING_ID("core_job_idle_spin_count")};
 static const ConfKey kCoreIsMainThreadWorkerDisabled{
     COMET_STRING_ID("core_is_main_thread_worker_disabled")};
 static const ConfKey kCoreTaggedHeapCapacity{
@@ -126,6 +132,8 @@ static constexpr auto kRenderingDriverEmpty{"empty"sv};
 
 // Resource. /////////////////////////////////////////////////////////////
 static const ConfKey kResourceRootPath{COMET_STRING_ID("resource_root_path")};
+static const ConfKey kResourceIsMemoryMapped{
+    COMET_STRING_ID("resource_is_memory_mapped")};
 
 constexpr u16 kMaxStrValueLength{260};
 
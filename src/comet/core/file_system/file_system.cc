@@ -16,6 +16,8 @@
 #include "comet/core/logger.h"
 
 #ifndef COMET_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #endif  // !COMET_WINDOWS
@@ -159,6 +161,100 @@ bool ReadBinaryFromFile(CTStringView path, Array<u8>& buff) {
 
 void CloseFile(std::ifstream& file) { file.close(); }
 
+bool MapFile(CTStringView path, MappedFile& file) {
+  COMET_ASSERT(!IsMapped(file), "File is already mapped!");
+#ifdef COMET_MSVC
+  file.file_handle = MSVC_CREATE_FILE(
+      path.GetCTStr(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+  if (file.file_handle == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+
+  LARGE_INTEGER size{};
+
+  if (!GetFileSizeEx(file.file_handle, &size) || size.QuadPart == 0) {
+    CloseHandle(file.file_handle);
+    file.file_handle = INVALID_HANDLE_VALUE;
+    return false;
+  }
+
+  file.mapping_handle = CreateFileMapping(file.file_handle, nullptr,
+                                          PAGE_READONLY, 0, 0, nullptr);
+
+  if (file.mapping_handle == nullptr) {
+    CloseHandle(file.file_handle);
+    file.file_handle = INVALID_HANDLE_VALUE;
+    return false;
+  }
+
+  file.data = static_cast<const u8*>(
+      MapViewOfFile(file.mapping_handle, FILE_MAP_READ, 0, 0, 0));
+
+  if (file.data == nullptr) {
+    CloseHandle(file.mapping_handle);
+    CloseHandle(file.file_handle);
+    file.mapping_handle = nullptr;
+    file.file_handle = INVALID_HANDLE_VALUE;
+    return false;
+  }
+
+  file.size = static_cast<usize>(size.QuadPart);
+#else
+  const auto fd{open(path.GetCTStr(), O_RDONLY)};
+
+  if (fd == -1) {
+    return false;
+  }
+
+  struct stat status;
+
+  if (fstat(fd, &status) != 0 || status.st_size == 0) {
+    close(fd);
+    return false;
+  }
+
+  const auto size{static_cast<usize>(status.st_size)};
+  auto* data{mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0)};
+
+  // The mapping keeps its own reference to the file.
+  close(fd);
+
+  if (data == MAP_FAILED) {
+    return false;
+  }
+
+  // Start reading ahead while the caller gets ready to consume the data.
+  madvise(data, size, MADV_WILLNEED);
+  file.data = static_cast<const u8*>(data);
+  file.size = size;
+#endif  // COMET_MSVC
+
+  return true;
+}
+
+void UnmapFile(MappedFile& file) {
+  if (!IsMapped(file)) {
+    return;
+  }
+
+#ifdef COMET_MSVC
+  UnmapViewOfFile(file.data);
+  CloseHandle(file.mapping_handle);
+  CloseHandle(file.file_handle);
+  file.mapping_handle = nullptr;
+  file.file_handle = INVALID_HANDLE_VALUE;
+#else
+  munmap(const_cast<u8*>(file.data), file.size);
+#endif  // COMET_MSVC
+
+  file.data = nullptr;
+  file.size = 0;
+}
+
+bool IsMapped(const MappedFile& file) { return file.data != nullptr; }
+
 bool WriteStrToFile(CTStringView path, const schar* buff, bool is_append) {
   auto mode{std::ios::binary | std::ios::out};
 
@@ -13,6 +13,7 @@
 
 #ifdef COMET_WIDE_TCHAR
 #define MSVC_CREATE_DIRECTORY CreateDirectoryW
+#define MSVC_CREATE_FILE CreateFileW
 #define MSVC_REMOVE_DIRECTORY RemoveDirectoryW
 #define MSVC_GET_CURRENT_DIRECTORY GetCurrentDirectoryW
 #define MSVC_GET_FULL_PATH_NAME GetFullPathNameW
@@ -25,6 +26,7 @@
 #define MSVC_WIN32_FIND_DATA WIN32_FIND_DATAW
 #else
 #define MSVC_CREATE_DIRECTORY CreateDirectoryA
+#define MSVC_CREATE_FILE CreateFileA
 #define MSVC_REMOVE_DIRECTORY RemoveDirectoryA
 #define MSVC_GET_CURRENT_DIRECTORY GetCurrentDirectoryA
 #define MSVC_GET_FULL_PATH_NAME GetFullPathNameA
@@ -50,6 +52,16 @@ constexpr CTStringView kDotFolderName{COMET_TCHAR(".")};
 constexpr CTStringView kDotDotFolderName{COMET_TCHAR("..")};
 constexpr auto kMaxPathLength{4096};
 
+// Read-only view of a whole file, backed by the OS page cache.
+struct MappedFile {
+  const u8* data{nullptr};
+  usize size{0};
+#ifdef COMET_MSVC
+  HANDLE file_handle{INVALID_HANDLE_VALUE};
+  HANDLE mapping_handle{nullptr};
+#endif  // COMET_MSVC
+};
+
 namespace internal {
 const tchar* GetTmpCopyWithNormalizedSlashes(CTStringView str);
 const tchar* GetNextElementForRelativePath(const tchar*& cursor,
@@ -67,6 +79,9 @@ bool WriteBinaryToFile(CTStringView path, const u8* buff, usize buff_len,
                        bool is_append);
 bool ReadBinaryFromFile(CTStringView path, Array<u8>& buff);
 void CloseFile(std::ifstream& file);
+bool MapFile(CTStringView path, MappedFile& file);
+void UnmapFile(MappedFile& file);
+bool IsMapped(const MappedFile& file);
 bool WriteStrToFile(CTStringView path, const schar* buff,
                     bool is_append = false);
 bool ReadStrFromFile(CTStringView path, schar* buff, usize buff_len,
@@ -123,6 +123,8 @@ void FramePacket::FramePacket::Reset() {
 
   projection_matrix = math::Mat4{};
   view_matrix = math::Mat4{};
+  camera_position = math::Vec3{};
+  camera_frustum = rendering::Frustum{};
   draw_count = 0;
 
   added_geometries = COMET_DOUBLE_FRAME_ORDERED_SET(AddedGeometry);
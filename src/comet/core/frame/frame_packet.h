@@ -17,6 +17,7 @@
 #include "comet/math/matrix.h"
 #include "comet/math/vector.h"
 #include "comet/physics/component/transform_component.h"
+#include "comet/rendering/camera/frustum.h"
 #include "comet/time/time_manager.h"
 
 namespace comet {
@@ -121,6 +122,8 @@ struct FramePacket {
   StageTimes stage_times[kFrameStageCount]{};
   math::Mat4 projection_matrix{};
   math::Mat4 view_matrix{};
+  math::Vec3 camera_position{};
+  rendering::Frustum camera_frustum{};
   usize draw_count{0};
 
   AddedGeometries* added_geometries{nullptr};
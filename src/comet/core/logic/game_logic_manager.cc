@@ -13,6 +13,7 @@
 #include "comet/core/concurrency/job/job.h"
 #include "comet/core/concurrency/job/job_utils.h"
 #include "comet/core/concurrency/job/scheduler.h"
+#include "comet/geometry/component/skeleton_component.h"
 #include "comet/rendering/camera/camera.h"
 
 namespace comet {
@@ -29,9 +30,28 @@ void GameLogicManager::Initialize() {
   camera_manager_ = &rendering::CameraManager::Get();
   scene_manager_ = &scene::SceneManager::Get();
   event_manager_ = &event::EventManager::Get();
+  system_scheduler_ = &entity::SystemScheduler::Get();
+
+  physics_system_id_ = system_scheduler_->Register<
+      entity::Read<>, entity::Write<physics::TransformRootComponent,
+                                    physics::TransformComponent>>(
+      "physics", UpdatePhysics, this, {}, job::JobStackSize::Large);
+
+  // Animations are sampled at the time computed by the physics system, and
+  // their level of detail depends on the transforms it updates.
+  animation_system_id_ = system_scheduler_->Register<
+      entity::Read<geometry::SkeletonComponent, physics::TransformComponent>,
+      entity::Write<animation::AnimationComponent>>(
+      "animation", UpdateAnimations, this, {physics_system_id_},
+      job::JobStackSize::Large);
 }
 
 void GameLogicManager::Shutdown() {
+  system_scheduler_->Unregister(animation_system_id_);
+  system_scheduler_->Unregister(physics_system_id_);
+  animation_system_id_ = entity::kInvalidSystemId;
+  physics_system_id_ = entity::kInvalidSystemId;
+  system_scheduler_ = nullptr;
   physics_manager_ = nullptr;
   entity_manager_ = nullptr;
   animation_manager_ = nullptr;
@@ -47,37 +67,43 @@ void GameLogicManager::Update(frame::FramePacket* packet) {
 
   struct Job {
     frame::FramePacket* packet{nullptr};
-    physics::PhysicsManager* physics_manager{nullptr};
-    entity::EntityManager* entity_manager{nullptr};
-    animation::AnimationManager* animation_manager{nullptr};
+    entity::SystemScheduler* system_scheduler{nullptr};
   };
 
   auto* job{COMET_FRAME_ALLOC_ONE_AND_POPULATE(Job)};
   job->packet = packet;
-  job->physics_manager = physics_manager_;
-  job->entity_manager = entity_manager_;
-  job->animation_manager = animation_manager_;
+  job->system_scheduler = system_scheduler_;
 
   job::Scheduler::Get().Kick(job::GenerateJobDescr(
       job::JobPriority::High,
       [](job::JobParamsHandle params_handle) {
         auto* job{reinterpret_cast<Job*>(params_handle)};
-        auto* packet{job->packet};
+        job->system_scheduler->Update(job->packet);
+      },
+      job, job::JobStackSize::Normal, packet->counter, "game_logic_update"));
+}
 
-        job->physics_manager->Update(packet);
+void GameLogicManager::UpdatePhysics(frame::FramePacket* packet,
+                                     entity::SystemParamsHandle params_handle) {
+  auto* manager{static_cast<GameLogicManager*>(params_handle)};
+  manager->physics_manager_->Update(packet);
 
-        packet->interpolation =
-            packet->lag / time::TimeManager::Get().GetFixedDeltaTime();
+  packet->interpolation =
+      packet->lag / time::TimeManager::Get().GetFixedDeltaTime();
+}
 
-        job->animation_manager->Update(packet);
-      },
-      job, job::JobStackSize::Large, packet->counter, "game_logic_update"));
+void GameLogicManager::UpdateAnimations(
+    frame::FramePacket* packet, entity::SystemParamsHandle params_handle) {
+  auto* manager{static_cast<GameLogicManager*>(params_handle)};
+  manager->animation_manager_->Update(packet);
 }
 
 void GameLogicManager::PopulatePacket(frame::FramePacket* packet) {
   auto* camera{camera_manager_->GetMainCamera()};
   packet->projection_matrix = camera->GetProjectionMatrix();
   packet->view_matrix = camera->GetViewMatrix();
+  packet->camera_position = camera->GetPosition();
+  packet->camera_frustum = camera->GetFrustum();
   auto expected_entity_count{scene_manager_->GetExpectedEntityCount()};
 
   packet->added_geometries->Reserve(expected_entity_count);
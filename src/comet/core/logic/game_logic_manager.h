@@ -10,6 +10,7 @@
 #include "comet/core/frame/frame_packet.h"
 #include "comet/core/manager.h"
 #include "comet/entity/entity_manager.h"
+#include "comet/entity/system_scheduler.h"
 #include "comet/event/event_manager.h"
 #include "comet/physics/physics_manager.h"
 #include "comet/rendering/camera/camera_manager.h"
@@ -33,14 +34,22 @@ class GameLogicManager : public Manager {
   void Update(frame::FramePacket* packet);
 
  private:
+  static void UpdatePhysics(frame::FramePacket* packet,
+                            entity::SystemParamsHandle params_handle);
+  static void UpdateAnimations(frame::FramePacket* packet,
+                               entity::SystemParamsHandle params_handle);
+
   void PopulatePacket(frame::FramePacket* packet);
 
+  entity::SystemId physics_system_id_{entity::kInvalidSystemId};
+  entity::SystemId animation_system_id_{entity::kInvalidSystemId};
   physics::PhysicsManager* physics_manager_{nullptr};
   entity::EntityManager* entity_manager_{nullptr};
   animation::AnimationManager* animation_manager_{nullptr};
   rendering::CameraManager* camera_manager_{nullptr};
   scene::SceneManager* scene_manager_{nullptr};
   event::EventManager* event_manager_{nullptr};
+  entity::SystemScheduler* system_scheduler_{nullptr};
 };
 }  // namespace comet
 
@@ -0,0 +1,266 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+#ifndef COMET_COMET_CORE_MEMORY_ALLOCATOR_POOL_ALLOCATOR_H_
+#define COMET_COMET_CORE_MEMORY_ALLOCATOR_POOL_ALLOCATOR_H_
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <atomic>
+#include <new>
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/concurrency/fiber/fiber_primitive.h"
+#include "comet/core/essentials.h"
+#include "comet/core/memory/allocator/stateful_allocator.h"
+#include "comet/core/memory/memory.h"
+#include "comet/core/memory/tagged_heap.h"
+#include "comet/core/type/gid.h"
+
+namespace comet {
+namespace memory {
+// Handles have the same layout as gid::Gid: the index of the slot is stored
+// in the low bits, and its generation in the high bits.
+using PoolHandle = gid::Gid;
+constexpr auto kInvalidPoolHandle{gid::kInvalidId};
+constexpr Alignment kPoolSlotAlignment{64};
+
+// Pool of objects of type T. Free slots form a lock-free stack, which makes
+// allocating and deallocating O(1). Slots are aligned to cache lines, so that
+// objects used by different threads do not share any. The pool grows one
+// tagged heap block at a time.
+// The generation of a slot is incremented every time it is deallocated, which
+// allows detecting handles referring to deallocated objects.
+template <typename T>
+class PoolAllocator : public StatefulAllocator {
+ public:
+  PoolAllocator() = default;
+  explicit PoolAllocator(MemoryTag memory_tag);
+  PoolAllocator(const PoolAllocator&) = delete;
+  PoolAllocator(PoolAllocator&&) = delete;
+  PoolAllocator& operator=(const PoolAllocator&) = delete;
+  PoolAllocator& operator=(PoolAllocator&&) = delete;
+  ~PoolAllocator() = default;
+
+  void Initialize() override;
+  void Destroy() override;
+
+  // Only allocations which fit in a slot are supported. Throws
+  // std::bad_alloc once the pool cannot grow anymore.
+  void* AllocateAligned(usize size, Alignment align) override;
+  void Deallocate(void* ptr) override;
+
+  PoolHandle GetHandle(const T* object) const;
+  // Returns null if the object referred by the handle was deallocated.
+  T* TryGet(PoolHandle handle) const;
+
+  usize GetCapacity() const noexcept;
+
+ private:
+  static inline constexpr u32 kInvalidSlotIndex_{kU32Max};
+  static inline constexpr usize kMaxBlockCount_{256};
+  // The free head packs a tag in its high bits, incremented on every update
+  // to prevent ABA issues, and the index of the first free slot in its low
+  // bits.
+  static inline constexpr u64 kFreeHeadIndexMask_{kU32Max};
+  static inline constexpr u64 kFreeHeadTagIncrement_{u64{1} << 32};
+
+  struct alignas(alignof(T) > kPoolSlotAlignment ? alignof(T)
+                                                 : kPoolSlotAlignment) Slot {
+    alignas(T) u8 storage[sizeof(T)];
+    std::atomic<u32> next_index{kInvalidSlotIndex_};
+    std::atomic<u32> generation{0};
+    u32 index{kInvalidSlotIndex_};
+  };
+
+  static u64 GenerateFreeHead(u64 previous_head, u32 index);
+
+  Slot* ResolveSlot(u32 index) const;
+  void Grow();
+  void PushSlots(Slot* first, Slot* last);
+
+  MemoryTag memory_tag_{kEngineMemoryTagUntagged};
+  usize slot_count_per_block_{0};
+  usize slot_index_shift_{0};
+  std::atomic<u64> free_head_{kInvalidSlotIndex_};
+  std::atomic<usize> block_count_{0};
+  Slot* blocks_[kMaxBlockCount_]{};
+  fiber::FiberSpinLock growth_lock_{};
+};
+
+template <typename T>
+inline PoolAllocator<T>::PoolAllocator(MemoryTag memory_tag)
+    : memory_tag_{memory_tag} {}
+
+template <typename T>
+inline void PoolAllocator<T>::Initialize() {
+  StatefulAllocator::Initialize();
+  const auto block_size{TaggedHeap::Get().GetBlockSize() - alignof(Slot)};
+  COMET_ASSERT(block_size >= sizeof(Slot),
+               "Pool slots do not fit in a tagged heap block!");
+
+  // Keep a power of 2 to resolve slots with shifts and masks.
+  slot_index_shift_ = 0;
+
+  while ((usize{2} << slot_index_shift_) * sizeof(Slot) <= block_size) {
+    ++slot_index_shift_;
+  }
+
+  slot_count_per_block_ = usize{1} << slot_index_shift_;
+  free_head_.store(kInvalidSlotIndex_, std::memory_order_relaxed);
+  block_count_.store(0, std::memory_order_relaxed);
+}
+
+template <typename T>
+inline void PoolAllocator<T>::Destroy() {
+  StatefulAllocator::Destroy();
+  TaggedHeap::Get().DeallocateAll(memory_tag_);
+  free_head_.store(kInvalidSlotIndex_, std::memory_order_relaxed);
+  block_count_.store(0, std::memory_order_relaxed);
+  slot_count_per_block_ = 0;
+  slot_index_shift_ = 0;
+
+  for (auto*& block : blocks_) {
+    block = nullptr;
+  }
+}
+
+template <typename T>
+inline void* PoolAllocator<T>::AllocateAligned([[maybe_unused]] usize size,
+                                               [[maybe_unused]] Alignment
+                                                   align) {
+  COMET_ASSERT(size <= sizeof(T), "Size ", size,
+               " does not fit in a pool slot!");
+  COMET_ASSERT(align <= alignof(Slot), "Alignment ", align,
+               " is not supported by the pool!");
+
+  while (true) {
+    auto head{free_head_.load(std::memory_order_acquire)};
+    const auto index{static_cast<u32>(head & kFreeHeadIndexMask_)};
+
+    if (index == kInvalidSlotIndex_) {
+      Grow();
+      continue;
+    }
+
+    auto* slot{ResolveSlot(index)};
+    const auto next_head{GenerateFreeHead(
+        head, slot->next_index.load(std::memory_order_relaxed))};
+
+    // On failure, the slot was popped concurrently: its next index might be
+    // stale, but the tag has changed too.
+    if (free_head_.compare_exchange_weak(head, next_head,
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_acquire)) {
+      return slot->storage;
+    }
+  }
+}
+
+template <typename T>
+inline void PoolAllocator<T>::Deallocate(void* ptr) {
+  auto* slot{reinterpret_cast<Slot*>(ptr)};
+  COMET_ASSERT(slot->index != kInvalidSlotIndex_,
+               "Pointer provided was not allocated from this pool!");
+  slot->generation.fetch_add(1, std::memory_order_release);
+  PushSlots(slot, slot);
+}
+
+template <typename T>
+inline PoolHandle PoolAllocator<T>::GetHandle(const T* object) const {
+  const auto* slot{reinterpret_cast<const Slot*>(object)};
+  const auto generation{static_cast<PoolHandle>(
+      slot->generation.load(std::memory_order_acquire))};
+  return ((generation << gid::kIndexBit) & gid::kGenerationMask) |
+         (static_cast<PoolHandle>(slot->index) & gid::kIndexMask);
+}
+
+template <typename T>
+inline T* PoolAllocator<T>::TryGet(PoolHandle handle) const {
+  const auto index{static_cast<u32>(handle & gid::kIndexMask)};
+
+  if (handle == kInvalidPoolHandle || index >= GetCapacity()) {
+    return nullptr;
+  }
+
+  auto* slot{ResolveSlot(index)};
+  const auto generation{static_cast<PoolHandle>(
+      slot->generation.load(std::memory_order_acquire))};
+
+  if (((generation << gid::kIndexBit) & gid::kGenerationMask) !=
+      (handle & gid::kGenerationMask)) {
+    return nullptr;
+  }
+
+  return reinterpret_cast<T*>(slot->storage);
+}
+
+template <typename T>
+inline usize PoolAllocator<T>::GetCapacity() const noexcept {
+  return block_count_.load(std::memory_order_acquire) * slot_count_per_block_;
+}
+
+template <typename T>
+inline u64 PoolAllocator<T>::GenerateFreeHead(u64 previous_head, u32 index) {
+  return ((previous_head & ~kFreeHeadIndexMask_) + kFreeHeadTagIncrement_) |
+         index;
+}
+
+template <typename T>
+inline typename PoolAllocator<T>::Slot* PoolAllocator<T>::ResolveSlot(
+    u32 index) const {
+  return blocks_[index >> slot_index_shift_] +
+         (index & (slot_count_per_block_ - 1));
+}
+
+template <typename T>
+inline void PoolAllocator<T>::Grow() {
+  fiber::FiberSpinLockGuard lock{growth_lock_};
+
+  // Case: another thread has grown the pool in the meantime.
+  if ((free_head_.load(std::memory_order_acquire) & kFreeHeadIndexMask_) !=
+      kInvalidSlotIndex_) {
+    return;
+  }
+
+  const auto block_index{block_count_.load(std::memory_order_relaxed)};
+
+  // Checked in release builds too: growing past the cap would write past the
+  // block table.
+  if (block_index >= kMaxBlockCount_ ||
+      (block_index + 1) * slot_count_per_block_ > gid::kIndexMask) {
+    COMET_ASSERT(false, "Pool is full! Capacity: ", GetCapacity(), ".");
+    throw std::bad_alloc();
+  }
+
+  auto* block{static_cast<Slot*>(
+      TaggedHeap::Get().AllocateBlockAligned(alignof(Slot), memory_tag_))};
+  const auto first_index{static_cast<u32>(block_index * slot_count_per_block_)};
+
+  for (usize i{0}; i < slot_count_per_block_; ++i) {
+    auto* slot{new (&block[i]) Slot{}};
+    slot->index = first_index + static_cast<u32>(i);
+    slot->next_index.store(slot->index + 1, std::memory_order_relaxed);
+  }
+
+  // Publish the block before its slots can be popped.
+  blocks_[block_index] = block;
+  block_count_.store(block_index + 1, std::memory_order_release);
+  PushSlots(&block[0], &block[slot_count_per_block_ - 1]);
+}
+
+template <typename T>
+inline void PoolAllocator<T>::PushSlots(Slot* first, Slot* last) {
+  auto head{free_head_.load(std::memory_order_relaxed)};
+
+  do {
+    last->next_index.store(static_cast<u32>(head & kFreeHeadIndexMask_),
+                           std::memory_order_relaxed);
+  } while (!free_head_.compare_exchange_weak(
+      head, GenerateFreeHead(head, first->index), std::memory_order_release,
+      std::memory_order_relaxed));
+}
+}  // namespace memory
+}  // namespace comet
+
+#endif  // COMET_COMET_CORE_MEMORY_ALLOCATOR_POOL_ALLOCATOR_H_
@@ -0,0 +1,308 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Header. /////////////////////////////////////////////////////////////////////
+#include "size_class_allocator.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <new>
+#include <utility>
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/concurrency/job/worker_context.h"
+#include "comet/core/memory/memory_utils.h"
+#include "comet/core/memory/tagged_heap.h"
+#include "comet/math/math_common.h"
+
+namespace comet {
+namespace memory {
+FiberSizeClassAllocator::FiberSizeClassAllocator(MemoryTag memory_tag)
+    : memory_tag_{memory_tag} {}
+
+FiberSizeClassAllocator::FiberSizeClassAllocator(
+    FiberSizeClassAllocator&& other) noexcept
+    : StatefulAllocator{std::move(other)},
+      memory_tag_{other.memory_tag_},
+      context_count_{other.context_count_},
+      thread_contexts_{std::move(other.thread_contexts_)},
+      shared_context_{other.shared_context_},
+      remote_objects_{other.remote_objects_},
+      chunk_cursor_{other.chunk_cursor_},
+      chunk_end_{other.chunk_end_} {
+  other.memory_tag_ = kEngineMemoryTagUntagged;
+  other.context_count_ = 0;
+  other.shared_context_ = {};
+  other.remote_objects_ = nullptr;
+  other.chunk_cursor_ = nullptr;
+  other.chunk_end_ = nullptr;
+}
+
+FiberSizeClassAllocator& FiberSizeClassAllocator::operator=(
+    FiberSizeClassAllocator&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+
+  StatefulAllocator::operator=(std::move(other));
+  memory_tag_ = other.memory_tag_;
+  context_count_ = other.context_count_;
+  thread_contexts_ = std::move(other.thread_contexts_);
+  shared_context_ = other.shared_context_;
+  remote_objects_ = other.remote_objects_;
+  chunk_cursor_ = other.chunk_cursor_;
+  chunk_end_ = other.chunk_end_;
+
+  other.memory_tag_ = kEngineMemoryTagUntagged;
+  other.context_count_ = 0;
+  other.shared_context_ = {};
+  other.remote_objects_ = nullptr;
+  other.chunk_cursor_ = nullptr;
+  other.chunk_end_ = nullptr;
+  return *this;
+}
+
+void FiberSizeClassAllocator::Initialize() {
+  StatefulAllocator::Initialize();
+  thread_contexts_.Initialize();
+  shared_context_ = {};
+
+  // One more context is shared by threads which are not fiber workers.
+  context_count_ = thread_contexts_.GetSize() + 1;
+  const auto remote_object_count{context_count_ * kSizeClassCount_};
+  remote_objects_ = reinterpret_cast<std::atomic<Object*>*>(
+      ReserveMemory(remote_object_count * sizeof(std::atomic<Object*>)));
+
+  for (usize i{0}; i < remote_object_count; ++i) {
+    new (&remote_objects_[i]) std::atomic<Object*>{nullptr};
+  }
+}
+
+void FiberSizeClassAllocator::Destroy() {
+  StatefulAllocator::Destroy();
+  thread_contexts_.Destroy();
+  TaggedHeap::Get().DeallocateAll(memory_tag_);
+  context_count_ = 0;
+  shared_context_ = {};
+  remote_objects_ = nullptr;
+  chunk_cursor_ = nullptr;
+  chunk_end_ = nullptr;
+}
+
+void* FiberSizeClassAllocator::AllocateAligned(usize size, Alignment align) {
+  COMET_ASSERT(size > 0, "Allocation size provided is 0!");
+  // Add alignment storage + object header.
+  const auto object_size{kObjectHeaderSize_ + size + align};
+
+  if (object_size > kMaxSizeClass_) {
+    return AllocateLarge(size, align);
+  }
+
+  const auto size_class_index{ResolveSizeClass(object_size)};
+  auto* object{TryPopObject(size_class_index)};
+
+  if (object == nullptr) {
+    object = PopSpanObjects(size_class_index);
+  }
+
+  return StoreShiftAndReturnAligned(
+      reinterpret_cast<u8*>(object) + kObjectHeaderSize_, size,
+      kSizeClasses_[size_class_index] - kObjectHeaderSize_, align);
+}
+
+void FiberSizeClassAllocator::Deallocate(void* ptr) {
+  auto* object{reinterpret_cast<Object*>(
+      static_cast<u8*>(ResolveNonAligned(static_cast<u8*>(ptr))) -
+      kObjectHeaderSize_)};
+  const auto* span{object->span};
+
+  if (span == nullptr) {
+    memory::Deallocate(object);
+    return;
+  }
+
+  const auto context_index{ResolveContextIndex()};
+
+  // Case: object is owned by another thread.
+  if (span->owner_index != context_index) {
+    PushRemoteObject(object);
+    return;
+  }
+
+  PushObjects(context_index, span->size_class_index, object, object);
+}
+
+usize FiberSizeClassAllocator::ResolveSizeClass(usize size) {
+  const auto* size_class{
+      std::lower_bound(kSizeClasses_, kSizeClasses_ + kSizeClassCount_, size)};
+  COMET_ASSERT(size_class != kSizeClasses_ + kSizeClassCount_,
+               "No size class found for size ", size, "!");
+  return static_cast<usize>(size_class - kSizeClasses_);
+}
+
+usize FiberSizeClassAllocator::ResolveContextIndex() const {
+  if (!job::IsFiberWorker()) {
+    return GetSharedContextIndex();
+  }
+
+  return static_cast<usize>(job::GetWorkerTypeIndex());
+}
+
+usize FiberSizeClassAllocator::GetSharedContextIndex() const noexcept {
+  return context_count_ - 1;
+}
+
+FiberSizeClassAllocator::ThreadContext& FiberSizeClassAllocator::GetContext(
+    usize context_index) {
+  if (context_index == GetSharedContextIndex()) {
+    return shared_context_;
+  }
+
+  return thread_contexts_.GetFromIndex(context_index);
+}
+
+std::atomic<FiberSizeClassAllocator::Object*>&
+FiberSizeClassAllocator::GetRemoteObjects(usize context_index,
+                                          usize size_class_index) {
+  return remote_objects_[context_index * kSizeClassCount_ + size_class_index];
+}
+
+FiberSizeClassAllocator::Object* FiberSizeClassAllocator::TryPopObject(
+    usize size_class_index) {
+  const auto context_index{ResolveContextIndex()};
+
+  if (context_index != GetSharedContextIndex()) {
+    return PopObject(context_index, size_class_index);
+  }
+
+  fiber::FiberSpinLockGuard lock{shared_context_lock_};
+  return PopObject(context_index, size_class_index);
+}
+
+FiberSizeClassAllocator::Object* FiberSizeClassAllocator::PopObject(
+    usize context_index, usize size_class_index) {
+  auto*& free_objects{GetContext(context_index).free_objects[size_class_index]};
+
+  // Take back all the objects deallocated by other threads at once.
+  if (free_objects == nullptr) {
+    free_objects = GetRemoteObjects(context_index, size_class_index)
+                       .exchange(nullptr, std::memory_order_acquire);
+  }
+
+  auto* object{free_objects};
+
+  if (object != nullptr) {
+    free_objects = object->next;
+  }
+
+  return object;
+}
+
+FiberSizeClassAllocator::Object* FiberSizeClassAllocator::PopSpanObjects(
+    usize size_class_index) {
+  auto* span{reinterpret_cast<Span*>(ReserveMemory(kSpanSize_))};
+
+  // Reserving memory may yield: the current fiber might have been resumed on
+  // another worker since.
+  const auto context_index{ResolveContextIndex()};
+  span->size_class_index = size_class_index;
+  span->owner_index = context_index;
+
+  const auto object_size{kSizeClasses_[size_class_index]};
+  const auto objects_offset{AlignSize(sizeof(Span), kSpanAlignment_)};
+  const auto object_count{(kSpanSize_ - objects_offset) / object_size};
+  auto* cursor{reinterpret_cast<u8*>(span) + objects_offset};
+  Object* first{nullptr};
+  Object* last{nullptr};
+
+  for (usize i{0}; i < object_count; ++i) {
+    auto* object{reinterpret_cast<Object*>(cursor)};
+    object->span = span;
+    object->next = nullptr;
+
+    if (last != nullptr) {
+      last->next = object;
+    } else {
+      first = object;
+    }
+
+    last = object;
+    cursor += object_size;
+  }
+
+  // Keep the first object, and cache the other ones.
+  if (first != last) {
+    PushObjects(context_index, size_class_index, first->next, last);
+  }
+
+  return first;
+}
+
+void FiberSizeClassAllocator::PushObjects(usize context_index,
+                                          usize size_class_index,
+                                          Object* first, Object* last) {
+  if (context_index != GetSharedContextIndex()) {
+    auto*& free_objects{
+        GetContext(context_index).free_objects[size_class_index]};
+    last->next = free_objects;
+    free_objects = first;
+    return;
+  }
+
+  fiber::FiberSpinLockGuard lock{shared_context_lock_};
+  last->next = shared_context_.free_objects[size_class_index];
+  shared_context_.free_objects[size_class_index] = first;
+}
+
+void FiberSizeClassAllocator::PushRemoteObject(Object* object) {
+  const auto* span{object->span};
+  auto& remote_objects{
+      GetRemoteObjects(span->owner_index, span->size_class_index)};
+  auto* head{remote_objects.load(std::memory_order_relaxed)};
+
+  do {
+    object->next = head;
+  } while (!remote_objects.compare_exchange_weak(head, object,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed));
+}
+
+u8* FiberSizeClassAllocator::ReserveMemory(usize size) {
+  fiber::FiberSpinLockGuard lock{chunk_lock_};
+  auto* ptr{chunk_cursor_ != nullptr
+                ? AlignPointer(chunk_cursor_, kSpanAlignment_)
+                : nullptr};
+
+  if (ptr == nullptr || ptr + size > chunk_end_) {
+    auto& tagged_heap{TaggedHeap::Get()};
+    const auto block_size{tagged_heap.GetBlockSize()};
+    const auto block_count{
+        (math::Max(size, kChunkSize_) + kSpanAlignment_ + block_size - 1) /
+        block_size};
+    ptr = static_cast<u8*>(tagged_heap.AllocateBlocksAligned(
+        block_count, kSpanAlignment_, memory_tag_));
+    chunk_end_ = ptr + block_count * block_size - kSpanAlignment_;
+  }
+
+  chunk_cursor_ = ptr + size;
+  return ptr;
+}
+
+void* FiberSizeClassAllocator::AllocateLarge(usize size, Alignment align) {
+  const auto allocation_size{kObjectHeaderSize_ + size + align};
+  auto* object{static_cast<Object*>(
+      memory::AllocateAligned(allocation_size, alignof(Object), memory_tag_))};
+  object->span = nullptr;
+
+  return StoreShiftAndReturnAligned(
+      reinterpret_cast<u8*>(object) + kObjectHeaderSize_, size,
+      allocation_size - kObjectHeaderSize_, align);
+}
+}  // namespace memory
+}  // namespace comet
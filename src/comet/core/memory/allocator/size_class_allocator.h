@@ -0,0 +1,111 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+#ifndef COMET_COMET_CORE_MEMORY_ALLOCATOR_SIZE_CLASS_ALLOCATOR_H_
+#define COMET_COMET_CORE_MEMORY_ALLOCATOR_SIZE_CLASS_ALLOCATOR_H_
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <atomic>
+#include <iterator>
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/concurrency/fiber/fiber_primitive.h"
+#include "comet/core/concurrency/provider/thread_provider.h"
+#include "comet/core/concurrency/provider/thread_provider_manager.h"
+#include "comet/core/essentials.h"
+#include "comet/core/memory/allocator/stateful_allocator.h"
+#include "comet/core/memory/memory.h"
+
+namespace comet {
+namespace memory {
+// General-purpose allocator. Allocations are rounded up to a size class, and
+// each fiber worker caches the free objects of every size class, so that
+// allocating and deallocating do not require any lock. Objects deallocated by
+// another thread are pushed to a list of their owner, which takes them back
+// all at once when its cache runs dry. Threads which are not fiber workers
+// share a common cache.
+// Objects are carved from spans, which are backed by the tagged heap.
+// Allocations larger than the biggest size class are forwarded to the
+// platform.
+class FiberSizeClassAllocator : public StatefulAllocator {
+ public:
+  FiberSizeClassAllocator() = default;
+  explicit FiberSizeClassAllocator(MemoryTag memory_tag);
+  FiberSizeClassAllocator(const FiberSizeClassAllocator&) = delete;
+  FiberSizeClassAllocator(FiberSizeClassAllocator&& other) noexcept;
+  FiberSizeClassAllocator& operator=(const FiberSizeClassAllocator&) = delete;
+  FiberSizeClassAllocator& operator=(FiberSizeClassAllocator&& other) noexcept;
+  ~FiberSizeClassAllocator() = default;
+
+  void Initialize() override;
+  void Destroy() override;
+
+  void* AllocateAligned(usize size, Alignment align) override;
+  void Deallocate(void* ptr) override;
+
+ private:
+  static inline constexpr usize kSizeClasses_[]{
+      32,   48,   64,   80,   96,   112,  128,  160,  192,
+      224,  256,  320,  384,  448,  512,  640,  768,  896,
+      1024, 1280, 1536, 1792, 2048, 2560, 3072, 3584, 4096};
+  static inline constexpr usize kSizeClassCount_{std::size(kSizeClasses_)};
+  static inline constexpr usize kMaxSizeClass_{
+      kSizeClasses_[kSizeClassCount_ - 1]};
+  static inline constexpr usize kSpanSize_{32768};    // 32 KiB.
+  static inline constexpr usize kChunkSize_{262144};  // 256 KiB.
+  static inline constexpr Alignment kSpanAlignment_{64};
+
+  struct Span {
+    usize size_class_index{kInvalidIndex};
+    usize owner_index{kInvalidIndex};
+  };
+
+  struct Object {
+    // Never overwritten. Null for allocations forwarded to the platform.
+    Span* span{nullptr};
+    // Only set while the object is free.
+    Object* next{nullptr};
+  };
+
+  static inline constexpr usize kObjectHeaderSize_{sizeof(Span*)};
+
+  struct ThreadContext {
+    Object* free_objects[kSizeClassCount_]{};
+  };
+
+  using ThreadContexts = thread::FiberThreadProvider<ThreadContext>;
+
+  static usize ResolveSizeClass(usize size);
+  usize ResolveContextIndex() const;
+  usize GetSharedContextIndex() const noexcept;
+  ThreadContext& GetContext(usize context_index);
+  std::atomic<Object*>& GetRemoteObjects(usize context_index,
+                                         usize size_class_index);
+
+  Object* TryPopObject(usize size_class_index);
+  Object* PopObject(usize context_index, usize size_class_index);
+  Object* PopSpanObjects(usize size_class_index);
+  void PushObjects(usize context_index, usize size_class_index, Object* first,
+                   Object* last);
+  void PushRemoteObject(Object* object);
+  u8* ReserveMemory(usize size);
+
+  void* AllocateLarge(usize size, Alignment align);
+
+  MemoryTag memory_tag_{kEngineMemoryTagUntagged};
+  usize context_count_{0};
+  ThreadContexts thread_contexts_{thread::ThreadProviderManager::Get()
+                                      .AllocateFiberProvider<ThreadContext>()};
+  ThreadContext shared_context_{};
+  fiber::FiberSpinLock shared_context_lock_{};
+  // Per context and size class.
+  std::atomic<Object*>* remote_objects_{nullptr};
+  fiber::FiberSpinLock chunk_lock_{};
+  u8* chunk_cursor_{nullptr};
+  u8* chunk_end_{nullptr};
+};
+}  // namespace memory
+}  // namespace comet
+
+#endif  // COMET_COMET_CORE_MEMORY_ALLOCATOR_SIZE_CLASS_ALLOCATOR_H_
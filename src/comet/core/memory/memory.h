@@ -57,9 +57,11 @@ enum EngineMemoryTag : MemoryTag {
   kEngineMemoryTagResourceSceneExtended,
   kEngineMemoryTagTString,
   kEngineMemoryTagEntity,
+  kEngineMemoryTagEntityChunk,
   kEngineMemoryTagFiber,
   kEngineMemoryTagThreadProvider,
   kEngineMemoryTagEvent,
+  kEngineMemoryTagAnimation,
   kEngineMemoryTagDebug,
   kEngineMemoryTagMainThread,
   kEngineMemoryTagUserBase = kU32Max,
@@ -99,12 +99,16 @@ const schar* GetMemoryTagLabel(MemoryTag tag) {
       return "tstring";
     case kEngineMemoryTagEntity:
       return "entity";
+    case kEngineMemoryTagEntityChunk:
+      return "entity_chunk";
     case kEngineMemoryTagFiber:
       return "fiber";
     case kEngineMemoryTagThreadProvider:
       return "thread_provider";
     case kEngineMemoryTagEvent:
       return "event";
+    case kEngineMemoryTagAnimation:
+      return "animation";
     case kEngineMemoryTagDebug:
       return "debug";
     case kEngineMemoryTagMainThread:
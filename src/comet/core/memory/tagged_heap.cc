@@ -11,12 +11,14 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 // External. ///////////////////////////////////////////////////////////////////
+#include <bit>
 #include <new>
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "comet/core/memory/allocation_tracking.h"
 #include "comet/core/memory/memory_utils.h"
 #include "comet/core/memory/virtual_memory.h"
+#include "comet/math/math_common.h"
 
 namespace comet {
 namespace memory {
@@ -50,20 +52,44 @@ void TaggedHeap::Initialize() {
   COMET_ASSERT(memory_ != nullptr, "Failed to allocate memory!");
   COMET_REGISTER_TAGGED_HEAP_POOL_ALLOCATION(capacity_);
 
-  // Set the capacity for all bitsets (including the global one), with
+  block_word_count_ =
+      (total_block_count_ + kBlockWordBitCount_ - 1) / kBlockWordBitCount_;
+
+  // Set the capacity for the block map and the allocation lists, with
   // additional alignment overhead.
-  bitset_allocator_ = PlatformStackAllocator{
-      Bitset::GetWordCountFromBitCount(total_block_count_) *
-              sizeof(Bitset::Word) * (kMaxTagCount_ + 1) +
-          alignof(Bitset::Word),
+  block_map_allocator_ = PlatformStackAllocator{
+      block_word_count_ * sizeof(std::atomic<BlockWord>) +
+          total_block_count_ * sizeof(usize) * 2 +
+          alignof(std::atomic<BlockWord>) + alignof(usize) * 2,
       kEngineMemoryTagTaggedHeap};
-  bitset_allocator_.Initialize();
-  global_block_map_ = Bitset{&bitset_allocator_, total_block_count_};
+  block_map_allocator_.Initialize();
+  block_words_ =
+      block_map_allocator_.AllocateMany<std::atomic<BlockWord>>(
+          block_word_count_);
+  allocation_block_counts_ =
+      block_map_allocator_.AllocateMany<usize>(total_block_count_);
+  next_allocations_ =
+      block_map_allocator_.AllocateMany<usize>(total_block_count_);
+
+  for (usize i{0}; i < block_word_count_; ++i) {
+    new (&block_words_[i]) std::atomic<BlockWord>{0};
+  }
+
+  // Blocks past the capacity are marked as used, so that they are never
+  // claimed.
+  const auto tail_bit_count{total_block_count_ % kBlockWordBitCount_};
+
+  if (tail_bit_count != 0) {
+    block_words_[block_word_count_ - 1].store(
+        GenerateBlockMask(tail_bit_count,
+                          kBlockWordBitCount_ - tail_bit_count),
+        std::memory_order_relaxed);
+  }
 
-  for (auto& bucket : tag_block_maps_) {
+  for (auto& bucket : tag_block_lists_) {
     for (auto& entry : bucket) {
-      entry.block_map = Bitset{&bitset_allocator_, total_block_count_};
-      entry.tag = kEngineMemoryTagInvalid;
+      entry.tag.store(kEngineMemoryTagInvalid, std::memory_order_relaxed);
+      entry.head.store(kInvalidIndex, std::memory_order_relaxed);
     }
   }
 
@@ -74,17 +100,19 @@ void TaggedHeap::Destroy() {
   COMET_ASSERT(is_initialized_,
                "Tried to destroy tagged heap, but it is not initialized!");
 
-  global_block_map_.Destroy();
-
-  for (auto& bucket : tag_block_maps_) {
+  for (auto& bucket : tag_block_lists_) {
     for (auto& entry : bucket) {
-      entry.block_map.Destroy();
-      entry.tag = kEngineMemoryTagInvalid;
+      entry.tag.store(kEngineMemoryTagInvalid, std::memory_order_relaxed);
+      entry.head.store(kInvalidIndex, std::memory_order_relaxed);
     }
   }
 
-  // Free all bitsets at once.
-  bitset_allocator_.Destroy();
+  // Free the block map and the allocation lists at once.
+  block_map_allocator_.Destroy();
+  block_words_ = nullptr;
+  allocation_block_counts_ = nullptr;
+  next_allocations_ = nullptr;
+  block_word_count_ = 0;
 
   if (memory_ != nullptr) {
     FreeVirtualMemory(memory_, capacity_);
@@ -163,22 +191,21 @@ void* TaggedHeap::AllocateBlocksAligned(usize count, Alignment align,
 }
 
 void TaggedHeap::DeallocateAll(MemoryTag tag) {
-  {
-    fiber::FiberLockGuard lock{mutex_};
-    auto* block_map{FindOrAddTag(tag)};
+  auto* block_list{FindOrAddTag(tag)};
 
-    if (block_map == nullptr) {
-      return;
-    }
+  if (block_list == nullptr) {
+    return;
+  }
 
-    for (usize i{0}; i < total_block_count_; ++i) {
-      if (!block_map->block_map.Test(i)) {
-        continue;
-      }
+  // Detach the whole list: allocations made with the tag from now on are not
+  // affected.
+  auto index{block_list->head.exchange(kInvalidIndex,
+                                       std::memory_order_acq_rel)};
 
-      block_map->block_map.Reset(i);
-      global_block_map_.Reset(i);
-    }
+  while (index != kInvalidIndex) {
+    const auto next_index{next_allocations_[index]};
+    ReleaseBlocks(index, allocation_block_counts_[index]);
+    index = next_index;
   }
 
   COMET_REGISTER_TAGGED_HEAP_DEALLOCATION(tag);
@@ -194,63 +221,139 @@ void* TaggedHeap::AllocateInternal(usize size, MemoryTag tag,
                "Cannot allocate! No memory is available...");
   block_count = (size + block_size_ - 1) / block_size_;
   COMET_ASSERT(block_count <= total_block_count_, "Max capacity reached!");
-  usize free_blocks_index;
-
-  {
-    fiber::FiberLockGuard lock{mutex_};
-    free_blocks_index = ResolveFreeBlocks(block_count);
+  const auto free_blocks_index{ClaimFreeBlocks(block_count)};
 
-    if (free_blocks_index == kInvalidIndex) {
-      COMET_ASSERT(false,
-                   "No sufficient memory available for allocation with size ",
-                   size, " and tag ", GetMemoryTagLabel(tag), "!");
-      throw std::bad_alloc();
-    }
+  if (free_blocks_index == kInvalidIndex) {
+    COMET_ASSERT(false,
+                 "No sufficient memory available for allocation with size ",
+                 size, " and tag ", GetMemoryTagLabel(tag), "!");
+    throw std::bad_alloc();
+  }
 
-    auto* block_map{FindOrAddTag(tag)};
+  allocation_block_counts_[free_blocks_index] = block_count;
+  auto* block_list{FindOrAddTag(tag)};
+  auto head{block_list->head.load(std::memory_order_relaxed)};
 
-    for (usize i{0}; i < block_count; ++i) {
-      auto map_index{free_blocks_index + i};
-      global_block_map_.Set(map_index);
-      block_map->block_map.Set(map_index);
-    }
-  }
+  do {
+    next_allocations_[free_blocks_index] = head;
+  } while (!block_list->head.compare_exchange_weak(
+      head, free_blocks_index, std::memory_order_release,
+      std::memory_order_relaxed));
 
   auto* ptr{static_cast<u8*>(memory_) + free_blocks_index * block_size_};
   COMET_POISON(ptr, block_count * block_size_);
   return ptr;
 }
 
+TaggedHeap::BlockWord TaggedHeap::GenerateBlockMask(usize offset,
+                                                    usize count) {
+  const auto mask{count == kBlockWordBitCount_
+                      ? ~BlockWord{0}
+                      : (BlockWord{1} << count) - 1};
+  return mask << offset;
+}
+
+usize TaggedHeap::ClaimFreeBlocks(usize block_count) {
+  while (true) {
+    const auto index{ResolveFreeBlocks(block_count)};
+
+    if (index == kInvalidIndex || TryClaimBlocks(index, block_count)) {
+      return index;
+    }
+
+    // Case: another fiber claimed some of the blocks in the meantime.
+  }
+}
+
 usize TaggedHeap::ResolveFreeBlocks(usize block_count) const {
   usize contiguous_block_count{0};
+  usize i{0};
+
+  // Skip whole runs of used or free blocks at once.
+  while (i < total_block_count_) {
+    const auto offset{i % kBlockWordBitCount_};
+    const auto bit_count{kBlockWordBitCount_ - offset};
+    const auto word{
+        block_words_[i / kBlockWordBitCount_].load(std::memory_order_relaxed) >>
+        offset};
 
-  for (usize i{0}; i < total_block_count_; ++i) {
-    if (global_block_map_.Test(i)) {
+    if ((word & 1) != 0) {
       contiguous_block_count = 0;
+      i += static_cast<usize>(std::countr_one(word));
       continue;
     }
 
-    ++contiguous_block_count;
+    const auto free_count{
+        math::Min(static_cast<usize>(std::countr_zero(word)), bit_count)};
 
-    if (contiguous_block_count == block_count) {
-      return i - (block_count - 1);
+    if (contiguous_block_count + free_count >= block_count) {
+      return i - contiguous_block_count;
     }
+
+    contiguous_block_count += free_count;
+    i += free_count;
   }
 
   return kInvalidIndex;
 }
 
-TaggedHeap::TagBlockMap* TaggedHeap::FindOrAddTag(MemoryTag tag) {
+bool TaggedHeap::TryClaimBlocks(usize index, usize block_count) {
+  const auto end{index + block_count};
+  auto i{index};
+
+  while (i < end) {
+    const auto offset{i % kBlockWordBitCount_};
+    const auto count{math::Min(kBlockWordBitCount_ - offset, end - i)};
+    const auto mask{GenerateBlockMask(offset, count)};
+    auto& word{block_words_[i / kBlockWordBitCount_]};
+    auto expected{word.load(std::memory_order_relaxed)};
+
+    while ((expected & mask) == 0 &&
+           !word.compare_exchange_weak(expected, expected | mask,
+                                       std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+    }
+
+    if ((expected & mask) != 0) {
+      ReleaseBlocks(index, i - index);
+      return false;
+    }
+
+    i += count;
+  }
+
+  return true;
+}
+
+void TaggedHeap::ReleaseBlocks(usize index, usize block_count) {
+  const auto end{index + block_count};
+  auto i{index};
+
+  while (i < end) {
+    const auto offset{i % kBlockWordBitCount_};
+    const auto count{math::Min(kBlockWordBitCount_ - offset, end - i)};
+    block_words_[i / kBlockWordBitCount_].fetch_and(
+        ~GenerateBlockMask(offset, count), std::memory_order_release);
+    i += count;
+  }
+}
+
+TaggedHeap::TagBlockList* TaggedHeap::FindOrAddTag(MemoryTag tag) {
   auto bucket_index{static_cast<usize>(tag % kBucketCount_)};
-  auto& bucket{tag_block_maps_[bucket_index]};
+  auto& bucket{tag_block_lists_[bucket_index]};
 
   for (auto& entry : bucket) {
-    if (entry.tag == tag) {
+    auto entry_tag{entry.tag.load(std::memory_order_acquire)};
+
+    // On failure, the tag which has been added concurrently is loaded.
+    if (entry_tag == kEngineMemoryTagInvalid &&
+        entry.tag.compare_exchange_strong(entry_tag, tag,
+                                          std::memory_order_acq_rel,
+                                          std::memory_order_acquire)) {
       return &entry;
     }
 
-    if (entry.tag == kEngineMemoryTagInvalid) {
-      entry.tag = tag;
+    if (entry_tag == tag) {
       return &entry;
     }
   }
@@ -5,13 +5,15 @@
 #ifndef COMET_COMET_CORE_MEMORY_TAGGED_HEAP_H_
 #define COMET_COMET_CORE_MEMORY_TAGGED_HEAP_H_
 
-#include "comet/core/concurrency/fiber/fiber_primitive.h"
+// External. ///////////////////////////////////////////////////////////////////
+#include <atomic>
+////////////////////////////////////////////////////////////////////////////////
+
 #include "comet/core/conf/configuration_manager.h"
 #include "comet/core/conf/configuration_value.h"
 #include "comet/core/essentials.h"
 #include "comet/core/memory/allocator/platform_allocator.h"
 #include "comet/core/memory/memory.h"
-#include "comet/core/type/bitset.h"
 
 namespace comet {
 namespace memory {
@@ -22,6 +24,9 @@ struct TaggedHeapArena {
   u8 data{0};
 };
 
+// Blocks are claimed with atomic operations on the words of the block map, so
+// allocations do not share any lock. Allocations owned by a tag are chained
+// together, which makes releasing a tag proportional to its allocation count.
 class TaggedHeap {
  public:
   TaggedHeap() = default;
@@ -50,29 +55,45 @@ class TaggedHeap {
   usize GetBlockSize() const noexcept;
 
  private:
+  using BlockWord = u64;
+
   static inline constexpr usize kBucketCount_{100};
   static inline constexpr usize kTagsPerBucketCount_{10};
-  static inline constexpr usize kMaxTagCount_{kBucketCount_ *
-                                              kTagsPerBucketCount_};
+  static inline constexpr usize kBlockWordBitCount_{sizeof(BlockWord) *
+                                                    kCharBit};
 
-  struct TagBlockMap {
-    MemoryTag tag{kEngineMemoryTagUntagged};
-    Bitset block_map{};
+  static_assert(std::atomic<BlockWord>::is_always_lock_free,
+                "std::atomic<BlockWord> needs to be always lock-free. "
+                "Unsupported architecture");
+
+  struct TagBlockList {
+    std::atomic<MemoryTag> tag{kEngineMemoryTagInvalid};
+    // First block of the last allocation made with the tag.
+    std::atomic<usize> head{kInvalidIndex};
   };
 
+  static BlockWord GenerateBlockMask(usize offset, usize count);
+
   void* AllocateInternal(usize size, MemoryTag tag, usize& block_count);
+  usize ClaimFreeBlocks(usize block_count);
   usize ResolveFreeBlocks(usize block_count) const;
-  TagBlockMap* FindOrAddTag(MemoryTag tag);
+  bool TryClaimBlocks(usize index, usize block_count);
+  void ReleaseBlocks(usize index, usize block_count);
+  TagBlockList* FindOrAddTag(MemoryTag tag);
 
   bool is_initialized_{false};
   usize total_block_count_{0};
+  usize block_word_count_{0};
   usize block_size_{0};
   usize capacity_{COMET_CONF_U64(conf::kCoreTaggedHeapCapacity)};
   MemoryDescr memory_descr_{GetMemoryDescr()};
-  Bitset global_block_map_{};
-  TagBlockMap tag_block_maps_[kBucketCount_][kTagsPerBucketCount_]{};
-  PlatformStackAllocator bitset_allocator_{};
-  mutable fiber::FiberMutex mutex_{};
+  // One bit per block, set if the block is used.
+  std::atomic<BlockWord>* block_words_{nullptr};
+  // Only relevant for the first block of each allocation.
+  usize* allocation_block_counts_{nullptr};
+  usize* next_allocations_{nullptr};
+  TagBlockList tag_block_lists_[kBucketCount_][kTagsPerBucketCount_]{};
+  PlatformStackAllocator block_map_allocator_{};
   void* memory_{nullptr};
 };
 }  // namespace memory
@@ -20,21 +20,26 @@
 
 namespace comet {
 bool IsAVXSupported() {
+  // Kernels check this on every call: only query the CPU once.
+  static const auto is_supported{[]() {
 #ifdef COMET_MSVC
-  int cpu_info[4];
-  __cpuid(cpu_info, 1);
-  return (cpu_info[2] & (1 << 28)) != 0;
+    int cpu_info[4];
+    __cpuid(cpu_info, 1);
+    return (cpu_info[2] & (1 << 28)) != 0;
 #else
-  unsigned int eax;
-  unsigned int ebx;
-  unsigned int ecx;
-  unsigned int edx;
+    unsigned int eax;
+    unsigned int ebx;
+    unsigned int ecx;
+    unsigned int edx;
 
-  if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
-    return (ecx & bit_AVX) != 0;
-  }
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+      return (ecx & bit_AVX) != 0;
+    }
 
-  return false;
+    return false;
 #endif  // COMET_MSVC
+  }()};
+
+  return is_supported;
 }
 }  // namespace comet
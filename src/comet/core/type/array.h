@@ -201,7 +201,7 @@ class Array : public internal::BaseArray<T> {
 
   ~Array() { Destroy(); }
 
-  bool operator==(const Array& other) {
+  bool operator==(const Array& other) const {
     if (this->size_ != other.size_) {
       return false;
     }
@@ -215,7 +215,7 @@ class Array : public internal::BaseArray<T> {
     return true;
   }
 
-  bool operator!=(const Array& other) { return !operator=(other); }
+  bool operator!=(const Array& other) const { return !operator==(other); }
 
   void Destroy() {
     if (this->data_ != nullptr) {
@@ -0,0 +1,616 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+#ifndef COMET_COMET_CORE_TYPE_FLAT_HASH_SET_H_
+#define COMET_COMET_CORE_TYPE_FLAT_HASH_SET_H_
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <bit>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/essentials.h"
+#include "comet/core/hash.h"
+#include "comet/core/memory/allocator/allocator.h"
+#include "comet/core/memory/memory_utils.h"
+#include "comet/core/type/hash_set.h"
+#include "comet/core/type/traits.h"
+#include "comet/math/math_common.h"
+
+namespace comet {
+namespace internal {
+// Each slot of a flat hash set has a control byte: full slots store the 7 low
+// bits of their hash, and empty and deleted slots have their sign bit set.
+using FlatControl = s8;
+constexpr FlatControl kFlatControlEmpty{-128};
+constexpr FlatControl kFlatControlDeleted{-2};
+
+constexpr usize kFlatGroupWidth{16};
+using FlatGroupMask = u32;
+
+// Control bytes are scanned by groups, in one instruction when SSE2 is
+// available.
+class FlatGroup {
+ public:
+  explicit FlatGroup(const FlatControl* controls) noexcept
+#ifdef COMET_ARCH_X86
+      : controls_{_mm_load_si128(reinterpret_cast<const __m128i*>(controls))} {
+  }
+#else
+      : controls_{controls} {
+  }
+#endif  // COMET_ARCH_X86
+
+  FlatGroupMask Match(FlatControl control) const noexcept {
+#ifdef COMET_ARCH_X86
+    return static_cast<FlatGroupMask>(_mm_movemask_epi8(
+        _mm_cmpeq_epi8(_mm_set1_epi8(control), controls_)));
+#else
+    FlatGroupMask mask{0};
+
+    for (usize i{0}; i < kFlatGroupWidth; ++i) {
+      mask |= static_cast<FlatGroupMask>(controls_[i] == control) << i;
+    }
+
+    return mask;
+#endif  // COMET_ARCH_X86
+  }
+
+  FlatGroupMask MatchEmpty() const noexcept {
+    return Match(kFlatControlEmpty);
+  }
+
+  FlatGroupMask MatchEmptyOrDeleted() const noexcept {
+#ifdef COMET_ARCH_X86
+    return static_cast<FlatGroupMask>(_mm_movemask_epi8(controls_));
+#else
+    FlatGroupMask mask{0};
+
+    for (usize i{0}; i < kFlatGroupWidth; ++i) {
+      mask |= static_cast<FlatGroupMask>(controls_[i] < 0) << i;
+    }
+
+    return mask;
+#endif  // COMET_ARCH_X86
+  }
+
+ private:
+#ifdef COMET_ARCH_X86
+  __m128i controls_;
+#else
+  const FlatControl* controls_;
+#endif  // COMET_ARCH_X86
+};
+
+// Spreads the hash over all the bits, since hashes of integers are the
+// integers themselves.
+inline u64 MixFlatHash(HashValue hash) noexcept {
+  return static_cast<u64>(hash) * 0x9e3779b97f4a7c15;
+}
+
+inline usize GetFlatGroupHash(u64 mixed_hash) noexcept {
+  return static_cast<usize>(mixed_hash >> 32);
+}
+
+inline FlatControl GetFlatControlHash(u64 mixed_hash) noexcept {
+  return static_cast<FlatControl>((mixed_hash >> 25) & 0x7f);
+}
+}  // namespace internal
+
+// Open-addressing hash set, in the fashion of Swiss tables. Entries are
+// stored in a single allocation, along with a control byte per slot, which
+// allows most lookups to only compare entries whose hashes partially match.
+// Capacity is always a power of 2, and deleted slots are marked with
+// tombstones, which are discarded when the set is rehashed.
+template <typename T, typename HashLogic = internal::DefaultSetHashLogic<T>>
+class FlatHashSet {
+ public:
+  using Hashable = typename HashLogic::Hashable;
+
+  template <bool IsConst>
+  class IteratorImpl {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using pointer = std::conditional_t<IsConst, const T*, T*>;
+    using reference = std::conditional_t<IsConst, const T&, T&>;
+
+    IteratorImpl() = default;
+
+    IteratorImpl(const internal::FlatControl* control,
+                 const internal::FlatControl* control_end, pointer slot)
+        : control_{control}, control_end_{control_end}, slot_{slot} {
+      SkipFreeSlots();
+    }
+
+    reference operator*() const noexcept { return *slot_; }
+
+    pointer operator->() const noexcept { return slot_; }
+
+    IteratorImpl& operator++() {
+      ++control_;
+      ++slot_;
+      SkipFreeSlots();
+      return *this;
+    }
+
+    IteratorImpl operator++(int) {
+      auto tmp{*this};
+      ++(*this);
+      return tmp;
+    }
+
+    bool operator==(const IteratorImpl& other) const noexcept {
+      return control_ == other.control_;
+    }
+
+    bool operator!=(const IteratorImpl& other) const noexcept {
+      return !(*this == other);
+    }
+
+   private:
+    const internal::FlatControl* control_{nullptr};
+    const internal::FlatControl* control_end_{nullptr};
+    pointer slot_{nullptr};
+
+    void SkipFreeSlots() {
+      while (control_ != control_end_ && *control_ < 0) {
+        ++control_;
+        ++slot_;
+      }
+    }
+  };
+
+  using Iterator = IteratorImpl<false>;
+  using ConstIterator = IteratorImpl<true>;
+
+  Iterator begin() {
+    return Iterator{controls_, controls_ + capacity_, slots_};
+  }
+
+  Iterator end() {
+    return Iterator{controls_ + capacity_, controls_ + capacity_,
+                    slots_ + capacity_};
+  }
+
+  ConstIterator begin() const {
+    return ConstIterator{controls_, controls_ + capacity_, slots_};
+  }
+
+  ConstIterator end() const {
+    return ConstIterator{controls_ + capacity_, controls_ + capacity_,
+                         slots_ + capacity_};
+  }
+
+  ConstIterator cbegin() const { return begin(); }
+  ConstIterator cend() const { return end(); }
+
+  static inline constexpr usize kDefaultObjCount{16};
+
+  FlatHashSet() = default;
+
+  FlatHashSet(memory::Allocator* allocator,
+              usize default_obj_count = kDefaultObjCount)
+      : allocator_{allocator} {
+    if (default_obj_count == 0) {
+      return;
+    }
+
+    Reserve(default_obj_count);
+  }
+
+  FlatHashSet(const FlatHashSet& other) : allocator_{other.allocator_} {
+    CopyFrom(other);
+  }
+
+  FlatHashSet(FlatHashSet&& other) noexcept
+      : capacity_{other.capacity_},
+        entry_count_{other.entry_count_},
+        growth_left_{other.growth_left_},
+        controls_{other.controls_},
+        slots_{other.slots_},
+        allocator_{other.allocator_} {
+    other.capacity_ = 0;
+    other.entry_count_ = 0;
+    other.growth_left_ = 0;
+    other.controls_ = nullptr;
+    other.slots_ = nullptr;
+    other.allocator_ = nullptr;
+  }
+
+  ~FlatHashSet() { Destroy(); }
+
+  FlatHashSet& operator=(const FlatHashSet& other) {
+    if (this == &other) {
+      return *this;
+    }
+
+    Destroy();
+    allocator_ = other.allocator_;
+    CopyFrom(other);
+    return *this;
+  }
+
+  FlatHashSet& operator=(FlatHashSet&& other) noexcept {
+    if (this == &other) {
+      return *this;
+    }
+
+    Destroy();
+    capacity_ = other.capacity_;
+    entry_count_ = other.entry_count_;
+    growth_left_ = other.growth_left_;
+    controls_ = other.controls_;
+    slots_ = other.slots_;
+    allocator_ = other.allocator_;
+
+    other.capacity_ = 0;
+    other.entry_count_ = 0;
+    other.growth_left_ = 0;
+    other.controls_ = nullptr;
+    other.slots_ = nullptr;
+    other.allocator_ = nullptr;
+    return *this;
+  }
+
+  bool operator==(const FlatHashSet& other) const {
+    if (entry_count_ != other.entry_count_) {
+      return false;
+    }
+
+    for (const auto& entry : *this) {
+      if (!other.IsContained(HashLogic::GetHashable(entry))) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  bool operator!=(const FlatHashSet& other) const { return !(*this == other); }
+
+  void Destroy() {
+    DestroyEntries();
+
+    if (controls_ != nullptr) {
+      allocator_->Deallocate(controls_);
+    }
+
+    capacity_ = 0;
+    entry_count_ = 0;
+    growth_left_ = 0;
+    controls_ = nullptr;
+    slots_ = nullptr;
+  }
+
+  template <typename V>
+  void Add(V&& obj) {
+    const auto& hashable{HashLogic::GetHashable(obj)};
+    const auto mixed_hash{internal::MixFlatHash(HashLogic::Hash(hashable))};
+
+    if (FindIndex(hashable, mixed_hash) != kInvalidIndex) {
+      return;
+    }
+
+    // Inserting might rehash: resolve the index first.
+    const auto new_index{PrepareInsert(mixed_hash)};
+    new (&slots_[new_index]) T{std::forward<V>(obj)};
+  }
+
+  template <typename V>
+  void Set(V&& obj) {
+    const auto& hashable{HashLogic::GetHashable(obj)};
+    const auto mixed_hash{internal::MixFlatHash(HashLogic::Hash(hashable))};
+    const auto index{FindIndex(hashable, mixed_hash)};
+
+    if (index != kInvalidIndex) {
+      slots_[index] = std::forward<V>(obj);
+      return;
+    }
+
+    // Inserting might rehash: resolve the index first.
+    const auto new_index{PrepareInsert(mixed_hash)};
+    new (&slots_[new_index]) T{std::forward<V>(obj)};
+  }
+
+  template <typename... Targs>
+  T& Emplace(Targs&&... args) {
+    T obj{std::forward<Targs>(args)...};
+    const auto& hashable{HashLogic::GetHashable(obj)};
+    const auto mixed_hash{internal::MixFlatHash(HashLogic::Hash(hashable))};
+    auto index{FindIndex(hashable, mixed_hash)};
+
+    if (index != kInvalidIndex) {
+      return slots_[index];
+    }
+
+    index = PrepareInsert(mixed_hash);
+    return *new (&slots_[index]) T{std::move(obj)};
+  }
+
+  bool Remove(const Hashable& hashable) {
+    const auto index{FindIndex(hashable)};
+
+    if (index == kInvalidIndex) {
+      return false;
+    }
+
+    Erase(index);
+    return true;
+  }
+
+  template <typename Predicate>
+  usize RemoveIf(Predicate&& predicate) {
+    usize removed_count{0};
+
+    for (usize i{0}; i < capacity_; ++i) {
+      if (controls_[i] >= 0 && predicate(slots_[i])) {
+        Erase(i);
+        ++removed_count;
+      }
+    }
+
+    return removed_count;
+  }
+
+  void Clear() {
+    DestroyEntries();
+
+    if (capacity_ == 0) {
+      return;
+    }
+
+    memory::Memset(controls_, kFlatControlEmpty_, capacity_);
+    entry_count_ = 0;
+    growth_left_ = GetMaxEntryCount(capacity_);
+  }
+
+  T* Find(const Hashable& hashable) {
+    const auto index{FindIndex(hashable)};
+    return index != kInvalidIndex ? &slots_[index] : nullptr;
+  }
+
+  const T* Find(const Hashable& hashable) const {
+    const auto index{FindIndex(hashable)};
+    return index != kInvalidIndex ? &slots_[index] : nullptr;
+  }
+
+  T Pop(const Hashable& hashable) {
+    const auto index{FindIndex(hashable)};
+    COMET_ASSERT(index != kInvalidIndex, "Value not found in FlatHashSet!");
+    T popped{std::move(slots_[index])};
+    Erase(index);
+    return popped;
+  }
+
+  void Reserve(usize entry_count) {
+    auto capacity{math::Max(capacity_, kMinCapacity_)};
+
+    while (GetMaxEntryCount(capacity) < entry_count) {
+      capacity *= 2;
+    }
+
+    if (capacity == capacity_) {
+      return;
+    }
+
+    Rehash(capacity);
+  }
+
+  bool IsContained(const Hashable& hashable) const {
+    return FindIndex(hashable) != kInvalidIndex;
+  }
+
+  usize GetEntryCount() const noexcept { return entry_count_; }
+
+  usize GetCapacity() const noexcept { return capacity_; }
+
+  bool IsEmpty() const noexcept { return entry_count_ == 0; }
+
+ private:
+  static inline constexpr usize kMinCapacity_{internal::kFlatGroupWidth};
+  static inline constexpr u8 kFlatControlEmpty_{
+      static_cast<u8>(internal::kFlatControlEmpty)};
+
+  // Max load factor is 7/8.
+  static usize GetMaxEntryCount(usize capacity) noexcept {
+    return capacity - capacity / 8;
+  }
+
+  usize GetGroupMask() const noexcept {
+    return capacity_ / internal::kFlatGroupWidth - 1;
+  }
+
+  usize FindIndex(const Hashable& hashable) const {
+    return FindIndex(hashable,
+                     internal::MixFlatHash(HashLogic::Hash(hashable)));
+  }
+
+  usize FindIndex(const Hashable& hashable, u64 mixed_hash) const {
+    if (capacity_ == 0) {
+      return kInvalidIndex;
+    }
+
+    const auto control{internal::GetFlatControlHash(mixed_hash)};
+    const auto group_mask{GetGroupMask()};
+    auto group_index{internal::GetFlatGroupHash(mixed_hash) & group_mask};
+
+    // Triangular probing visits every group, since their count is a power
+    // of 2.
+    for (usize probe_count{1};; ++probe_count) {
+      const auto offset{group_index * internal::kFlatGroupWidth};
+      const internal::FlatGroup group{controls_ + offset};
+
+      for (auto mask{group.Match(control)}; mask != 0; mask &= mask - 1) {
+        const auto index{offset + static_cast<usize>(std::countr_zero(mask))};
+
+        if (HashLogic::AreEqual(HashLogic::GetHashable(slots_[index]),
+                                hashable)) {
+          return index;
+        }
+      }
+
+      // An empty slot would have ended the probing of the entry on insertion.
+      if (group.MatchEmpty() != 0) {
+        return kInvalidIndex;
+      }
+
+      group_index = (group_index + probe_count) & group_mask;
+    }
+  }
+
+  usize FindFreeIndex(u64 mixed_hash) const {
+    const auto group_mask{GetGroupMask()};
+    auto group_index{internal::GetFlatGroupHash(mixed_hash) & group_mask};
+
+    for (usize probe_count{1};; ++probe_count) {
+      const auto offset{group_index * internal::kFlatGroupWidth};
+      const auto mask{
+          internal::FlatGroup{controls_ + offset}.MatchEmptyOrDeleted()};
+
+      if (mask != 0) {
+        return offset + static_cast<usize>(std::countr_zero(mask));
+      }
+
+      group_index = (group_index + probe_count) & group_mask;
+    }
+  }
+
+  // Returns the index of an uninitialized slot, marked as full.
+  usize PrepareInsert(u64 mixed_hash) {
+    if (growth_left_ == 0) {
+      Grow();
+    }
+
+    const auto index{FindFreeIndex(mixed_hash)};
+
+    if (controls_[index] == internal::kFlatControlEmpty) {
+      --growth_left_;
+    }
+
+    controls_[index] = internal::GetFlatControlHash(mixed_hash);
+    ++entry_count_;
+    return index;
+  }
+
+  void Erase(usize index) {
+    slots_[index].~T();
+    --entry_count_;
+
+    // If the group still has an empty slot, no probing has ever gone past it:
+    // the slot can be freed right away.
+    const auto offset{index & ~(internal::kFlatGroupWidth - 1)};
+
+    if (internal::FlatGroup{controls_ + offset}.MatchEmpty() != 0) {
+      controls_[index] = internal::kFlatControlEmpty;
+      ++growth_left_;
+      return;
+    }
+
+    controls_[index] = internal::kFlatControlDeleted;
+  }
+
+  void Grow() {
+    if (capacity_ == 0) {
+      Rehash(kMinCapacity_);
+      return;
+    }
+
+    // Case: most of the free slots are tombstones. Discard them instead.
+    if (entry_count_ * 2 <= GetMaxEntryCount(capacity_)) {
+      Rehash(capacity_);
+      return;
+    }
+
+    Rehash(capacity_ * 2);
+  }
+
+  void Allocate(usize capacity) {
+    COMET_ASSERT(allocator_ != nullptr, "FlatHashSet has no allocator!");
+    const auto slots_offset{memory::AlignSize(capacity, alignof(T))};
+    auto* memory{static_cast<u8*>(allocator_->AllocateAligned(
+        slots_offset + capacity * sizeof(T),
+        math::Max(alignof(T), internal::kFlatGroupWidth)))};
+
+    controls_ = reinterpret_cast<internal::FlatControl*>(memory);
+    slots_ = reinterpret_cast<T*>(memory + slots_offset);
+    capacity_ = capacity;
+    memory::Memset(controls_, kFlatControlEmpty_, capacity_);
+  }
+
+  void Rehash(usize capacity) {
+    auto* old_controls{controls_};
+    auto* old_slots{slots_};
+    const auto old_capacity{capacity_};
+    Allocate(capacity);
+    growth_left_ = GetMaxEntryCount(capacity_) - entry_count_;
+
+    for (usize i{0}; i < old_capacity; ++i) {
+      if (old_controls[i] < 0) {
+        continue;
+      }
+
+      auto& obj{old_slots[i]};
+      const auto mixed_hash{
+          internal::MixFlatHash(HashLogic::Hash(HashLogic::GetHashable(obj)))};
+      const auto index{FindFreeIndex(mixed_hash)};
+      controls_[index] = internal::GetFlatControlHash(mixed_hash);
+
+      if constexpr (std::is_move_constructible_v<T>) {
+        new (&slots_[index]) T{std::move(obj)};
+      } else if constexpr (std::is_copy_constructible_v<T>) {
+        new (&slots_[index]) T{obj};
+      } else {
+        static_assert(always_false_v<T>,
+                      "Object type must be moveable or copyable!");
+      }
+
+      obj.~T();
+    }
+
+    if (old_controls != nullptr) {
+      allocator_->Deallocate(old_controls);
+    }
+  }
+
+  void CopyFrom(const FlatHashSet& other) {
+    if (other.capacity_ == 0) {
+      return;
+    }
+
+    Allocate(other.capacity_);
+    memory::CopyMemory(controls_, other.controls_, capacity_);
+    entry_count_ = other.entry_count_;
+    growth_left_ = other.growth_left_;
+
+    for (usize i{0}; i < capacity_; ++i) {
+      if (controls_[i] >= 0) {
+        new (&slots_[i]) T{other.slots_[i]};
+      }
+    }
+  }
+
+  void DestroyEntries() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (usize i{0}; i < capacity_; ++i) {
+        if (controls_[i] >= 0) {
+          slots_[i].~T();
+        }
+      }
+    }
+  }
+
+  usize capacity_{0};
+  usize entry_count_{0};
+  usize growth_left_{0};
+  internal::FlatControl* controls_{nullptr};
+  T* slots_{nullptr};
+  memory::Allocator* allocator_{nullptr};
+};
+}  // namespace comet
+
+#endif  // COMET_COMET_CORE_TYPE_FLAT_HASH_SET_H_
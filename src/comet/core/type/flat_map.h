@@ -0,0 +1,176 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+#ifndef COMET_COMET_CORE_TYPE_FLAT_MAP_H_
+#define COMET_COMET_CORE_TYPE_FLAT_MAP_H_
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/essentials.h"
+#include "comet/core/memory/allocator/allocator.h"
+#include "comet/core/type/flat_hash_set.h"
+#include "comet/core/type/map.h"
+
+namespace comet {
+// Same interface as Map, backed by a flat hash set. Pointers to values are
+// invalidated when the map grows.
+template <typename Key, typename Value,
+          typename HashLogic = internal::DefaultMapHashLogic<Key, Value>>
+class FlatMap {
+ public:
+  using KVPair = Pair<Key, Value>;
+  using Pairs = FlatHashSet<KVPair, HashLogic>;
+
+  using Iterator = typename Pairs::Iterator;
+  using ConstIterator = typename Pairs::ConstIterator;
+
+  Iterator begin() { return pairs_.begin(); }
+  Iterator end() { return pairs_.end(); }
+  ConstIterator begin() const { return pairs_.begin(); }
+  ConstIterator end() const { return pairs_.end(); }
+  ConstIterator cbegin() const { return pairs_.cbegin(); }
+  ConstIterator cend() const { return pairs_.cend(); }
+
+  static inline constexpr usize kDefaultCapacity{16};
+
+  FlatMap() = default;
+
+  FlatMap(memory::Allocator* allocator)
+      : FlatMap(allocator, allocator != nullptr ? kDefaultCapacity : 0) {}
+
+  FlatMap(memory::Allocator* allocator, usize capacity)
+      : pairs_{allocator, capacity}, allocator_{allocator} {}
+
+  FlatMap(const FlatMap& other)
+      : pairs_{other.pairs_}, allocator_{other.allocator_} {}
+
+  FlatMap(FlatMap&& other) noexcept
+      : pairs_{std::move(other.pairs_)}, allocator_{other.allocator_} {
+    other.allocator_ = nullptr;
+  }
+
+  FlatMap& operator=(const FlatMap& other) {
+    if (this == &other) {
+      return *this;
+    }
+
+    pairs_ = other.pairs_;
+    allocator_ = other.allocator_;
+    return *this;
+  }
+
+  FlatMap& operator=(FlatMap&& other) noexcept {
+    if (this == &other) {
+      return *this;
+    }
+
+    pairs_ = std::move(other.pairs_);
+    allocator_ = other.allocator_;
+
+    other.allocator_ = nullptr;
+    return *this;
+  }
+
+  ~FlatMap() { Destroy(); }
+
+  void Destroy() { pairs_.Destroy(); }
+
+  Value& operator[](const Key& key) { return Get(key); }
+
+  bool operator==(const FlatMap& other) const {
+    return pairs_ == other.pairs_;
+  }
+
+  bool operator!=(const FlatMap& other) const { return !(*this == other); }
+
+  Value& Get(const Key& key) {
+    auto* value = TryGet(key);
+
+    if (value != nullptr) {
+      return *value;
+    }
+
+    if constexpr (std::is_constructible_v<Value, memory::Allocator*>) {
+      auto& new_pair{pairs_.Emplace(KVPair{key, Value(allocator_)})};
+      return new_pair.value;
+    } else if constexpr (std::is_default_constructible_v<Value>) {
+      auto& new_pair{pairs_.Emplace(KVPair{key, Value{}})};
+      return new_pair.value;
+    } else {
+      COMET_ASSERT(false,
+                   "Key not found and value is not default-constructible.");
+      throw std::runtime_error(
+          "Key not found and value is not default-constructible.");
+    }
+  }
+
+  const Value& Get(const Key& key) const {
+    auto* value = TryGet(key);
+    COMET_ASSERT(value != nullptr, "No value found!");
+    return *value;
+  }
+
+  Value* TryGet(const Key& key) {
+    auto* pair{pairs_.Find(key)};
+    return pair ? &pair->value : nullptr;
+  }
+
+  const Value* TryGet(const Key& key) const {
+    const auto* pair{pairs_.Find(key)};
+    return pair ? &pair->value : nullptr;
+  }
+
+  template <typename K, typename V>
+  void Set(K&& key, V&& value) {
+    pairs_.Set(KVPair{std::forward<K>(key), std::forward<V>(value)});
+  }
+
+  template <typename P>
+  void Set(P&& pair) {
+    pairs_.Set(std::forward<P>(pair));
+  }
+
+  template <typename K, typename... Targs>
+  KVPair& Emplace(K&& key, Targs&&... args) {
+    return pairs_.Emplace(
+        KVPair{std::forward<K>(key), Value{std::forward<Targs>(args)...}});
+  }
+
+  bool Remove(const Key& key) { return pairs_.Remove(key); }
+
+  template <typename Predicate>
+  usize RemoveIf(Predicate&& predicate) {
+    return pairs_.RemoveIf([&predicate](const KVPair& pair) {
+      return predicate(HashLogic::GetHashable(pair), pair.value);
+    });
+  }
+
+  Value Pop(const Key& key) {
+    auto pair{pairs_.Pop(key)};
+    return std::move(pair.value);
+  }
+
+  void Clear() { pairs_.Clear(); }
+
+  bool IsContained(const Key& key) const { return pairs_.IsContained(key); }
+
+  void Reserve(usize capacity) { pairs_.Reserve(capacity); }
+
+  usize GetEntryCount() const noexcept { return pairs_.GetEntryCount(); }
+
+  usize GetCapacity() const noexcept { return pairs_.GetCapacity(); }
+
+  bool IsEmpty() const noexcept { return pairs_.IsEmpty(); }
+
+ private:
+  Pairs pairs_{};
+  memory::Allocator* allocator_{nullptr};
+};
+}  // namespace comet
+
+#endif  // COMET_COMET_CORE_TYPE_FLAT_MAP_H_
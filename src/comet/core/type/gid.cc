@@ -29,14 +29,12 @@ void DestroyGids() { internal::IdGenerationAllocator::Get().Destroy(); }
 
 namespace internal {
 memory::StatefulAllocator& IdGenerationAllocator::Get() {
-  static IdGenerationAllocator singleton{512};
+  static IdGenerationAllocator singleton{};
   return singleton;
 }
 
-IdGenerationAllocator::IdGenerationAllocator(usize base_capacity)
-    : allocator_{sizeof(IdGeneration),
-                 base_capacity / sizeof(IdGeneration) + sizeof(IdGeneration),
-                 memory::kEngineMemoryTagGid} {}
+IdGenerationAllocator::IdGenerationAllocator()
+    : allocator_{memory::kEngineMemoryTagGid} {}
 
 IdGenerationAllocator::IdGenerationAllocator(
     IdGenerationAllocator&& other) noexcept
@@ -10,7 +10,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "comet/core/essentials.h"
-#include "comet/core/memory/allocator/free_list_allocator.h"
+#include "comet/core/memory/allocator/size_class_allocator.h"
 #include "comet/core/memory/allocator/stateful_allocator.h"
 #include "comet/core/type/array.h"
 
@@ -43,8 +43,7 @@ class IdGenerationAllocator : public memory::StatefulAllocator {
  public:
   static memory::StatefulAllocator& Get();
 
-  IdGenerationAllocator() = default;
-  explicit IdGenerationAllocator(usize base_capacity);
+  IdGenerationAllocator();
   IdGenerationAllocator(const IdGenerationAllocator&) = delete;
   IdGenerationAllocator(IdGenerationAllocator&& other) noexcept;
   IdGenerationAllocator& operator=(const IdGenerationAllocator&) = delete;
@@ -58,7 +57,7 @@ class IdGenerationAllocator : public memory::StatefulAllocator {
   void Deallocate(void* ptr) override;
 
  private:
-  memory::FiberFreeListAllocator allocator_{};
+  memory::FiberSizeClassAllocator allocator_{};
 };
 }  // namespace internal
 
@@ -0,0 +1,231 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+#ifndef COMET_COMET_CORE_TYPE_WORK_STEALING_DEQUE_H_
+#define COMET_COMET_CORE_TYPE_WORK_STEALING_DEQUE_H_
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <atomic>
+#include <optional>
+#include <type_traits>
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/essentials.h"
+#include "comet/core/memory/allocator/allocator.h"
+
+namespace comet {
+// Bounded Chase-Lev deque. Only the owner may call TryPush() and TryPop(),
+// which operate on the bottom end (LIFO). Any other thread may call
+// TrySteal(), which operates on the top end (FIFO).
+// https://fzn.fr/readings/ppopp13.pdf
+template <class T>
+class LockFreeWorkStealingDeque {
+  static_assert(std::atomic<ssize>::is_always_lock_free,
+                "std::atomic<ssize> needs to be always lock-free. Unsupported "
+                "architecture");
+  // Thieves may read an element which is being concurrently overwritten. The
+  // copy is discarded when their CAS fails, which is only safe for trivial
+  // types.
+  static_assert(std::is_trivially_copyable_v<T>,
+                "T must be trivially copyable!");
+
+ public:
+  LockFreeWorkStealingDeque() = default;
+  LockFreeWorkStealingDeque(memory::Allocator* allocator, usize capacity);
+  LockFreeWorkStealingDeque(const LockFreeWorkStealingDeque&) = delete;
+  LockFreeWorkStealingDeque(LockFreeWorkStealingDeque&& other) noexcept;
+  LockFreeWorkStealingDeque& operator=(const LockFreeWorkStealingDeque&) =
+      delete;
+  LockFreeWorkStealingDeque& operator=(
+      LockFreeWorkStealingDeque&& other) noexcept;
+  ~LockFreeWorkStealingDeque();
+
+  void Destroy();
+
+  bool TryPush(const T& element);
+  std::optional<T> TryPop();
+  std::optional<T> TrySteal();
+
+  usize GetCapacity() const noexcept;
+  usize GetSize() const noexcept;
+  bool IsEmpty() const noexcept;
+
+ private:
+  constexpr static auto kCachelineSize_{64};
+  using CachelinePad = u8[kCachelineSize_];
+
+  CachelinePad pad0_{};
+  std::atomic<ssize> top_{0};
+  CachelinePad pad1_{};
+  std::atomic<ssize> bottom_{0};
+  CachelinePad pad2_{};
+  T* elements_{nullptr};
+  usize mask_{0};
+  usize capacity_{0};
+  memory::Allocator* allocator_{nullptr};
+};
+
+template <class T>
+inline LockFreeWorkStealingDeque<T>::LockFreeWorkStealingDeque(
+    memory::Allocator* allocator, usize capacity)
+    : elements_{static_cast<T*>(
+          allocator->AllocateAligned(capacity * sizeof(T), alignof(T)))},
+      mask_{capacity - 1},
+      capacity_{capacity},
+      allocator_{allocator} {
+  COMET_ASSERT(this->capacity_ >= 2,
+               "Capacity needs to be at least 2: ", this->capacity_, "!");
+  COMET_ASSERT((this->capacity_ & (this->capacity_ - 1)) == 0,
+               "Capacity must be a power of 2: ", this->capacity_, "!");
+}
+
+template <class T>
+inline LockFreeWorkStealingDeque<T>::LockFreeWorkStealingDeque(
+    LockFreeWorkStealingDeque<T>&& other) noexcept
+    : top_{other.top_.load(std::memory_order_acquire)},
+      bottom_{other.bottom_.load(std::memory_order_acquire)},
+      elements_{other.elements_},
+      mask_{other.mask_},
+      capacity_{other.capacity_},
+      allocator_{other.allocator_} {
+  other.top_.store(0, std::memory_order_relaxed);
+  other.bottom_.store(0, std::memory_order_relaxed);
+  other.elements_ = nullptr;
+  other.mask_ = 0;
+  other.capacity_ = 0;
+  other.allocator_ = nullptr;
+}
+
+template <class T>
+inline LockFreeWorkStealingDeque<T>& LockFreeWorkStealingDeque<T>::operator=(
+    LockFreeWorkStealingDeque<T>&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+
+  Destroy();
+
+  this->top_.store(other.top_.load(std::memory_order_acquire),
+                   std::memory_order_relaxed);
+  this->bottom_.store(other.bottom_.load(std::memory_order_acquire),
+                      std::memory_order_relaxed);
+  this->elements_ = other.elements_;
+  this->mask_ = other.mask_;
+  this->capacity_ = other.capacity_;
+  this->allocator_ = other.allocator_;
+
+  other.top_.store(0, std::memory_order_relaxed);
+  other.bottom_.store(0, std::memory_order_relaxed);
+  other.elements_ = nullptr;
+  other.mask_ = 0;
+  other.capacity_ = 0;
+  other.allocator_ = nullptr;
+  return *this;
+}
+
+template <class T>
+inline LockFreeWorkStealingDeque<T>::~LockFreeWorkStealingDeque() {
+  Destroy();
+}
+
+template <class T>
+inline void LockFreeWorkStealingDeque<T>::Destroy() {
+  if (this->elements_ != nullptr) {
+    this->allocator_->Deallocate(this->elements_);
+    this->elements_ = nullptr;
+  }
+
+  this->top_.store(0, std::memory_order_relaxed);
+  this->bottom_.store(0, std::memory_order_relaxed);
+}
+
+template <class T>
+inline bool LockFreeWorkStealingDeque<T>::TryPush(const T& element) {
+  auto bottom{this->bottom_.load(std::memory_order_relaxed)};
+  auto top{this->top_.load(std::memory_order_acquire)};
+
+  if (bottom - top >= static_cast<ssize>(this->capacity_)) {
+    // Case: deque is full.
+    return false;
+  }
+
+  this->elements_[static_cast<usize>(bottom) & this->mask_] = element;
+  std::atomic_thread_fence(std::memory_order_release);
+  this->bottom_.store(bottom + 1, std::memory_order_relaxed);
+  return true;
+}
+
+template <class T>
+inline std::optional<T> LockFreeWorkStealingDeque<T>::TryPop() {
+  auto bottom{this->bottom_.load(std::memory_order_relaxed) - 1};
+  this->bottom_.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto top{this->top_.load(std::memory_order_relaxed)};
+
+  if (top > bottom) {
+    // Case: deque is empty.
+    this->bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return std::nullopt;
+  }
+
+  auto element{this->elements_[static_cast<usize>(bottom) & this->mask_]};
+
+  if (top != bottom) {
+    return element;
+  }
+
+  // Case: last element. Race against thieves.
+  auto is_won{this->top_.compare_exchange_strong(top, top + 1,
+                                                 std::memory_order_seq_cst,
+                                                 std::memory_order_relaxed)};
+  this->bottom_.store(bottom + 1, std::memory_order_relaxed);
+
+  if (!is_won) {
+    return std::nullopt;
+  }
+
+  return element;
+}
+
+template <class T>
+inline std::optional<T> LockFreeWorkStealingDeque<T>::TrySteal() {
+  auto top{this->top_.load(std::memory_order_acquire)};
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto bottom{this->bottom_.load(std::memory_order_acquire)};
+
+  if (top >= bottom) {
+    return std::nullopt;
+  }
+
+  auto element{this->elements_[static_cast<usize>(top) & this->mask_]};
+
+  if (!this->top_.compare_exchange_strong(top, top + 1,
+                                          std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+    // Case: another thief or the owner took it first.
+    return std::nullopt;
+  }
+
+  return element;
+}
+
+template <class T>
+inline usize LockFreeWorkStealingDeque<T>::GetCapacity() const noexcept {
+  return this->capacity_;
+}
+
+template <class T>
+inline usize LockFreeWorkStealingDeque<T>::GetSize() const noexcept {
+  auto bottom{this->bottom_.load(std::memory_order_relaxed)};
+  auto top{this->top_.load(std::memory_order_relaxed)};
+  return bottom > top ? static_cast<usize>(bottom - top) : 0;
+}
+
+template <class T>
+inline bool LockFreeWorkStealingDeque<T>::IsEmpty() const noexcept {
+  return GetSize() == 0;
+}
+}  // namespace comet
+
+#endif  // COMET_COMET_CORE_TYPE_WORK_STEALING_DEQUE_H_
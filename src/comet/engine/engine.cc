@@ -26,6 +26,7 @@
 #include "comet/core/type/gid.h"
 #include "comet/engine/engine_event.h"
 #include "comet/entity/entity_manager.h"
+#include "comet/entity/system_scheduler.h"
 #include "comet/event/event.h"
 #include "comet/event/event_manager.h"
 #include "comet/geometry/geometry_manager.h"
@@ -190,6 +191,7 @@ void Engine::Load() {
 
   animation::AnimationManager::Get().Initialize();
   entity::EntityManager::Get().Initialize();
+  entity::SystemScheduler::Get().Initialize();
   geometry::GeometryManager::Get().Initialize();
   GameLogicManager::Get().Initialize();
 }
@@ -219,6 +221,7 @@ void Engine::PreUnload() {
   input::InputManager::Get().Shutdown();
   GameLogicManager::Get().Shutdown();
   geometry::GeometryManager::Get().Shutdown();
+  entity::SystemScheduler::Get().Shutdown();
   entity::EntityManager::Get().Shutdown();
   animation::AnimationManager::Get().Shutdown();
   physics::PhysicsManager::Get().Shutdown();
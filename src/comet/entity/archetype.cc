@@ -10,10 +10,60 @@
 #include "archetype.h"
 ////////////////////////////////////////////////////////////////////////////////
 
+#include "comet/core/memory/memory_utils.h"
 #include "comet/entity/entity_memory_manager.h"
 
 namespace comet {
 namespace entity {
+namespace internal {
+HashValue GenerateHash(const EntityType& entity_type) {
+  usize hash{0};
+
+  for (const auto component_type_id : entity_type) {
+    hash = HashCombine(hash, component_type_id);
+  }
+
+  return static_cast<HashValue>(hash);
+}
+
+const EntityTypeHashLogic::EntryKey& EntityTypeHashLogic::GetHashable(
+    const EntryPair& pair) {
+  return pair.key;
+}
+
+HashValue EntityTypeHashLogic::Hash(const EntryKey& key) {
+  return GenerateHash(*key);
+}
+
+bool EntityTypeHashLogic::AreEqual(const EntryKey& a, const EntryKey& b) {
+  return *a == *b;
+}
+
+usize GetColumnIndex(const Archetype* archetype, usize offset) {
+  for (usize i{0}; i < archetype->components.GetSize(); ++i) {
+    const auto& column{archetype->components[i]};
+
+    if (column.size > 0 && offset >= column.offset &&
+        offset < column.offset + column.size * archetype->chunk_capacity) {
+      return i;
+    }
+  }
+
+  return kInvalidIndex;
+}
+
+ChangeVersion& GetComponentVersion(const void* cmp) {
+  auto* header{GetChunkHeader(cmp)};
+  auto* chunk{reinterpret_cast<u8*>(header)};
+  const auto cmp_index{
+      GetColumnIndex(header->archetype,
+                     static_cast<usize>(static_cast<const u8*>(cmp) - chunk))};
+  COMET_ASSERT(cmp_index != kInvalidIndex,
+               "Component is not stored in an archetype chunk!");
+  return GetChunkVersions(chunk)[cmp_index];
+}
+}  // namespace internal
+
 ArchetypePtr GenerateArchetype() {
   auto& memory_manager{EntityMemoryManager::Get()};
 
@@ -21,9 +71,13 @@ ArchetypePtr GenerateArchetype() {
               .AllocateOneAndPopulate<Archetype>()};
 
   p->entity_type = EntityType{&memory_manager.GetEntityTypeAllocator()};
-  p->entity_ids = Array<EntityId>{&memory_manager.GetEntityIdAllocator()};
   p->components =
-      Array<ComponentArray>{&memory_manager.GetComponentArrayAllocator()};
+      Array<ComponentColumn>{&memory_manager.GetComponentColumnAllocator()};
+  p->chunks = Array<u8*>{&memory_manager.GetArchetypeChunkPointerAllocator()};
+  p->add_edges = ArchetypeEdges{&memory_manager.GetArchetypeMapAllocator(),
+                                kArchetypeEdgeInitialCapacity};
+  p->remove_edges = ArchetypeEdges{&memory_manager.GetArchetypeMapAllocator(),
+                                   kArchetypeEdgeInitialCapacity};
 
   ArchetypePtr archetype{
       p, [](Archetype* ptr) {
@@ -33,5 +87,111 @@ ArchetypePtr GenerateArchetype() {
 
   return archetype;
 }
+
+void InitializeChunkLayout(Archetype* archetype) {
+  const auto header_size{sizeof(ArchetypeChunkHeader) +
+                         sizeof(ChangeVersion) *
+                             archetype->components.GetSize()};
+  archetype->entity_ids_offset =
+      memory::AlignSize(header_size, alignof(EntityId));
+  usize row_size{sizeof(EntityId)};
+
+  for (const auto& column : archetype->components) {
+    row_size += column.size;
+  }
+
+  auto chunk_capacity{(kArchetypeChunkSize - archetype->entity_ids_offset) /
+                      row_size};
+
+  // Columns are aligned, which may leave some padding between them: remove
+  // rows until all of them fit.
+  while (chunk_capacity > 0) {
+    auto offset{archetype->entity_ids_offset +
+                sizeof(EntityId) * chunk_capacity};
+
+    for (auto& column : archetype->components) {
+      if (column.size == 0) {
+        column.offset = 0;
+        continue;
+      }
+
+      offset = memory::AlignSize(offset, column.align);
+      column.offset = offset;
+      offset += column.size * chunk_capacity;
+    }
+
+    if (offset <= kArchetypeChunkSize) {
+      break;
+    }
+
+    --chunk_capacity;
+  }
+
+  COMET_ASSERT(chunk_capacity > 0, "Components of archetype #", archetype->id,
+               " do not fit in a chunk!");
+  archetype->chunk_capacity = chunk_capacity;
+}
+
+void InitializeChunk(const Archetype* archetype, u8* chunk) {
+  reinterpret_cast<ArchetypeChunkHeader*>(chunk)->archetype = archetype;
+  auto* versions{GetChunkVersions(chunk)};
+
+  for (usize i{0}; i < archetype->components.GetSize(); ++i) {
+    versions[i] = kInitialChangeVersion;
+  }
+}
+
+void CopyComponentRows(const Archetype* src_archetype, usize src_cmp_index,
+                       usize src_row, Archetype* dst_archetype,
+                       usize dst_cmp_index, usize dst_row, usize count) {
+  const auto cmp_size{dst_archetype->components[dst_cmp_index].size};
+  COMET_ASSERT(src_archetype->components[src_cmp_index].size == cmp_size,
+               "Component columns do not match!");
+
+  // Rows are copied one chunk at a time.
+  while (count > 0) {
+    const auto src_chunk_count{src_archetype->chunk_capacity -
+                               src_row % src_archetype->chunk_capacity};
+    const auto dst_chunk_count{dst_archetype->chunk_capacity -
+                               dst_row % dst_archetype->chunk_capacity};
+    auto batch_count{src_chunk_count < dst_chunk_count ? src_chunk_count
+                                                       : dst_chunk_count};
+    batch_count = batch_count < count ? batch_count : count;
+
+    memory::CopyMemory(
+        GetComponentElement(dst_archetype, dst_cmp_index, dst_row),
+        GetComponentElement(src_archetype, src_cmp_index, src_row),
+        cmp_size * batch_count);
+
+    src_row += batch_count;
+    dst_row += batch_count;
+    count -= batch_count;
+  }
+}
+
+void MarkRowsChanged(const Archetype* archetype, usize row_begin,
+                     usize row_end, ChangeVersion version) {
+  if (row_begin >= row_end) {
+    return;
+  }
+
+  const auto chunk_begin{row_begin / archetype->chunk_capacity};
+  const auto chunk_end{(row_end - 1) / archetype->chunk_capacity + 1};
+
+  for (auto i{chunk_begin}; i < chunk_end; ++i) {
+    for (usize j{0}; j < archetype->components.GetSize(); ++j) {
+      MarkChunkChanged(archetype, i, j, version);
+    }
+  }
+}
+
+void MarkComponentChanged(const void* cmp, ChangeVersion version) {
+  internal::StoreChangeVersion(internal::GetComponentVersion(cmp), version);
+}
+
+ChangeVersion GetComponentChangeVersion(const void* cmp) {
+  return std::atomic_ref<ChangeVersion>{internal::GetComponentVersion(cmp)}
+      .load(std::memory_order_relaxed);
+}
 }  // namespace entity
 }  // namespace comet
@@ -5,45 +5,86 @@
 #ifndef COMET_COMET_ENTITY_ARCHETYPE_H_
 #define COMET_COMET_ENTITY_ARCHETYPE_H_
 
+#include <atomic>
+
 #include "comet/core/essentials.h"
+#include "comet/core/hash.h"
 #include "comet/core/memory/memory.h"
 #include "comet/core/type/array.h"
+#include "comet/core/type/flat_map.h"
 #include "comet/core/type/map.h"
 #include "comet/entity/entity_id.h"
 #include "comet/entity/entity_type.h"
 
 namespace comet {
 namespace entity {
-struct ComponentArray {
-  u8* elements{nullptr};
+// Archetypes store their rows in chunks of fixed size. Every chunk holds the
+// entity IDs and all the component columns of the same rows: growing an
+// archetype never moves existing rows, and chunks can be processed
+// independently from one another. Chunks are aligned on their size, so the
+// chunk of any component can be retrieved from its address.
+constexpr usize kArchetypeChunkSize{16384};
+constexpr memory::Alignment kArchetypeChunkAlignment{16384};
+
+// Value of the change version of the entity manager when a component column
+// of a chunk was last written to.
+using ChangeVersion = u64;
+constexpr ChangeVersion kInitialChangeVersion{0};
+
+// Location of a component type in every chunk of an archetype.
+struct ComponentColumn {
+  usize offset{0};
+  // Size of a single component. Tags have no storage.
   usize size{0};
+  memory::Alignment align{0};
 };
 
 using ArchetypeId = usize;
 constexpr auto kInvalidArchetypeId{static_cast<ArchetypeId>(-1)};
 
+struct Archetype;
+using ArchetypeEdges = FlatMap<EntityId, Archetype*>;
+constexpr usize kArchetypeEdgeInitialCapacity{4};
+
 struct Archetype {
   ArchetypeId id{kInvalidArchetypeId};
   usize size{0};
   usize capacity{0};
+  // Maximum number of rows in a single chunk.
+  usize chunk_capacity{0};
+  // Offset of the entity IDs in every chunk, after its header.
+  usize entity_ids_offset{0};
   EntityType entity_type{};
-  Array<EntityId> entity_ids{};
-  Array<ComponentArray> components{};
+  Array<ComponentColumn> components{};
+  Array<u8*> chunks{};
+  // Archetypes reached by adding or removing a single component type. They
+  // are filled lazily, when entities move from one archetype to another.
+  ArchetypeEdges add_edges{};
+  ArchetypeEdges remove_edges{};
 };
 
+// Stored at the beginning of every chunk, followed by the change version of
+// each of its component columns.
+struct ArchetypeChunkHeader {
+  const Archetype* archetype{nullptr};
+};
+
+static_assert(sizeof(ArchetypeChunkHeader) % alignof(ChangeVersion) == 0,
+              "Change versions must follow archetype chunk headers!");
+
 struct Record {
   Archetype* archetype{nullptr};
   usize row{kInvalidIndex};
 };
 
-using Records = Map<EntityId, Record>;
+using Records = FlatMap<EntityId, Record>;
 
 struct ArchetypeRecord {
   usize cmp_array_index{kInvalidIndex};
 };
 
-using ArchetypeMap = Map<ArchetypeId, ArchetypeRecord>;
-using EntityArchetypeMap = Map<EntityId, Archetype*>;
+using ArchetypeMap = FlatMap<ArchetypeId, ArchetypeRecord>;
+using EntityArchetypeMap = FlatMap<EntityId, Archetype*>;
 
 struct RegisteredComponentType {
   ComponentTypeDescr type_descr{};
@@ -51,11 +92,174 @@ struct RegisteredComponentType {
   usize use_count{0};
 };
 
-using RegisteredComponentTypeMap = Map<EntityId, RegisteredComponentType>;
+using RegisteredComponentTypeMap =
+    FlatMap<EntityId, RegisteredComponentType>;
 
 using ArchetypePtr = memory::CustomUniquePtr<Archetype>;
 
+namespace internal {
+HashValue GenerateHash(const EntityType& entity_type);
+
+// Hashes and compares the entity types themselves, not their addresses.
+struct EntityTypeHashLogic
+    : public MapHashLogic<const EntityType*, Archetype*> {
+  using EntryPair = typename MapHashLogic<const EntityType*, Archetype*>::Value;
+  using EntryKey =
+      typename MapHashLogic<const EntityType*, Archetype*>::Hashable;
+
+  static const EntryKey& GetHashable(const EntryPair& pair);
+  static HashValue Hash(const EntryKey& key);
+  static bool AreEqual(const EntryKey& a, const EntryKey& b);
+};
+}  // namespace internal
+
+using ArchetypeIndex =
+    FlatMap<const EntityType*, Archetype*, internal::EntityTypeHashLogic>;
+
 ArchetypePtr GenerateArchetype();
+
+// Computes the offset of every column in the chunks of the archetype, and how
+// many rows fit in each of them. Entity IDs are stored after the chunk header.
+void InitializeChunkLayout(Archetype* archetype);
+// Must be called on every chunk allocated for the archetype.
+void InitializeChunk(const Archetype* archetype, u8* chunk);
+
+// Copies count contiguous rows of a component column from an archetype to
+// another, whatever the chunks they are stored in.
+void CopyComponentRows(const Archetype* src_archetype, usize src_cmp_index,
+                       usize src_row, Archetype* dst_archetype,
+                       usize dst_cmp_index, usize dst_row, usize count);
+
+inline usize GetChunkCount(const Archetype* archetype) {
+  return (archetype->size + archetype->chunk_capacity - 1) /
+         archetype->chunk_capacity;
+}
+
+// Number of rows used in the chunk.
+inline usize GetChunkSize(const Archetype* archetype, usize chunk_index) {
+  const auto chunk_begin{chunk_index * archetype->chunk_capacity};
+
+  if (archetype->size <= chunk_begin) {
+    return 0;
+  }
+
+  const auto size{archetype->size - chunk_begin};
+  return size < archetype->chunk_capacity ? size : archetype->chunk_capacity;
+}
+
+inline EntityId* GetChunkEntityIds(const Archetype* archetype,
+                                   usize chunk_index) {
+  return reinterpret_cast<EntityId*>(archetype->chunks[chunk_index] +
+                                     archetype->entity_ids_offset);
+}
+
+// ptr may point anywhere in the chunk.
+inline ArchetypeChunkHeader* GetChunkHeader(const void* ptr) {
+  return reinterpret_cast<ArchetypeChunkHeader*>(
+      reinterpret_cast<uptr>(ptr) &
+      ~static_cast<uptr>(kArchetypeChunkAlignment - 1));
+}
+
+inline ChangeVersion* GetChunkVersions(u8* chunk) {
+  return reinterpret_cast<ChangeVersion*>(chunk +
+                                          sizeof(ArchetypeChunkHeader));
+}
+
+inline ChangeVersion GetChunkVersion(const Archetype* archetype,
+                                     usize chunk_index, usize cmp_index) {
+  // Versions may be written by other jobs meanwhile.
+  return std::atomic_ref<ChangeVersion>{GetChunkVersions(
+                                            archetype->chunks[chunk_index])
+                                            [cmp_index]}
+      .load(std::memory_order_relaxed);
+}
+
+namespace internal {
+inline void StoreChangeVersion(ChangeVersion& chunk_version,
+                               ChangeVersion version) {
+  std::atomic_ref<ChangeVersion> ref{chunk_version};
+
+  // Avoid writing to the chunk header when it is already up to date, since
+  // it is shared by all the jobs processing the same chunk.
+  if (ref.load(std::memory_order_relaxed) != version) {
+    ref.store(version, std::memory_order_relaxed);
+  }
+}
+}  // namespace internal
+
+inline void MarkChunkChanged(const Archetype* archetype, usize chunk_index,
+                             usize cmp_index, ChangeVersion version) {
+  internal::StoreChangeVersion(
+      GetChunkVersions(archetype->chunks[chunk_index])[cmp_index], version);
+}
+
+inline u8* GetChunkColumn(const Archetype* archetype, usize chunk_index,
+                          usize cmp_index) {
+  return archetype->chunks[chunk_index] +
+         archetype->components[cmp_index].offset;
+}
+
+inline EntityId& GetEntityId(const Archetype* archetype, usize row) {
+  return GetChunkEntityIds(archetype, row / archetype->chunk_capacity)
+      [row % archetype->chunk_capacity];
+}
+
+inline u8* GetComponentElement(const Archetype* archetype, usize cmp_index,
+                               usize row) {
+  return GetChunkColumn(archetype, row / archetype->chunk_capacity,
+                        cmp_index) +
+         (row % archetype->chunk_capacity) *
+             archetype->components[cmp_index].size;
+}
+
+// Marks every column of the chunks of the rows in [row_begin, row_end).
+void MarkRowsChanged(const Archetype* archetype, usize row_begin,
+                     usize row_end, ChangeVersion version);
+// cmp must point to a component stored in an archetype chunk.
+void MarkComponentChanged(const void* cmp, ChangeVersion version);
+ChangeVersion GetComponentChangeVersion(const void* cmp);
+
+template <typename Function>
+void EachEntityId(const Archetype* archetype, const Function& func) {
+  const auto chunk_count{GetChunkCount(archetype)};
+
+  for (usize i{0}; i < chunk_count; ++i) {
+    const auto* entity_ids{GetChunkEntityIds(archetype, i)};
+    const auto chunk_size{GetChunkSize(archetype, i)};
+
+    for (usize j{0}; j < chunk_size; ++j) {
+      func(entity_ids[j]);
+    }
+  }
+}
+
+template <typename ComponentType>
+usize GetComponentIndex(const Archetype* archetype) {
+  const auto component_type_id{
+      ComponentTypeDescrGetter<ComponentType>::Get().id};
+  auto cmp_index{archetype->entity_type.GetIndex(component_type_id)};
+  COMET_ASSERT(cmp_index != kInvalidIndex, "Component ", component_type_id,
+               " not found in archetype #", archetype->id, "!");
+  return cmp_index;
+}
+
+template <typename ComponentType>
+ComponentType* GetComponentArray(const Archetype* archetype,
+                                 usize chunk_index) {
+  return reinterpret_cast<ComponentType*>(GetChunkColumn(
+      archetype, chunk_index, GetComponentIndex<ComponentType>(archetype)));
+}
+
+// Returns true if any of the columns of the given types was written to at or
+// after the since version. See EntityManager::AdvanceChangeVersion().
+template <typename... ComponentTypes>
+bool IsChunkChanged(const Archetype* archetype, usize chunk_index,
+                    ChangeVersion since) {
+  return ((GetChunkVersion(archetype, chunk_index,
+                           GetComponentIndex<ComponentTypes>(archetype)) >=
+           since) ||
+          ...);
+}
 }  // namespace entity
 }  // namespace comet
 
@@ -0,0 +1,107 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Header. /////////////////////////////////////////////////////////////////////
+#include "archetype_chunk_allocator.h"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/memory/memory_utils.h"
+#include "comet/core/memory/tagged_heap.h"
+
+namespace comet {
+namespace entity {
+ArchetypeChunkAllocator::ArchetypeChunkAllocator(usize chunk_size,
+                                                 memory::Alignment chunk_align,
+                                                 memory::MemoryTag memory_tag)
+    : chunk_size_{chunk_size},
+      chunk_align_{chunk_align},
+      memory_tag_{memory_tag} {
+  COMET_ASSERT(chunk_size_ >= sizeof(FreeChunk),
+               "Archetype chunks are too small!");
+  COMET_ASSERT(chunk_size_ % chunk_align_ == 0,
+               "Archetype chunk size must be a multiple of its alignment!");
+}
+
+void ArchetypeChunkAllocator::Initialize() {
+  StatefulAllocator::Initialize();
+  used_chunk_count_ = 0;
+  free_head_ = nullptr;
+}
+
+void ArchetypeChunkAllocator::Destroy() {
+  StatefulAllocator::Destroy();
+  memory::TaggedHeap::Get().DeallocateAll(memory_tag_);
+  used_chunk_count_ = 0;
+  free_head_ = nullptr;
+}
+
+void* ArchetypeChunkAllocator::AllocateAligned(
+    [[maybe_unused]] usize size, [[maybe_unused]] memory::Alignment align) {
+  COMET_ASSERT(size <= chunk_size_, "Size ", size,
+               " does not fit in an archetype chunk!");
+  COMET_ASSERT(align <= chunk_align_, "Alignment ", align,
+               " is not supported by archetype chunks!");
+  fiber::FiberSpinLockGuard lock{lock_};
+
+  if (free_head_ == nullptr) {
+    Grow();
+  }
+
+  auto* chunk{free_head_};
+  free_head_ = chunk->next;
+  ++used_chunk_count_;
+  return chunk;
+}
+
+void ArchetypeChunkAllocator::Deallocate(void* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+
+  fiber::FiberSpinLockGuard lock{lock_};
+  COMET_ASSERT(used_chunk_count_ > 0, "No archetype chunk is allocated!");
+  auto* chunk{static_cast<FreeChunk*>(ptr)};
+  chunk->next = free_head_;
+  free_head_ = chunk;
+  --used_chunk_count_;
+}
+
+usize ArchetypeChunkAllocator::GetChunkSize() const noexcept {
+  return chunk_size_;
+}
+
+usize ArchetypeChunkAllocator::GetUsedChunkCount() const noexcept {
+  return used_chunk_count_;
+}
+
+void ArchetypeChunkAllocator::Grow() {
+  auto& tagged_heap{memory::TaggedHeap::Get()};
+  const auto block_size{tagged_heap.GetBlockSize()};
+
+  // The tagged heap does not support alignments as large as the chunk ones:
+  // chunks are aligned manually, which may waste up to one of them.
+  const auto min_size{chunk_size_ + chunk_align_ + memory::kMaxAlignment};
+  const auto block_count{(min_size + block_size - 1) / block_size};
+  auto* blocks{
+      static_cast<u8*>(tagged_heap.AllocateBlocks(block_count, memory_tag_))};
+  auto* chunks_begin{memory::AlignPointer(blocks, chunk_align_)};
+  const auto* blocks_end{blocks + block_count * block_size -
+                         memory::kMaxAlignment};
+  const auto chunk_count{static_cast<usize>(blocks_end - chunks_begin) /
+                         chunk_size_};
+  COMET_ASSERT(chunk_count > 0, "No archetype chunk could be allocated!");
+
+  for (usize i{chunk_count}; i > 0; --i) {
+    auto* chunk{
+        reinterpret_cast<FreeChunk*>(chunks_begin + (i - 1) * chunk_size_)};
+    chunk->next = free_head_;
+    free_head_ = chunk;
+  }
+}
+}  // namespace entity
+}  // namespace comet
@@ -0,0 +1,56 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+#ifndef COMET_COMET_ENTITY_ARCHETYPE_CHUNK_ALLOCATOR_H_
+#define COMET_COMET_ENTITY_ARCHETYPE_CHUNK_ALLOCATOR_H_
+
+#include "comet/core/concurrency/fiber/fiber_primitive.h"
+#include "comet/core/essentials.h"
+#include "comet/core/memory/allocator/stateful_allocator.h"
+#include "comet/core/memory/memory.h"
+
+namespace comet {
+namespace entity {
+// Pool of archetype chunks, which all have the same size and alignment. Chunks
+// are carved out of tagged heap blocks, and released chunks are reused first.
+// Memory is only given back to the tagged heap when the pool is destroyed.
+class ArchetypeChunkAllocator : public memory::StatefulAllocator {
+ public:
+  ArchetypeChunkAllocator() = default;
+  ArchetypeChunkAllocator(usize chunk_size, memory::Alignment chunk_align,
+                          memory::MemoryTag memory_tag);
+  ArchetypeChunkAllocator(const ArchetypeChunkAllocator&) = delete;
+  ArchetypeChunkAllocator(ArchetypeChunkAllocator&&) = delete;
+  ArchetypeChunkAllocator& operator=(const ArchetypeChunkAllocator&) = delete;
+  ArchetypeChunkAllocator& operator=(ArchetypeChunkAllocator&&) = delete;
+  ~ArchetypeChunkAllocator() = default;
+
+  void Initialize() override;
+  void Destroy() override;
+
+  // Only allocations which fit in a chunk are supported.
+  void* AllocateAligned(usize size, memory::Alignment align) override;
+  void Deallocate(void* ptr) override;
+
+  usize GetChunkSize() const noexcept;
+  usize GetUsedChunkCount() const noexcept;
+
+ private:
+  struct FreeChunk {
+    FreeChunk* next{nullptr};
+  };
+
+  void Grow();
+
+  usize chunk_size_{0};
+  memory::Alignment chunk_align_{0};
+  memory::MemoryTag memory_tag_{memory::kEngineMemoryTagUntagged};
+  usize used_chunk_count_{0};
+  FreeChunk* free_head_{nullptr};
+  fiber::FiberSpinLock lock_{};
+};
+}  // namespace entity
+}  // namespace comet
+
+#endif  // COMET_COMET_ENTITY_ARCHETYPE_CHUNK_ALLOCATOR_H_
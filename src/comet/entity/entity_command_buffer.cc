@@ -0,0 +1,59 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Header. /////////////////////////////////////////////////////////////////////
+#include "entity_command_buffer.h"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/memory/memory_utils.h"
+
+namespace comet {
+namespace entity {
+namespace internal {
+bool EntityCommandBuffer::CanPush(usize count) const noexcept {
+  return head_ != nullptr &&
+         head_->size + count <= EntityCommandBlock::kCapacity_;
+}
+
+void EntityCommandBuffer::AttachBlock(EntityCommandBlock* block) {
+  COMET_ASSERT(block != nullptr, "Entity command block is null!");
+  COMET_ASSERT(block->size == 0, "Entity command block is not empty!");
+  block->next = head_;
+  head_ = block;
+}
+
+void EntityCommandBuffer::Push(const EntityCommand& command) {
+  COMET_ASSERT(CanPush(1), "No room left in entity command buffer!");
+  head_->commands[head_->size++] = command;
+  ++size_;
+}
+
+void EntityCommandBuffer::CopyTo(EntityCommand* dst) const {
+  // Blocks are stored from the most recent one, so they are copied from the
+  // end of the destination.
+  auto offset{size_};
+
+  for (const auto* block{head_}; block != nullptr; block = block->next) {
+    offset -= block->size;
+    memory::CopyMemory(dst + offset, block->commands,
+                       block->size * sizeof(EntityCommand));
+  }
+}
+
+void EntityCommandBuffer::Clear() {
+  // Blocks are owned by the frame allocator.
+  head_ = nullptr;
+  size_ = 0;
+}
+
+usize EntityCommandBuffer::GetSize() const noexcept { return size_; }
+
+bool EntityCommandBuffer::IsEmpty() const noexcept { return size_ == 0; }
+}  // namespace internal
+}  // namespace entity
+}  // namespace comet
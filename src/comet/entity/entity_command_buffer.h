@@ -0,0 +1,70 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+#ifndef COMET_COMET_ENTITY_ENTITY_COMMAND_BUFFER_H_
+#define COMET_COMET_ENTITY_ENTITY_COMMAND_BUFFER_H_
+
+#include "comet/core/essentials.h"
+#include "comet/entity/component.h"
+#include "comet/entity/entity_id.h"
+
+namespace comet {
+namespace entity {
+namespace internal {
+using EntityCommandSequence = u64;
+
+enum class EntityCommandType : u8 {
+  Unknown = 0,
+  Generate,
+  AddComponent,
+  RemoveComponent,
+  Destroy
+};
+
+struct EntityCommand {
+  EntityId entity_id{kInvalidEntityId};
+  // Commands recorded by the same call share the same sequence. Sequences
+  // follow the order in which calls were made, whatever the worker.
+  EntityCommandSequence sequence{0};
+  EntityCommandType type{EntityCommandType::Unknown};
+  // Only the ID of the type is set when a component is removed.
+  ComponentDescr cmp_descr{};
+};
+
+struct EntityCommandBlock {
+  static constexpr usize kCapacity_{256};
+
+  EntityCommandBlock* next{nullptr};
+  usize size{0};
+  EntityCommand commands[kCapacity_]{};
+};
+
+// Structural changes recorded by a single fiber worker during a frame. Blocks
+// are allocated by the caller and are never moved, so recording does not
+// require any lock. Since allocating a block may suspend the current fiber,
+// room must be made before retrieving the buffer of the current worker, not
+// in between.
+class EntityCommandBuffer {
+ public:
+  bool CanPush(usize count) const noexcept;
+  void AttachBlock(EntityCommandBlock* block);
+  void Push(const EntityCommand& command);
+  // Copies the commands to dst in the order they were recorded. dst must be
+  // able to hold GetSize() commands.
+  void CopyTo(EntityCommand* dst) const;
+  void Clear();
+
+  usize GetSize() const noexcept;
+  bool IsEmpty() const noexcept;
+
+ private:
+  // Most recent block first.
+  EntityCommandBlock* head_{nullptr};
+  usize size_{0};
+};
+}  // namespace internal
+}  // namespace entity
+}  // namespace comet
+
+#endif  // COMET_COMET_ENTITY_ENTITY_COMMAND_BUFFER_H_
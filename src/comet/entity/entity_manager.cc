@@ -10,7 +10,13 @@
 #include "entity_manager.h"
 ////////////////////////////////////////////////////////////////////////////////
 
+// External. ///////////////////////////////////////////////////////////////////
+#include <algorithm>
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/algorithm/radix_sort.h"
 #include "comet/core/concurrency/job/job_utils.h"
+#include "comet/core/concurrency/job/parallel.h"
 #include "comet/core/concurrency/job/scheduler.h"
 #include "comet/core/frame/frame_allocator.h"
 #include "comet/core/frame/frame_event.h"
@@ -42,25 +48,9 @@ bool ComponentTypeDescrHashLogic::AreEqual(const Hashable& a,
   return a.id == b.id;
 }
 
-void MovedEntities::Add(Archetype* archetype,
-                        const internal::DeferredEntity& entity) {
-  auto* entities{map.TryGet(archetype)};
-
-  if (entities == nullptr) {
-    entities =
-        &map.Emplace(archetype,
-                     frame::FrameArray<const internal::DeferredEntity*>{})
-             .value;
-  }
-
-  entities->PushBack(&entity);
-}
-
-bool MovedEntities::IsEmpty() const { return map.IsEmpty(); }
-
 bool DeferredChanges::IsEmpty() const {
-  return archetype_size_deltas.IsEmpty() && added_to.IsEmpty() &&
-         removed_from.IsEmpty() && destroyed_ids.IsEmpty();
+  return added_to.IsEmpty() && removed_from.IsEmpty() &&
+         destroyed_ids.IsEmpty();
 }
 }  // namespace internal
 
@@ -83,10 +73,12 @@ void EntityManager::Initialize() {
   // Tags: configuration entity memory
   archetypes_ =
       Array<ArchetypePtr>{&memory_manager.GetArchetypePointerAllocator()};
+  archetype_index_ = ArchetypeIndex{&memory_manager.GetArchetypeMapAllocator()};
+  queries_ =
+      Array<EntityQuery*>{&memory_manager.GetArchetypePointerAllocator()};
 
   root_archetype_ = GetArchetype(EntityType{});
-  deferred_entities_ = COMET_FRAME_ALLOC_ONE_AND_POPULATE(
-      DeferredEntities, kDeferredEntityInitialCount_);
+  command_buffers_.Initialize();
   EntityFactoryManager::Get().Initialize();
 
   auto on_event{COMET_EVENT_BIND_FUNCTION(OnEvent)};
@@ -101,25 +93,29 @@ void EntityManager::Shutdown() {
   EntityFactoryManager::Get().Shutdown();
   auto& memory_manager{EntityMemoryManager::Get()};
 
-  for (auto& archetype : archetypes_) {
-    for (auto& cmp_array : archetype->components) {
-      if (cmp_array.size == 0) {
-        continue;
-      }
+  auto& chunk_allocator{memory_manager.GetArchetypeChunkAllocator()};
 
-      memory_manager.GetComponentArrayElementsAllocator(cmp_array.size)
-          .Deallocate(cmp_array.elements);
-      cmp_array.elements = nullptr;
+  for (auto& archetype : archetypes_) {
+    for (auto* chunk : archetype->chunks) {
+      chunk_allocator.Deallocate(chunk);
     }
+
+    archetype->chunks.Clear();
   }
 
+  for (auto* query : queries_) {
+    query->Clear();
+  }
+
+  queries_.Destroy();
+  archetype_index_.Destroy();
   archetypes_.Destroy();
   component_id_handler_.Shutdown();
   root_archetype_ = nullptr;
   entity_id_handler_.Shutdown();
   records_.Destroy();
   registered_component_types_.Destroy();
-  deferred_entities_ = nullptr;
+  command_buffers_.Destroy();
   memory_manager.Shutdown();
   Manager::Shutdown();
 }
@@ -147,39 +143,30 @@ void EntityManager::WaitForEntityUpdates() {
 }
 
 EntityId EntityManager::Generate() {
-  auto new_entity_id{entity_id_handler_.Generate()};
-  fiber::FiberLockGuard lock{deferred_mutex_};
-  COMET_ASSERT(deferred_entities_ != nullptr, "Deferred entities are null!");
-  deferred_entities_->Emplace(new_entity_id,
-                              internal::DeferredEntity{false, new_entity_id});
+  auto new_entity_id{kInvalidEntityId};
+
+  {
+    fiber::FiberSpinLockGuard lock{entity_id_lock_};
+    new_entity_id = entity_id_handler_.Generate();
+  }
+
+  RecordCommand(new_entity_id, internal::EntityCommandType::Generate);
   return new_entity_id;
 }
 
 bool EntityManager::IsEntity(const EntityId& entity_id) const {
-  return entity_id != kInvalidEntityId &&
-         entity_id_handler_.IsAlive(GetGid(entity_id));
+  if (entity_id == kInvalidEntityId) {
+    return false;
+  }
+
+  fiber::FiberSpinLockGuard lock{entity_id_lock_};
+  return entity_id_handler_.IsAlive(GetGid(entity_id));
 }
 
 void EntityManager::Destroy(EntityId entity_id) {
   COMET_ASSERT(IsEntity(entity_id),
                "Attempting to destroy a non-existent entity!");
-  {
-    fiber::FiberLockGuard lock{deferred_mutex_};
-    COMET_ASSERT(deferred_entities_ != nullptr, "Deferred entities are null!");
-    auto* entity{deferred_entities_->TryGet(entity_id)};
-
-    if (entity != nullptr) {
-      entity->is_destroyed = true;
-      entity->added_cmps.Destroy();
-      entity->removed_cmps.Destroy();
-    } else {
-      COMET_ASSERT(deferred_entities_ != nullptr,
-                   "Deferred entities are null!");
-      deferred_entities_->Emplace(entity_id,
-                                  internal::DeferredEntity{true, entity_id});
-    }
-  }
-
+  RecordCommand(entity_id, internal::EntityCommandType::Destroy);
   EachChild<>([&](auto child_entity_id) { Destroy(child_entity_id); },
               entity_id);
 }
@@ -202,20 +189,20 @@ bool EntityManager::HasComponent(EntityId entity_id,
 void EntityManager::RemoveComponents(EntityId entity_id,
                                      const Array<EntityId>& component_ids) {
   COMET_ASSERT(IsEntity(entity_id), "Entity #", entity_id, " does not exist!");
-  fiber::FiberLockGuard lock{deferred_mutex_};
-  COMET_ASSERT(deferred_entities_ != nullptr, "Deferred entities are null!");
-  auto* entity{deferred_entities_->TryGet(entity_id)};
+  const auto count{component_ids.GetSize()};
 
-  if (entity == nullptr) {
-    entity =
-        &deferred_entities_
-             ->Emplace(entity_id, internal::DeferredEntity{false, entity_id})
-             .value;
+  if (count == 0) {
+    return;
   }
 
-  COMET_ASSERT(!entity->is_destroyed, "Entity #", entity_id,
-               " is scheduled to be destroyed!");
-  DeferRemovingComponents(entity, component_ids);
+  frame::FrameArray<internal::EntityCommand> commands{};
+  commands.Reserve(count);
+
+  for (const auto component_id : component_ids) {
+    commands.PushBack(GenerateRemoveCommand(entity_id, component_id));
+  }
+
+  RecordCommands(commands.GetData(), count);
 }
 
 void EntityManager::AddParent(EntityId entity_id, EntityId parent_id) {
@@ -227,20 +214,12 @@ void EntityManager::AddParent(EntityId entity_id, EntityId parent_id) {
                "Trying to add entity #", entity_id,
                " to a dead parent (entity #", parent_id, ")!");
 
-  fiber::FiberLockGuard lock{deferred_mutex_};
-  COMET_ASSERT(deferred_entities_ != nullptr, "Deferred entities are null!");
-  auto* entity{deferred_entities_->TryGet(entity_id)};
-
-  if (entity == nullptr) {
-    entity =
-        &deferred_entities_
-             ->Emplace(entity_id, internal::DeferredEntity{false, entity_id})
-             .value;
-  }
-
-  COMET_ASSERT(!entity->is_destroyed, "Entity #", entity_id,
-               " is scheduled to be destroyed!");
-  DeferAddingParent(entity, parent_id);
+  internal::EntityCommand command{};
+  command.entity_id = entity_id;
+  command.type = internal::EntityCommandType::AddComponent;
+  command.cmp_descr.type_descr.id = Tag(EntityIdTag::Child, parent_id);
+  command.cmp_descr.type_descr.size = 0;
+  RecordCommands(&command, 1);
 }
 
 bool EntityManager::HasParent(EntityId entity_id, EntityId parent_id) {
@@ -262,6 +241,121 @@ bool EntityManager::HasParent(EntityId entity_id, EntityId parent_id) {
   return false;
 }
 
+void EntityManager::UnregisterQuery(EntityQuery& query) {
+  if (!query.IsRegistered()) {
+    return;
+  }
+
+  fiber::FiberLockGuard lock{query_mutex_};
+  queries_.RemoveFromValue(&query);
+  query.Clear();
+}
+
+usize EntityManager::GetStructureVersion() const noexcept {
+  return structure_version_;
+}
+
+ChangeVersion EntityManager::GetChangeVersion() const noexcept {
+  return change_version_.load(std::memory_order_relaxed);
+}
+
+ChangeVersion EntityManager::AdvanceChangeVersion() noexcept {
+  return change_version_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void EntityManager::PopulateQuery(EntityQuery& query,
+                                  const EntityId* component_type_ids,
+                                  usize count) {
+  COMET_ASSERT(!query.IsRegistered(), "Query is already registered!");
+  query.Populate(component_type_ids, count);
+  fiber::FiberLockGuard lock{query_mutex_};
+
+  for (auto& archetype : archetypes_) {
+    query.TryAdd(archetype.get());
+  }
+
+  query.is_registered_ = true;
+  queries_.PushBack(&query);
+}
+
+Archetype* EntityManager::GetNextArchetype(
+    Archetype* archetype, const internal::DeferredEntity& entity) {
+  const auto added_count{entity.added_cmps.GetSize()};
+  const auto removed_count{entity.removed_cmps.GetSize()};
+
+  // Most structural changes add or remove a single component type: follow
+  // the archetype graph instead of building and looking up a new entity type.
+  if (added_count == 1 && removed_count == 0) {
+    return GetArchetypeWith(archetype, entity.added_cmps[0].type_descr.id);
+  }
+
+  if (added_count == 0 && removed_count == 1) {
+    return GetArchetypeWithout(archetype, entity.removed_cmps[0]);
+  }
+
+  if (added_count == 0 && removed_count == 0) {
+    return archetype;
+  }
+
+  EntityType new_entity_type{archetype->entity_type};
+
+  if (!entity.added_cmps.IsEmpty()) {
+    new_entity_type = AddToEntityType(new_entity_type,
+                                      GenerateEntityType(entity.added_cmps));
+  }
+
+  if (!entity.removed_cmps.IsEmpty()) {
+    new_entity_type = RemoveFromEntityType(
+        new_entity_type, GenerateEntityType(entity.removed_cmps));
+  }
+
+  return GetArchetype(std::move(new_entity_type));
+}
+
+Archetype* EntityManager::GetArchetypeWith(Archetype* archetype,
+                                           EntityId component_type_id) {
+  auto** edge{archetype->add_edges.TryGet(component_type_id)};
+
+  if (edge != nullptr) {
+    return *edge;
+  }
+
+  auto* new_archetype{archetype};
+
+  if (!archetype->entity_type.IsContained(component_type_id)) {
+    EntityType new_entity_type{archetype->entity_type};
+    new_entity_type.PushBack(component_type_id);
+    CleanEntityType(new_entity_type);
+    new_archetype = GetArchetype(std::move(new_entity_type));
+    new_archetype->remove_edges.Set(component_type_id, archetype);
+  }
+
+  archetype->add_edges.Set(component_type_id, new_archetype);
+  return new_archetype;
+}
+
+Archetype* EntityManager::GetArchetypeWithout(Archetype* archetype,
+                                              EntityId component_type_id) {
+  auto** edge{archetype->remove_edges.TryGet(component_type_id)};
+
+  if (edge != nullptr) {
+    return *edge;
+  }
+
+  auto* new_archetype{archetype};
+
+  if (archetype->entity_type.IsContained(component_type_id)) {
+    EntityType new_entity_type{archetype->entity_type};
+    new_entity_type.RemoveFromValue(component_type_id);
+    CleanEntityType(new_entity_type);
+    new_archetype = GetArchetype(std::move(new_entity_type));
+    new_archetype->add_edges.Set(component_type_id, archetype);
+  }
+
+  archetype->remove_edges.Set(component_type_id, new_archetype);
+  return new_archetype;
+}
+
 void EntityManager::RegisterComponentType(
     const ComponentTypeDescr& type_descr) {
   auto* component_type{registered_component_types_.TryGet(type_descr.id)};
@@ -301,163 +395,268 @@ void EntityManager::UnregisterComponentType(EntityId component_type_id) {
   }
 }
 
-void EntityManager::ResizeArchetype(Archetype* archetype, s16 delta) {
-  ReserveArchetypeCapacity(archetype, archetype->entity_ids.GetSize() + delta);
-}
-
 void EntityManager::ReserveArchetypeCapacity(Archetype* archetype,
                                              usize capacity) {
-  constexpr f32 kGrowthThreshold{0.1f};
-  constexpr f32 kShrinkThreshold{0.25f};
-  constexpr usize kMinCapacity{16};
+  // A spare chunk is kept when shrinking, so that an archetype whose size
+  // oscillates around a chunk boundary does not allocate and release chunks
+  // every frame.
+  constexpr usize kSpareChunkCount{1};
+
+  COMET_ASSERT(capacity >= archetype->size, "Capacity ", capacity,
+               " is too small for archetype #", archetype->id, ", which has ",
+               archetype->size, " entities!");
+  const auto chunk_capacity{archetype->chunk_capacity};
+  const auto chunk_count{(capacity + chunk_capacity - 1) / chunk_capacity};
+  auto& chunk_allocator{
+      EntityMemoryManager::Get().GetArchetypeChunkAllocator()};
+  auto& chunks{archetype->chunks};
+
+  // Existing chunks are never moved.
+  while (chunks.GetSize() < chunk_count) {
+    auto* chunk{static_cast<u8*>(chunk_allocator.AllocateAligned(
+        kArchetypeChunkSize, kArchetypeChunkAlignment))};
+    InitializeChunk(archetype, chunk);
+    chunks.PushBack(chunk);
+  }
+
+  if (chunks.GetSize() > chunk_count + kSpareChunkCount) {
+    for (auto i{chunk_count + kSpareChunkCount}; i < chunks.GetSize(); ++i) {
+      chunk_allocator.Deallocate(chunks[i]);
+    }
 
-  if (capacity < kMinCapacity) {
-    capacity = kMinCapacity;
+    chunks.Resize(chunk_count + kSpareChunkCount);
   }
 
-  auto current_capacity{archetype->capacity};
+  archetype->capacity = chunks.GetSize() * chunk_capacity;
+}
+
+bool EntityManager::DoesEntityTypeContain(const EntityType& entity_type,
+                                          EntityId component_type_id) {
+  return entity_type.IsContained(component_type_id);
+}
 
-  if (capacity > current_capacity) {
-    if (capacity >= current_capacity * (1 - kGrowthThreshold)) {
-      capacity = math::Max(current_capacity * 2, capacity);
+internal::EntityCommand EntityManager::GenerateRemoveCommand(
+    EntityId entity_id, EntityId component_type_id) {
+  internal::EntityCommand command{};
+  command.entity_id = entity_id;
+  command.type = internal::EntityCommandType::RemoveComponent;
+  command.cmp_descr.type_descr.id = component_type_id;
+  return command;
+}
+
+void EntityManager::RecordCommand(EntityId entity_id,
+                                  internal::EntityCommandType type) {
+  internal::EntityCommand command{};
+  command.entity_id = entity_id;
+  command.type = type;
+  RecordCommands(&command, 1);
+}
+
+void EntityManager::RecordCommands(internal::EntityCommand* commands,
+                                   usize count) {
+  usize offset{0};
+
+  while (offset < count) {
+    // If a batch is recorded before another one, even on another worker, its
+    // sequence is lower. Batches of a same call may end up in the buffers of
+    // different workers if reserving them suspends the fiber.
+    const auto sequence{
+        command_sequence_.fetch_add(1, std::memory_order_relaxed)};
+    const auto batch_count{math::Min(
+        count - offset, internal::EntityCommandBlock::kCapacity_)};
+    auto& buffer{ReserveCommands(batch_count)};
+
+    for (usize i{0}; i < batch_count; ++i) {
+      auto& command{commands[offset + i]};
+      command.sequence = sequence;
+      buffer.Push(command);
     }
-  } else if (capacity < current_capacity) {
-    auto usage{static_cast<f32>(capacity) / current_capacity};
 
-    if (usage < kShrinkThreshold && current_capacity > kMinCapacity) {
-      capacity = math::Max(current_capacity / 2, kMinCapacity);
-    }
+    offset += batch_count;
   }
+}
 
-  if (capacity == current_capacity) {
-    return;
+internal::EntityCommandBuffer& EntityManager::ReserveCommands(usize count) {
+  auto* buffer{&command_buffers_.Get()};
+
+  if (buffer->CanPush(count)) {
+    return *buffer;
   }
 
-  auto delta{static_cast<ssize>(capacity) -
-             static_cast<ssize>(current_capacity)};
+  auto* block{
+      COMET_FRAME_ALLOC_ONE_AND_POPULATE(internal::EntityCommandBlock)};
 
-  archetype->entity_ids.Resize(math::Max(usize{0}, capacity));
-  archetype->capacity = capacity;
+  // Allocating may have suspended the fiber, which may now run on another
+  // worker: the buffer must be retrieved again.
+  buffer = &command_buffers_.Get();
+  buffer->AttachBlock(block);
+  return *buffer;
+}
 
-  if (archetype->size > archetype->capacity) {
-    archetype->size = archetype->capacity;
-  }
+void EntityManager::ProcessDeferredOperations() {
+  auto entities{PopulateDeferredEntities()};
 
-  // Case: nothing to resize.
-  if (archetype->entity_type.GetSize() == 0) {
+  if (entities.IsEmpty()) {
     return;
   }
 
-  for (usize i{0}; i < archetype->entity_type.GetSize(); ++i) {
-    const auto cmp_type_id{archetype->entity_type[i]};
-    const auto& old_cmp_array{archetype->components[i]};
-    auto* old_cmp_elements{old_cmp_array.elements};
-    auto old_cmp_size{old_cmp_array.size};
-    const auto& cmp_type_descr{
-        registered_component_types_[cmp_type_id].type_descr};
-    const auto cmp_size{cmp_type_descr.size};
-    const auto cmp_align{cmp_type_descr.align};
+  RegisterDeferredComponentTypes(entities);
+  internal::DeferredChanges changes{PopulateChanges(entities)};
 
-    usize new_size{0};
-    auto tmp{static_cast<s32>(old_cmp_size) +
-             static_cast<s32>(cmp_size) * delta};
-
-    if (tmp > 0) {
-      new_size = tmp;
-    }
+  if (changes.IsEmpty()) {
+    return;
+  }
 
-    // If new_size < copy_size, the last existing components will be
-    // truncated.
-    const auto copy_size{math::Min(old_cmp_size, new_size)};
-    archetype->components[i] = {nullptr, new_size};
-    auto& memory_manager{EntityMemoryManager::Get()};
+  ResizeDeferredArchetypes(changes, true);
+  AddDeferredEntitiesToNewArchetypes(changes);
+  RemoveDeferredEntitiesFromOldArchetypes(changes);
+  ProcessDeferredDestructions(changes);
+  ResizeDeferredArchetypes(changes, false);
+  ++structure_version_;
+}
 
-    if (new_size > 0) {
-      archetype->components[i].elements = reinterpret_cast<u8*>(
-          memory_manager.GetComponentArrayElementsAllocator(new_size)
-              .AllocateAligned(new_size, cmp_align));
-    }
+frame::FrameArray<internal::DeferredEntity>
+EntityManager::PopulateDeferredEntities() {
+  frame::FrameArray<internal::DeferredEntity> entities{};
+  usize command_count{0};
 
-    if (copy_size != 0) {
-      memory::CopyMemory(archetype->components[i].elements, old_cmp_elements,
-                         copy_size);
-    }
+  for (const auto& buffer : command_buffers_) {
+    command_count += buffer.GetSize();
+  }
 
-    if (old_cmp_size != 0) {
-      memory_manager.GetComponentArrayElementsAllocator(old_cmp_size)
-          .Deallocate(old_cmp_elements);
-      old_cmp_elements = nullptr;
-    }
+  if (command_count == 0) {
+    return entities;
   }
-}
 
-bool EntityManager::DoesEntityTypeContain(const EntityType& entity_type,
-                                          EntityId component_type_id) {
-  return entity_type.IsContained(component_type_id);
-}
+  frame::FrameArray<internal::EntityCommand> commands{};
+  commands.Resize(command_count);
+  usize offset{0};
 
-void EntityManager::DeferRemovingComponents(internal::DeferredEntity* entity,
-                                            const Array<EntityId>& src) {
-  for (const auto& id : src) {
-    DeferRemovingComponent(entity, id);
+  for (auto& buffer : command_buffers_) {
+    buffer.CopyTo(commands.GetData() + offset);
+    offset += buffer.GetSize();
+    buffer.Clear();
   }
-}
 
-void EntityManager::DeferRemovingComponent(internal::DeferredEntity* entity,
-                                           const EntityId& id) {
-  bool is_removal{false};
+  command_sequence_.store(0, std::memory_order_relaxed);
+
+  // Radix sorts are stable: sorting by entity after sorting by sequence keeps
+  // the commands of every entity in the order they were recorded.
+  auto* commands_begin{commands.GetData()};
+  auto* commands_end{commands_begin + command_count};
+  frame::FrameArray<internal::EntityCommand> scratch{};
+  scratch.Resize(command_count);
+
+  ParallelRadixSort(commands_begin, commands_end, scratch.GetData(),
+                    [](const internal::EntityCommand& command) {
+                      return command.sequence;
+                    });
+
+  ParallelRadixSort(commands_begin, commands_end, scratch.GetData(),
+                    [](const internal::EntityCommand& command) {
+                      return command.entity_id;
+                    });
+
+  frame::FrameArray<usize> entity_offsets{};
 
-  for (usize i{0}; i < entity->added_cmps.GetSize(); ++i) {
-    if (entity->added_cmps[i].type_descr.id == id) {
-      entity->added_cmps.RemoveFromIndex(i);
-      is_removal = true;
+  for (usize i{0}; i < command_count; ++i) {
+    if (i == 0 || commands[i].entity_id != commands[i - 1].entity_id) {
+      entity_offsets.PushBack(i);
     }
   }
 
-  if (is_removal) {
-    return;
+  const auto entity_count{entity_offsets.GetSize()};
+  entity_offsets.PushBack(command_count);
+  entities.Resize(entity_count);
+
+  job::ParallelFor(
+      {0, entity_count}, 0,
+      [&entities, &commands, &entity_offsets](usize index) {
+        const auto entity_offset{entity_offsets[index]};
+        ApplyCommands(entities[index], &commands[entity_offset],
+                      entity_offsets[index + 1] - entity_offset);
+      });
+
+  return entities;
+}
+
+void EntityManager::ApplyCommands(internal::DeferredEntity& entity,
+                                  const internal::EntityCommand* commands,
+                                  usize count) {
+  entity.id = commands[0].entity_id;
+
+  for (usize i{0}; i < count; ++i) {
+    const auto& command{commands[i]};
+
+    switch (command.type) {
+      case internal::EntityCommandType::Generate:
+        break;
+
+      case internal::EntityCommandType::AddComponent:
+        COMET_ASSERT(!entity.is_destroyed, "Entity #", entity.id,
+                     " is scheduled to be destroyed!");
+        AddDeferredComponent(entity, command.cmp_descr);
+        break;
+
+      case internal::EntityCommandType::RemoveComponent:
+        COMET_ASSERT(!entity.is_destroyed, "Entity #", entity.id,
+                     " is scheduled to be destroyed!");
+        RemoveDeferredComponent(entity, command.cmp_descr.type_descr.id);
+        break;
+
+      case internal::EntityCommandType::Destroy:
+        entity.is_destroyed = true;
+        entity.added_cmps.Clear();
+        entity.removed_cmps.Clear();
+        break;
+
+      default:
+        COMET_ASSERT(
+            false, "Unknown or unsupported entity command type: ",
+            static_cast<std::underlying_type_t<internal::EntityCommandType>>(
+                command.type),
+            "!");
+    }
   }
-
-  entity->removed_cmps.PushBack(id);
 }
 
-void EntityManager::DeferAddingParent(internal::DeferredEntity* entity,
-                                      EntityId parent_id) {
-  ComponentTypeDescr type_descr{};
-  type_descr.id = Tag(EntityIdTag::Child, parent_id);
-  type_descr.size = 0;
-  RegisterComponentType(type_descr);
-  entity->removed_cmps.RemoveFromValue(type_descr.id);
-  entity->added_cmps.EmplaceBack(type_descr, nullptr);
-}
+void EntityManager::AddDeferredComponent(internal::DeferredEntity& entity,
+                                         const ComponentDescr& cmp_descr) {
+  const auto component_type_id{cmp_descr.type_descr.id};
+  entity.removed_cmps.RemoveFromValue(component_type_id);
 
-void EntityManager::ProcessDeferredOperations() {
-  fiber::FiberLockGuard lock{deferred_mutex_};
-  RegisterDeferredComponentTypes();
+  for (auto& added_cmp : entity.added_cmps) {
+    // Case: the component was already added. The last one wins.
+    if (added_cmp.type_descr.id == component_type_id) {
+      added_cmp = cmp_descr;
+      return;
+    }
+  }
 
-  internal::DeferredChanges changes{PopulateChanges()};
+  entity.added_cmps.PushBack(cmp_descr);
+}
 
-  if (!changes.IsEmpty()) {
-    ResizeDeferredArchetypes(changes, true);
-    AddDeferredEntitiesToNewArchetypes(changes);
-    RemoveDeferredEntitiesFromOldArchetypes(changes);
-    ProcessDeferredDestructions(changes);
-    ResizeDeferredArchetypes(changes, false);
+void EntityManager::RemoveDeferredComponent(internal::DeferredEntity& entity,
+                                            EntityId component_type_id) {
+  for (usize i{0}; i < entity.added_cmps.GetSize(); ++i) {
+    // Case: the component was added in the meantime.
+    if (entity.added_cmps[i].type_descr.id == component_type_id) {
+      entity.added_cmps.RemoveFromIndex(i);
+      return;
+    }
   }
 
-  deferred_entities_ = COMET_FRAME_ALLOC_ONE_AND_POPULATE(
-      DeferredEntities, kDeferredEntityInitialCount_);
+  if (!entity.removed_cmps.IsContained(component_type_id)) {
+    entity.removed_cmps.PushBack(component_type_id);
+  }
 }
 
-void EntityManager::RegisterDeferredComponentTypes() {
+void EntityManager::RegisterDeferredComponentTypes(
+    const frame::FrameArray<internal::DeferredEntity>& entities) {
   frame::FrameHashSet<ComponentTypeDescr, internal::ComponentTypeDescrHashLogic>
       unique_cmp_type_descrs{};
 
-  COMET_ASSERT(deferred_entities_ != nullptr, "Deferred entities are null!");
-
-  for (const auto& pair : *deferred_entities_) {
-    const auto& entity{pair.value};
-
+  for (const auto& entity : entities) {
     for (const auto& cmp : entity.added_cmps) {
       unique_cmp_type_descrs.Add(cmp.type_descr);
     }
@@ -470,13 +669,11 @@ void EntityManager::RegisterDeferredComponentTypes() {
   }
 }
 
-internal::DeferredChanges EntityManager::PopulateChanges() {
+internal::DeferredChanges EntityManager::PopulateChanges(
+    const frame::FrameArray<internal::DeferredEntity>& entities) {
   internal::DeferredChanges changes{};
-  COMET_ASSERT(deferred_entities_ != nullptr, "Deferred entities are null!");
-
-  for (const auto& pair : *deferred_entities_) {
-    auto& entity{pair.value};
 
+  for (const auto& entity : entities) {
     if (entity.is_destroyed) {
       PrepareDeferredDestroyedEntity(changes, entity);
     } else {
@@ -494,8 +691,9 @@ void EntityManager::PrepareDeferredDestroyedEntity(
   auto* record{records_.TryGet(entity.id)};
 
   if (record != nullptr && record->archetype != nullptr) {
-    --changes.archetype_size_deltas[record->archetype];
-    changes.removed_from.Add(record->archetype, entity);
+    ++changes.archetype_deltas[record->archetype].removed_count;
+    changes.removed_from.EmplaceBack(&entity, record->archetype, record->row,
+                                     nullptr, kInvalidIndex);
   }
 }
 
@@ -504,268 +702,269 @@ void EntityManager::PrepareDeferredEntity(
     const internal::DeferredEntity& entity) {
   auto& record{records_[entity.id]};
   auto* old_archetype{record.archetype};
-  EntityType new_entity_type{};
-
-  if (old_archetype != nullptr) {
-    new_entity_type = old_archetype->entity_type;
-
-    if (!entity.added_cmps.IsEmpty()) {
-      new_entity_type = AddToEntityType(new_entity_type,
-                                        GenerateEntityType(entity.added_cmps));
-    }
-  } else {
-    new_entity_type = GenerateEntityType(entity.added_cmps);
-  }
+  const auto old_row{record.row};
+  auto* new_archetype{GetNextArchetype(
+      old_archetype != nullptr ? old_archetype : root_archetype_, entity)};
 
-  if (!entity.removed_cmps.IsEmpty()) {
-    new_entity_type = RemoveFromEntityType(
-        new_entity_type, GenerateEntityType(entity.removed_cmps));
+  // Case: changes cancel each other out.
+  if (new_archetype == old_archetype) {
+    return;
   }
 
-  auto* new_archetype{GetArchetype(new_entity_type)};
-
   if (old_archetype != nullptr) {
-    changes.removed_from.Add(old_archetype, entity);
-    --changes.archetype_size_deltas[old_archetype];
+    ++changes.archetype_deltas[old_archetype].removed_count;
+    changes.removed_from.EmplaceBack(&entity, old_archetype, old_row,
+                                     new_archetype, kInvalidIndex);
   }
 
-  ++changes.archetype_size_deltas[new_archetype];
-
-  changes.added_to.Add(new_archetype, entity);
+  ++changes.archetype_deltas[new_archetype].added_count;
+  changes.added_to.EmplaceBack(&entity, old_archetype, old_row, new_archetype,
+                               kInvalidIndex);
 }
 
 void EntityManager::AddDeferredEntitiesToNewArchetypes(
-    const internal::DeferredChanges& changes) {
-  struct JobParams {
-    usize new_entity_index{kInvalidIndex};
-    const internal::DeferredEntity* entity{nullptr};
-    Archetype* new_archetype{nullptr};
+    internal::DeferredChanges& changes) {
+  struct MoveRange {
+    usize begin{0};
+    usize end{0};
   };
 
-  job::CounterGuard guard{};
-  auto& scheduler{job::Scheduler::Get()};
-
-  for (auto& pair : changes.added_to.map) {
-    auto* new_archetype{pair.key};
-    auto& entities{pair.value};
-    auto base_index{new_archetype->size};
-    new_archetype->size += entities.GetSize();
-
-    for (const auto* entity : entities) {
-      auto new_entity_index{base_index++};
-
-      auto* params{COMET_FRAME_ALLOC_ONE_AND_POPULATE(
-          JobParams, new_entity_index, entity, new_archetype)};
-
-      scheduler.Kick(job::GenerateJobDescr(
-          job::JobPriority::High,
-          [](job::JobParamsHandle params_handle) {
-            auto* params{reinterpret_cast<const JobParams*>(params_handle)};
-            auto* entity{params->entity};
-            auto* new_archetype{params->new_archetype};
-            auto new_entity_index{params->new_entity_index};
-            auto& entity_manager{EntityManager::Get()};
-
-            auto& record{entity_manager.records_[entity->id]};
-            auto* old_archetype{record.archetype};
-            new_archetype->entity_ids[new_entity_index] = entity->id;
-            record.archetype = new_archetype;
-            auto old_entity_index{record.row};
-            record.row = new_entity_index;
-
-            entity_manager.TransferComponents(new_archetype, new_entity_index,
-                                              old_archetype, old_entity_index,
-                                              entity->added_cmps);
-          },
-          params, job::JobStackSize::Normal, guard.GetCounter(),
-          "add_deferred_entity"));
+  auto& moves{changes.added_to};
+
+  // Entities moving between the same archetypes are grouped and sorted by row,
+  // so that their components can be copied in bulk.
+  std::sort(moves.begin(), moves.end(), [](const auto& a, const auto& b) {
+    if (a.new_archetype != b.new_archetype) {
+      return a.new_archetype < b.new_archetype;
+    }
+
+    if (a.old_archetype != b.old_archetype) {
+      return a.old_archetype < b.old_archetype;
+    }
+
+    return a.old_row < b.old_row;
+  });
+
+  frame::FrameArray<MoveRange> ranges{};
+  const auto move_count{moves.GetSize()};
+  usize range_begin{0};
+
+  for (usize i{0}; i < move_count; ++i) {
+    auto& move{moves[i]};
+    move.new_row = move.new_archetype->size++;
+    const auto next_index{i + 1};
+
+    if (next_index == move_count ||
+        moves[next_index].new_archetype != move.new_archetype ||
+        moves[next_index].old_archetype != move.old_archetype ||
+        next_index - range_begin == kMaxEntityMoveCountPerJob_) {
+      ranges.EmplaceBack(range_begin, next_index);
+      range_begin = next_index;
     }
   }
 
-  guard.Wait();
+  job::ParallelFor({0, ranges.GetSize()}, 1,
+                   [this, &moves, &ranges](usize index) {
+                     const auto& range{ranges[index]};
+                     TransferComponents(&moves[range.begin],
+                                        range.end - range.begin);
+                   });
 }
 
 void EntityManager::RemoveDeferredEntitiesFromOldArchetypes(
     internal::DeferredChanges& changes) {
-  struct JobParams {
-    usize old_entity_index{kInvalidIndex};
-    usize swap_index{kInvalidIndex};
-    Archetype* old_archetype{nullptr};
+  struct Move {
+    usize hole_row{kInvalidIndex};
+    usize filler_row{kInvalidIndex};
+    Archetype* archetype{nullptr};
   };
 
-  job::CounterGuard guard{};
-  auto& scheduler{job::Scheduler::Get()};
+  auto& removals{changes.removed_from};
 
-  for (auto& pair : changes.removed_from.map) {
-    auto* old_archetype{pair.key};
-    auto& entities{pair.value};
-    usize offset{0};
+  std::sort(removals.begin(), removals.end(),
+            [](const auto& a, const auto& b) {
+              if (a.old_archetype != b.old_archetype) {
+                return a.old_archetype < b.old_archetype;
+              }
 
-    std::sort(entities.begin(), entities.end(),
-              [this](const auto* a, const auto* b) {
-                return records_[a->id].row < records_[b->id].row;
-              });
+              return a.old_row < b.old_row;
+            });
 
-    for (const auto* entity : entities) {
-      auto& record{records_[entity->id]};
-      auto old_entity_index{record.row};
-      auto swap_index{old_archetype->size - 1 - offset++};
+  frame::FrameArray<Move> moves{};
+  const auto removal_count{removals.GetSize()};
+  usize group_begin{0};
 
-      if (old_entity_index == swap_index) {
-        continue;
+  while (group_begin < removal_count) {
+    auto* archetype{removals[group_begin].old_archetype};
+    auto group_end{group_begin + 1};
+
+    while (group_end < removal_count &&
+           removals[group_end].old_archetype == archetype) {
+      ++group_end;
+    }
+
+    // Removed rows below the new size are filled with the rows left above it,
+    // starting from the last one.
+    const auto new_size{archetype->size - (group_end - group_begin)};
+    auto hole_index{group_begin};
+    auto removed_index{group_end};
+    auto filler_row{archetype->size};
+
+    while (hole_index < group_end && removals[hole_index].old_row < new_size) {
+      --filler_row;
+
+      // Case: the row is removed as well.
+      while (removals[removed_index - 1].old_row == filler_row) {
+        --removed_index;
+        --filler_row;
       }
 
-      auto* params{COMET_FRAME_ALLOC_ONE_AND_POPULATE(
-          JobParams, old_entity_index, swap_index, old_archetype)};
-
-      scheduler.Kick(job::GenerateJobDescr(
-          job::JobPriority::High,
-          [](job::JobParamsHandle params_handle) {
-            auto* params{reinterpret_cast<const JobParams*>(params_handle)};
-            auto* old_archetype{params->old_archetype};
-            auto old_entity_index{params->old_entity_index};
-            auto swap_index{params->swap_index};
-            auto& entity_manager{EntityManager::Get()};
-
-            auto& last_entity_record{
-                entity_manager.records_[old_archetype->entity_ids[swap_index]]};
-
-            for (usize i{0}; i < old_archetype->entity_type.GetSize(); ++i) {
-              auto& cmp_array{old_archetype->components[i]};
-              auto component_type_id{old_archetype->entity_type[i]};
-
-              auto cmp_size{
-                  entity_manager.registered_component_types_[component_type_id]
-                      .type_descr.size};
-
-              if (cmp_size > 0) {
-                auto* cmp_elements{cmp_array.elements};
-                auto* entity_data{cmp_elements + cmp_size * old_entity_index};
-                auto* last_entity_data{cmp_elements + cmp_size * swap_index};
-                memory::CopyMemory(entity_data, last_entity_data, cmp_size);
-              }
-            }
-
-            last_entity_record.row = old_entity_index;
-            old_archetype->entity_ids[old_entity_index] =
-                old_archetype->entity_ids[swap_index];
-          },
-          params, job::JobStackSize::Normal, guard.GetCounter(),
-          "remove_deferred_entity"));
+      moves.EmplaceBack(removals[hole_index++].old_row, filler_row, archetype);
     }
 
-    old_archetype->size -= entities.GetSize();
+    archetype->size = new_size;
+    group_begin = group_end;
   }
 
-  guard.Wait();
+  job::ParallelFor({0, moves.GetSize()}, 0, [this, &moves](usize index) {
+    const auto& move{moves[index]};
+    auto* archetype{move.archetype};
+    const auto filler_entity_id{GetEntityId(archetype, move.filler_row)};
+
+    for (usize i{0}; i < archetype->components.GetSize(); ++i) {
+      const auto cmp_size{archetype->components[i].size};
+
+      if (cmp_size > 0) {
+        memory::CopyMemory(GetComponentElement(archetype, i, move.hole_row),
+                           GetComponentElement(archetype, i, move.filler_row),
+                           cmp_size);
+      }
+    }
+
+    GetEntityId(archetype, move.hole_row) = filler_entity_id;
+    records_.Get(filler_entity_id).row = move.hole_row;
+    MarkRowsChanged(archetype, move.hole_row, move.hole_row + 1,
+                    GetChangeVersion());
+  });
 }
 
 void EntityManager::ProcessDeferredDestructions(
     const internal::DeferredChanges& changes) {
+  fiber::FiberSpinLockGuard lock{entity_id_lock_};
+
   for (auto entity_id : changes.destroyed_ids) {
     records_.Remove(entity_id);
     entity_id_handler_.Destroy(GetGid(entity_id));
   }
 }
 
-void EntityManager::TransferComponents(
-    Archetype* new_archetype, usize new_entity_index, Archetype* old_archetype,
-    usize old_entity_index,
-    const frame::FrameArray<ComponentDescr>& added_cmps) {
+void EntityManager::TransferComponents(const internal::EntityMove* moves,
+                                       usize count) {
+  auto* new_archetype{moves[0].new_archetype};
+  auto* old_archetype{moves[0].old_archetype};
+
+  for (usize i{0}; i < count; ++i) {
+    const auto& move{moves[i]};
+    auto& record{records_.Get(move.entity->id)};
+    record.archetype = new_archetype;
+    record.row = move.new_row;
+    GetEntityId(new_archetype, move.new_row) = move.entity->id;
+  }
+
   for (usize i{0}; i < new_archetype->entity_type.GetSize(); ++i) {
-    auto& new_cmp_array{new_archetype->components[i]};
-    auto component_type_id{new_archetype->entity_type[i]};
-    auto cmp_size{
-        registered_component_types_[component_type_id].type_descr.size};
-
-    if (cmp_size > 0) {
-      auto* new_cmp_elements{new_cmp_array.elements};
-      auto new_cmp_offset{cmp_size * new_entity_index};
-
-      auto old_cmp_index{
-          old_archetype != nullptr
-              ? old_archetype->entity_type.GetIndex(component_type_id)
-              : kInvalidIndex};
-
-      if (old_cmp_index != kInvalidIndex) {
-        CopyExistingComponent(old_archetype, old_cmp_index, old_entity_index,
-                              new_cmp_elements, new_cmp_offset, cmp_size);
-      } else {
-        CopyNewComponent(added_cmps, component_type_id, new_cmp_elements,
-                         new_cmp_offset, cmp_size);
-      }
+    if (new_archetype->components[i].size == 0) {
+      continue;
     }
-  }
-}
 
-void EntityManager::CopyExistingComponent(
-    Archetype* old_archetype, usize old_cmp_index, usize old_entity_index,
-    u8* new_cmp_elements, usize new_cmp_offset, usize cmp_size) {
-  auto& old_cmp_array{old_archetype->components[old_cmp_index]};
-  auto* old_cmp_elements{old_cmp_array.elements};
-  auto old_cmp_offset{cmp_size * old_entity_index};
+    const auto component_type_id{new_archetype->entity_type[i]};
+    const auto old_cmp_index{
+        old_archetype != nullptr
+            ? old_archetype->entity_type.GetIndex(component_type_id)
+            : kInvalidIndex};
+
+    if (old_cmp_index != kInvalidIndex) {
+      CopyExistingComponents(moves, count, old_cmp_index, i);
+    } else {
+      CopyNewComponents(moves, count, component_type_id, i);
+    }
+  }
 
-  memory::CopyMemory(new_cmp_elements + new_cmp_offset,
-                     old_cmp_elements + old_cmp_offset, cmp_size);
+  // New rows are contiguous.
+  MarkRowsChanged(new_archetype, moves[0].new_row,
+                  moves[count - 1].new_row + 1, GetChangeVersion());
 }
 
-void EntityManager::CopyNewComponent(
-    const frame::FrameArray<ComponentDescr>& added_cmps,
-    EntityId component_type_id, u8* new_cmp_elements, usize new_cmp_offset,
-    usize cmp_size) {
-  const ComponentDescr* found_added_cmp{nullptr};
+void EntityManager::CopyExistingComponents(const internal::EntityMove* moves,
+                                           usize count, usize old_cmp_index,
+                                           usize new_cmp_index) {
+  usize run_begin{0};
 
-  for (auto& added_cmp : added_cmps) {
-    if (added_cmp.type_descr.id == component_type_id) {
-      found_added_cmp = &added_cmp;
-      break;
+  // New rows are contiguous: every run of contiguous old rows is copied at
+  // once, one chunk at a time.
+  for (usize i{1}; i <= count; ++i) {
+    if (i < count && moves[i].old_row == moves[i - 1].old_row + 1) {
+      continue;
     }
-  }
 
-  COMET_ASSERT(found_added_cmp != nullptr,
-               "Tried adding a non-existing component!");
-  memory::CopyMemory(new_cmp_elements + new_cmp_offset, found_added_cmp->data,
-                     cmp_size);
+    const auto& move{moves[run_begin]};
+    CopyComponentRows(move.old_archetype, old_cmp_index, move.old_row,
+                      move.new_archetype, new_cmp_index, move.new_row,
+                      i - run_begin);
+    run_begin = i;
+  }
 }
 
-void EntityManager::ResizeDeferredArchetypes(
-    const internal::DeferredChanges& changes, bool is_growth) {
-  struct JobParams {
-    s16 delta{0};
-    Archetype* archetype{nullptr};
-  };
+void EntityManager::CopyNewComponents(const internal::EntityMove* moves,
+                                      usize count, EntityId component_type_id,
+                                      usize new_cmp_index) {
+  const auto* new_archetype{moves[0].new_archetype};
+  const auto cmp_size{new_archetype->components[new_cmp_index].size};
 
-  job::CounterGuard guard{};
-  auto& scheduler{job::Scheduler::Get()};
+  for (usize i{0}; i < count; ++i) {
+    const auto& move{moves[i]};
+    const ComponentDescr* found_added_cmp{nullptr};
 
-  for (const auto& pair : changes.archetype_size_deltas) {
-    if (pair.value == 0 || (pair.value < 0 && is_growth)) {
-      continue;
+    for (const auto& added_cmp : move.entity->added_cmps) {
+      if (added_cmp.type_descr.id == component_type_id) {
+        found_added_cmp = &added_cmp;
+        break;
+      }
     }
 
-    auto* params{
-        COMET_FRAME_ALLOC_ONE_AND_POPULATE(JobParams, pair.value, pair.key)};
-
-    scheduler.Kick(job::GenerateJobDescr(
-        job::JobPriority::High,
-        [](job::JobParamsHandle params_handle) {
-          auto* params{reinterpret_cast<const JobParams*>(params_handle)};
-          EntityManager::Get().ResizeArchetype(params->archetype,
-                                               params->delta);
-        },
-        params, job::JobStackSize::Normal, guard.GetCounter(),
-        "grow_archetype"));
+    COMET_ASSERT(found_added_cmp != nullptr,
+                 "Tried adding a non-existing component!");
+    memory::CopyMemory(
+        GetComponentElement(new_archetype, new_cmp_index, move.new_row),
+        found_added_cmp->data, cmp_size);
   }
+}
 
-  guard.Wait();
+void EntityManager::ResizeDeferredArchetypes(
+    const internal::DeferredChanges& changes, bool is_growth) {
+  // Resizing only allocates or releases whole chunks: nothing is copied.
+  for (const auto& pair : changes.archetype_deltas) {
+    auto* archetype{pair.key};
+    const auto& delta{pair.value};
+
+    if (is_growth) {
+      // Entities are added before others are removed.
+      if (delta.added_count > 0) {
+        ReserveArchetypeCapacity(archetype,
+                                 archetype->size + delta.added_count);
+      }
+    } else if (delta.removed_count > 0) {
+      ReserveArchetypeCapacity(archetype, archetype->size);
+    }
+  }
 }
 
 void EntityManager::PrepareNewFrame() {
-  COMET_ASSERT(deferred_entities_ == nullptr || deferred_entities_->IsEmpty(),
-               "No all entity changes have been processed!");
-
-  deferred_entities_ = COMET_FRAME_ALLOC_ONE_AND_POPULATE(
-      DeferredEntities, kDeferredEntityInitialCount_);
+  // Commands were allocated from the frame allocator, which has been cleared.
+  for (auto& buffer : command_buffers_) {
+    COMET_ASSERT(buffer.IsEmpty(),
+                 "Not all entity changes have been processed!");
+    buffer.Clear();
+  }
 }
 
 void EntityManager::OnEvent(const event::Event& event) {
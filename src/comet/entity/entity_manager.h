@@ -6,11 +6,14 @@
 #define COMET_COMET_ENTITY_ENTITY_MANAGER_H_
 
 // External. ///////////////////////////////////////////////////////////////////
+#include <atomic>
 #include <utility>
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "comet/core/concurrency/fiber/fiber_primitive.h"
 #include "comet/core/concurrency/job/job.h"
+#include "comet/core/concurrency/provider/thread_provider.h"
+#include "comet/core/concurrency/provider/thread_provider_manager.h"
 #include "comet/core/essentials.h"
 #include "comet/core/frame/frame_utils.h"
 #include "comet/core/hash.h"
@@ -19,7 +22,9 @@
 #include "comet/core/type/array.h"
 #include "comet/entity/archetype.h"
 #include "comet/entity/component.h"
+#include "comet/entity/entity_command_buffer.h"
 #include "comet/entity/entity_id.h"
+#include "comet/entity/entity_query.h"
 #include "comet/entity/entity_type.h"
 #include "comet/event/event.h"
 
@@ -31,7 +36,6 @@ struct DeferredEntity {
   EntityId id{kInvalidEntityId};
   frame::FrameArray<ComponentDescr> added_cmps{};
   frame::FrameArray<EntityId> removed_cmps{};
-  job::Counter* global_counter{nullptr};
 };
 
 HashValue GenerateHash(const ComponentTypeDescr& descr);
@@ -45,23 +49,29 @@ struct ComponentTypeDescrHashLogic {
   static bool AreEqual(const Hashable& a, const Hashable& b);
 };
 
-struct MovedEntities {
-  using MoveMap =
-      frame::FrameMap<Archetype*,
-                      frame::FrameArray<const internal::DeferredEntity*>>;
-  MoveMap map{};
+struct EntityMove {
+  const DeferredEntity* entity{nullptr};
+  Archetype* old_archetype{nullptr};
+  usize old_row{kInvalidIndex};
+  Archetype* new_archetype{nullptr};
+  usize new_row{kInvalidIndex};
+};
 
-  void Add(Archetype* archetype, const internal::DeferredEntity& entity);
-  bool IsEmpty() const;
+struct ArchetypeDelta {
+  usize added_count{0};
+  usize removed_count{0};
 };
 
 struct DeferredChanges {
-  using ArchetypeDeltas = frame::FrameMap<Archetype*, s16>;
+  using ArchetypeDeltas = frame::FrameMap<Archetype*, ArchetypeDelta>;
+  using EntityMoves = frame::FrameArray<EntityMove>;
   using DestroyedEntityIds = frame::FrameArray<EntityId>;
 
-  ArchetypeDeltas archetype_size_deltas{};
-  MovedEntities added_to{};
-  MovedEntities removed_from{};
+  ArchetypeDeltas archetype_deltas{};
+  // Entities joining an archetype.
+  EntityMoves added_to{};
+  // Entities leaving an archetype, destroyed ones included.
+  EntityMoves removed_from{};
   DestroyedEntityIds destroyed_ids{static_cast<usize>(16)};
 
   bool IsEmpty() const;
@@ -82,6 +92,8 @@ class EntityManager : public Manager {
   void Initialize() override;
   void Shutdown() override;
 
+  // Applies the structural changes recorded since the last call. It must be
+  // called at a synchronization point: no change may be recorded meanwhile.
   void DispatchComponentChanges();
   void WaitForEntityUpdates();
 
@@ -99,24 +111,18 @@ class EntityManager : public Manager {
     return HasComponent(entity_id, component_type_id);
   }
 
+  // Structural changes are recorded in the command buffer of the current
+  // worker, and applied by DispatchComponentChanges().
   template <typename... ComponentTypes>
   void AddComponents(EntityId entity_id, const ComponentTypes&... components) {
+    static_assert(sizeof...(ComponentTypes) > 0,
+                  "At least one component must be provided!");
     COMET_ASSERT(IsEntity(entity_id), "Entity #", entity_id,
                  " does not exist!");
-    fiber::FiberLockGuard lock{deferred_mutex_};
-    auto* entity{deferred_entities_->TryGet(entity_id)};
-
-    if (entity == nullptr) {
-      entity =
-          &deferred_entities_
-               ->Emplace(entity_id, internal::DeferredEntity{false, entity_id})
-               .value;
-    }
-
-    COMET_ASSERT(!entity->is_destroyed, "Entity #", entity_id,
-                 " is scheduled to be destroyed!");
-
-    (DeferAddingComponent(entity, components), ...);
+    internal::EntityCommand commands[sizeof...(ComponentTypes)]{};
+    usize i{0};
+    (void(commands[i++] = GenerateAddCommand(entity_id, components)), ...);
+    RecordCommands(commands, sizeof...(ComponentTypes));
   }
 
   void RemoveComponents(EntityId entity_id,
@@ -124,44 +130,30 @@ class EntityManager : public Manager {
 
   template <typename... ComponentIds>
   void RemoveComponents(EntityId entity_id, ComponentIds&&... component_ids) {
+    static_assert(sizeof...(ComponentIds) > 0,
+                  "At least one component ID must be provided!");
     COMET_ASSERT(IsEntity(entity_id), "Entity #", entity_id,
                  " does not exist!");
-    fiber::FiberLockGuard lock{deferred_mutex_};
-    auto* entity{deferred_entities_->TryGet(entity_id)};
-
-    if (entity == nullptr) {
-      entity =
-          &deferred_entities_
-               ->Emplace(entity_id, internal::DeferredEntity{false, entity_id})
-               .value;
-    }
-
-    COMET_ASSERT(!entity->is_destroyed, "Entity #", entity_id,
-                 " is scheduled to be destroyed!");
-    (DeferRemovingComponent(entity->removed_cmps,
-                            std::forward<ComponentIds>(component_ids)),
+    internal::EntityCommand commands[sizeof...(ComponentIds)]{};
+    usize i{0};
+    (void(commands[i++] = GenerateRemoveCommand(
+              entity_id, std::forward<ComponentIds>(component_ids))),
      ...);
+    RecordCommands(commands, sizeof...(ComponentIds));
   }
 
   template <typename... ComponentTypes>
   void RemoveComponents(EntityId entity_id) {
+    static_assert(sizeof...(ComponentTypes) > 0,
+                  "At least one component type must be provided!");
     COMET_ASSERT(IsEntity(entity_id), "Entity #", entity_id,
                  " does not exist!");
-    fiber::FiberLockGuard lock{deferred_mutex_};
-    auto* entity{deferred_entities_->TryGet(entity_id)};
-
-    if (entity == nullptr) {
-      entity =
-          &deferred_entities_
-               ->Emplace(entity_id, internal::DeferredEntity{false, entity_id})
-               .value;
-    }
-
-    COMET_ASSERT(!entity->is_destroyed, "Entity #", entity_id,
-                 " is scheduled to be destroyed!");
-    (DeferRemovingComponent(entity,
-                            ComponentTypeDescrGetter<ComponentTypes>::Get().id),
+    internal::EntityCommand commands[sizeof...(ComponentTypes)]{};
+    usize i{0};
+    (void(commands[i++] = GenerateRemoveCommand(
+              entity_id, ComponentTypeDescrGetter<ComponentTypes>::Get().id)),
      ...);
+    RecordCommands(commands, sizeof...(ComponentTypes));
   }
 
   template <typename ComponentType>
@@ -180,10 +172,28 @@ class EntityManager : public Manager {
         registered_component_types_.Get(component_type_id)
             .archetype_map.Get(record.archetype->id)};
 
-    return reinterpret_cast<ComponentType*>(
-               record.archetype->components[archetype_record.cmp_array_index]
-                   .elements) +
-           record.row;
+    return reinterpret_cast<ComponentType*>(GetComponentElement(
+        record.archetype, archetype_record.cmp_array_index, record.row));
+  }
+
+  // Same as GetComponent(), but the column of the component is marked as
+  // changed. Writes through GetComponent() are not seen by change filters.
+  template <typename ComponentType>
+  ComponentType* GetMutableComponent(EntityId entity_id) {
+    auto* cmp{GetComponent<ComponentType>(entity_id)};
+
+    if (cmp != nullptr) {
+      MarkChanged(cmp);
+    }
+
+    return cmp;
+  }
+
+  // Marks the column of a component stored by the entity manager as changed.
+  template <typename ComponentType>
+  void MarkChanged(const ComponentType* cmp) {
+    COMET_ASSERT(cmp != nullptr, "Component is null!");
+    MarkComponentChanged(cmp, GetChangeVersion());
   }
 
   void AddParent(EntityId entity_id, EntityId parent_id);
@@ -192,51 +202,41 @@ class EntityManager : public Manager {
   template <typename... ComponentTypes, typename Function,
             typename... ComponentTypeIds>
   void Each(const Function& func, ComponentTypeIds... component_type_ids) {
-    constexpr auto component_type_count{sizeof...(ComponentTypes)};
-    constexpr auto component_type_ids_count{sizeof...(ComponentTypeIds)};
-    constexpr auto component_id_count{component_type_count +
-                                      component_type_ids_count};
-
-    usize i{0};
-    StaticArray<EntityId, component_id_count> all_ids{};
-    (void(all_ids[i++] = component_type_ids), ...);
-    (void(all_ids[i++] = ComponentTypeDescrGetter<ComponentTypes>::Get().id),
-     ...);
+    auto all_ids{GenerateQueryIds<ComponentTypes...>(component_type_ids...)};
 
     if (all_ids.IsEmpty()) {
       for (const auto& archetype : archetypes_) {
-        for (auto entity_id : archetype->entity_ids) {
-          func(entity_id);
-        }
+        EachEntityId(archetype.get(), func);
       }
 
       return;
     }
 
-    std::sort(all_ids.begin(), all_ids.end());
-
-    for (auto& archetype : archetypes_) {
-      if (archetype->entity_type.GetSize() < all_ids.GetSize()) {
-        continue;
-      }
-
-      usize count{0};
-
-      for (auto component_type_id : archetype->entity_type) {
-        if (component_type_id == all_ids[count]) {
-          ++count;
-        }
-
-        if (count == all_ids.GetSize()) {
-          for (usize entity_index{0}; entity_index < archetype->size;
-               ++entity_index) {
-            func(archetype->entity_ids[entity_index]);
-          }
+    EachMatchingArchetype(all_ids, [&](const Archetype* archetype) {
+      EachEntityId(archetype, func);
+    });
+  }
 
-          break;
-        }
+  // Calls func(count, entity_ids, components...) once per non-empty chunk of
+  // the archetypes matching the query. Each component pointer is the start of
+  // a contiguous array of count components, in the same order as entity_ids,
+  // so systems can iterate linearly without any lookup.
+  template <typename... ComponentTypes, typename Function,
+            typename... ComponentTypeIds>
+  void EachChunk(const Function& func, ComponentTypeIds... component_type_ids) {
+    static_assert(sizeof...(ComponentTypes) > 0,
+                  "At least one component type must be provided!");
+    auto all_ids{GenerateQueryIds<ComponentTypes...>(component_type_ids...)};
+
+    EachMatchingArchetype(all_ids, [&](const Archetype* archetype) {
+      const auto chunk_count{GetChunkCount(archetype)};
+
+      for (usize i{0}; i < chunk_count; ++i) {
+        func(GetChunkSize(archetype, i),
+             static_cast<const EntityId*>(GetChunkEntityIds(archetype, i)),
+             GetComponentArray<ComponentTypes>(archetype, i)...);
       }
-    }
+    });
   }
 
   template <typename... ComponentTypes, typename Function>
@@ -244,15 +244,44 @@ class EntityManager : public Manager {
     Each<ComponentTypes...>(func, Tag(EntityIdTag::Child, parent_id));
   }
 
+  // Registers a persistent query matching the archetypes which contain all
+  // the given component types. Its archetype list is then kept up to date
+  // every time a new archetype is generated. Queries are unregistered when the
+  // entity manager shuts down.
+  template <typename... ComponentTypes, typename... ComponentTypeIds>
+  void RegisterQuery(EntityQuery& query,
+                     ComponentTypeIds... component_type_ids) {
+    auto all_ids{GenerateQueryIds<ComponentTypes...>(component_type_ids...)};
+    PopulateQuery(query, all_ids.GetData(), all_ids.GetSize());
+  }
+
+  void UnregisterQuery(EntityQuery& query);
+
+  // Incremented every time entities move between archetypes, which
+  // invalidates component pointers.
+  usize GetStructureVersion() const noexcept;
+  // Version stored in the columns written to from now on.
+  ChangeVersion GetChangeVersion() const noexcept;
+  // Returns the current change version, and increments it. Systems filtering
+  // changes keep the returned value, and process the columns changed at or
+  // after it the next time they run. A write racing with the increment may
+  // still be stamped with the returned version: it is then picked up by the
+  // next run instead of being lost, at the cost of visiting the columns
+  // written to just before the increment twice.
+  ChangeVersion AdvanceChangeVersion() noexcept;
+
  private:
-  inline static constexpr usize kDeferredEntityInitialCount_{128};
+  // Above this count, moves to the same archetype are split between several
+  // jobs.
+  inline static constexpr usize kMaxEntityMoveCountPerJob_{1024};
 
   template <typename EntityType>
   Archetype* GetArchetype(EntityType&& entity_type) {
-    for (auto& archetype : archetypes_) {
-      if (archetype->entity_type == entity_type) {
-        return archetype.get();
-      }
+    const entity::EntityType* entity_type_p{&entity_type};
+    auto** found_archetype{archetype_index_.TryGet(entity_type_p)};
+
+    if (found_archetype != nullptr) {
+      return *found_archetype;
     }
 
     auto archetype{GenerateArchetype()};
@@ -261,10 +290,14 @@ class EntityManager : public Manager {
 
     for (const auto component_type_id : archetype->entity_type) {
       archetype_id = HashCombine(archetype_id, component_type_id);
-      archetype->components.EmplaceBack(ComponentArray{nullptr, 0});
+      const auto& type_descr{
+          registered_component_types_.Get(component_type_id).type_descr};
+      archetype->components.EmplaceBack(
+          ComponentColumn{0, type_descr.size, type_descr.align});
     }
 
     archetype->id = archetype_id;
+    InitializeChunkLayout(archetype.get());
     usize i{0};
 
     for (const auto component_type_id : archetype->entity_type) {
@@ -274,34 +307,69 @@ class EntityManager : public Manager {
     }
 
     auto* archetype_p{archetype.get()};
+    fiber::FiberLockGuard lock{query_mutex_};
     archetypes_.PushBack(std::move(archetype));
+    archetype_index_.Emplace(&archetype_p->entity_type, archetype_p);
+
+    for (auto* query : queries_) {
+      query->TryAdd(archetype_p);
+    }
+
     return archetype_p;
   }
 
+  template <typename... ComponentTypes, typename... ComponentTypeIds>
+  auto GenerateQueryIds(ComponentTypeIds... component_type_ids) const {
+    constexpr auto component_type_count{sizeof...(ComponentTypes)};
+    constexpr auto component_type_ids_count{sizeof...(ComponentTypeIds)};
+    constexpr auto component_id_count{component_type_count +
+                                      component_type_ids_count};
+
+    usize i{0};
+    StaticArray<EntityId, component_id_count> all_ids{};
+    (void(all_ids[i++] = component_type_ids), ...);
+    (void(all_ids[i++] = ComponentTypeDescrGetter<ComponentTypes>::Get().id),
+     ...);
+    std::sort(all_ids.begin(), all_ids.end());
+    return all_ids;
+  }
+
+  template <typename QueryIds, typename Function>
+  void EachMatchingArchetype(const QueryIds& all_ids, const Function& func) {
+    for (auto& archetype : archetypes_) {
+      if (internal::IsArchetypeMatching(*archetype, all_ids)) {
+        func(archetype.get());
+      }
+    }
+  }
+
+  void PopulateQuery(EntityQuery& query, const EntityId* component_type_ids,
+                     usize count);
+  Archetype* GetNextArchetype(Archetype* archetype,
+                              const internal::DeferredEntity& entity);
+  Archetype* GetArchetypeWith(Archetype* archetype, EntityId component_type_id);
+  Archetype* GetArchetypeWithout(Archetype* archetype,
+                                 EntityId component_type_id);
+
   void RegisterComponentType(const ComponentTypeDescr& type_descr);
   void RegisterComponentTypes(
       const Array<ComponentDescr>& component_type_descrs);
   void UnregisterComponentType(EntityId component_type_id);
-  void ResizeArchetype(Archetype* archetype, s16 delta);
   void ReserveArchetypeCapacity(Archetype* archetype, usize capacity);
   bool DoesEntityTypeContain(const EntityType& entity_type,
                              EntityId component_type_id);
 
-  template <typename... ComponentTypes>
-  void DeferAddingComponents(internal::DeferredEntity* entity,
-                             const ComponentTypes&... component) {
-    (DeferAddingComponent(entity, component), ...);
-  }
-
   template <typename ComponentType>
-  void DeferAddingComponent(internal::DeferredEntity* entity,
-                            const ComponentType& component) {
+  static internal::EntityCommand GenerateAddCommand(
+      EntityId entity_id, const ComponentType& component) {
     const auto& type_descr{ComponentTypeDescrGetter<ComponentType>::Get()};
-    entity->removed_cmps.RemoveFromValue(type_descr.id);
+    internal::EntityCommand command{};
+    command.entity_id = entity_id;
+    command.type = internal::EntityCommandType::AddComponent;
+    command.cmp_descr.type_descr = type_descr;
 
     if (type_descr.size == 0) {
-      entity->added_cmps.EmplaceBack(type_descr, nullptr);
-      return;
+      return command;
     }
 
     auto& frame_allocator{frame::GetFrameAllocator()};
@@ -310,56 +378,71 @@ class EntityManager : public Manager {
         frame_allocator.AllocateAligned(type_descr.size, type_descr.align))};
     memory::CopyMemory(data, reinterpret_cast<const u8*>(&component),
                        type_descr.size);
-    entity->added_cmps.EmplaceBack(type_descr, data);
+    command.cmp_descr.data = data;
+    return command;
   }
 
-  void DeferRemovingComponents(internal::DeferredEntity* entity,
-                               const Array<EntityId>& src);
-  void DeferRemovingComponent(internal::DeferredEntity* entity,
-                              const EntityId& id);
-
-  void DeferAddingParent(internal::DeferredEntity* entity, EntityId parent_id);
+  static internal::EntityCommand GenerateRemoveCommand(
+      EntityId entity_id, EntityId component_type_id);
+  void RecordCommand(EntityId entity_id, internal::EntityCommandType type);
+  void RecordCommands(internal::EntityCommand* commands, usize count);
+  internal::EntityCommandBuffer& ReserveCommands(usize count);
 
   // Deferred operations.
   void ProcessDeferredOperations();
-  void RegisterDeferredComponentTypes();
-  internal::DeferredChanges PopulateChanges();
+  frame::FrameArray<internal::DeferredEntity> PopulateDeferredEntities();
+  static void ApplyCommands(internal::DeferredEntity& entity,
+                            const internal::EntityCommand* commands,
+                            usize count);
+  static void AddDeferredComponent(internal::DeferredEntity& entity,
+                                   const ComponentDescr& cmp_descr);
+  static void RemoveDeferredComponent(internal::DeferredEntity& entity,
+                                      EntityId component_type_id);
+  void RegisterDeferredComponentTypes(
+      const frame::FrameArray<internal::DeferredEntity>& entities);
+  internal::DeferredChanges PopulateChanges(
+      const frame::FrameArray<internal::DeferredEntity>& entities);
   void PrepareDeferredDestroyedEntity(internal::DeferredChanges& changes,
                                       const internal::DeferredEntity& entity);
   void PrepareDeferredEntity(internal::DeferredChanges& changes,
                              const internal::DeferredEntity& entity);
-  void AddDeferredEntitiesToNewArchetypes(
-      const internal::DeferredChanges& changes);
+  void AddDeferredEntitiesToNewArchetypes(internal::DeferredChanges& changes);
   void RemoveDeferredEntitiesFromOldArchetypes(
       internal::DeferredChanges& changes);
   void ProcessDeferredDestructions(const internal::DeferredChanges& changes);
-  void TransferComponents(Archetype* new_archetype, usize new_entity_index,
-                          Archetype* old_archetype, usize old_entity_index,
-                          const frame::FrameArray<ComponentDescr>& added_cmps);
-  void CopyExistingComponent(Archetype* old_archetype, usize old_cmp_index,
-                             usize old_entity_index, u8* new_cmp_elements,
-                             usize new_cmp_offset, usize cmp_size);
-  void CopyNewComponent(const frame::FrameArray<ComponentDescr>& added_cmps,
-                        EntityId component_type_id, u8* new_cmp_elements,
-                        usize new_cmp_offset, usize cmp_size);
+  void TransferComponents(const internal::EntityMove* moves, usize count);
+  void CopyExistingComponents(const internal::EntityMove* moves, usize count,
+                              usize old_cmp_index, usize new_cmp_index);
+  void CopyNewComponents(const internal::EntityMove* moves, usize count,
+                         EntityId component_type_id, usize new_cmp_index);
   void ResizeDeferredArchetypes(const internal::DeferredChanges& changes,
                                 bool is_growth);
   void PrepareNewFrame();
   void OnEvent(const event::Event& event);
 
-  using DeferredEntities = frame::FrameMap<EntityId, internal::DeferredEntity>;
+  using EntityCommandBuffers =
+      thread::FiberThreadProvider<internal::EntityCommandBuffer>;
 
   bool is_update_{false};
-  fiber::FiberMutex deferred_mutex_{};
+  usize structure_version_{0};
+  std::atomic<ChangeVersion> change_version_{kInitialChangeVersion + 1};
+  std::atomic<internal::EntityCommandSequence> command_sequence_{0};
+  EntityCommandBuffers command_buffers_{
+      thread::ThreadProviderManager::Get()
+          .AllocateFiberProvider<internal::EntityCommandBuffer>()};
   fiber::FiberMutex update_mutex_{};
   fiber::FiberCV update_cv_{};
+  fiber::FiberMutex query_mutex_{};
   Archetype* root_archetype_{nullptr};
   Array<ArchetypePtr> archetypes_{};
+  ArchetypeIndex archetype_index_{};
+  Array<EntityQuery*> queries_{};
+  // Entities may be generated from any worker during a frame.
+  mutable fiber::FiberSpinLock entity_id_lock_{};
   gid::BreedHandler entity_id_handler_{};
   gid::BreedHandler component_id_handler_{};
   Records records_{};
   RegisteredComponentTypeMap registered_component_types_{};
-  DeferredEntities* deferred_entities_{};
 };
 }  // namespace entity
 }  // namespace comet
@@ -23,33 +23,21 @@ EntityMemoryManager::EntityMemoryManager()
       medium_block_allocator_{kMediumAllocatorAllocationUnit_, 512,
                               memory::kEngineMemoryTagEntity},
       big_block_allocator_{kBigAllocatorAllocationUnit_, 512,
-                           memory::kEngineMemoryTagEntity},
-      cmp_small_block_allocator_{kCmpSmallAllocatorAllocationUnit_, 512,
-                                 memory::kEngineMemoryTagEntity},
-      cmp_medium_block_allocator_{kCmpMediumAllocatorAllocationUnit_, 512,
-                                  memory::kEngineMemoryTagEntity},
-      cmp_big_block_allocator_{kCmpBigAllocatorAllocationUnit_, 512,
-                               memory::kEngineMemoryTagEntity} {}
+                           memory::kEngineMemoryTagEntity} {}
 
 void EntityMemoryManager::Initialize() {
   Manager::Initialize();
   small_block_allocator_.Initialize();
   medium_block_allocator_.Initialize();
   big_block_allocator_.Initialize();
-
-  cmp_small_block_allocator_.Initialize();
-  cmp_medium_block_allocator_.Initialize();
-  cmp_big_block_allocator_.Initialize();
+  chunk_allocator_.Initialize();
 }
 
 void EntityMemoryManager::Shutdown() {
   small_block_allocator_.Destroy();
   medium_block_allocator_.Destroy();
   big_block_allocator_.Destroy();
-
-  cmp_small_block_allocator_.Destroy();
-  cmp_medium_block_allocator_.Destroy();
-  cmp_big_block_allocator_.Destroy();
+  chunk_allocator_.Destroy();
 
   Manager::Shutdown();
 }
@@ -58,11 +46,13 @@ memory::Allocator& EntityMemoryManager::GetRecordAllocator() noexcept {
   return small_block_allocator_;
 }
 
-memory::Allocator& EntityMemoryManager::GetComponentArrayAllocator() noexcept {
+memory::Allocator&
+EntityMemoryManager::GetComponentColumnAllocator() noexcept {
   return small_block_allocator_;
 }
 
-memory::Allocator& EntityMemoryManager::GetEntityIdAllocator() noexcept {
+memory::Allocator&
+EntityMemoryManager::GetArchetypeChunkPointerAllocator() noexcept {
   return small_block_allocator_;
 }
 
@@ -96,17 +86,9 @@ memory::Allocator& EntityMemoryManager::GetArchetypeAllocator() noexcept {
   return medium_block_allocator_;
 }
 
-memory::Allocator& EntityMemoryManager::GetComponentArrayElementsAllocator(
-    usize size) noexcept {
-  if (size <= kCmpSmallAllocatorAllocationUnit_) {
-    return cmp_small_block_allocator_;
-  }
-
-  if (size <= kCmpMediumAllocatorAllocationUnit_) {
-    return cmp_medium_block_allocator_;
-  }
-
-  return cmp_big_block_allocator_;
+ArchetypeChunkAllocator&
+EntityMemoryManager::GetArchetypeChunkAllocator() noexcept {
+  return chunk_allocator_;
 }
 }  // namespace entity
 }  // namespace comet
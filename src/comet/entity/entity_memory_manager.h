@@ -10,6 +10,7 @@
 #include "comet/core/memory/allocator/allocator.h"
 #include "comet/core/memory/allocator/free_list_allocator.h"
 #include "comet/entity/archetype.h"
+#include "comet/entity/archetype_chunk_allocator.h"
 
 namespace comet {
 namespace entity {
@@ -28,8 +29,8 @@ class EntityMemoryManager : public Manager {
   void Shutdown() override;
 
   memory::Allocator& GetRecordAllocator() noexcept;
-  memory::Allocator& GetComponentArrayAllocator() noexcept;
-  memory::Allocator& GetEntityIdAllocator() noexcept;
+  memory::Allocator& GetComponentColumnAllocator() noexcept;
+  memory::Allocator& GetArchetypeChunkPointerAllocator() noexcept;
   memory::Allocator& GetComponentDescrAllocator() noexcept;
   memory::Allocator& GetRecordsAllocator() noexcept;
   memory::Allocator& GetRegisteredComponentTypeMapAllocator() noexcept;
@@ -38,24 +39,19 @@ class EntityMemoryManager : public Manager {
   memory::Allocator& GetArchetypePointerAllocator() noexcept;
   memory::Allocator& GetArchetypeAllocator() noexcept;
 
-  memory::Allocator& GetComponentArrayElementsAllocator(usize size) noexcept;
+  ArchetypeChunkAllocator& GetArchetypeChunkAllocator() noexcept;
 
  private:
   static inline constexpr usize kSmallAllocatorAllocationUnit_{16};
   static inline constexpr usize kMediumAllocatorAllocationUnit_{64};
   static inline constexpr usize kBigAllocatorAllocationUnit_{sizeof(Archetype)};
 
-  static inline constexpr usize kCmpSmallAllocatorAllocationUnit_{128};
-  static inline constexpr usize kCmpMediumAllocatorAllocationUnit_{1024};
-  static inline constexpr usize kCmpBigAllocatorAllocationUnit_{16384};
-
   memory::FiberFreeListAllocator small_block_allocator_{};
   memory::FiberFreeListAllocator medium_block_allocator_{};
   memory::FiberFreeListAllocator big_block_allocator_{};
-
-  memory::FiberFreeListAllocator cmp_small_block_allocator_{};
-  memory::FiberFreeListAllocator cmp_medium_block_allocator_{};
-  memory::FiberFreeListAllocator cmp_big_block_allocator_{};
+  ArchetypeChunkAllocator chunk_allocator_{
+      kArchetypeChunkSize, kArchetypeChunkAlignment,
+      memory::kEngineMemoryTagEntityChunk};
 };
 }  // namespace entity
 }  // namespace comet
@@ -0,0 +1,52 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Header. /////////////////////////////////////////////////////////////////////
+#include "entity_query.h"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/entity/entity_memory_manager.h"
+
+namespace comet {
+namespace entity {
+bool EntityQuery::IsRegistered() const noexcept { return is_registered_; }
+
+const Array<Archetype*>& EntityQuery::GetArchetypes() const noexcept {
+  return archetypes_;
+}
+
+void EntityQuery::Populate(const EntityId* component_type_ids, usize count) {
+  auto& memory_manager{EntityMemoryManager::Get()};
+  component_type_ids_ = EntityType{&memory_manager.GetEntityTypeAllocator()};
+  component_type_ids_.Reserve(count);
+
+  for (usize i{0}; i < count; ++i) {
+    component_type_ids_.PushBack(component_type_ids[i]);
+  }
+
+  CleanEntityType(component_type_ids_);
+  archetypes_ =
+      Array<Archetype*>{&memory_manager.GetArchetypePointerAllocator()};
+}
+
+void EntityQuery::Clear() {
+  component_type_ids_.Destroy();
+  archetypes_.Destroy();
+  is_registered_ = false;
+}
+
+bool EntityQuery::TryAdd(Archetype* archetype) {
+  if (!internal::IsArchetypeMatching(*archetype, component_type_ids_)) {
+    return false;
+  }
+
+  archetypes_.PushBack(archetype);
+  return true;
+}
+}  // namespace entity
+}  // namespace comet
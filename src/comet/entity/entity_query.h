@@ -0,0 +1,162 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+#ifndef COMET_COMET_ENTITY_ENTITY_QUERY_H_
+#define COMET_COMET_ENTITY_ENTITY_QUERY_H_
+
+#include "comet/core/concurrency/job/parallel.h"
+#include "comet/core/essentials.h"
+#include "comet/core/frame/frame_utils.h"
+#include "comet/core/type/array.h"
+#include "comet/entity/archetype.h"
+#include "comet/entity/entity_id.h"
+
+namespace comet {
+namespace entity {
+namespace internal {
+// Both the entity type of the archetype and the query IDs must be sorted.
+template <typename QueryIds>
+bool IsArchetypeMatching(const Archetype& archetype, const QueryIds& all_ids) {
+  const auto id_count{all_ids.GetSize()};
+
+  if (id_count == 0) {
+    return true;
+  }
+
+  if (archetype.entity_type.GetSize() < id_count) {
+    return false;
+  }
+
+  usize count{0};
+
+  for (auto component_type_id : archetype.entity_type) {
+    if (component_type_id == all_ids[count] && ++count == id_count) {
+      return true;
+    }
+  }
+
+  return false;
+}
+}  // namespace internal
+
+// Persistent query, which caches the archetypes matching its component types.
+// Once registered to the entity manager, it is updated every time a new
+// archetype is generated, so that iterating over it never scans the whole
+// archetype list.
+class EntityQuery {
+ public:
+  EntityQuery() = default;
+  EntityQuery(const EntityQuery&) = delete;
+  EntityQuery(EntityQuery&&) = delete;
+  EntityQuery& operator=(const EntityQuery&) = delete;
+  EntityQuery& operator=(EntityQuery&&) = delete;
+  ~EntityQuery() = default;
+
+  template <typename Function>
+  void Each(const Function& func) const {
+    for (const auto* archetype : archetypes_) {
+      EachEntityId(archetype, func);
+    }
+  }
+
+  // See EntityManager::EachChunk().
+  template <typename... ComponentTypes, typename Function>
+  void EachChunk(const Function& func) const {
+    static_assert(sizeof...(ComponentTypes) > 0,
+                  "At least one component type must be provided!");
+
+    for (const auto* archetype : archetypes_) {
+      const auto chunk_count{GetChunkCount(archetype)};
+
+      for (usize i{0}; i < chunk_count; ++i) {
+        func(GetChunkSize(archetype, i),
+             static_cast<const EntityId*>(GetChunkEntityIds(archetype, i)),
+             GetComponentArray<ComponentTypes>(archetype, i)...);
+      }
+    }
+  }
+
+  // Same as EachChunk(), but only the chunks in which a column of one of the
+  // given types was written to at or after the since version are visited.
+  // Returns the number of rows which were skipped.
+  template <typename... ComponentTypes, typename Function>
+  usize EachChangedChunk(ChangeVersion since, const Function& func) const {
+    static_assert(sizeof...(ComponentTypes) > 0,
+                  "At least one component type must be provided!");
+    usize skipped_row_count{0};
+
+    for (const auto* archetype : archetypes_) {
+      const auto chunk_count{GetChunkCount(archetype)};
+
+      for (usize i{0}; i < chunk_count; ++i) {
+        const auto chunk_size{GetChunkSize(archetype, i)};
+
+        if (!IsChunkChanged<ComponentTypes...>(archetype, i, since)) {
+          skipped_row_count += chunk_size;
+          continue;
+        }
+
+        func(chunk_size,
+             static_cast<const EntityId*>(GetChunkEntityIds(archetype, i)),
+             GetComponentArray<ComponentTypes>(archetype, i)...);
+      }
+    }
+
+    return skipped_row_count;
+  }
+
+  // Same as EachChunk(), but chunks are processed in parallel, each of them by
+  // a single job. No structural change may be dispatched meanwhile.
+  template <typename... ComponentTypes, typename Function>
+  void ParallelEachChunk(const Function& func) const {
+    static_assert(sizeof...(ComponentTypes) > 0,
+                  "At least one component type must be provided!");
+
+    struct ChunkRef {
+      const Archetype* archetype{nullptr};
+      usize chunk_index{kInvalidIndex};
+    };
+
+    frame::FrameArray<ChunkRef> chunk_refs{};
+
+    for (const auto* archetype : archetypes_) {
+      const auto chunk_count{GetChunkCount(archetype)};
+
+      for (usize i{0}; i < chunk_count; ++i) {
+        chunk_refs.EmplaceBack(archetype, i);
+      }
+    }
+
+    job::ParallelFor({0, chunk_refs.GetSize()}, 1,
+                     [&chunk_refs, &func](usize index) {
+                       const auto& chunk_ref{chunk_refs[index]};
+                       const auto* archetype{chunk_ref.archetype};
+                       const auto chunk_index{chunk_ref.chunk_index};
+
+                       func(GetChunkSize(archetype, chunk_index),
+                            static_cast<const EntityId*>(
+                                GetChunkEntityIds(archetype, chunk_index)),
+                            GetComponentArray<ComponentTypes>(
+                                archetype, chunk_index)...);
+                     });
+  }
+
+  bool IsRegistered() const noexcept;
+  const Array<Archetype*>& GetArchetypes() const noexcept;
+
+ private:
+  friend class EntityManager;
+
+  void Populate(const EntityId* component_type_ids, usize count);
+  void Clear();
+  bool TryAdd(Archetype* archetype);
+
+  bool is_registered_{false};
+  EntityType component_type_ids_{};
+  Array<Archetype*> archetypes_{};
+};
+}  // namespace entity
+}  // namespace comet
+
+#endif  // COMET_COMET_ENTITY_ENTITY_QUERY_H_
@@ -0,0 +1,223 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Header. /////////////////////////////////////////////////////////////////////
+#include "system_scheduler.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <utility>
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/c_string.h"
+#include "comet/core/concurrency/job/job_utils.h"
+#include "comet/core/date.h"
+#include "comet/math/math_common.h"
+#include "comet/profiler/profiler.h"
+
+namespace comet {
+namespace entity {
+SystemScheduler& SystemScheduler::Get() {
+  static SystemScheduler singleton{};
+  return singleton;
+}
+
+void SystemScheduler::Initialize() {
+  Manager::Initialize();
+  systems_ = Array<internal::System>{&allocator_};
+  schedule_ = SystemSchedule{&allocator_};
+  last_schedule_ = SystemSchedule{&allocator_};
+  job_params_ = Array<JobParams>{&allocator_};
+  system_id_counter_ = 0;
+  is_graph_dirty_ = false;
+}
+
+void SystemScheduler::Shutdown() {
+  systems_.Destroy();
+  schedule_.Destroy();
+  last_schedule_.Destroy();
+  graph_.Destroy();
+  job_params_.Destroy();
+  system_id_counter_ = 0;
+  is_graph_dirty_ = false;
+  Manager::Shutdown();
+}
+
+void SystemScheduler::Unregister(SystemId system_id) {
+  fiber::FiberLockGuard lock{mutex_};
+
+  for (usize i{0}; i < systems_.GetSize(); ++i) {
+    if (systems_[i].id == system_id) {
+      systems_.RemoveFromIndex(i);
+      is_graph_dirty_ = true;
+      return;
+    }
+  }
+
+  COMET_ASSERT(false, "Tried to unregister unknown system #", system_id, "!");
+}
+
+void SystemScheduler::Update(frame::FramePacket* packet) {
+  COMET_PROFILE("SystemScheduler::Update");
+  fiber::FiberLockGuard lock{mutex_};
+
+  if (is_graph_dirty_) {
+    BuildGraph();
+  }
+
+  if (!systems_.IsEmpty()) {
+    for (auto& entry : schedule_) {
+      entry.start_time_ns = 0;
+      entry.end_time_ns = 0;
+    }
+
+    packet_ = packet;
+    graph_.KickAndWait();
+    packet_ = nullptr;
+  }
+
+  PublishSchedule();
+}
+
+SystemSchedule SystemScheduler::GetLastSchedule() const {
+  fiber::FiberSpinLockGuard guard{last_schedule_lock_};
+  return last_schedule_;
+}
+
+usize SystemScheduler::GetSystemCount() const noexcept {
+  return systems_.GetSize();
+}
+
+void SystemScheduler::OnSystem(job::JobParamsHandle params_handle) {
+  const auto* params{static_cast<const JobParams*>(params_handle)};
+  auto* scheduler{params->scheduler};
+  const auto& system{scheduler->systems_[params->system_index]};
+  auto& entry{scheduler->schedule_[params->system_index]};
+
+  entry.start_time_ns = GetTimestampNanoSeconds();
+  system.func(scheduler->packet_, system.params_handle);
+  entry.end_time_ns = GetTimestampNanoSeconds();
+}
+
+SystemId SystemScheduler::Register(
+    const schar* label, SystemFunc func, SystemParamsHandle params_handle,
+    EntityType reads, EntityType writes,
+    std::initializer_list<SystemId> dependencies,
+    job::JobStackSize stack_size) {
+  COMET_ASSERT(func != nullptr, "Function of system \"", label,
+               "\" is null!");
+  fiber::FiberLockGuard lock{mutex_};
+
+  internal::System system{};
+  Copy(system.label, label, math::Min(GetLength(label), kMaxSystemLabelLen));
+  system.id = system_id_counter_++;
+  system.func = func;
+  system.params_handle = params_handle;
+  system.stack_size = stack_size;
+  system.reads = std::move(reads);
+  system.writes = std::move(writes);
+  system.dependencies = Array<SystemId>{&allocator_};
+
+  for (auto dependency_id : dependencies) {
+    COMET_ASSERT(dependency_id < system.id, "System \"", label,
+                 "\" depends on system #", dependency_id,
+                 ", which must be registered first!");
+    system.dependencies.PushBack(dependency_id);
+  }
+
+  auto system_id{system.id};
+  systems_.PushBack(std::move(system));
+  is_graph_dirty_ = true;
+  return system_id;
+}
+
+void SystemScheduler::BuildGraph() {
+  const auto system_count{systems_.GetSize()};
+  schedule_.Clear();
+  schedule_.Reserve(system_count);
+  graph_.Clear();
+  // Nodes point to the parameters: they must not move once the graph is built.
+  job_params_.Resize(system_count);
+
+  for (usize i{0}; i < system_count; ++i) {
+    auto& system{systems_[i]};
+    system.level = 0;
+    usize dependency_count{0};
+
+    auto& params{job_params_[i]};
+    params.scheduler = this;
+    params.system_index = i;
+    const auto node_id{graph_.AddNode(
+        job::GenerateJobDescr(job::JobPriority::High, OnSystem, &params,
+                              system.stack_size, nullptr, system.label))};
+
+    // Conflicting systems run in registration order, which keeps the graph
+    // acyclic.
+    for (usize j{0}; j < i; ++j) {
+      auto& other{systems_[j]};
+
+      if (!system.dependencies.IsContained(other.id) &&
+          !AreConflicting(system, other)) {
+        continue;
+      }
+
+      graph_.AddDependency(j, node_id);
+      ++dependency_count;
+      system.level = math::Max(system.level, other.level + 1);
+    }
+
+    SystemScheduleEntry entry{};
+    Copy(entry.label, system.label, kMaxSystemLabelLen + 1);
+    entry.id = system.id;
+    entry.level = system.level;
+    entry.dependency_count = dependency_count;
+    schedule_.PushBack(entry);
+  }
+
+  is_graph_dirty_ = false;
+}
+
+void SystemScheduler::PublishSchedule() {
+  fiber::FiberSpinLockGuard guard{last_schedule_lock_};
+  last_schedule_.Clear();
+  last_schedule_.Reserve(schedule_.GetSize());
+
+  for (const auto& entry : schedule_) {
+    last_schedule_.PushBack(entry);
+  }
+}
+
+bool SystemScheduler::AreConflicting(const internal::System& a,
+                                     const internal::System& b) const {
+  return AreIntersecting(a.writes, b.writes) ||
+         AreIntersecting(a.writes, b.reads) ||
+         AreIntersecting(a.reads, b.writes);
+}
+
+bool SystemScheduler::AreIntersecting(const EntityType& a,
+                                      const EntityType& b) {
+  // Entity types are sorted.
+  usize i{0};
+  usize j{0};
+
+  while (i < a.GetSize() && j < b.GetSize()) {
+    if (a[i] == b[j]) {
+      return true;
+    }
+
+    if (a[i] < b[j]) {
+      ++i;
+    } else {
+      ++j;
+    }
+  }
+
+  return false;
+}
+}  // namespace entity
+}  // namespace comet
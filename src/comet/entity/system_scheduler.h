@@ -0,0 +1,166 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+#ifndef COMET_COMET_ENTITY_SYSTEM_SCHEDULER_H_
+#define COMET_COMET_ENTITY_SYSTEM_SCHEDULER_H_
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <initializer_list>
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/concurrency/fiber/fiber_primitive.h"
+#include "comet/core/concurrency/job/job.h"
+#include "comet/core/concurrency/job/job_graph.h"
+#include "comet/core/essentials.h"
+#include "comet/core/frame/frame_packet.h"
+#include "comet/core/manager.h"
+#include "comet/core/memory/allocator/platform_allocator.h"
+#include "comet/core/type/array.h"
+#include "comet/entity/component.h"
+#include "comet/entity/entity_id.h"
+#include "comet/entity/entity_type.h"
+
+namespace comet {
+namespace entity {
+using SystemId = usize;
+constexpr auto kInvalidSystemId{static_cast<SystemId>(-1)};
+constexpr usize kMaxSystemLabelLen{63};
+
+using SystemParamsHandle = void*;
+using SystemFunc = void (*)(frame::FramePacket*, SystemParamsHandle);
+
+// Component types accessed by a system. See SystemScheduler::Register().
+template <typename... ComponentTypes>
+struct Read {};
+
+template <typename... ComponentTypes>
+struct Write {};
+
+struct SystemScheduleEntry {
+  schar label[kMaxSystemLabelLen + 1]{'\0'};
+  SystemId id{kInvalidSystemId};
+  // Length of the longest dependency chain leading to the system: systems
+  // with the same level may run concurrently.
+  usize level{0};
+  usize dependency_count{0};
+  u64 start_time_ns{0};
+  u64 end_time_ns{0};
+};
+
+using SystemSchedule = Array<SystemScheduleEntry>;
+
+namespace internal {
+template <typename Access>
+struct SystemAccessIds;
+
+template <template <typename...> typename Access, typename... ComponentTypes>
+struct SystemAccessIds<Access<ComponentTypes...>> {
+  static EntityType Generate(memory::Allocator* allocator) {
+    EntityType ids{allocator};
+    ids.Reserve(sizeof...(ComponentTypes));
+    (ids.PushBack(ComponentTypeDescrGetter<ComponentTypes>::Get().id), ...);
+    CleanEntityType(ids);
+    return ids;
+  }
+};
+
+struct System {
+  schar label[kMaxSystemLabelLen + 1]{'\0'};
+  SystemId id{kInvalidSystemId};
+  SystemFunc func{nullptr};
+  SystemParamsHandle params_handle{nullptr};
+  job::JobStackSize stack_size{job::JobStackSize::Unknown};
+  EntityType reads{};
+  EntityType writes{};
+  Array<SystemId> dependencies{};
+  // Populated when the graph is built.
+  usize level{0};
+};
+}  // namespace internal
+
+// Runs the registered systems every frame. Each system declares the component
+// types it reads and writes: two systems conflict if one of them writes a
+// component type that the other one accesses. Conflicting systems run in
+// registration order, while independent ones are dispatched concurrently on
+// the fiber scheduler. Dependencies which cannot be expressed with component
+// types (e.g., frame packet data) can be declared explicitly.
+// The job graph is only rebuilt when systems change, and is kicked again on
+// every update.
+class SystemScheduler : public Manager {
+ public:
+  static SystemScheduler& Get();
+
+  SystemScheduler() = default;
+  SystemScheduler(const SystemScheduler&) = delete;
+  SystemScheduler(SystemScheduler&&) = delete;
+  SystemScheduler& operator=(const SystemScheduler&) = delete;
+  SystemScheduler& operator=(SystemScheduler&&) = delete;
+  virtual ~SystemScheduler() = default;
+
+  void Initialize() override;
+  void Shutdown() override;
+
+  // Usage: Register<Read<A, B>, Write<C>>("label", func).
+  // Explicit dependencies must be registered beforehand.
+  template <typename ReadAccess = Read<>, typename WriteAccess = Write<>>
+  SystemId Register(const schar* label, SystemFunc func,
+                    SystemParamsHandle params_handle = nullptr,
+                    std::initializer_list<SystemId> dependencies = {},
+                    job::JobStackSize stack_size = job::JobStackSize::Normal) {
+    return Register(
+        label, func, params_handle,
+        internal::SystemAccessIds<ReadAccess>::Generate(&allocator_),
+        internal::SystemAccessIds<WriteAccess>::Generate(&allocator_),
+        dependencies, stack_size);
+  }
+
+  void Unregister(SystemId system_id);
+
+  // Runs all the systems, and returns once all of them are done.
+  void Update(frame::FramePacket* packet);
+
+  // Copy of the schedule of the last completed update, in registration order.
+  // Safe to call while an update runs.
+  SystemSchedule GetLastSchedule() const;
+  usize GetSystemCount() const noexcept;
+
+ private:
+  struct JobParams {
+    SystemScheduler* scheduler{nullptr};
+    usize system_index{kInvalidIndex};
+  };
+
+  static void OnSystem(job::JobParamsHandle params_handle);
+
+  SystemId Register(const schar* label, SystemFunc func,
+                    SystemParamsHandle params_handle, EntityType reads,
+                    EntityType writes,
+                    std::initializer_list<SystemId> dependencies,
+                    job::JobStackSize stack_size);
+  void BuildGraph();
+  void PublishSchedule();
+  bool AreConflicting(const internal::System& a,
+                      const internal::System& b) const;
+  static bool AreIntersecting(const EntityType& a, const EntityType& b);
+
+  bool is_graph_dirty_{false};
+  SystemId system_id_counter_{0};
+  memory::PlatformAllocator allocator_{memory::kEngineMemoryTagEntity};
+  fiber::FiberMutex mutex_{};
+  Array<internal::System> systems_{};
+  // Written by the systems while they run.
+  SystemSchedule schedule_{};
+  // Copied from schedule_ once all the systems of an update are done.
+  SystemSchedule last_schedule_{};
+  mutable fiber::FiberSpinLock last_schedule_lock_{};
+  // Packet of the current update.
+  frame::FramePacket* packet_{nullptr};
+  // One per system, pointed to by the nodes of the graph.
+  Array<JobParams> job_params_{};
+  job::JobGraph graph_{&allocator_};
+};
+}  // namespace entity
+}  // namespace comet
+
+#endif  // COMET_COMET_ENTITY_SYSTEM_SCHEDULER_H_
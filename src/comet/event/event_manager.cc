@@ -15,7 +15,6 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "comet/core/memory/memory.h"
-#include "comet/math/math_common.h"
 
 namespace comet {
 namespace event {
@@ -25,12 +24,7 @@ EventManager& EventManager::Get() {
 }
 
 EventManager::EventManager()
-    : listener_allocator_{
-          math::Max(
-              sizeof(Pair<stringid::StringId, Array<EventListener>>),
-              math::Max(sizeof(EventListener),
-                        sizeof(Pair<EventListenerId, stringid::StringId>))),
-          4096, memory::kEngineMemoryTagEvent} {}
+    : listener_allocator_{memory::kEngineMemoryTagEvent} {}
 
 void EventManager::Initialize() {
   Manager::Initialize();
@@ -12,10 +12,10 @@
 #include "comet/core/conf/configuration_manager.h"
 #include "comet/core/essentials.h"
 #include "comet/core/manager.h"
-#include "comet/core/memory/allocator/free_list_allocator.h"
 #include "comet/core/memory/allocator/platform_allocator.h"
+#include "comet/core/memory/allocator/size_class_allocator.h"
 #include "comet/core/type/array.h"
-#include "comet/core/type/map.h"
+#include "comet/core/type/flat_map.h"
 #include "comet/core/type/ring_queue.h"
 #include "comet/event/event.h"
 
@@ -30,8 +30,8 @@ struct EventListener {
   Callback callback{};
 };
 
-using EventListeners = Map<stringid::StringId, Array<EventListener>>;
-using IdEventTypeMap = Map<EventListenerId, stringid::StringId>;
+using EventListeners = FlatMap<stringid::StringId, Array<EventListener>>;
+using IdEventTypeMap = FlatMap<EventListenerId, stringid::StringId>;
 using EventQueue = LockFreeMPSCRingQueue<EventPtr>;
 
 class EventManager : public Manager {
@@ -76,7 +76,7 @@ class EventManager : public Manager {
   EventListeners listeners_{};
   IdEventTypeMap id_event_type_map_{};
   EventQueue event_queue_{};
-  memory::FiberFreeListAllocator listener_allocator_;
+  memory::FiberSizeClassAllocator listener_allocator_;
 
   // Platform allocator is used because it is only allocated once, during engine
   // startup.
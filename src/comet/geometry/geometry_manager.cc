@@ -24,7 +24,7 @@ GeometryManager& GeometryManager::Get() {
 }
 
 GeometryManager::GeometryManager()
-    : mesh_allocator_{sizeof(Mesh), 1024, memory::kEngineMemoryTagGeometry},
+    : mesh_allocator_{memory::kEngineMemoryTagGeometry},
       mesh_pair_allocator_{sizeof(Pair<MeshId, Mesh*>), 1024,
                            memory::kEngineMemoryTagGeometry},
       vertex_allocator_{sizeof(Vertex), 1024, memory::kEngineMemoryTagGeometry},
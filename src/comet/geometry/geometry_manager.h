@@ -9,6 +9,7 @@
 #include "comet/core/essentials.h"
 #include "comet/core/manager.h"
 #include "comet/core/memory/allocator/free_list_allocator.h"
+#include "comet/core/memory/allocator/pool_allocator.h"
 #include "comet/core/type/map.h"
 #include "comet/core/type/tstring.h"
 #include "comet/entity/entity_id.h"
@@ -78,7 +79,7 @@ class GeometryManager : public Manager {
   Mesh* GenerateInternal(const resource::MeshResource* resource);
   void Destroy(Mesh* mesh, bool is_destroying_handler);
 
-  memory::FiberFreeListAllocator mesh_allocator_;
+  memory::PoolAllocator<Mesh> mesh_allocator_;
   memory::FiberFreeListAllocator mesh_pair_allocator_;
   memory::FiberFreeListAllocator vertex_allocator_;
   memory::FiberFreeListAllocator index_allocator_;
@@ -241,6 +241,88 @@ Mat4 ComposeTransform(const Vec3& translation, const Quat& rotation,
          ToScaleMatrix(scale);
 }
 
+void ComposeTransforms(const TransformChannels& channels, Mat4* out,
+                       usize count) {
+#ifdef COMET_ARCH_X86
+  SSEComposeTransforms(channels, out, count);
+#else
+  ScalarComposeTransforms(channels, out, count);
+#endif  // COMET_ARCH_X86
+}
+
+void ScalarComposeTransforms(const TransformChannels& channels, Mat4* out,
+                             usize count, usize offset) {
+  for (auto i{offset}; i < count; ++i) {
+    out[i] = ComposeTransform(
+        Vec3{channels.translations_x[i], channels.translations_y[i],
+             channels.translations_z[i]},
+        Quat{channels.rotations_w[i], channels.rotations_x[i],
+             channels.rotations_y[i], channels.rotations_z[i]},
+        channels.scales[i]);
+  }
+}
+
+#ifdef COMET_ARCH_X86
+void SSEComposeTransforms(const TransformChannels& channels, Mat4* out,
+                          usize count) {
+  const auto one{_mm_set1_ps(1.0f)};
+  const auto two{_mm_set1_ps(2.0f)};
+  const auto zero{_mm_setzero_ps()};
+  usize i{0};
+
+  // Each lane holds one transform: 4 transforms are composed at once.
+  for (; i + 4 <= count; i += 4) {
+    const auto x{_mm_loadu_ps(channels.rotations_x + i)};
+    const auto y{_mm_loadu_ps(channels.rotations_y + i)};
+    const auto z{_mm_loadu_ps(channels.rotations_z + i)};
+    const auto w{_mm_loadu_ps(channels.rotations_w + i)};
+    const auto scale{_mm_loadu_ps(channels.scales + i)};
+    const auto scale2{_mm_mul_ps(two, scale)};
+
+    const auto xx{_mm_mul_ps(x, x)};
+    const auto yy{_mm_mul_ps(y, y)};
+    const auto zz{_mm_mul_ps(z, z)};
+    const auto xy{_mm_mul_ps(x, y)};
+    const auto xz{_mm_mul_ps(x, z)};
+    const auto yz{_mm_mul_ps(y, z)};
+    const auto wx{_mm_mul_ps(w, x)};
+    const auto wy{_mm_mul_ps(w, y)};
+    const auto wz{_mm_mul_ps(w, z)};
+
+    // Same as ToRotationMatrix(), scaled. columns[j][k] holds row k of column
+    // j for all 4 transforms: transposing it gives column j of each transform.
+    __m128 columns[4][4]{
+        {_mm_mul_ps(scale,
+                    _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz)))),
+         _mm_mul_ps(scale2, _mm_add_ps(xy, wz)),
+         _mm_mul_ps(scale2, _mm_sub_ps(xz, wy)), zero},
+        {_mm_mul_ps(scale2, _mm_sub_ps(xy, wz)),
+         _mm_mul_ps(scale,
+                    _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz)))),
+         _mm_mul_ps(scale2, _mm_add_ps(yz, wx)), zero},
+        {_mm_mul_ps(scale2, _mm_add_ps(xz, wy)),
+         _mm_mul_ps(scale2, _mm_sub_ps(yz, wx)),
+         _mm_mul_ps(scale,
+                    _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy)))),
+         zero},
+        {_mm_loadu_ps(channels.translations_x + i),
+         _mm_loadu_ps(channels.translations_y + i),
+         _mm_loadu_ps(channels.translations_z + i), one}};
+
+    for (usize j{0}; j < 4; ++j) {
+      auto& column{columns[j]};
+      _MM_TRANSPOSE4_PS(column[0], column[1], column[2], column[3]);
+
+      for (usize k{0}; k < 4; ++k) {
+        _mm_storeu_ps(&out[i + k][j][0], column[k]);
+      }
+    }
+  }
+
+  ScalarComposeTransforms(channels, out, count, i);
+}
+#endif  // COMET_ARCH_X86
+
 void DecomposeTransform(const Mat4& transform, Vec3& translation_out,
                         Quat& rotation_out, Vec3& scale_out) {
   translation_out = ExtractTranslation(transform);
@@ -36,6 +36,29 @@ Quat ExtractRotation(const Mat4& transform);
 Mat4 ComposeTransform(const Vec3& translation, const Quat& rotation,
                       const Vec3& scale);
 Mat4 ComposeTransform(const Vec3& translation, const Quat& rotation, f32 scale);
+
+// Components of transforms with uniform scales, one array per component.
+struct TransformChannels {
+  const f32* translations_x{nullptr};
+  const f32* translations_y{nullptr};
+  const f32* translations_z{nullptr};
+  const f32* rotations_x{nullptr};
+  const f32* rotations_y{nullptr};
+  const f32* rotations_z{nullptr};
+  const f32* rotations_w{nullptr};
+  const f32* scales{nullptr};
+};
+
+// Batch version of ComposeTransform() with uniform scales. The scalar version
+// skips the transforms before offset, which SIMD versions have composed.
+void ComposeTransforms(const TransformChannels& channels, Mat4* out,
+                       usize count);
+void ScalarComposeTransforms(const TransformChannels& channels, Mat4* out,
+                             usize count, usize offset = 0);
+#ifdef COMET_ARCH_X86
+void SSEComposeTransforms(const TransformChannels& channels, Mat4* out,
+                          usize count);
+#endif  // COMET_ARCH_X86
 void DecomposeTransform(const Mat4& transform, Vec3& translation_out,
                         Quat& rotation_out, Vec3& scale_out);
 void DecomposeTransform(const Mat4& transform, Vec3& translation_out,
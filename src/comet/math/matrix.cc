@@ -10,6 +10,86 @@
 #include "matrix.h"
 ////////////////////////////////////////////////////////////////////////////////
 
+// External. ///////////////////////////////////////////////////////////////////
+#ifdef COMET_ARCH_X86
+#include <immintrin.h>
+#endif  // COMET_ARCH_X86
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/processor.h"
+
 namespace comet {
-namespace math {}  // namespace math
+namespace math {
+void MultiplyMatrices(const Mat4* a, const Mat4* b, Mat4* out, usize count) {
+  MultiplyMatrices(a, b, sizeof(Mat4), out, count);
+}
+
+void MultiplyMatrices(const Mat4* a, const Mat4* b, usize b_stride, Mat4* out,
+                      usize count) {
+#ifdef COMET_ARCH_X86
+  if (IsAVXSupported()) {
+    AVXMultiplyMatrices(a, b, b_stride, out, count);
+  } else {
+    SSEMultiplyMatrices(a, b, b_stride, out, count);
+  }
+#else
+  ScalarMultiplyMatrices(a, b, b_stride, out, count);
+#endif  // COMET_ARCH_X86
+}
+
+void ScalarMultiplyMatrices(const Mat4* a, const Mat4* b, usize b_stride,
+                            Mat4* out, usize count) {
+  const auto* b_bytes{reinterpret_cast<const u8*>(b)};
+
+  for (usize i{0}; i < count; ++i) {
+    out[i] = a[i] * *reinterpret_cast<const Mat4*>(b_bytes + i * b_stride);
+  }
+}
+
+#ifdef COMET_ARCH_X86
+void SSEMultiplyMatrices(const Mat4* a, const Mat4* b, usize b_stride,
+                         Mat4* out, usize count) {
+  const auto* b_bytes{reinterpret_cast<const u8*>(b)};
+
+  for (usize i{0}; i < count; ++i) {
+    MultiplyMatrix(a[i], *reinterpret_cast<const Mat4*>(b_bytes + i * b_stride),
+                   out[i]);
+  }
+}
+
+void AVXMultiplyMatrices(const Mat4* a, const Mat4* b, usize b_stride,
+                         Mat4* out, usize count) {
+  const auto* b_bytes{reinterpret_cast<const u8*>(b)};
+
+  for (usize i{0}; i < count; ++i) {
+    const auto* a_data{&a[i][0][0]};
+    const auto* b_data{
+        &(*reinterpret_cast<const Mat4*>(b_bytes + i * b_stride))[0][0]};
+    auto* out_data{&out[i][0][0]};
+
+    // Each column of a is duplicated in both lanes, while each lane holds a
+    // different column of b: two columns of the result are computed at once.
+    const auto a0{_mm256_broadcast_ps(reinterpret_cast<const __m128*>(a_data))};
+    const auto a1{
+        _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a_data + 4))};
+    const auto a2{
+        _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a_data + 8))};
+    const auto a3{
+        _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a_data + 12))};
+
+    for (usize j{0}; j < 16; j += 8) {
+      const auto b_columns{_mm256_loadu_ps(b_data + j)};
+      const auto columns{_mm256_add_ps(
+          _mm256_add_ps(
+              _mm256_mul_ps(a0, _mm256_permute_ps(b_columns, 0x00)),
+              _mm256_mul_ps(a1, _mm256_permute_ps(b_columns, 0x55))),
+          _mm256_add_ps(
+              _mm256_mul_ps(a2, _mm256_permute_ps(b_columns, 0xaa)),
+              _mm256_mul_ps(a3, _mm256_permute_ps(b_columns, 0xff))))};
+      _mm256_storeu_ps(out_data + j, columns);
+    }
+  }
+}
+#endif  // COMET_ARCH_X86
+}  // namespace math
 }  // namespace comet
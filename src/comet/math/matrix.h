@@ -26,6 +26,51 @@ using Mat3x2 = glm::mat3x2;
 using Mat3x4 = glm::mat3x4;
 using Mat4x2 = glm::mat4x2;
 using Mat4x3 = glm::mat4x3;
+
+// out = a * b. out may alias a or b.
+inline void MultiplyMatrix(const Mat4& a, const Mat4& b, Mat4& out) {
+#ifdef COMET_ARCH_X86
+  const auto* a_data{&a[0][0]};
+  const auto* b_data{&b[0][0]};
+  const auto a0{_mm_loadu_ps(a_data)};
+  const auto a1{_mm_loadu_ps(a_data + 4)};
+  const auto a2{_mm_loadu_ps(a_data + 8)};
+  const auto a3{_mm_loadu_ps(a_data + 12)};
+  __m128 columns[4];
+
+  for (usize i{0}; i < 4; ++i) {
+    const auto* b_column{b_data + i * 4};
+    columns[i] = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(a0, _mm_set1_ps(b_column[0])),
+                   _mm_mul_ps(a1, _mm_set1_ps(b_column[1]))),
+        _mm_add_ps(_mm_mul_ps(a2, _mm_set1_ps(b_column[2])),
+                   _mm_mul_ps(a3, _mm_set1_ps(b_column[3]))));
+  }
+
+  auto* out_data{&out[0][0]};
+
+  for (usize i{0}; i < 4; ++i) {
+    _mm_storeu_ps(out_data + i * 4, columns[i]);
+  }
+#else
+  out = a * b;
+#endif  // COMET_ARCH_X86
+}
+
+// Batch kernels: out[i] = a[i] * b[i]. b_stride is the distance in bytes
+// between two matrices of b, so that matrices stored in larger structures can
+// be read in place. out must not alias a or b.
+void MultiplyMatrices(const Mat4* a, const Mat4* b, Mat4* out, usize count);
+void MultiplyMatrices(const Mat4* a, const Mat4* b, usize b_stride, Mat4* out,
+                      usize count);
+void ScalarMultiplyMatrices(const Mat4* a, const Mat4* b, usize b_stride,
+                            Mat4* out, usize count);
+#ifdef COMET_ARCH_X86
+void SSEMultiplyMatrices(const Mat4* a, const Mat4* b, usize b_stride,
+                         Mat4* out, usize count);
+void AVXMultiplyMatrices(const Mat4* a, const Mat4* b, usize b_stride,
+                         Mat4* out, usize count);
+#endif  // COMET_ARCH_X86
 }  // namespace math
 }  // namespace comet
 
@@ -34,6 +34,10 @@ void PhysicsManager::Shutdown() {
   fixed_delta_time_ = .01666f;
   lag_ = 0;
   current_frame_packet_ = nullptr;
+  transform_hierarchy_.Destroy();
+  transform_hierarchy_version_ = 0;
+  is_transform_hierarchy_dirty_.store(true, std::memory_order_release);
+  transform_stats_ = {};
   Manager::Shutdown();
 };
 
@@ -45,14 +49,20 @@ void PhysicsManager::Update(frame::FramePacket* packet) {
 
   constexpr u32 kMaxSteps{5};
   u32 step_count{0};
+  TransformStats transform_stats{};
 
   while (lag_ >= fixed_delta_time_ && step_count < kMaxSteps) {
-    UpdateEntityTransforms(packet);
+    transform_stats = transform_stats + UpdateEntityTransforms(packet);
     lag_ -= fixed_delta_time_;
     current_time_ += fixed_delta_time_;
     ++step_count;
   }
 
+  {
+    fiber::FiberSpinLockGuard guard{transform_stats_lock_};
+    transform_stats_ = transform_stats;
+  }
+
   counter_ += step_count;
   packet->time = current_time_;
   packet->lag = lag_;
@@ -66,23 +76,8 @@ void PhysicsManager::Update(frame::FramePacket* packet) {
   }
 }
 
-void PhysicsManager::UpdateTree(
-    frame::FramePacket* packet, entity::EntityId parent_entity_id,
-    const TransformComponent* parent_transform_cmp) const {
-  auto& entity_manager{entity::EntityManager::Get()};
-
-  entity_manager.EachChild<TransformComponent>(
-      [&](auto entity_id) {
-        auto* transform_cmp{
-            entity_manager.GetComponent<TransformComponent>(entity_id)};
-
-        transform_cmp->global =
-            transform_cmp->local * parent_transform_cmp->global;
-
-        packet->RegisterDirtyTransform(entity_id, transform_cmp);
-        UpdateTree(packet, entity_id, transform_cmp);
-      },
-      parent_entity_id);
+void PhysicsManager::InvalidateTransformHierarchy() {
+  is_transform_hierarchy_dirty_.store(true, std::memory_order_release);
 }
 
 TransformRootComponent PhysicsManager::GenerateTransformRootComponent() const {
@@ -123,28 +118,24 @@ f64 PhysicsManager::GetFrameTime() const noexcept {
   return frame_rate_ == 0 ? 0.0 : (1.0 / static_cast<f64>(frame_rate_));
 }
 
-void PhysicsManager::UpdateEntityTransforms(frame::FramePacket* packet) {
-  auto& entity_manager{entity::EntityManager::Get()};
-
-  entity_manager.Each<TransformRootComponent, TransformComponent>(
-      [&](auto entity_id) {
-        auto* root_cmp{
-            entity_manager.GetComponent<TransformRootComponent>(entity_id)};
-
-        if (!root_cmp->is_child_dirty) {
-          return;
-        }
+TransformStats PhysicsManager::GetTransformStats() const {
+  fiber::FiberSpinLockGuard guard{transform_stats_lock_};
+  return transform_stats_;
+}
 
-        auto* transform_cmp{
-            entity_manager.GetComponent<TransformComponent>(entity_id)};
+TransformStats PhysicsManager::UpdateEntityTransforms(
+    frame::FramePacket* packet) {
+  const auto version{entity::EntityManager::Get().GetStructureVersion()};
 
-        if (transform_cmp->is_dirty) {
-          transform_cmp->global = transform_cmp->local;
-        }
+  // Components might have moved, or the hierarchy changed.
+  if (is_transform_hierarchy_dirty_.exchange(false,
+                                             std::memory_order_acq_rel) ||
+      version != transform_hierarchy_version_) {
+    transform_hierarchy_.Rebuild();
+    transform_hierarchy_version_ = version;
+  }
 
-        UpdateTree(packet, entity_id, transform_cmp);
-        root_cmp->is_child_dirty = false;
-      });
+  return transform_hierarchy_.Update(packet);
 }
 }  // namespace physics
 }  // namespace comet
@@ -5,12 +5,20 @@
 #ifndef COMET_COMET_PHYSICS_PHYSICS_MANAGER_H_
 #define COMET_COMET_PHYSICS_PHYSICS_MANAGER_H_
 
+// External. ///////////////////////////////////////////////////////////////////
+#include <atomic>
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/concurrency/fiber/fiber_primitive.h"
 #include "comet/core/essentials.h"
 #include "comet/core/frame/frame_packet.h"
 #include "comet/core/manager.h"
+#include "comet/core/memory/allocator/platform_allocator.h"
+#include "comet/core/memory/memory.h"
 #include "comet/entity/entity_id.h"
 #include "comet/math/matrix.h"
 #include "comet/physics/component/transform_component.h"
+#include "comet/physics/transform_hierarchy.h"
 
 namespace comet {
 namespace physics {
@@ -28,8 +36,8 @@ class PhysicsManager : public Manager {
   void Initialize() override;
   void Shutdown() override;
   void Update(frame::FramePacket* packet);
-  void UpdateTree(frame::FramePacket* packet, entity::EntityId parent_entity_id,
-                  const TransformComponent* parent_transform_cmp) const;
+  // Must be called when the parent or the root of a transform changes.
+  void InvalidateTransformHierarchy();
 
   TransformRootComponent GenerateTransformRootComponent() const;
   TransformComponent GenerateTransformComponent(
@@ -44,9 +52,11 @@ class PhysicsManager : public Manager {
 
   u32 GetFrameRate() const noexcept;
   f64 GetFrameTime() const noexcept;
+  // Counters of all the fixed steps of the last frame.
+  TransformStats GetTransformStats() const;
 
  private:
-  void UpdateEntityTransforms(frame::FramePacket* packet);
+  TransformStats UpdateEntityTransforms(frame::FramePacket* packet);
 
   u32 counter_{0};
   u32 frame_rate_{0};
@@ -56,6 +66,12 @@ class PhysicsManager : public Manager {
   f64 fixed_delta_time_{.01666f};  // 60 Hz refresh by default.
   f64 lag_{.0};
   frame::FramePacket* current_frame_packet_{nullptr};
+  std::atomic<bool> is_transform_hierarchy_dirty_{true};
+  usize transform_hierarchy_version_{0};
+  memory::PlatformAllocator allocator_{memory::kEngineMemoryTagEntity};
+  TransformHierarchy transform_hierarchy_{&allocator_};
+  mutable fiber::FiberSpinLock transform_stats_lock_{};
+  TransformStats transform_stats_{};
 };
 }  // namespace physics
 }  // namespace comet
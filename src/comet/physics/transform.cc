@@ -12,15 +12,19 @@
 
 #include "comet/entity/entity_manager.h"
 #include "comet/math/geometry.h"
+#include "comet/physics/physics_manager.h"
 
 namespace comet {
 namespace physics {
 namespace internal {
 void MakeDirty(TransformComponent* cmp) {
+  auto& entity_manager{entity::EntityManager::Get()};
   cmp->is_dirty = true;
+  entity_manager.MarkChanged(cmp);
 
-  entity::EntityManager::Get()
-      .GetComponent<TransformRootComponent>(cmp->root_entity_id)
+  // The chunk of the root must be marked too, or the tree is skipped.
+  entity_manager
+      .GetMutableComponent<TransformRootComponent>(cmp->root_entity_id)
       ->is_child_dirty = true;
 }
 }  // namespace internal
@@ -68,11 +72,13 @@ void ResetLocalTransform(TransformComponent* cmp) {
 void SetParentEntity(TransformComponent* cmp, entity::EntityId new_parent) {
   cmp->parent_entity_id = new_parent;
   internal::MakeDirty(cmp);
+  PhysicsManager::Get().InvalidateTransformHierarchy();
 }
 
 void SetRootEntity(TransformComponent* cmp, entity::EntityId new_root) {
   cmp->root_entity_id = new_root;
   internal::MakeDirty(cmp);
+  PhysicsManager::Get().InvalidateTransformHierarchy();
 }
 }  // namespace physics
 }  // namespace comet
@@ -0,0 +1,298 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Header. /////////////////////////////////////////////////////////////////////
+#include "transform_hierarchy.h"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/concurrency/job/parallel.h"
+#include "comet/core/frame/frame_utils.h"
+#include "comet/entity/entity_manager.h"
+#include "comet/profiler/profiler.h"
+
+namespace comet {
+namespace physics {
+TransformStats operator+(const TransformStats& a, const TransformStats& b) {
+  TransformStats stats{};
+  stats.update_count = a.update_count + b.update_count;
+  stats.tree_count = a.tree_count + b.tree_count;
+  stats.updated_tree_count = a.updated_tree_count + b.updated_tree_count;
+  stats.row_count = a.row_count + b.row_count;
+  stats.skipped_row_count = a.skipped_row_count + b.skipped_row_count;
+  stats.updated_row_count = a.updated_row_count + b.updated_row_count;
+  return stats;
+}
+
+TransformHierarchy::TransformHierarchy(memory::Allocator* allocator)
+    : allocator_{allocator},
+      entity_ids_{allocator},
+      transform_cmps_{allocator},
+      parent_indices_{allocator},
+      dirty_flags_{allocator},
+      root_cmps_{allocator},
+      tree_offsets_{allocator},
+      root_chunks_{allocator} {}
+
+void TransformHierarchy::Rebuild() {
+  COMET_PROFILE("TransformHierarchy::Rebuild");
+  auto& entity_manager{entity::EntityManager::Get()};
+
+  if (!root_query_.IsRegistered()) {
+    entity_manager.RegisterQuery<TransformRootComponent, TransformComponent>(
+        root_query_);
+  }
+
+  if (!transform_query_.IsRegistered()) {
+    entity_manager.RegisterQuery<TransformComponent>(transform_query_);
+  }
+
+  // Gather all the nodes.
+  frame::FrameArray<entity::EntityId> node_ids{};
+  frame::FrameArray<TransformComponent*> node_cmps{};
+
+  transform_query_.EachChunk<TransformComponent>(
+      [&](usize count, const entity::EntityId* entity_ids,
+          TransformComponent* transform_cmps) {
+        for (usize i{0}; i < count; ++i) {
+          node_ids.PushBack(entity_ids[i]);
+          node_cmps.PushBack(&transform_cmps[i]);
+        }
+      });
+
+  const auto node_count{node_ids.GetSize()};
+  frame::FrameMap<entity::EntityId, usize> node_indices{};
+  node_indices.Reserve(node_count);
+
+  for (usize i{0}; i < node_count; ++i) {
+    node_indices.Emplace(node_ids[i], i);
+  }
+
+  // Link every node to its parent, and store the children of each node
+  // contiguously.
+  frame::FrameArray<usize> parent_nodes{};
+  frame::FrameArray<usize> child_offsets{};
+  parent_nodes.Resize(node_count);
+  child_offsets.Resize(node_count + 1);
+
+  for (usize i{0}; i <= node_count; ++i) {
+    child_offsets[i] = 0;
+  }
+
+  for (usize i{0}; i < node_count; ++i) {
+    const auto* parent_node{
+        node_indices.TryGet(node_cmps[i]->parent_entity_id)};
+    parent_nodes[i] = parent_node != nullptr ? *parent_node : kInvalidIndex;
+
+    if (parent_node != nullptr) {
+      ++child_offsets[*parent_node + 1];
+    }
+  }
+
+  for (usize i{1}; i <= node_count; ++i) {
+    child_offsets[i] += child_offsets[i - 1];
+  }
+
+  frame::FrameArray<usize> children{};
+  frame::FrameArray<usize> child_cursors{};
+  children.Resize(node_count);
+  child_cursors.Resize(node_count);
+
+  for (usize i{0}; i < node_count; ++i) {
+    child_cursors[i] = child_offsets[i];
+  }
+
+  for (usize i{0}; i < node_count; ++i) {
+    const auto parent_node{parent_nodes[i]};
+
+    if (parent_node != kInvalidIndex) {
+      children[child_cursors[parent_node]++] = i;
+    }
+  }
+
+  // Flatten each tree with a breadth-first traversal, which sorts its rows by
+  // depth.
+  entity_ids_.Clear();
+  transform_cmps_.Clear();
+  parent_indices_.Clear();
+  root_cmps_.Clear();
+  tree_offsets_.Clear();
+  root_chunks_.Clear();
+  entity_ids_.Reserve(node_count);
+  transform_cmps_.Reserve(node_count);
+  parent_indices_.Reserve(node_count);
+
+  frame::FrameArray<usize> row_nodes{};
+  row_nodes.Reserve(node_count);
+
+  root_query_.EachChunk<TransformRootComponent>(
+      [&](usize count, const entity::EntityId* entity_ids,
+          TransformRootComponent* root_cmps) {
+        const auto tree_begin{root_cmps_.GetSize()};
+
+        for (usize i{0}; i < count; ++i) {
+          const auto* root_node{node_indices.TryGet(entity_ids[i])};
+
+          // Nested roots are updated with the tree they belong to.
+          if (root_node == nullptr ||
+              parent_nodes[*root_node] != kInvalidIndex) {
+            continue;
+          }
+
+          const auto row_begin{entity_ids_.GetSize()};
+          tree_offsets_.PushBack(row_begin);
+          root_cmps_.PushBack(&root_cmps[i]);
+
+          row_nodes.PushBack(*root_node);
+          entity_ids_.PushBack(node_ids[*root_node]);
+          transform_cmps_.PushBack(node_cmps[*root_node]);
+          parent_indices_.PushBack(kInvalidIndex);
+
+          for (auto row{row_begin}; row < entity_ids_.GetSize(); ++row) {
+            const auto node{row_nodes[row]};
+
+            for (auto j{child_offsets[node]}; j < child_offsets[node + 1];
+                 ++j) {
+              const auto child_node{children[j]};
+              row_nodes.PushBack(child_node);
+              entity_ids_.PushBack(node_ids[child_node]);
+              transform_cmps_.PushBack(node_cmps[child_node]);
+              parent_indices_.PushBack(row);
+            }
+          }
+        }
+
+        if (root_cmps_.GetSize() > tree_begin) {
+          root_chunks_.EmplaceBack(root_cmps, tree_begin,
+                                   root_cmps_.GetSize());
+        }
+      });
+
+  tree_offsets_.PushBack(entity_ids_.GetSize());
+  dirty_flags_.Resize(entity_ids_.GetSize());
+
+  // New or moved nodes have never been propagated.
+  is_full_update_ = true;
+}
+
+TransformStats TransformHierarchy::Update(frame::FramePacket* packet) {
+  COMET_PROFILE("TransformHierarchy::Update");
+  const auto since{last_change_version_};
+  last_change_version_ = entity::EntityManager::Get().AdvanceChangeVersion();
+
+  TransformStats stats{};
+  stats.update_count = 1;
+  stats.tree_count = GetTreeCount();
+  stats.row_count = GetNodeCount();
+
+  frame::FrameArray<usize> tree_indices{};
+  tree_indices.Reserve(GetTreeCount());
+
+  for (const auto& root_chunk : root_chunks_) {
+    if (!is_full_update_ &&
+        entity::GetComponentChangeVersion(root_chunk.root_cmps) < since) {
+      stats.skipped_row_count += tree_offsets_[root_chunk.tree_end] -
+                                 tree_offsets_[root_chunk.tree_begin];
+      continue;
+    }
+
+    for (auto i{root_chunk.tree_begin}; i < root_chunk.tree_end; ++i) {
+      tree_indices.PushBack(i);
+    }
+  }
+
+  stats = stats + job::ParallelReduce(
+                      {0, tree_indices.GetSize()}, 0, TransformStats{},
+                      [this, packet, &tree_indices](usize index) {
+                        return UpdateTree(tree_indices[index], packet);
+                      },
+                      [](const TransformStats& a, const TransformStats& b) {
+                        return a + b;
+                      });
+
+  is_full_update_ = false;
+  return stats;
+}
+
+void TransformHierarchy::Destroy() {
+  auto& entity_manager{entity::EntityManager::Get()};
+  entity_manager.UnregisterQuery(root_query_);
+  entity_manager.UnregisterQuery(transform_query_);
+
+  entity_ids_.Destroy();
+  transform_cmps_.Destroy();
+  parent_indices_.Destroy();
+  dirty_flags_.Destroy();
+  root_cmps_.Destroy();
+  tree_offsets_.Destroy();
+  root_chunks_.Destroy();
+  is_full_update_ = false;
+  last_change_version_ = entity::kInitialChangeVersion;
+}
+
+usize TransformHierarchy::GetNodeCount() const noexcept {
+  return entity_ids_.GetSize();
+}
+
+usize TransformHierarchy::GetTreeCount() const noexcept {
+  return root_cmps_.GetSize();
+}
+
+TransformStats TransformHierarchy::UpdateTree(usize tree_index,
+                                              frame::FramePacket* packet) {
+  TransformStats stats{};
+  auto* root_cmp{root_cmps_[tree_index]};
+
+  if (!root_cmp->is_child_dirty && !is_full_update_) {
+    return stats;
+  }
+
+  auto& entity_manager{entity::EntityManager::Get()};
+  const auto row_begin{tree_offsets_[tree_index]};
+  const auto row_end{tree_offsets_[tree_index + 1]};
+  auto* root_transform_cmp{transform_cmps_[row_begin]};
+  stats.updated_tree_count = 1;
+
+  if (root_transform_cmp->is_dirty) {
+    root_transform_cmp->global = root_transform_cmp->local;
+    entity_manager.MarkChanged(root_transform_cmp);
+    ++stats.updated_row_count;
+  }
+
+  dirty_flags_[row_begin] = is_full_update_ || root_transform_cmp->is_dirty;
+  root_transform_cmp->is_dirty = false;
+
+  for (auto row{row_begin + 1}; row < row_end; ++row) {
+    auto* transform_cmp{transform_cmps_[row]};
+    const auto parent_index{parent_indices_[row]};
+
+    // Parents come first: their flag is already up to date.
+    const auto is_dirty{transform_cmp->is_dirty ||
+                        dirty_flags_[parent_index] != 0};
+    dirty_flags_[row] = is_dirty;
+
+    if (!is_dirty) {
+      continue;
+    }
+
+    math::MultiplyMatrix(transform_cmp->local,
+                         transform_cmps_[parent_index]->global,
+                         transform_cmp->global);
+    transform_cmp->is_dirty = false;
+    entity_manager.MarkChanged(transform_cmp);
+    ++stats.updated_row_count;
+
+    if (packet != nullptr) {
+      packet->RegisterDirtyTransform(entity_ids_[row], transform_cmp);
+    }
+  }
+
+  root_cmp->is_child_dirty = false;
+  return stats;
+}
+}  // namespace physics
+}  // namespace comet
@@ -0,0 +1,91 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+#ifndef COMET_COMET_PHYSICS_TRANSFORM_HIERARCHY_H_
+#define COMET_COMET_PHYSICS_TRANSFORM_HIERARCHY_H_
+
+#include "comet/core/essentials.h"
+#include "comet/core/frame/frame_packet.h"
+#include "comet/core/memory/allocator/allocator.h"
+#include "comet/core/type/array.h"
+#include "comet/entity/archetype.h"
+#include "comet/entity/entity_id.h"
+#include "comet/entity/entity_query.h"
+#include "comet/physics/component/transform_component.h"
+
+namespace comet {
+namespace physics {
+// Counters of transform updates.
+struct TransformStats {
+  usize update_count{0};
+  usize tree_count{0};
+  usize updated_tree_count{0};
+  usize row_count{0};
+  // Rows of the trees whose roots did not change, which were not visited.
+  usize skipped_row_count{0};
+  // Rows whose global transform was computed again.
+  usize updated_row_count{0};
+};
+
+TransformStats operator+(const TransformStats& a, const TransformStats& b);
+
+// Flat view of every transform tree. Each tree is stored as a contiguous
+// range of rows sorted by depth, the root being the first one, and each row
+// refers to its parent by index. Updating a tree is then a single linear pass,
+// since a parent is always processed before its children, and trees are
+// updated in parallel. Trees are only visited when the chunk of their root
+// changed since the last update.
+// Component pointers are only valid until the next structural change of the
+// entity manager: the hierarchy must be rebuilt after that.
+class TransformHierarchy {
+ public:
+  TransformHierarchy() = default;
+  explicit TransformHierarchy(memory::Allocator* allocator);
+  TransformHierarchy(const TransformHierarchy&) = delete;
+  TransformHierarchy(TransformHierarchy&&) = delete;
+  TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+  TransformHierarchy& operator=(TransformHierarchy&&) = delete;
+  ~TransformHierarchy() = default;
+
+  void Rebuild();
+  // Propagates the global transforms of the trees which have a dirty node.
+  // Every updated child transform is registered to the packet, if any.
+  TransformStats Update(frame::FramePacket* packet);
+  void Destroy();
+
+  usize GetNodeCount() const noexcept;
+  usize GetTreeCount() const noexcept;
+
+ private:
+  // Trees whose roots are stored in the same chunk. They are skipped at once
+  // when none of these roots was marked as changed.
+  struct RootChunk {
+    const TransformRootComponent* root_cmps{nullptr};
+    usize tree_begin{0};
+    usize tree_end{0};
+  };
+
+  TransformStats UpdateTree(usize tree_index, frame::FramePacket* packet);
+
+  bool is_full_update_{false};
+  entity::ChangeVersion last_change_version_{entity::kInitialChangeVersion};
+  memory::Allocator* allocator_{nullptr};
+  entity::EntityQuery root_query_{};
+  entity::EntityQuery transform_query_{};
+
+  // Per row.
+  Array<entity::EntityId> entity_ids_{};
+  Array<TransformComponent*> transform_cmps_{};
+  Array<usize> parent_indices_{};
+  Array<u8> dirty_flags_{};
+
+  // Per tree. Tree i spans rows [tree_offsets_[i], tree_offsets_[i + 1]).
+  Array<TransformRootComponent*> root_cmps_{};
+  Array<usize> tree_offsets_{};
+  Array<RootChunk> root_chunks_{};
+};
+}  // namespace physics
+}  // namespace comet
+
+#endif  // COMET_COMET_PHYSICS_TRANSFORM_HIERARCHY_H_
@@ -100,7 +100,6 @@ ThreadProfilerContext::ThreadProfilerContext(memory::Allocator* allocator)
 ThreadProfilerContext::ThreadProfilerContext(
     ThreadProfilerContext&& other) noexcept
     : thread_id{other.thread_id},
-      active_nodes{std::move(other.active_nodes)},
       root_nodes{std::move(other.root_nodes)},
       nodes{std::move(other.nodes)} {
   other.thread_id = thread::kInvalidThreadId;
@@ -113,7 +112,6 @@ ThreadProfilerContext& ThreadProfilerContext::operator=(
   }
 
   thread_id = other.thread_id;
-  active_nodes = std::move(other.active_nodes);
   root_nodes = std::move(other.root_nodes);
   nodes = std::move(other.nodes);
 
@@ -184,27 +182,36 @@ ProfilerRecordContext& ProfilerRecordContext::operator=(
 }
 
 ProfilerData::ProfilerData(memory::Allocator* allocator)
-    : record_context{allocator} {}
+    : system_schedule{allocator}, record_context{allocator} {}
 
 ProfilerData::ProfilerData(ProfilerData&& other) noexcept
     : physics_frame_time{other.physics_frame_time},
       physics_frame_rate{other.physics_frame_rate},
+      physics_transform_stats{other.physics_transform_stats},
       rendering_frame_time{other.rendering_frame_time},
       rendering_frame_rate{other.rendering_frame_rate},
 #ifdef COMET_DEBUG_RENDERING
       rendering_draw_count{other.rendering_draw_count},
 #endif  // COMET_DEBUG_RENDERING
       rendering_driver_type{other.rendering_driver_type},
+      animation_stats{other.animation_stats},
+      job_stats{other.job_stats},
+      job_parker_stats{other.job_parker_stats},
+      system_schedule{std::move(other.system_schedule)},
       memory_use{other.memory_use},
       tag_use{std::move(other.tag_use)},
       record_context{std::move(other.record_context)} {
   other.physics_frame_rate = 0;
+  other.physics_transform_stats = {};
   other.rendering_frame_time = 0;
   other.rendering_frame_rate = 0;
 #ifdef COMET_DEBUG_RENDERING
   other.rendering_draw_count = 0;
 #endif  // COMET_DEBUG_RENDERING
   other.rendering_driver_type = rendering::DriverType::Unknown;
+  other.animation_stats = {};
+  other.job_stats = {};
+  other.job_parker_stats = {};
   other.memory_use = 0;
 }
 
@@ -214,32 +221,41 @@ ProfilerData& ProfilerData::operator=(ProfilerData&& other) noexcept {
   }
 
   physics_frame_rate = other.physics_frame_rate;
+  physics_transform_stats = other.physics_transform_stats;
   rendering_frame_time = other.rendering_frame_time;
   rendering_frame_rate = other.rendering_frame_rate;
 #ifdef COMET_DEBUG_RENDERING
   rendering_draw_count = other.rendering_draw_count;
 #endif  // COMET_DEBUG_RENDERING
   rendering_driver_type = other.rendering_driver_type;
+  animation_stats = other.animation_stats;
+  job_stats = other.job_stats;
+  job_parker_stats = other.job_parker_stats;
+  system_schedule = std::move(other.system_schedule);
   memory_use = other.memory_use;
   tag_use = std::move(other.tag_use);
   record_context = std::move(other.record_context);
 
   other.physics_frame_rate = 0;
+  other.physics_transform_stats = {};
   other.rendering_frame_time = 0;
   other.rendering_frame_rate = 0;
 #ifdef COMET_DEBUG_RENDERING
   other.rendering_draw_count = 0;
 #endif  // COMET_DEBUG_RENDERING
   other.rendering_driver_type = rendering::DriverType::Unknown;
+  other.animation_stats = {};
+  other.job_stats = {};
+  other.job_parker_stats = {};
   other.memory_use = 0;
   return *this;
 }
 
 ProfiledScope::ProfiledScope(const schar* label) {
-  ProfilerManager::Get().StartProfiling(label);
+  ProfilerManager::Get().StartProfiling(label, *this);
 }
 
-ProfiledScope::~ProfiledScope() { ProfilerManager::Get().StopProfiling(); }
+ProfiledScope::~ProfiledScope() { ProfilerManager::Get().StopProfiling(*this); }
 }  // namespace profiler
 }  // namespace comet
 #endif  // COMET_PROFILING
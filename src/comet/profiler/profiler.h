@@ -6,10 +6,13 @@
 #define COMET_COMET_PROFILER_PROFILER_H_
 
 // External. ///////////////////////////////////////////////////////////////////
+#include <atomic>
 #include <optional>
-#include <stack>
 ////////////////////////////////////////////////////////////////////////////////
 
+#include "comet/animation/animation_lod.h"
+#include "comet/core/concurrency/job/worker.h"
+#include "comet/core/concurrency/job/worker_parker.h"
 #include "comet/core/concurrency/thread/thread.h"
 #include "comet/core/essentials.h"
 #include "comet/core/frame/frame_packet.h"
@@ -17,6 +20,8 @@
 #include "comet/core/memory/memory.h"
 #include "comet/core/type/array.h"
 #include "comet/core/type/map.h"
+#include "comet/entity/system_scheduler.h"
+#include "comet/physics/transform_hierarchy.h"
 #include "comet/rendering/rendering_common.h"
 
 #ifdef COMET_PROFILING
@@ -50,7 +55,6 @@ struct ProfilerNode {
 
 struct ThreadProfilerContext {
   thread::ThreadId thread_id{thread::kInvalidThreadId};
-  std::stack<ProfilerNode*> active_nodes{};
   Array<ProfilerNode*> root_nodes{};
   Array<memory::UniquePtr<ProfilerNode>> nodes{};
 
@@ -96,12 +100,17 @@ struct ProfilerRecordContext {
 struct ProfilerData {
   f64 physics_frame_time{0};
   u32 physics_frame_rate{0};
+  physics::TransformStats physics_transform_stats{};
   f64 rendering_frame_time{0};
   u32 rendering_frame_rate{0};
 #ifdef COMET_DEBUG_RENDERING
   u32 rendering_draw_count{0};
 #endif  // COMET_DEBUG_RENDERING
   rendering::DriverType rendering_driver_type{rendering::DriverType::Unknown};
+  animation::AnimationStats animation_stats{};
+  job::FiberWorkerStats job_stats{};
+  job::WorkerParkerStats job_parker_stats{};
+  entity::SystemSchedule system_schedule{};
   usize memory_use{0};
   Map<memory::MemoryTag, usize> tag_use{};
   ProfilerRecordContext record_context{};
@@ -114,14 +123,26 @@ struct ProfilerData {
   ~ProfilerData() = default;
 };
 
+class ProfilerManager;
+
+// Scopes are tracked per fiber, which can be suspended in a scope and resumed
+// on another worker.
 class ProfiledScope {
  public:
   explicit ProfiledScope(const schar* label);
-  ProfiledScope(const ProfiledScope&) = default;
-  ProfiledScope(ProfiledScope&&) noexcept = default;
-  ProfiledScope& operator=(const ProfiledScope&) = default;
-  ProfiledScope& operator=(ProfiledScope&&) noexcept = default;
+  ProfiledScope(const ProfiledScope&) = delete;
+  ProfiledScope(ProfiledScope&&) = delete;
+  ProfiledScope& operator=(const ProfiledScope&) = delete;
+  ProfiledScope& operator=(ProfiledScope&&) = delete;
   ~ProfiledScope();
+
+ private:
+  friend class ProfilerManager;
+
+  ProfiledScope* parent_{nullptr};
+  ProfilerNode* node_{nullptr};
+  // Nodes are dropped when frames end: the ones of older frames are not used.
+  u64 frame_generation_{0};
 };
 }  // namespace profiler
 }  // namespace comet
@@ -16,9 +16,14 @@
 #include <utility>
 ////////////////////////////////////////////////////////////////////////////////
 
+#include "comet/animation/animation_manager.h"
+#include "comet/core/concurrency/fiber/fiber.h"
+#include "comet/core/concurrency/fiber/fiber_context.h"
+#include "comet/core/concurrency/job/scheduler.h"
 #include "comet/core/date.h"
 #include "comet/core/memory/allocation_tracking.h"
 #include "comet/engine/engine_event.h"
+#include "comet/entity/system_scheduler.h"
 #include "comet/event/event_manager.h"
 #include "comet/physics/physics_manager.h"
 #include "comet/rendering/rendering_manager.h"
@@ -26,6 +31,9 @@
 #ifdef COMET_PROFILING
 namespace comet {
 namespace profiler {
+// Innermost profiled scope of threads which are not running fibers.
+static thread_local ProfiledScope* tls_active_scope{nullptr};
+
 ProfilerManager& ProfilerManager::Get() {
   static ProfilerManager singleton{};
   return singleton;
@@ -59,12 +67,27 @@ void ProfilerManager::Update() {
 
   data_.physics_frame_time = physics_manager.GetFrameTime();
   data_.physics_frame_rate = physics_manager.GetFrameRate();
+  data_.physics_transform_stats = physics_manager.GetTransformStats();
   data_.rendering_driver_type = rendering_manager.GetDriverType();
   data_.rendering_frame_time = rendering_manager.GetFrameTime();
   data_.rendering_frame_rate = rendering_manager.GetFrameRate();
 #ifdef COMET_DEBUG_RENDERING
   data_.rendering_draw_count = rendering_manager.GetDrawCount();
 #endif  // COMET_DEBUG_RENDERING
+  data_.animation_stats = animation::AnimationManager::Get().GetStats();
+  data_.job_stats = job::Scheduler::Get().GetFiberWorkerStats();
+  data_.job_parker_stats =
+      job::Scheduler::Get().GetFiberWorkerParkerStats();
+
+  const auto system_schedule{
+      entity::SystemScheduler::Get().GetLastSchedule()};
+  data_.system_schedule.Clear();
+  data_.system_schedule.Reserve(system_schedule.GetSize());
+
+  for (const auto& entry : system_schedule) {
+    data_.system_schedule.PushBack(entry);
+  }
+
   COMET_GET_MEMORY_USE(data_.memory_use);
   COMET_GET_TAG_USE(data_.tag_use);
 #endif  // COMET_DEBUG
@@ -83,18 +106,22 @@ void ProfilerManager::StartFrame(frame::FrameCount frame_count) {
 
 void ProfilerManager::EndFrame() {
   RecordFrame();
+  frame_generation_.fetch_add(1, std::memory_order_acq_rel);
   auto thread_context_count{thread_contexts_.GetSize()};
 
   for (usize i{0}; i < thread_context_count; ++i) {
     auto& thread_context{thread_contexts_.GetFromIndex(i)};
     thread_context.thread_id = thread_contexts_.GetThreadIdFromIndex(i);
-    thread_context.active_nodes = {};
     thread_context.root_nodes = Array<ProfilerNode*>{&allocator_};
     thread_context.nodes = Array<memory::UniquePtr<ProfilerNode>>{&allocator_};
   }
 }
 
-void ProfilerManager::StartProfiling(const schar* label) {
+void ProfilerManager::StartProfiling(const schar* label,
+                                     ProfiledScope& scope) {
+  scope.parent_ = GetActiveScope();
+  SetActiveScope(&scope);
+
   if (!is_recording_) {
     return;
   }
@@ -102,36 +129,39 @@ void ProfilerManager::StartProfiling(const schar* label) {
   auto& thread_context{thread_contexts_.Get()};
   auto now{GetTimestampNanoSeconds()};
   auto node{std::make_unique<ProfilerNode>(&allocator_, label, now)};
-
-  if (thread_context.active_nodes.empty()) {
-    thread_context.root_nodes.PushBack(node.get());
+  const auto frame_generation{
+      frame_generation_.load(std::memory_order_acquire)};
+  const auto* parent{scope.parent_};
+
+  // The parent node belongs to the same fiber: no other thread uses it.
+  if (parent != nullptr && parent->node_ != nullptr &&
+      parent->frame_generation_ == frame_generation) {
+    parent->node_->children.PushBack(node.get());
   } else {
-    thread_context.active_nodes.top()->children.PushBack(node.get());
+    thread_context.root_nodes.PushBack(node.get());
   }
 
-  thread_context.active_nodes.push(node.get());
+  scope.node_ = node.get();
+  scope.frame_generation_ = frame_generation;
   thread_context.nodes.PushBack(std::move(node));
 }
 
-void ProfilerManager::StopProfiling() {
-  if (!is_recording_) {
-    return;
-  }
-
-  auto& thread_context{thread_contexts_.Get()};
+void ProfilerManager::StopProfiling(ProfiledScope& scope) {
+  SetActiveScope(scope.parent_);
+  auto* node{scope.node_};
+  const auto frame_generation{
+      frame_generation_.load(std::memory_order_acquire)};
 
-  if (thread_context.active_nodes.empty()) {
+  // Nodes of scopes open when their frame ended have been dropped.
+  if (node == nullptr || scope.frame_generation_ != frame_generation) {
     return;
   }
 
   auto now{GetTimestampNanoSeconds()};
-  auto* node{thread_context.active_nodes.top()};
   node->end_time = now;
   node->elapsed_time_ms =
       static_cast<ProfilerElapsedTime>(node->end_time - node->start_time) /
       1000000.0f;
-
-  thread_context.active_nodes.pop();
 }
 
 void ProfilerManager::Record() { is_recording_ = true; }
@@ -152,6 +182,23 @@ void ProfilerManager::OnEvent(const event::Event& event) {
   }
 }
 
+ProfiledScope* ProfilerManager::GetActiveScope() {
+  if (fiber::IsFiber()) {
+    return static_cast<ProfiledScope*>(fiber::GetFiber()->GetProfiledScope());
+  }
+
+  return tls_active_scope;
+}
+
+void ProfilerManager::SetActiveScope(ProfiledScope* scope) {
+  if (fiber::IsFiber()) {
+    fiber::GetFiber()->SetProfiledScope(scope);
+    return;
+  }
+
+  tls_active_scope = scope;
+}
+
 void ProfilerManager::RecordFrame() {
   if (!is_frame_recording_) {
     data_.record_context.frame_contexts.PushBack(std::nullopt);
@@ -8,6 +8,10 @@
 #include "comet/core/essentials.h"
 
 #ifdef COMET_PROFILING
+// External. ///////////////////////////////////////////////////////////////////
+#include <atomic>
+////////////////////////////////////////////////////////////////////////////////
+
 #include "comet/core/concurrency/provider/thread_provider.h"
 #include "comet/core/concurrency/provider/thread_provider_manager.h"
 #include "comet/core/frame/frame_packet.h"
@@ -37,8 +41,8 @@ class ProfilerManager : public Manager {
   void StartFrame(frame::FrameCount frame_count);
   void EndFrame();
 
-  void StartProfiling(const schar* label);
-  void StopProfiling();
+  void StartProfiling(const schar* label, ProfiledScope& scope);
+  void StopProfiling(ProfiledScope& scope);
 
   void Record();
   void StopRecording();
@@ -52,6 +56,8 @@ class ProfilerManager : public Manager {
       thread::FiberThreadProvider<ThreadProfilerContext>;
 
   static void OnEvent(const event::Event& event);
+  static ProfiledScope* GetActiveScope();
+  static void SetActiveScope(ProfiledScope* scope);
 
   void RecordFrame();
 
@@ -59,6 +65,7 @@ class ProfilerManager : public Manager {
       thread::ThreadProviderManager::Get()
           .AllocateFiberProvider<ThreadProfilerContext>()};
 
+  std::atomic<u64> frame_generation_{0};
   bool is_recording_{false};
   bool is_frame_recording_{false};
   memory::PlatformAllocator allocator_{memory::kEngineMemoryTagDebug};
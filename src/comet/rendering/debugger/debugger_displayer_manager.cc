@@ -46,6 +46,12 @@ void DebuggerDisplayerManager::Draw() {
   DrawPhysicsSection(profiler_data);
   ImGui::Spacing();
   DrawRenderingSection(profiler_data);
+  ImGui::Spacing();
+  DrawAnimationSection(profiler_data);
+  ImGui::Spacing();
+  DrawJobSection(profiler_data);
+  ImGui::Spacing();
+  DrawSystemSection(profiler_data);
 
 #ifdef COMET_TRACK_ALLOCATIONS
   ImGui::Spacing();
@@ -64,10 +70,17 @@ void DebuggerDisplayerManager::Draw() {
 #ifdef COMET_IMGUI
 void DebuggerDisplayerManager::DrawPhysicsSection(
     const profiler::ProfilerData& profiler_data) const {
+  const auto& transform_stats{profiler_data.physics_transform_stats};
   ImGui::Text("PHYSICS");
   ImGui::Indent();
   ImGui::Text("Frame Time: %f ms", profiler_data.physics_frame_time * 1000);
   ImGui::Text("Framerate: %u Hz", profiler_data.physics_frame_rate);
+  ImGui::Text("Transform updates: %zu", transform_stats.update_count);
+  ImGui::Text("Transform trees: %zu / %zu",
+              transform_stats.updated_tree_count, transform_stats.tree_count);
+  ImGui::Text("Transform rows: %zu (skipped: %zu, updated: %zu)",
+              transform_stats.row_count, transform_stats.skipped_row_count,
+              transform_stats.updated_row_count);
   ImGui::Unindent();
 }
 
@@ -85,6 +98,77 @@ void DebuggerDisplayerManager::DrawRenderingSection(
   ImGui::Unindent();
 }
 
+void DebuggerDisplayerManager::DrawAnimationSection(
+    const profiler::ProfilerData& profiler_data) const {
+  const auto& animation_stats{profiler_data.animation_stats};
+  ImGui::Text("ANIMATIONS");
+  ImGui::Indent();
+  ImGui::Text("Entities: %zu (evaluated: %zu, extrapolated: %zu, culled: %zu)",
+              animation_stats.entity_count,
+              animation_stats.evaluated_entity_count,
+              animation_stats.extrapolated_entity_count,
+              animation_stats.culled_entity_count);
+  ImGui::Text("Evaluated joints: %zu / %zu",
+              animation_stats.evaluated_joint_count,
+              animation_stats.joint_count);
+  ImGui::Unindent();
+}
+
+void DebuggerDisplayerManager::DrawJobSection(
+    const profiler::ProfilerData& profiler_data) const {
+  const auto& job_stats{profiler_data.job_stats};
+  ImGui::Text("JOBS");
+  ImGui::Indent();
+  ImGui::Text("Local jobs: %zu", job_stats.local_job_count);
+  ImGui::Text("Global jobs: %zu", job_stats.global_job_count);
+  ImGui::Text("Stolen jobs: %zu / %zu attempts", job_stats.stolen_job_count,
+              job_stats.steal_attempt_count);
+
+  const auto& parker_stats{profiler_data.job_parker_stats};
+  const auto wake_count{parker_stats.wake_count > 0 ? parker_stats.wake_count
+                                                    : 1};
+  ImGui::Text("Parks: %zu", parker_stats.park_count);
+  ImGui::Text("Parked time: %.2f ms",
+              static_cast<f64>(parker_stats.total_parked_time_ns) / 1000000.0);
+  ImGui::Text("Wake latency: %.2f us (max: %.2f us)",
+              static_cast<f64>(parker_stats.total_wake_latency_ns) /
+                  static_cast<f64>(wake_count) / 1000.0,
+              static_cast<f64>(parker_stats.max_wake_latency_ns) / 1000.0);
+  ImGui::Unindent();
+}
+
+void DebuggerDisplayerManager::DrawSystemSection(
+    const profiler::ProfilerData& profiler_data) const {
+  const auto& system_schedule{profiler_data.system_schedule};
+  u64 update_start_time_ns{kU64Max};
+
+  for (const auto& entry : system_schedule) {
+    if (entry.start_time_ns != 0) {
+      update_start_time_ns =
+          std::min(update_start_time_ns, entry.start_time_ns);
+    }
+  }
+
+  ImGui::Text("SYSTEMS");
+  ImGui::Indent();
+
+  for (const auto& entry : system_schedule) {
+    const auto start_time_ns{entry.start_time_ns != 0 ? entry.start_time_ns
+                                                      : update_start_time_ns};
+    const auto end_time_ns{entry.end_time_ns > start_time_ns
+                               ? entry.end_time_ns
+                               : start_time_ns};
+
+    ImGui::Text("%s: level %zu, %zu dependencies, +%.3f ms, %.3f ms",
+                entry.label, entry.level, entry.dependency_count,
+                static_cast<f64>(start_time_ns - update_start_time_ns) /
+                    1000000.0,
+                static_cast<f64>(end_time_ns - start_time_ns) / 1000000.0);
+  }
+
+  ImGui::Unindent();
+}
+
 void DebuggerDisplayerManager::DrawMemorySection(
     const profiler::ProfilerData& profiler_data) const {
   allocation_tracker_displayer_.Draw(profiler_data);
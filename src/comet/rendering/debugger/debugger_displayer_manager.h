@@ -33,6 +33,9 @@ class DebuggerDisplayerManager : public Manager {
 #ifdef COMET_IMGUI
   void DrawPhysicsSection(const profiler::ProfilerData& profiler_data) const;
   void DrawRenderingSection(const profiler::ProfilerData& profiler_data) const;
+  void DrawAnimationSection(const profiler::ProfilerData& profiler_data) const;
+  void DrawJobSection(const profiler::ProfilerData& profiler_data) const;
+  void DrawSystemSection(const profiler::ProfilerData& profiler_data) const;
   void DrawMemorySection(const profiler::ProfilerData& profiler_data) const;
   void DrawProfilingSection(const profiler::ProfilerData& profiler_data);
 
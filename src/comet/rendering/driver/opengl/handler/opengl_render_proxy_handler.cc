@@ -16,9 +16,9 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "comet/core/algorithm/back_insert_iterator.h"
-#include "comet/core/algorithm/inplace_merge.h"
+#include "comet/core/algorithm/parallel_merge.h"
+#include "comet/core/algorithm/radix_sort.h"
 #include "comet/core/algorithm/set_difference.h"
-#include "comet/core/algorithm/sort.h"
 #include "comet/math/matrix.h"
 #include "comet/profiler/profiler.h"
 #include "comet/rendering/driver/opengl/data/opengl_material.h"
@@ -228,6 +228,19 @@ bool RenderProxyHandler::OnRenderBatchSort(const RenderBatchEntry& a,
   return a.proxy->id < b.proxy->id;
 }
 
+void RenderProxyHandler::SortRenderBatches(RenderBatchEntry* begin,
+                                           RenderBatchEntry* end) {
+  // Radix sort is stable: sorting by proxy ID, then by sort key, gives the
+  // order of OnRenderBatchSort().
+  ParallelRadixSort(begin, end, [](const RenderBatchEntry& entry) {
+    return entry.proxy->id;
+  });
+
+  ParallelRadixSort(begin, end, [](const RenderBatchEntry& entry) {
+    return entry.sort_key;
+  });
+}
+
 void RenderProxyHandler::GenerateUpdateTemporaryStructures(
     const frame::FramePacket* packet) {
   // Rough estimate: if reallocations become frequent in a single frame, we
@@ -468,8 +481,9 @@ void RenderProxyHandler::DestroyRenderProxies(
   // Sort the destroyed batch entries to align with batch_entries_ for
   // set_difference.
   // batch_entries_ is already sorted, so no need to do it here.
-  Sort(destroyed_batch_entries_->begin(), destroyed_batch_entries_->end(),
-       OnRenderBatchSort);
+  auto* destroyed_batches{destroyed_batch_entries_->GetData()};
+  SortRenderBatches(destroyed_batches,
+                    destroyed_batches + destroyed_batch_entries_->GetSize());
 
   Array<RenderBatchEntry> filtered_batches{&general_allocator_,
                                            batch_entries_.GetSize()};
@@ -573,18 +587,21 @@ void RenderProxyHandler::GenerateBatchEntries() {
     batch.proxy = &new_proxy;
   }
 
-  Sort(new_batch_entries_.begin(), new_batch_entries_.end(), OnRenderBatchSort);
+  auto* new_batches{new_batch_entries_.GetData()};
+  SortRenderBatches(new_batches, new_batches + new_batch_entries_.GetSize());
 
   auto batch_count{batch_entries_.GetSize()};
   auto new_batch_count{new_batch_entries_.GetSize()};
 
   if (batch_count > 0 && new_batch_count > 0) {
-    batch_entries_.PushFromRange(new_batch_entries_);
-    auto* start{batch_entries_.GetData()};
-    auto* pivot{start + batch_count};
-    auto* end{start + batch_entries_.GetSize()};
+    Array<RenderBatchEntry> merged_batches{&general_allocator_};
+    merged_batches.Resize(batch_count + new_batch_count);
+
+    ParallelMerge(batch_entries_.GetData(), batch_count,
+                  new_batch_entries_.GetData(), new_batch_count,
+                  merged_batches.GetData(), OnRenderBatchSort);
 
-    InplaceMerge(start, pivot, end, OnRenderBatchSort);
+    batch_entries_ = std::move(merged_batches);
   } else if (batch_count == 0) {
     batch_entries_ = std::move(new_batch_entries_);
   }
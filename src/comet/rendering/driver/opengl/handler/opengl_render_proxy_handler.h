@@ -66,6 +66,7 @@ class RenderProxyHandler : public Handler {
 
   static bool OnRenderBatchSort(const RenderBatchEntry& a,
                                 const RenderBatchEntry& b);
+  static void SortRenderBatches(RenderBatchEntry* begin, RenderBatchEntry* end);
 
   void GenerateUpdateTemporaryStructures(const frame::FramePacket* packet);
   void DestroyUpdateTemporaryStructures();
@@ -53,15 +53,13 @@ usize GetAnimationClipSize(const AnimationClipResource& resource) {
 
   size += sizeof(usize);
 
-  for (const auto& sample : resource.clip.samples) {
-    size += sizeof(usize);
-
-    auto pose_count{sample.joint_poses.GetSize()};
-
-    for (usize i{0}; i < pose_count; ++i) {
-      size += sizeof(animation::CompressedJointPose);
-    }
-  }
+  const auto& clip{resource.clip};
+  size += sizeof(usize);
+  size += clip.tracks.GetSize() * sizeof(animation::AnimationTrack);
+  size += sizeof(usize);
+  size += clip.key_frames.GetSize() * sizeof(u16);
+  size += sizeof(usize);
+  size += clip.key_data.GetSize() * sizeof(u8);
 
   size += sizeof(bool);
   return size;
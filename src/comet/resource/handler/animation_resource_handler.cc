@@ -24,8 +24,7 @@ void AnimationClipResourceHandler::Initialize() {
   ResourceHandler::Initialize();
 
   anim_allocator_ = memory::FiberFreeListAllocator{
-      math::Max(sizeof(animation::AnimationSample),
-                sizeof(animation::JointPose)),
+      sizeof(animation::AnimationTrack),
       kDefaultAllocatorCapacity_, memory::kEngineMemoryTagResource};
 
   anim_allocator_.Initialize();
@@ -54,21 +53,10 @@ ResourceFile AnimationClipResourceHandler::Pack(
   constexpr auto kAnimationClipIdSize{sizeof(animation::AnimationClipId)};
   constexpr auto kFramesPerSecondSize{sizeof(animation::FrameIndex)};
   constexpr auto kFrameCountSize{sizeof(animation::FrameIndex)};
-  constexpr auto kSampleCountSize{sizeof(usize)};
-  constexpr auto kJointPoseCountSize{sizeof(usize)};
-#ifndef COMET_COMPRESS_ANIMATIONS
-  constexpr auto kJointPoseRotationSize{sizeof(math::Quat)};
-  constexpr auto kJointPoseTranslationSize{sizeof(math::Vec3)};
-  constexpr auto kJointPoseScaleSize{sizeof(f32)};
-#else
-  constexpr auto kJointPoseRotationXSize{sizeof(u16)};
-  constexpr auto kJointPoseRotationYSize{sizeof(u16)};
-  constexpr auto kJointPoseRotationZSize{sizeof(u16)};
-  constexpr auto kJointPoseTranslationXSize{sizeof(u16)};
-  constexpr auto kJointPoseTranslationYSize{sizeof(u16)};
-  constexpr auto kJointPoseTranslationZSize{sizeof(u16)};
-  constexpr auto kJointPoseScaleSize{sizeof(u16)};
-#endif  // !COMET_COMPRESS_ANIMATIONS
+  constexpr auto kJointCountSize{sizeof(usize)};
+  constexpr auto kTrackCountSize{sizeof(usize)};
+  constexpr auto kKeyFrameCountSize{sizeof(usize)};
+  constexpr auto kKeyDataSizeSize{sizeof(usize)};
   constexpr auto kIsLoopSize{sizeof(bool)};
 
   const auto& clip{resource.clip};
@@ -89,55 +77,32 @@ ResourceFile AnimationClipResourceHandler::Pack(
   memory::CopyMemory(&buffer[cursor], &clip.frame_count, kFrameCountSize);
   cursor += kFrameCountSize;
 
-  auto sample_count{clip.samples.GetSize()};
-  memory::CopyMemory(&buffer[cursor], &sample_count, kSampleCountSize);
-  cursor += kSampleCountSize;
-
-  for (const auto& sample : clip.samples) {
-    auto joint_pose_count{sample.joint_poses.GetSize()};
-    memory::CopyMemory(&buffer[cursor], &joint_pose_count, kJointPoseCountSize);
-    cursor += kJointPoseCountSize;
-
-    for (const auto& pose : sample.joint_poses) {
-#ifndef COMET_COMPRESS_ANIMATIONS
-      memory::CopyMemory(&buffer[cursor], &pose.rotation,
-                         kJointPoseRotationSize);
-      cursor += kJointPoseRotationSize;
-      memory::CopyMemory(&buffer[cursor], &pose.translation,
-                         kJointPoseTranslationSize);
-      cursor += kJointPoseTranslationSize;
-      memory::CopyMemory(&buffer[cursor], &pose.scale, kJointPoseScaleSize);
-      cursor += kJointPoseScaleSize;
-#else
-      memory::CopyMemory(&buffer[cursor], &pose.rotation_x,
-                         kJointPoseRotationXSize);
-      cursor += kJointPoseRotationXSize;
-
-      memory::CopyMemory(&buffer[cursor], &pose.rotation_y,
-                         kJointPoseRotationYSize);
-      cursor += kJointPoseRotationYSize;
-
-      memory::CopyMemory(&buffer[cursor], &pose.rotation_z,
-                         kJointPoseRotationZSize);
-      cursor += kJointPoseRotationZSize;
-
-      memory::CopyMemory(&buffer[cursor], &pose.translation_x,
-                         kJointPoseTranslationXSize);
-      cursor += kJointPoseTranslationXSize;
-
-      memory::CopyMemory(&buffer[cursor], &pose.translation_y,
-                         kJointPoseTranslationYSize);
-      cursor += kJointPoseTranslationYSize;
-
-      memory::CopyMemory(&buffer[cursor], &pose.translation_z,
-                         kJointPoseTranslationZSize);
-      cursor += kJointPoseTranslationZSize;
-
-      memory::CopyMemory(&buffer[cursor], &pose.scale, kJointPoseScaleSize);
-      cursor += kJointPoseScaleSize;
-#endif  // COMET_COMPRESS_ANIMATIONS
-    }
-  }
+  memory::CopyMemory(&buffer[cursor], &clip.joint_count, kJointCountSize);
+  cursor += kJointCountSize;
+
+  auto track_count{clip.tracks.GetSize()};
+  memory::CopyMemory(&buffer[cursor], &track_count, kTrackCountSize);
+  cursor += kTrackCountSize;
+
+  const auto tracks_size{track_count * sizeof(animation::AnimationTrack)};
+  memory::CopyMemory(&buffer[cursor], clip.tracks.GetData(), tracks_size);
+  cursor += tracks_size;
+
+  auto key_frame_count{clip.key_frames.GetSize()};
+  memory::CopyMemory(&buffer[cursor], &key_frame_count, kKeyFrameCountSize);
+  cursor += kKeyFrameCountSize;
+
+  const auto key_frames_size{key_frame_count * sizeof(u16)};
+  memory::CopyMemory(&buffer[cursor], clip.key_frames.GetData(),
+                     key_frames_size);
+  cursor += key_frames_size;
+
+  auto key_data_size{clip.key_data.GetSize()};
+  memory::CopyMemory(&buffer[cursor], &key_data_size, kKeyDataSizeSize);
+  cursor += kKeyDataSizeSize;
+
+  memory::CopyMemory(&buffer[cursor], clip.key_data.GetData(), key_data_size);
+  cursor += key_data_size;
 
   memory::CopyMemory(&buffer[cursor], &clip.is_loop, kIsLoopSize);
   cursor += kIsLoopSize;
@@ -153,8 +118,7 @@ void AnimationClipResourceHandler::Unpack(const ResourceFile& file,
   UnpackPodResourceDescr<AnimationClipResourceDescr>(file, resource->descr);
 
   Array<u8> data{byte_allocator_};
-  UnpackResourceData(file, data);
-  const auto* buffer{data.GetData()};
+  const auto* buffer{ViewResourceData(file, data)};
   usize cursor{0};
 
   constexpr auto kResourceIdSize{sizeof(resource::ResourceId)};
@@ -162,21 +126,10 @@ void AnimationClipResourceHandler::Unpack(const ResourceFile& file,
   constexpr auto kAnimationClipIdSize{sizeof(animation::AnimationClipId)};
   constexpr auto kFramesPerSecondSize{sizeof(animation::FrameIndex)};
   constexpr auto kFrameCountSize{sizeof(animation::FrameIndex)};
-  constexpr auto kSampleCountSize{sizeof(usize)};
-  constexpr auto kJointPoseCountSize{sizeof(usize)};
-#ifndef COMET_COMPRESS_ANIMATIONS
-  constexpr auto kJointPoseRotationSize{sizeof(math::Quat)};
-  constexpr auto kJointPoseTranslationSize{sizeof(math::Vec3)};
-  constexpr auto kJointPoseScaleSize{sizeof(f32)};
-#else
-  constexpr auto kJointPoseRotationXSize{sizeof(u16)};
-  constexpr auto kJointPoseRotationYSize{sizeof(u16)};
-  constexpr auto kJointPoseRotationZSize{sizeof(u16)};
-  constexpr auto kJointPoseTranslationXSize{sizeof(u16)};
-  constexpr auto kJointPoseTranslationYSize{sizeof(u16)};
-  constexpr auto kJointPoseTranslationZSize{sizeof(u16)};
-  constexpr auto kJointPoseScaleSize{sizeof(u16)};
-#endif  // !COMET_COMPRESS_ANIMATIONS
+  constexpr auto kJointCountSize{sizeof(usize)};
+  constexpr auto kTrackCountSize{sizeof(usize)};
+  constexpr auto kKeyFrameCountSize{sizeof(usize)};
+  constexpr auto kKeyDataSizeSize{sizeof(usize)};
   constexpr auto kIsLoopSize{sizeof(bool)};
 
   memory::CopyMemory(&resource->id, &buffer[cursor], kResourceIdSize);
@@ -197,69 +150,42 @@ void AnimationClipResourceHandler::Unpack(const ResourceFile& file,
   memory::CopyMemory(&clip.frame_count, &buffer[cursor], kFrameCountSize);
   cursor += kFrameCountSize;
 
-  clip.samples = Array<animation::CompressedAnimationSample>{
-      ResolveAllocator(&anim_allocator_, life_span)};
-  usize sample_count;
-
-  memory::CopyMemory(&sample_count, &buffer[cursor], kSampleCountSize);
-  cursor += kSampleCountSize;
-  clip.samples.Reserve(sample_count);
-
-  for (usize i{0}; i < sample_count; ++i) {
-    auto& sample{clip.samples.EmplaceBack()};
-
-    sample.joint_poses = Array<animation::CompressedJointPose>{
-        ResolveAllocator(&anim_allocator_, life_span)};
-    usize joint_pose_count;
-
-    memory::CopyMemory(&joint_pose_count, &buffer[cursor], kJointPoseCountSize);
-    cursor += kJointPoseCountSize;
-    sample.joint_poses.Reserve(sample_count);
-
-    for (usize j{0}; j < joint_pose_count; ++j) {
-      auto& pose{sample.joint_poses.EmplaceBack()};
-
-#ifndef COMET_COMPRESS_ANIMATIONS
-      memory::CopyMemory(&pose.rotation, &buffer[cursor],
-                         kJointPoseRotationSize);
-      cursor += kJointPoseRotationSize;
-
-      memory::CopyMemory(&pose.translation, &buffer[cursor],
-                         kJointPoseTranslationSize);
-      cursor += kJointPoseTranslationSize;
-
-      memory::CopyMemory(&pose.scale, &buffer[cursor], kJointPoseScaleSize);
-      cursor += kJointPoseScaleSize;
-#else
-      memory::CopyMemory(&pose.rotation_x, &buffer[cursor],
-                         kJointPoseRotationXSize);
-      cursor += kJointPoseRotationXSize;
-
-      memory::CopyMemory(&pose.rotation_y, &buffer[cursor],
-                         kJointPoseRotationYSize);
-      cursor += kJointPoseRotationYSize;
-
-      memory::CopyMemory(&pose.rotation_z, &buffer[cursor],
-                         kJointPoseRotationZSize);
-      cursor += kJointPoseRotationZSize;
-
-      memory::CopyMemory(&pose.translation_x, &buffer[cursor],
-                         kJointPoseTranslationXSize);
-      cursor += kJointPoseTranslationXSize;
-
-      memory::CopyMemory(&pose.translation_y, &buffer[cursor],
-                         kJointPoseTranslationYSize);
-      cursor += kJointPoseTranslationYSize;
-
-      memory::CopyMemory(&pose.translation_z, &buffer[cursor],
-                         kJointPoseTranslationZSize);
-      cursor += kJointPoseTranslationZSize;
-
-      memory::CopyMemory(&pose.scale, &buffer[cursor], kJointPoseScaleSize);
-      cursor += kJointPoseScaleSize;
-#endif  // !COMET_COMPRESS_ANIMATIONS
-    }
-  }
+  memory::CopyMemory(&clip.joint_count, &buffer[cursor], kJointCountSize);
+  cursor += kJointCountSize;
+
+  auto* allocator{ResolveAllocator(&anim_allocator_, life_span)};
+  clip.tracks = Array<animation::AnimationTrack>{allocator};
+  usize track_count;
+
+  memory::CopyMemory(&track_count, &buffer[cursor], kTrackCountSize);
+  cursor += kTrackCountSize;
+  clip.tracks.Resize(track_count);
+
+  const auto tracks_size{track_count * sizeof(animation::AnimationTrack)};
+  memory::CopyMemory(clip.tracks.GetData(), &buffer[cursor], tracks_size);
+  cursor += tracks_size;
+
+  clip.key_frames = Array<u16>{allocator};
+  usize key_frame_count;
+
+  memory::CopyMemory(&key_frame_count, &buffer[cursor], kKeyFrameCountSize);
+  cursor += kKeyFrameCountSize;
+  clip.key_frames.Resize(key_frame_count);
+
+  const auto key_frames_size{key_frame_count * sizeof(u16)};
+  memory::CopyMemory(clip.key_frames.GetData(), &buffer[cursor],
+                     key_frames_size);
+  cursor += key_frames_size;
+
+  clip.key_data = Array<u8>{allocator};
+  usize key_data_size;
+
+  memory::CopyMemory(&key_data_size, &buffer[cursor], kKeyDataSizeSize);
+  cursor += kKeyDataSizeSize;
+  clip.key_data.Resize(key_data_size);
+
+  memory::CopyMemory(clip.key_data.GetData(), &buffer[cursor], key_data_size);
+  cursor += key_data_size;
 
   memory::CopyMemory(&clip.is_loop, &buffer[cursor], kIsLoopSize);
   cursor += kIsLoopSize;
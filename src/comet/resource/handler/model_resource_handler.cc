@@ -119,8 +119,7 @@ void StaticModelResourceHandler::Unpack(const ResourceFile& file,
   UnpackPodResourceDescr<StaticModelResourceDescr>(file, resource->descr);
 
   Array<u8> data{byte_allocator_};
-  UnpackResourceData(file, data);
-  const auto* buffer{data.GetData()};
+  const auto* buffer{ViewResourceData(file, data)};
   usize cursor{0};
 
   constexpr auto kResourceIdSize{sizeof(ResourceId)};
@@ -314,8 +313,7 @@ void SkeletalModelResourceHandler::Unpack(const ResourceFile& file,
   UnpackPodResourceDescr<SkeletalModelResourceDescr>(file, resource->descr);
 
   Array<u8> data{byte_allocator_};
-  UnpackResourceData(file, data);
-  const auto* buffer{data.GetData()};
+  const auto* buffer{ViewResourceData(file, data)};
   usize cursor{0};
 
   constexpr auto kResourceIdSize{sizeof(ResourceId)};
@@ -472,8 +470,7 @@ void SkeletonResourceHandler::Unpack(const ResourceFile& file,
   UnpackPodResourceDescr<SkeletonResourceDescr>(file, resource->descr);
 
   Array<u8> data{byte_allocator_};
-  UnpackResourceData(file, data);
-  const auto* buffer{data.GetData()};
+  const auto* buffer{ViewResourceData(file, data)};
   usize cursor{0};
 
   constexpr auto kResourceIdSize{sizeof(ResourceId)};
@@ -6,16 +6,21 @@
 #define COMET_COMET_RESOURCE_RESOURCE_HANDLER_H_
 
 // External. ///////////////////////////////////////////////////////////////////
+#include <atomic>
 #include <type_traits>
 ////////////////////////////////////////////////////////////////////////////////
 
+#include "comet/core/concurrency/job/job.h"
+#include "comet/core/concurrency/job/job_utils.h"
+#include "comet/core/concurrency/job/scheduler.h"
 #include "comet/core/essentials.h"
 #include "comet/core/frame/frame_event.h"
 #include "comet/core/logger.h"
 #include "comet/core/memory/allocator/allocator.h"
 #include "comet/core/memory/allocator/free_list_allocator.h"
 #include "comet/core/memory/memory.h"
-#include "comet/core/type/hash_set.h"
+#include "comet/core/type/array.h"
+#include "comet/core/type/flat_hash_set.h"
 #include "comet/core/type/string_id.h"
 #include "comet/core/type/tstring.h"
 #include "comet/event/event.h"
@@ -23,6 +28,7 @@
 #include "comet/profiler/profiler.h"
 #include "comet/resource/handler/resource_handler_utils.h"
 #include "comet/resource/resource.h"
+#include "comet/resource/resource_archive.h"
 #include "comet/scene/scene_event.h"
 
 namespace comet {
@@ -33,8 +39,119 @@ struct ResourceHandlerDescr {
   internal::LifeSpanAllocators life_span_allocators{};
   memory::Allocator* ptr_allocator{nullptr};
   memory::Allocator* byte_allocator{nullptr};
+  bool is_memory_mapped{false};
+  const ResourceArchives* archives{nullptr};
 };
 
+using ResourceLoadCallbackHandle = void*;
+using ResourceLoadCallback = void (*)(ResourceLoadCallbackHandle);
+
+struct ResourceLoadDescr {
+  ResourceLifeSpan life_span{ResourceLifeSpan::Manual};
+  // Resources needed first (e.g., visible meshes) should be requested with a
+  // higher priority.
+  job::JobPriority priority{job::JobPriority::Normal};
+  job::JobStackSize stack_size{job::JobStackSize::Normal};
+  // Called once every resource of the request is loaded, from the worker
+  // which loaded the last one.
+  ResourceLoadCallback callback{nullptr};
+  ResourceLoadCallbackHandle callback_handle{nullptr};
+  // Optional. Incremented when the request is kicked, and decremented once it
+  // is done, which allows waiting for several requests at once.
+  job::Counter* counter{nullptr};
+};
+
+template <typename T>
+class ResourceHandler;
+
+// Batch of resources loaded asynchronously. See ResourceHandler::LoadAsync().
+// A request waits for its pending loads when destroyed.
+template <typename T>
+class ResourceLoadRequest {
+ public:
+  ResourceLoadRequest() = delete;
+  explicit ResourceLoadRequest(memory::Allocator* allocator);
+  ResourceLoadRequest(const ResourceLoadRequest&) = delete;
+  ResourceLoadRequest(ResourceLoadRequest&&) = delete;
+  ResourceLoadRequest& operator=(const ResourceLoadRequest&) = delete;
+  ResourceLoadRequest& operator=(ResourceLoadRequest&&) = delete;
+  ~ResourceLoadRequest();
+
+  void Wait();
+  bool IsDone() const noexcept;
+
+  usize GetSize() const noexcept;
+  // Resources are stored in request order, and are only valid once the
+  // request is done.
+  T* GetResource(usize index) const;
+
+ private:
+  friend class ResourceHandler<T>;
+
+  struct JobParams {
+    ResourceHandler<T>* handler{nullptr};
+    ResourceLoadRequest<T>* request{nullptr};
+    usize index{kInvalidIndex};
+  };
+
+  void Finish();
+
+  ResourceLoadDescr descr_{};
+  job::Counter* counter_{nullptr};
+  std::atomic<usize> remaining_count_{0};
+  Array<ResourceId> ids_{};
+  Array<T*> resources_{};
+  Array<JobParams> job_params_{};
+};
+
+template <typename T>
+inline ResourceLoadRequest<T>::ResourceLoadRequest(
+    memory::Allocator* allocator)
+    : ids_{allocator}, resources_{allocator}, job_params_{allocator} {}
+
+template <typename T>
+inline ResourceLoadRequest<T>::~ResourceLoadRequest() {
+  if (counter_ == nullptr) {
+    return;
+  }
+
+  Wait();
+  job::Scheduler::Get().DestroyCounter(counter_);
+  counter_ = nullptr;
+}
+
+template <typename T>
+inline void ResourceLoadRequest<T>::Wait() {
+  job::Scheduler::Get().Wait(counter_);
+}
+
+template <typename T>
+inline bool ResourceLoadRequest<T>::IsDone() const noexcept {
+  return counter_ == nullptr || counter_->IsZero();
+}
+
+template <typename T>
+inline usize ResourceLoadRequest<T>::GetSize() const noexcept {
+  return ids_.GetSize();
+}
+
+template <typename T>
+inline T* ResourceLoadRequest<T>::GetResource(usize index) const {
+  COMET_ASSERT(IsDone(), "Resource load request is not done yet!");
+  return resources_[index];
+}
+
+template <typename T>
+inline void ResourceLoadRequest<T>::Finish() {
+  if (descr_.callback != nullptr) {
+    descr_.callback(descr_.callback_handle);
+  }
+
+  if (descr_.counter != nullptr) {
+    descr_.counter->Decrement();
+  }
+}
+
 template <typename T>
 class ResourceHandler {
  public:
@@ -52,6 +169,14 @@ class ResourceHandler {
   T* Load(CTStringView path,
           ResourceLifeSpan life_span = ResourceLifeSpan::Manual);
   T* Load(ResourceId id, ResourceLifeSpan life_span = ResourceLifeSpan::Manual);
+  // Loads the resources on fiber workers without blocking the caller, which
+  // keeps the request alive until it is done. Resources which are already
+  // loaded are set immediately.
+  void LoadAsync(ResourceId id, ResourceLoadRequest<T>& request,
+                 const ResourceLoadDescr& descr = {});
+  void LoadAsync(const ResourceId* ids, usize id_count,
+                 ResourceLoadRequest<T>& request,
+                 const ResourceLoadDescr& descr = {});
   void Unload(CTStringView path);
   void Unload(ResourceId id);
 
@@ -65,7 +190,9 @@ class ResourceHandler {
 
   virtual void InitializeDefaults() {};
   virtual void DestroyDefaults() {};
+  T* TryGetLoaded(ResourceId id, ResourceLifeSpan life_span);
   T* LoadInternal(ResourceId id, ResourceLifeSpan life_span);
+  static void OnLoadAsync(job::JobParamsHandle params_handle);
   void DestroyDeleted();
   memory::Allocator* ResolveAllocator(memory::Allocator* default_allocator,
                                       ResourceLifeSpan life_span) const;
@@ -85,8 +212,10 @@ class ResourceHandler {
   internal::LoadingTracker<T> tracker_{};
   memory::FiberFreeListAllocator resource_allocator_{};
   internal::LifeSpanAllocators life_span_allocators_{};
-  HashSet<T*> deleted_resources_{};
+  FlatHashSet<T*> deleted_resources_{};
   memory::Allocator* byte_allocator_{nullptr};
+  bool is_memory_mapped_{false};
+  const ResourceArchives* archives_{nullptr};
 
  private:
   bool is_initialized_{false};
@@ -106,7 +235,9 @@ inline ResourceHandler<T>::ResourceHandler(const ResourceHandlerDescr& descr)
                               : kDefaultResourceCapacity_,
                           memory::kEngineMemoryTagResource},
       life_span_allocators_{descr.life_span_allocators},
-      byte_allocator_{descr.byte_allocator} {}
+      byte_allocator_{descr.byte_allocator},
+      is_memory_mapped_{descr.is_memory_mapped},
+      archives_{descr.archives} {}
 
 template <typename T>
 inline ResourceHandler<T>::~ResourceHandler() {
@@ -122,7 +253,7 @@ inline void ResourceHandler<T>::Initialize() {
 
   defaults_.Initialize();
   tracker_.Initialize();
-  deleted_resources_ = HashSet<T*>{byte_allocator_, 64};
+  deleted_resources_ = FlatHashSet<T*>{byte_allocator_, 64};
   InitializeDefaults();
 
   const auto event_function{
@@ -157,13 +288,9 @@ inline T* ResourceHandler<T>::Load(CTStringView path,
 template <typename T>
 inline T* ResourceHandler<T>::Load(ResourceId id, ResourceLifeSpan life_span) {
   COMET_RESOURCE_HANDLER_SETUP_PROFILING("Load", id);
-  T* resource;
+  auto* resource{TryGetLoaded(id, life_span)};
 
-  if ((resource = defaults_.TryGet(id)) != nullptr) {
-    return resource;
-  }
-
-  if ((resource = cache_.TryGet(id, life_span)) != nullptr) {
+  if (resource != nullptr) {
     return resource;
   }
 
@@ -179,6 +306,62 @@ inline T* ResourceHandler<T>::Load(ResourceId id, ResourceLifeSpan life_span) {
   return resource;
 }
 
+template <typename T>
+inline void ResourceHandler<T>::LoadAsync(ResourceId id,
+                                          ResourceLoadRequest<T>& request,
+                                          const ResourceLoadDescr& descr) {
+  LoadAsync(&id, 1, request, descr);
+}
+
+template <typename T>
+inline void ResourceHandler<T>::LoadAsync(const ResourceId* ids,
+                                          usize id_count,
+                                          ResourceLoadRequest<T>& request,
+                                          const ResourceLoadDescr& descr) {
+  COMET_PROFILE("ResourceHandler<T>::LoadAsync");
+  COMET_ASSERT(request.counter_ == nullptr,
+               "Resource load request has already been kicked!");
+  request.descr_ = descr;
+  request.counter_ = job::Scheduler::Get().GenerateCounter();
+  request.ids_.Resize(id_count);
+  request.resources_.Resize(id_count);
+  request.job_params_.Reserve(id_count);
+
+  for (usize i{0}; i < id_count; ++i) {
+    const auto id{ids[i]};
+    auto* resource{TryGetLoaded(id, descr.life_span)};
+    request.ids_[i] = id;
+    request.resources_[i] = resource;
+
+    if (resource == nullptr) {
+      auto& params{request.job_params_.EmplaceBack()};
+      params.handler = this;
+      params.request = &request;
+      params.index = i;
+    }
+  }
+
+  if (descr.counter != nullptr) {
+    descr.counter->Increment();
+  }
+
+  const auto pending_count{request.job_params_.GetSize()};
+  request.remaining_count_.store(pending_count, std::memory_order_relaxed);
+
+  if (pending_count == 0) {
+    request.Finish();
+    return;
+  }
+
+  auto& scheduler{job::Scheduler::Get()};
+
+  for (auto& params : request.job_params_) {
+    scheduler.Kick(job::GenerateJobDescr(descr.priority, OnLoadAsync, &params,
+                                         descr.stack_size, request.counter_,
+                                         "resource_load_async"));
+  }
+}
+
 template <typename T>
 inline void ResourceHandler<T>::Unload(CTStringView path) {
   Unload(GenerateResourceIdFromPath<T>(path));
@@ -208,6 +391,18 @@ inline void ResourceHandler<T>::Unload(ResourceId id) {
   deleted_resources_.Add(resource);
 }
 
+template <typename T>
+inline T* ResourceHandler<T>::TryGetLoaded(ResourceId id,
+                                           ResourceLifeSpan life_span) {
+  auto* resource{defaults_.TryGet(id)};
+
+  if (resource != nullptr) {
+    return resource;
+  }
+
+  return cache_.TryGet(id, life_span);
+}
+
 template <typename T>
 inline T* ResourceHandler<T>::LoadInternal(ResourceId id,
                                            ResourceLifeSpan life_span) {
@@ -215,13 +410,26 @@ inline T* ResourceHandler<T>::LoadInternal(ResourceId id,
   ResourceFile file{};
   file.descr = Array<u8>{byte_allocator_};
   file.data = Array<u8>{byte_allocator_};
-  const auto& resource_abs_path{
-      internal::GenerateTlsResourceAbsPath(root_path_, id)};
   T* resource{nullptr};
 
-  if (LoadResourceFile(resource_abs_path, file)) {
+  // Archived resources are read in place, while loose files are the
+  // fallback.
+  auto is_loaded{archives_ != nullptr &&
+                 TryGetResourceFile(*archives_, id, file)};
+
+  if (!is_loaded) {
+    // Loading waits for I/O jobs: the fiber may be resumed on another worker,
+    // while this one reuses its cached path.
+    const TString resource_abs_path{
+        internal::GenerateTlsResourceAbsPath(root_path_, id)};
+    is_loaded = is_memory_mapped_ ? MapResourceFile(resource_abs_path, file)
+                                  : LoadResourceFile(resource_abs_path, file);
+  }
+
+  if (is_loaded) {
     resource = resource_allocator_.AllocateOneAndPopulate<T>();
     Unpack(file, life_span, resource);
+    UnmapResourceFile(file);
     resource->ref_count = 1;
     cache_.Set(resource->id, life_span, resource);
   } else {
@@ -233,6 +441,24 @@ inline T* ResourceHandler<T>::LoadInternal(ResourceId id,
   return resource;
 }
 
+template <typename T>
+inline void ResourceHandler<T>::OnLoadAsync(
+    job::JobParamsHandle params_handle) {
+  const auto* params{
+      static_cast<const typename ResourceLoadRequest<T>::JobParams*>(
+          params_handle)};
+  auto* request{params->request};
+  request->resources_[params->index] = params->handler->Load(
+      request->ids_[params->index], request->descr_.life_span);
+
+  // The request's counter is only decremented once this job returns, so the
+  // request is still alive at this point.
+  if (request->remaining_count_.fetch_sub(1, std::memory_order_acq_rel) ==
+      1) {
+    request->Finish();
+  }
+}
+
 template <typename T>
 inline void ResourceHandler<T>::DestroyDeleted() {
   for (auto* resource : deleted_resources_) {
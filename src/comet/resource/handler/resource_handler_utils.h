@@ -15,7 +15,7 @@
 #include "comet/core/memory/allocator/allocator.h"
 #include "comet/core/memory/allocator/free_list_allocator.h"
 #include "comet/core/memory/memory.h"
-#include "comet/core/type/map.h"
+#include "comet/core/type/flat_map.h"
 #include "comet/core/type/tstring.h"
 #include "comet/profiler/profiler.h"
 #include "comet/resource/resource.h"
@@ -48,7 +48,7 @@ class DefaultResources {
 
  private:
   memory::Allocator* allocator_{nullptr};
-  Map<ResourceId, T*> defaults_{};
+  FlatMap<ResourceId, T*> defaults_{};
 };
 
 template <typename T>
@@ -57,7 +57,7 @@ inline DefaultResources<T>::DefaultResources(memory::Allocator* allocator)
 
 template <typename T>
 inline void DefaultResources<T>::Initialize() {
-  defaults_ = Map<ResourceId, T*>{allocator_};
+  defaults_ = FlatMap<ResourceId, T*>{allocator_};
 }
 
 template <typename T>
@@ -122,7 +122,7 @@ class ResourceCache {
 
  private:
   fiber::FiberMutex mtx_{};
-  Map<ResourceIdLifeSpanPair, T*> resources_{};
+  FlatMap<ResourceIdLifeSpanPair, T*> resources_{};
 };
 
 template <typename T>
@@ -208,7 +208,7 @@ class LoadingTracker {
   void ReleaseLoadingState(LoadingResourceState<T>* state);
 
   fiber::FiberMutex mtx_{};
-  Map<ResourceIdLifeSpanPair, LoadingResourceState<T>*> loading_{};
+  FlatMap<ResourceIdLifeSpanPair, LoadingResourceState<T>*> loading_{};
   memory::FiberFreeListAllocator state_allocator_{
       sizeof(LoadingResourceState<T>), 128, memory::kEngineMemoryTagResource};
   memory::Allocator* ptr_allocator_{nullptr};
@@ -221,7 +221,7 @@ inline LoadingTracker<T>::LoadingTracker(memory::Allocator* ptr_allocator)
 template <typename T>
 inline void LoadingTracker<T>::Initialize() {
   loading_ =
-      Map<ResourceIdLifeSpanPair, LoadingResourceState<T>*>{ptr_allocator_};
+      FlatMap<ResourceIdLifeSpanPair, LoadingResourceState<T>*>{ptr_allocator_};
 }
 
 template <typename T>
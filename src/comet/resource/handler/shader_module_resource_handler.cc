@@ -56,13 +56,12 @@ void ShaderModuleResourceHandler::Unpack(const ResourceFile& file,
   UnpackPodResourceDescr<ShaderModuleResourceDescr>(file, resource->descr);
 
   Array<u8> data{byte_allocator_};
-  UnpackResourceData(file, data);
-  const auto* buffer{data.GetData()};
+  const auto* buffer{ViewResourceData(file, data)};
   usize cursor{0};
 
   constexpr auto kResourceIdSize{sizeof(resource::ResourceId)};
   constexpr auto kResourceTypeIdSize{sizeof(resource::ResourceTypeId)};
-  const auto data_size{data.GetSize() - kResourceIdSize - kResourceTypeIdSize};
+  const auto data_size{file.data_size - kResourceIdSize - kResourceTypeIdSize};
 
   memory::CopyMemory(&resource->id, &buffer[cursor], kResourceIdSize);
   cursor += kResourceIdSize;
@@ -54,12 +54,12 @@ void ShaderResourceHandler::Unpack(const ResourceFile& file,
                                    ResourceLifeSpan life_span,
                                    ShaderResource* resource) {
   Array<u8> dumped_descr{byte_allocator_};
-  UnpackBytes(file.compression_mode, file.descr, file.descr_size, dumped_descr);
+  UnpackBytes(file.compression_mode, GetPackedDescr(file),
+              file.packed_descr_size, file.descr_size, dumped_descr);
   ParseDescr(dumped_descr, resource->descr);
 
   Array<u8> data{byte_allocator_};
-  UnpackResourceData(file, data);
-  const auto* buffer{data.GetData()};
+  const auto* buffer{ViewResourceData(file, data)};
   usize cursor{0};
 
   constexpr auto kResourceIdSize{sizeof(resource::ResourceId)};
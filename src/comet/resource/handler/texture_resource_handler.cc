@@ -69,13 +69,12 @@ void TextureResourceHandler::Unpack(const ResourceFile& file,
   UnpackPodResourceDescr<TextureResourceDescr>(file, resource->descr);
 
   Array<u8> data{byte_allocator_};
-  UnpackResourceData(file, data);
-  const auto* buffer{data.GetData()};
+  const auto* buffer{ViewResourceData(file, data)};
   usize cursor{0};
 
   constexpr auto kResourceIdSize{sizeof(resource::ResourceId)};
   constexpr auto kResourceTypeIdSize{sizeof(resource::ResourceTypeId)};
-  const auto data_size{sizeof(u8) * data.GetSize() - kResourceIdSize -
+  const auto data_size{sizeof(u8) * file.data_size - kResourceIdSize -
                        kResourceTypeIdSize};
 
   memory::CopyMemory(&resource->id, &buffer[cursor], kResourceIdSize);
@@ -96,17 +96,42 @@ void UnpackResourceData(const ResourceFile& file, Array<u8>& data,
                      ? math::Min(max_data_size, file.data_size)
                      : file.data_size};
 
-  UnpackBytes(file.compression_mode, file.data, data_size, data);
+  UnpackBytes(file.compression_mode, GetPackedData(file),
+              file.packed_data_size, data_size, data);
 }
 
-bool SaveResourceFile(CTStringView path, const ResourceFile& file) {
-  std::ofstream out_file;
+const u8* GetPackedDescr(const ResourceFile& file) {
+  if (file.in_place_bytes != nullptr) {
+    return file.in_place_bytes + kResourceFileHeaderSize;
+  }
 
-  if (!OpenFileToWriteTo(path, out_file, false, true)) {
-    COMET_LOG_RESOURCE_ERROR("Unable to write resource file: ", path);
-    return false;
+  return file.descr.GetData();
+}
+
+const u8* GetPackedData(const ResourceFile& file) {
+  if (file.in_place_bytes != nullptr) {
+    return file.in_place_bytes + kResourceFileHeaderSize +
+           file.packed_descr_size;
   }
 
+  return file.data.GetData();
+}
+
+const u8* ViewResourceData(const ResourceFile& file, Array<u8>& buffer) {
+  if (file.compression_mode == CompressionMode::None) {
+    return GetPackedData(file);
+  }
+
+  UnpackResourceData(file, buffer);
+  return buffer.GetData();
+}
+
+usize GetResourceFileSize(const ResourceFile& file) {
+  return kResourceFileHeaderSize + file.packed_descr_size +
+         file.packed_data_size;
+}
+
+void WriteResourceFile(std::ofstream& out_file, const ResourceFile& file) {
   out_file.write(reinterpret_cast<const schar*>(&file.resource_type_id),
                  static_cast<std::streamsize>(sizeof(file.resource_type_id)));
 
@@ -125,40 +150,119 @@ bool SaveResourceFile(CTStringView path, const ResourceFile& file) {
   out_file.write(reinterpret_cast<const schar*>(&file.data_size),
                  static_cast<std::streamsize>(sizeof(file.data_size)));
 
-  out_file.write(reinterpret_cast<const schar*>(file.descr.GetData()),
+  out_file.write(reinterpret_cast<const schar*>(GetPackedDescr(file)),
                  file.packed_descr_size);
 
-  out_file.write(reinterpret_cast<const schar*>(file.data.GetData()),
+  out_file.write(reinterpret_cast<const schar*>(GetPackedData(file)),
                  file.packed_data_size);
+}
+
+bool SaveResourceFile(CTStringView path, const ResourceFile& file) {
+  std::ofstream out_file;
 
+  if (!OpenFileToWriteTo(path, out_file, false, true)) {
+    COMET_LOG_RESOURCE_ERROR("Unable to write resource file: ", path);
+    return false;
+  }
+
+  WriteResourceFile(out_file, file);
   CloseFile(out_file);
   return true;
 }
 
+bool MapResourceFile(CTStringView path, ResourceFile& file) {
+  if (!MapFile(path, file.mapped_file)) {
+    COMET_LOG_RESOURCE_ERROR("Unable to map resource file: ", path);
+    return false;
+  }
+
+  if (!ViewResourceFile(file.mapped_file.data, file.mapped_file.size, file)) {
+    COMET_LOG_RESOURCE_ERROR("Invalid resource file: ", path);
+    UnmapResourceFile(file);
+    return false;
+  }
+
+  return true;
+}
+
+void UnmapResourceFile(ResourceFile& file) {
+  UnmapFile(file.mapped_file);
+  file.in_place_bytes = nullptr;
+}
+
+bool ViewResourceFile(const u8* bytes, usize size, ResourceFile& file) {
+  if (size < kResourceFileHeaderSize) {
+    return false;
+  }
+
+  usize cursor{0};
+  memory::CopyMemory(&file.resource_type_id, bytes + cursor,
+                     sizeof(file.resource_type_id));
+  cursor += sizeof(file.resource_type_id);
+  memory::CopyMemory(&file.compression_mode, bytes + cursor,
+                     sizeof(file.compression_mode));
+  cursor += sizeof(file.compression_mode);
+  memory::CopyMemory(&file.packed_descr_size, bytes + cursor,
+                     sizeof(file.packed_descr_size));
+  cursor += sizeof(file.packed_descr_size);
+  memory::CopyMemory(&file.packed_data_size, bytes + cursor,
+                     sizeof(file.packed_data_size));
+  cursor += sizeof(file.packed_data_size);
+  memory::CopyMemory(&file.descr_size, bytes + cursor,
+                     sizeof(file.descr_size));
+  cursor += sizeof(file.descr_size);
+  memory::CopyMemory(&file.data_size, bytes + cursor, sizeof(file.data_size));
+
+  if (size < GetResourceFileSize(file)) {
+    return false;
+  }
+
+  file.in_place_bytes = bytes;
+  return true;
+}
+
 bool LoadResourceFile(CTStringView path, ResourceFile& file) {
   struct JobParams {
+    bool is_opened{false};
     bool is_loaded{false};
     const tchar* path{nullptr};
     ResourceFile* file{nullptr};
+    std::ifstream in_file{};
   };
 
   JobParams params{};
   params.path = path.GetCTStr();
   params.file = &file;
 
+#ifdef COMET_FIBER_DEBUG_LABEL
+  schar debug_label[fiber::Fiber::kDebugLabelMaxLen_ + 1]{};
+  auto prefix_len{GetLength("rfile_alloc_")};
+  Copy(debug_label, "rfile_alloc_", prefix_len);
+  auto name{GetName(params.path)};
+
+  Copy(debug_label + prefix_len, name.GetCTStr(),
+       math::Min(fiber::Fiber::kDebugLabelMaxLen_ - prefix_len,
+                 name.GetLength()));
+#else
+  const schar* debug_label{nullptr};
+#endif  // COMET_FIBER_DEBUG_LABEL
+
+  // Reading the header, allocating the buffers from a fiber, and reading the
+  // rest of the file are chained: no job is blocked while another one runs.
+  job::CounterGuard header_guard{};
+  job::CounterGuard alloc_guard{};
   job::CounterGuard guard{};
+  auto& scheduler{job::Scheduler::Get()};
 
-  job::Scheduler::Get().KickAndWait(job::GenerateIOJobDescr(
+  scheduler.Kick(job::GenerateIOJobDescr(
       [](job::IOJobParamsHandle params_handle) {
         auto* params{reinterpret_cast<JobParams*>(params_handle)};
         auto* path{params->path};
         auto* file{params->file};
-
-        std::ifstream in_file;
+        auto& in_file{params->in_file};
 
         if (!OpenFileToReadFrom(path, in_file, false, true)) {
           COMET_LOG_RESOURCE_ERROR("Unable to open resource file: ", path);
-          params->is_loaded = false;
           return;
         }
 
@@ -181,52 +285,52 @@ bool LoadResourceFile(CTStringView path, ResourceFile& file) {
         in_file.read(reinterpret_cast<schar*>(&file->data_size),
                      sizeof(file->data_size));
 
-        struct AllocJobParams {
-          ResourceFile* file{nullptr};
-        };
-
-        AllocJobParams alloc_params{};
-        alloc_params.file = file;
-
-#ifdef COMET_FIBER_DEBUG_LABEL
-        schar debug_label[fiber::Fiber::kDebugLabelMaxLen_ + 1];
-        auto prefix_len{GetLength("rfile_alloc_")};
-        Copy(debug_label, "rfile_alloc_", prefix_len);
-        auto name{GetName(path)};
-
-        Copy(debug_label + prefix_len, name.GetCTStr(),
-             math::Min(fiber::Fiber::kDebugLabelMaxLen_ - prefix_len,
-                       name.GetLength()));
-#else
-        const schar* debug_label{nullptr};
-#endif  // COMET_FIBER_DEBUG_LABEL
-
-        {
-          job::CounterGuard alloc_guard{};
-
-          job::Scheduler::Get().KickAndWait(job::GenerateJobDescr(
-              job::JobPriority::High,
-              [](job::JobParamsHandle params_handle) {
-                auto* alloc_params{
-                    reinterpret_cast<AllocJobParams*>(params_handle)};
-                auto* file{alloc_params->file};
-                file->descr.Resize(file->packed_descr_size);
-                file->data.Resize(file->packed_data_size);
-              },
-              &alloc_params, job::JobStackSize::Normal,
-              alloc_guard.GetCounter(), debug_label));
-        }
-
-        in_file.read(reinterpret_cast<schar*>(file->descr.GetData()),
-                     file->packed_descr_size);
-
-        in_file.read(reinterpret_cast<schar*>(file->data.GetData()),
-                     file->packed_data_size);
-
-        params->is_loaded = true;
+        params->is_opened = true;
       },
-      &params, guard.GetCounter()));
-
+      &params, header_guard.GetCounter()));
+
+  scheduler.KickAfter(
+      job::GenerateJobDescr(
+          job::JobPriority::High,
+          [](job::JobParamsHandle params_handle) {
+            auto* params{reinterpret_cast<JobParams*>(params_handle)};
+
+            if (!params->is_opened) {
+              return;
+            }
+
+            auto* file{params->file};
+            file->descr.Resize(file->packed_descr_size);
+            file->data.Resize(file->packed_data_size);
+          },
+          &params, job::JobStackSize::Normal, alloc_guard.GetCounter(),
+          debug_label),
+      header_guard.GetCounter());
+
+  scheduler.KickAfter(
+      job::GenerateIOJobDescr(
+          [](job::IOJobParamsHandle params_handle) {
+            auto* params{reinterpret_cast<JobParams*>(params_handle)};
+
+            if (!params->is_opened) {
+              return;
+            }
+
+            auto* file{params->file};
+            auto& in_file{params->in_file};
+
+            in_file.read(reinterpret_cast<schar*>(file->descr.GetData()),
+                         file->packed_descr_size);
+
+            in_file.read(reinterpret_cast<schar*>(file->data.GetData()),
+                         file->packed_data_size);
+
+            params->is_loaded = true;
+          },
+          &params, guard.GetCounter()),
+      alloc_guard.GetCounter());
+
+  guard.Wait();
   return params.is_loaded;
 }
 }  // namespace resource
@@ -6,11 +6,13 @@
 #define COMET_COMET_RESOURCE_RESOURCE_H_
 
 // External. ///////////////////////////////////////////////////////////////////
+#include <fstream>
 #include <type_traits>
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "comet/core/compression.h"
 #include "comet/core/essentials.h"
+#include "comet/core/file_system/file_system.h"
 #include "comet/core/memory/memory.h"
 #include "comet/core/type/string_id.h"
 #include "comet/core/type/tstring.h"
@@ -37,8 +39,16 @@ struct ResourceFile {
   usize packed_data_size{0};
   Array<u8> descr{};
   Array<u8> data{};
+  // Set when the file is read in place (e.g., memory-mapped): points to its
+  // serialized form, and descr and data are left empty.
+  const u8* in_place_bytes{nullptr};
+  MappedFile mapped_file{};
 };
 
+// Resource type ID, compression mode, and the four sizes of the file.
+constexpr usize kResourceFileHeaderSize{
+    sizeof(ResourceTypeId) + sizeof(CompressionMode) + sizeof(usize) * 4};
+
 using RefCount = u32;
 constexpr auto kInvalidRefCount{static_cast<RefCount>(-1)};
 
@@ -111,15 +121,31 @@ void UnpackBytes(CompressionMode compression_mode,
 void UnpackResourceData(const ResourceFile& file, Array<u8>& data,
                         usize max_data_size = kInvalidSize);
 
+const u8* GetPackedDescr(const ResourceFile& file);
+const u8* GetPackedData(const ResourceFile& file);
+
+// Returns the unpacked data of the file. Uncompressed data is returned in
+// place (e.g., straight from the file mapping): the buffer is only used to
+// decompress the data otherwise.
+const u8* ViewResourceData(const ResourceFile& file, Array<u8>& buffer);
+
 template <typename ResourceDescrType>
 void UnpackPodResourceDescr(const ResourceFile& file,
                             ResourceDescrType& descr) {
-  UnpackBytes(file.compression_mode, file.descr.GetData(),
+  UnpackBytes(file.compression_mode, GetPackedDescr(file),
               file.packed_descr_size, descr);
 }
 
+usize GetResourceFileSize(const ResourceFile& file);
+void WriteResourceFile(std::ofstream& out_file, const ResourceFile& file);
 bool SaveResourceFile(CTStringView path, const ResourceFile& file);
 bool LoadResourceFile(CTStringView path, ResourceFile& file);
+// Reads a serialized resource file in place. The bytes must outlive the file.
+bool ViewResourceFile(const u8* bytes, usize size, ResourceFile& file);
+// Maps the file instead of reading it. The file must be unmapped once
+// unpacked.
+bool MapResourceFile(CTStringView path, ResourceFile& file);
+void UnmapResourceFile(ResourceFile& file);
 }  // namespace resource
 }  // namespace comet
 
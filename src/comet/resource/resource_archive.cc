@@ -0,0 +1,221 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Header. /////////////////////////////////////////////////////////////////////
+#include "resource_archive.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <utility>
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/logger.h"
+#include "comet/core/memory/memory_utils.h"
+
+namespace comet {
+namespace resource {
+ResourceArchive::ResourceArchive(ResourceArchive&& other) noexcept
+    : mapped_file_{other.mapped_file_},
+      entries_{other.entries_},
+      entry_count_{other.entry_count_} {
+  other.mapped_file_ = MappedFile{};
+  other.entries_ = nullptr;
+  other.entry_count_ = 0;
+}
+
+ResourceArchive& ResourceArchive::operator=(ResourceArchive&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+
+  Close();
+  mapped_file_ = other.mapped_file_;
+  entries_ = other.entries_;
+  entry_count_ = other.entry_count_;
+  other.mapped_file_ = MappedFile{};
+  other.entries_ = nullptr;
+  other.entry_count_ = 0;
+  return *this;
+}
+
+ResourceArchive::~ResourceArchive() { Close(); }
+
+bool ResourceArchive::Open(CTStringView path) {
+  COMET_ASSERT(!IsOpen(), "Resource archive is already open!");
+
+  if (!MapFile(path, mapped_file_)) {
+    COMET_LOG_RESOURCE_ERROR("Unable to map resource archive: ", path);
+    return false;
+  }
+
+  ResourceArchiveHeader header{};
+
+  if (mapped_file_.size < sizeof(header)) {
+    COMET_LOG_RESOURCE_ERROR("Invalid resource archive: ", path);
+    Close();
+    return false;
+  }
+
+  memory::CopyMemory(&header, mapped_file_.data, sizeof(header));
+
+  if (header.magic != kResourceArchiveMagic ||
+      header.version != kResourceArchiveVersion) {
+    COMET_LOG_RESOURCE_ERROR("Unsupported resource archive: ", path);
+    Close();
+    return false;
+  }
+
+  const auto toc_size{header.entry_count * sizeof(ResourceArchiveEntry)};
+
+  if (header.toc_offset % alignof(ResourceArchiveEntry) != 0 ||
+      header.toc_offset + toc_size > mapped_file_.size) {
+    COMET_LOG_RESOURCE_ERROR("Corrupted resource archive: ", path);
+    Close();
+    return false;
+  }
+
+  // The mapping is page-aligned: the table of contents is read in place.
+  entries_ = reinterpret_cast<const ResourceArchiveEntry*>(mapped_file_.data +
+                                                           header.toc_offset);
+  entry_count_ = static_cast<usize>(header.entry_count);
+  return true;
+}
+
+void ResourceArchive::Close() {
+  UnmapFile(mapped_file_);
+  entries_ = nullptr;
+  entry_count_ = 0;
+}
+
+const ResourceArchiveEntry* ResourceArchive::TryGetEntry(
+    ResourceId resource_id) const {
+  const auto* end{entries_ + entry_count_};
+  const auto* entry{std::lower_bound(
+      entries_, end, resource_id,
+      [](const ResourceArchiveEntry& entry, ResourceId resource_id) {
+        return entry.resource_id < resource_id;
+      })};
+
+  if (entry == end || entry->resource_id != resource_id) {
+    return nullptr;
+  }
+
+  return entry;
+}
+
+bool ResourceArchive::TryGetResourceFile(ResourceId resource_id,
+                                         ResourceFile& file) const {
+  const auto* entry{TryGetEntry(resource_id)};
+
+  if (entry == nullptr) {
+    return false;
+  }
+
+  if (entry->offset + entry->size > mapped_file_.size ||
+      !ViewResourceFile(mapped_file_.data + entry->offset,
+                        static_cast<usize>(entry->size), file)) {
+    COMET_LOG_RESOURCE_ERROR("Corrupted resource archive entry: ",
+                             COMET_STRING_ID_LABEL(resource_id), ".");
+    return false;
+  }
+
+  file.resource_id = resource_id;
+  return true;
+}
+
+bool ResourceArchive::IsOpen() const noexcept { return IsMapped(mapped_file_); }
+
+usize ResourceArchive::GetEntryCount() const noexcept { return entry_count_; }
+
+bool TryGetResourceFile(const ResourceArchives& archives,
+                        ResourceId resource_id, ResourceFile& file) {
+  for (const auto& archive : archives) {
+    if (archive.TryGetResourceFile(resource_id, file)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+ResourceArchiveWriter::ResourceArchiveWriter(memory::Allocator* allocator)
+    : entries_{allocator} {}
+
+ResourceArchiveWriter::~ResourceArchiveWriter() {
+  COMET_ASSERT(!out_file_.is_open(),
+               "Destructor called for resource archive writer, but it is "
+               "still open!");
+}
+
+bool ResourceArchiveWriter::Open(CTStringView path) {
+  COMET_ASSERT(!out_file_.is_open(),
+               "Resource archive writer is already open!");
+
+  if (!OpenFileToWriteTo(path, out_file_, false, true)) {
+    COMET_LOG_RESOURCE_ERROR("Unable to write resource archive: ", path);
+    return false;
+  }
+
+  // The header is written last, once the table of contents is known.
+  offset_ = 0;
+  entries_.Clear();
+  Pad(kResourceArchiveAlignment);
+  return true;
+}
+
+void ResourceArchiveWriter::Add(const ResourceFile& file) {
+  COMET_ASSERT(out_file_.is_open(), "Resource archive writer is not open!");
+  Pad(kResourceArchiveAlignment);
+
+  auto& entry{entries_.EmplaceBack()};
+  entry.offset = offset_;
+  entry.size = GetResourceFileSize(file);
+  entry.resource_id = file.resource_id;
+  entry.compression_mode = file.compression_mode;
+
+  WriteResourceFile(out_file_, file);
+  offset_ += static_cast<usize>(entry.size);
+}
+
+bool ResourceArchiveWriter::Close() {
+  COMET_ASSERT(out_file_.is_open(), "Resource archive writer is not open!");
+  std::sort(entries_.begin(), entries_.end(),
+            [](const ResourceArchiveEntry& a, const ResourceArchiveEntry& b) {
+              return a.resource_id < b.resource_id;
+            });
+
+  Pad(alignof(ResourceArchiveEntry));
+
+  ResourceArchiveHeader header{};
+  header.entry_count = entries_.GetSize();
+  header.toc_offset = offset_;
+
+  out_file_.write(reinterpret_cast<const schar*>(entries_.GetData()),
+                  static_cast<std::streamsize>(entries_.GetSize() *
+                                               sizeof(ResourceArchiveEntry)));
+
+  out_file_.seekp(0);
+  out_file_.write(reinterpret_cast<const schar*>(&header),
+                  static_cast<std::streamsize>(sizeof(header)));
+
+  const auto is_ok{out_file_.good()};
+  CloseFile(out_file_);
+  entries_.Clear();
+  offset_ = 0;
+  return is_ok;
+}
+
+void ResourceArchiveWriter::Pad(usize alignment) {
+  static constexpr schar kPadding[kResourceArchiveAlignment]{};
+  const auto padding{memory::AlignSize(offset_, alignment) - offset_};
+  out_file_.write(kPadding, static_cast<std::streamsize>(padding));
+  offset_ += padding;
+}
+}  // namespace resource
+}  // namespace comet
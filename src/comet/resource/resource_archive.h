@@ -0,0 +1,100 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+#ifndef COMET_COMET_RESOURCE_RESOURCE_ARCHIVE_H_
+#define COMET_COMET_RESOURCE_RESOURCE_ARCHIVE_H_
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <fstream>
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/essentials.h"
+#include "comet/core/file_system/file_system.h"
+#include "comet/core/memory/allocator/allocator.h"
+#include "comet/core/type/array.h"
+#include "comet/core/type/tstring.h"
+#include "comet/resource/resource.h"
+
+namespace comet {
+namespace resource {
+// Archive layout: header, entries (each one being a serialized resource file),
+// and the table of contents, which is sorted by resource ID. Entries are
+// page-aligned so that they can be mapped and read in place.
+constexpr CTStringView kResourceArchiveExtension{COMET_TCHAR("pak")};
+constexpr u32 kResourceArchiveMagic{0x4b415043};  // "CPAK".
+constexpr u32 kResourceArchiveVersion{1};
+constexpr usize kResourceArchiveAlignment{4096};
+
+struct ResourceArchiveHeader {
+  u32 magic{kResourceArchiveMagic};
+  u32 version{kResourceArchiveVersion};
+  u64 entry_count{0};
+  u64 toc_offset{0};
+};
+
+struct ResourceArchiveEntry {
+  u64 offset{0};
+  u64 size{0};
+  ResourceId resource_id{kInvalidResourceId};
+  CompressionMode compression_mode{CompressionMode::None};
+};
+
+// Read-only, memory-mapped archive.
+class ResourceArchive {
+ public:
+  ResourceArchive() = default;
+  ResourceArchive(const ResourceArchive&) = delete;
+  ResourceArchive(ResourceArchive&& other) noexcept;
+  ResourceArchive& operator=(const ResourceArchive&) = delete;
+  ResourceArchive& operator=(ResourceArchive&& other) noexcept;
+  ~ResourceArchive();
+
+  bool Open(CTStringView path);
+  void Close();
+
+  const ResourceArchiveEntry* TryGetEntry(ResourceId resource_id) const;
+  // The file is read in place, and is valid until the archive is closed.
+  bool TryGetResourceFile(ResourceId resource_id, ResourceFile& file) const;
+
+  bool IsOpen() const noexcept;
+  usize GetEntryCount() const noexcept;
+
+ private:
+  MappedFile mapped_file_{};
+  const ResourceArchiveEntry* entries_{nullptr};
+  usize entry_count_{0};
+};
+
+using ResourceArchives = Array<ResourceArchive>;
+
+bool TryGetResourceFile(const ResourceArchives& archives,
+                        ResourceId resource_id, ResourceFile& file);
+
+// Writes an archive entry by entry. The table of contents is written when
+// the writer is closed.
+class ResourceArchiveWriter {
+ public:
+  ResourceArchiveWriter() = delete;
+  explicit ResourceArchiveWriter(memory::Allocator* allocator);
+  ResourceArchiveWriter(const ResourceArchiveWriter&) = delete;
+  ResourceArchiveWriter(ResourceArchiveWriter&&) = delete;
+  ResourceArchiveWriter& operator=(const ResourceArchiveWriter&) = delete;
+  ResourceArchiveWriter& operator=(ResourceArchiveWriter&&) = delete;
+  ~ResourceArchiveWriter();
+
+  bool Open(CTStringView path);
+  void Add(const ResourceFile& file);
+  bool Close();
+
+ private:
+  void Pad(usize alignment);
+
+  usize offset_{0};
+  std::ofstream out_file_{};
+  Array<ResourceArchiveEntry> entries_{};
+};
+}  // namespace resource
+}  // namespace comet
+
+#endif  // COMET_COMET_RESOURCE_RESOURCE_ARCHIVE_H_
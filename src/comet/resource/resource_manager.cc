@@ -10,8 +10,13 @@
 #include "resource_manager.h"
 ////////////////////////////////////////////////////////////////////////////////
 
+// External. ///////////////////////////////////////////////////////////////////
+#include <utility>
+////////////////////////////////////////////////////////////////////////////////
+
 #include "comet/core/conf/configuration_manager.h"
 #include "comet/core/file_system/file_system.h"
+#include "comet/core/logger.h"
 
 namespace comet {
 namespace resource {
@@ -32,12 +37,16 @@ void ResourceManager::Initialize() {
   Clean(root_resource_path_);
 
   InitializeResourcesDirectory();
+  archives_ = ResourceArchives{&handler_allocator_};
+  OpenArchives();
   InitializeHandlers();
 }
 
 void ResourceManager::Shutdown() {
   root_resource_path_.Destroy();
   DestroyHandlers();
+  CloseArchives();
+  archives_.Destroy();
   byte_allocator_.Destroy();
   scene_allocator_.Destroy();
   global_allocator_.Destroy();
@@ -48,6 +57,30 @@ const TString& ResourceManager::GetRootResourcePath() {
   return root_resource_path_;
 }
 
+void ResourceManager::OpenArchives() {
+  CloseArchives();
+
+  ForEachFile(root_resource_path_, [&](CTStringView path) {
+    if (GetExtension(path) != kResourceArchiveExtension) {
+      return;
+    }
+
+    ResourceArchive archive{};
+
+    if (archive.Open(path)) {
+      COMET_LOG_RESOURCE_DEBUG("Resource archive opened: ", path, " (",
+                               archive.GetEntryCount(), " entries).");
+      archives_.PushBack(std::move(archive));
+    }
+  });
+}
+
+void ResourceManager::CloseArchives() { archives_.Clear(); }
+
+const ResourceArchives& ResourceManager::GetArchives() const noexcept {
+  return archives_;
+}
+
 MaterialResourceHandler* ResourceManager::GetMaterials() {
   return materials_.get();
 }
@@ -91,6 +124,8 @@ void ResourceManager::InitializeHandlers() {
   descr.life_span_allocators.scene = &scene_allocator_;
   descr.ptr_allocator = &ptr_allocator_;
   descr.byte_allocator = &byte_allocator_;
+  descr.is_memory_mapped = COMET_CONF_BOOL(conf::kResourceIsMemoryMapped);
+  descr.archives = &archives_;
 
   // TODO(m4jr0): Those are wild guesses. Not sure if it should be
   // updated/configurable.
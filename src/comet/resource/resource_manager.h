@@ -18,6 +18,7 @@
 #include "comet/resource/handler/shader_resource_handler.h"
 #include "comet/resource/handler/texture_resource_handler.h"
 #include "comet/resource/resource_allocator.h"
+#include "comet/resource/resource_archive.h"
 
 namespace comet {
 namespace resource {
@@ -37,6 +38,11 @@ class ResourceManager : public Manager {
 
   const TString& GetRootResourcePath();
 
+  // Archives are mapped: they must be closed before being rewritten.
+  void OpenArchives();
+  void CloseArchives();
+  const ResourceArchives& GetArchives() const noexcept;
+
   MaterialResourceHandler* GetMaterials();
   StaticModelResourceHandler* GetStaticModels();
   SkeletalModelResourceHandler* GetSkeletalModels();
@@ -66,6 +72,7 @@ class ResourceManager : public Manager {
       memory::kEngineMemoryTagResourceScene,
       memory::kEngineMemoryTagResourceSceneExtended};
 
+  ResourceArchives archives_{};
   memory::UniquePtr<MaterialResourceHandler> materials_{nullptr};
   memory::UniquePtr<StaticModelResourceHandler> static_models_{nullptr};
   memory::UniquePtr<SkeletalModelResourceHandler> skeletal_models_{nullptr};
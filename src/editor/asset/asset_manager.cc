@@ -16,11 +16,14 @@
 #include "nlohmann/json.hpp"
 ////////////////////////////////////////////////////////////////////////////////
 
+#include "comet/core/c_string.h"
 #include "comet/core/concurrency/job/job.h"
 #include "comet/core/concurrency/job/job_utils.h"
 #include "comet/core/concurrency/job/scheduler.h"
 #include "comet/core/file_system/file_system.h"
 #include "comet/core/type/tstring.h"
+#include "comet/resource/resource.h"
+#include "comet/resource/resource_archive.h"
 #include "comet/resource/resource_manager.h"
 #include "editor/asset/asset_utils.h"
 #include "editor/asset/exporter/model/model_exporter.h"
@@ -59,6 +62,9 @@ void AssetManager::Initialize() {
 
   root_resource_path_ = resource::ResourceManager::Get().GetRootResourcePath();
   COMET_DISALLOW_STR_ALLOC(root_resource_path_);
+  resource_archive_path_ = root_resource_path_ / COMET_TCHAR("resources.");
+  resource_archive_path_ += resource::kResourceArchiveExtension;
+  COMET_DISALLOW_STR_ALLOC(resource_archive_path_);
 
   exporters_ = Array<memory::UniquePtr<AssetExporter>>{&exporters_allocator_};
   exporters_.Reserve(4);
@@ -79,22 +85,34 @@ void AssetManager::RefreshLibraryMetadataFile() {
 
 void AssetManager::Shutdown() {
   is_force_refresh_ = false;
+  is_resource_archive_dirty_ = false;
   last_update_time_ = 0;
   root_asset_path_.Destroy();
   root_resource_path_.Destroy();
+  resource_archive_path_.Destroy();
   library_meta_path_.Destroy();
   exporters_.Destroy();
   Manager::Shutdown();
 }
 
 void AssetManager::Refresh() {
-  job::CounterGuard guard{};
-  auto* counter{guard.GetCounter()};
+  {
+    job::CounterGuard guard{};
+    auto* counter{guard.GetCounter()};
+
+    auto job{job::GenerateIOJobDescr(OnRefresh, counter, counter)};
+
+    job::Scheduler::Get().Kick(job);
+    guard.Wait();
+  }
 
-  auto job{job::GenerateIOJobDescr(OnRefresh, counter, counter)};
+  if (!is_resource_archive_dirty_ && Exists(resource_archive_path_)) {
+    return;
+  }
 
-  job::Scheduler::Get().Kick(job);
-  guard.Wait();
+  job::CounterGuard guard{};
+  job::Scheduler::Get().KickAndWait(job::GenerateIOJobDescr(
+      OnResourceArchiveBuild, this, guard.GetCounter()));
 }
 
 const TString& AssetManager::GetAssetsRootPath() const noexcept {
@@ -110,6 +128,11 @@ void AssetManager::OnRefresh(job::IOJobParamsHandle params_handle) {
   AssetManager::Get().RefreshLibrary(global_counter);
 }
 
+void AssetManager::OnResourceArchiveBuild(
+    job::IOJobParamsHandle params_handle) {
+  reinterpret_cast<AssetManager*>(params_handle)->BuildResourceArchive();
+}
+
 void AssetManager::RefreshLibrary(job::Counter* global_counter) {
   RefreshFolder(global_counter, root_asset_path_);
   RefreshLibraryMetadataFile();
@@ -167,6 +190,7 @@ void AssetManager::RefreshAsset(job::Counter* global_counter,
   for (const auto& exporter : exporters_) {
     if (exporter->IsCompatible(GetExtension(asset_abs_path))) {
       exporter->Process(descr);
+      is_resource_archive_dirty_ = true;
     }
   }
 }
@@ -230,6 +254,60 @@ bool AssetManager::IsRefreshNeeded(CTStringView asset_abs_path,
 
   return false;
 }
+
+void AssetManager::BuildResourceArchive() {
+  COMET_LOG_GLOBAL_INFO("Building resource archive: ", resource_archive_path_,
+                        "...");
+  auto& resource_manager{resource::ResourceManager::Get()};
+
+  // The archive might be mapped by the resource manager.
+  resource_manager.CloseArchives();
+  resource::ResourceArchiveWriter writer{&byte_allocator_};
+
+  if (!writer.Open(resource_archive_path_)) {
+    resource_manager.OpenArchives();
+    return;
+  }
+
+  usize resource_count{0};
+
+  ForEachFile(root_resource_path_, [&](CTStringView path) {
+    // Loose resource files are named after their ID.
+    const auto name{GetName(path)};
+
+    if (name.IsEmpty()) {
+      return;
+    }
+
+    for (usize i{0}; i < name.GetLength(); ++i) {
+      if (name[i] < COMET_TCHAR('0') || name[i] > COMET_TCHAR('9')) {
+        return;
+      }
+    }
+
+    resource::ResourceFile file{};
+
+    if (!resource::MapResourceFile(path, file)) {
+      return;
+    }
+
+    file.resource_id = ParseU32(name.GetCTStr());
+    writer.Add(file);
+    resource::UnmapResourceFile(file);
+    ++resource_count;
+  });
+
+  if (writer.Close()) {
+    COMET_LOG_GLOBAL_INFO("Resource archive built with ", resource_count,
+                          " resources.");
+  } else {
+    COMET_LOG_GLOBAL_ERROR(
+        "Unable to build resource archive: ", resource_archive_path_, "!");
+  }
+
+  is_resource_archive_dirty_ = false;
+  resource_manager.OpenArchives();
+}
 }  // namespace asset
 }  // namespace editor
 }  // namespace comet
@@ -37,17 +37,22 @@ class AssetManager : public Manager {
 
  private:
   static void OnRefresh(job::IOJobParamsHandle params_handle);
+  static void OnResourceArchiveBuild(job::IOJobParamsHandle params_handle);
 
   void RefreshLibrary(job::Counter* global_counter);
   void RefreshFolder(job::Counter* global_counter, CTStringView asset_abs_path);
   void RefreshAsset(job::Counter* global_counter, CTStringView asset_abs_path);
   bool IsRefreshNeeded(CTStringView asset_abs_path,
                        CTStringView metadata_file_path) const;
+  // Packs every loose resource file into a single archive.
+  void BuildResourceArchive();
 
   bool is_force_refresh_{false};
+  bool is_resource_archive_dirty_{false};
   f64 last_update_time_{0};
   TString root_asset_path_{};
   TString root_resource_path_{};
+  TString resource_archive_path_{};
   TString library_meta_path_{};
   memory::PlatformAllocator exporters_allocator_{memory::kEditorMemoryTagAsset};
   memory::PlatformAllocator byte_allocator_{memory::kEditorMemoryTagAsset};
@@ -10,6 +10,7 @@
 #include "animation_export_utils.h"
 ////////////////////////////////////////////////////////////////////////////////
 
+#include "comet/animation/animation_compression.h"
 #include "comet/geometry/geometry_common.h"
 #include "comet/math/geometry.h"
 #include "comet/math/vector.h"
@@ -134,17 +135,16 @@ void PopulateSample(ModelExport& model_export,
                     const geometry::Skeleton& skeleton,
                     const AnimationChannelData& channel_data, u32 tick_delta,
                     animation::FrameIndex frame,
-                    animation::CompressedAnimationSample& sample) {
+                    animation::AnimationSample& sample) {
   const auto skeleton_joint_count{static_cast<u32>(skeleton.joints.GetSize())};
-  sample.joint_poses =
-      Array<animation::CompressedJointPose>(model_export.allocator);
+  sample.joint_poses = Array<animation::JointPose>(model_export.allocator);
   sample.joint_poses.Resize(skeleton_joint_count);
   auto tick_time{frame * tick_delta};
 
   for (u32 joint_index{0}; joint_index < skeleton_joint_count; ++joint_index) {
     const auto& joint{skeleton.joints[joint_index]};
     const auto* channel_node{channel_data.TryGet(joint.id)};
-    animation::JointPose pose;
+    auto& pose{sample.joint_poses[joint_index]};
 
     if (channel_node != nullptr) {
       if (channel_node->has_channel) {
@@ -157,8 +157,6 @@ void PopulateSample(ModelExport& model_export,
       pose.rotation = {1, 0, 0, 0};
       pose.scale = 1.0f;
     }
-
-    sample.joint_poses[joint_index] = CompressJointPose(pose);
   }
 }
 
@@ -172,7 +170,7 @@ void PopulateAnimationClip(ModelExport& model_export,
       resource::GenerateAnimationClipId(model_export.path, animation_name);
   clip_resource.type_id = resource::AnimationClipResource::kResourceTypeId;
 
-  auto& clip{clip_resource.clip};
+  animation::AnimationClip clip{};
   clip.id = static_cast<animation::AnimationClipId>(clip_resource.id);
   clip.frames_per_second = kDefaultAnimationFrameRate;
 
@@ -186,7 +184,7 @@ void PopulateAnimationClip(ModelExport& model_export,
       static_cast<u32>(duration_seconds * clip.frames_per_second);
   clip.is_loop = IsLoop(animation_name);
   auto* allocator{model_export.allocator};
-  clip.samples = Array<animation::CompressedAnimationSample>(allocator);
+  clip.samples = Array<animation::AnimationSample>(allocator);
   clip.samples.Reserve(clip.frame_count);
 
   auto channel_data{GenerateAnimationChannelData(model_export, raw_animation)};
@@ -197,6 +195,27 @@ void PopulateAnimationClip(ModelExport& model_export,
     PopulateSample(model_export, skeleton, channel_data, tick_delta, frame,
                    sample);
   }
+
+  auto& compressed_clip{clip_resource.clip};
+  compressed_clip.tracks = Array<animation::AnimationTrack>(allocator);
+  compressed_clip.key_frames = Array<u16>(allocator);
+  compressed_clip.key_data = Array<u8>(allocator);
+  animation::CompressAnimationClip(clip, compressed_clip);
+
+  COMET_LOG_GLOBAL_DEBUG(
+      "Compressed ", animation_name, " animation: ",
+      compressed_clip.key_frames.GetSize(), " keys, ",
+      animation::GetCompressedAnimationClipMemorySize(compressed_clip),
+      " bytes for ",
+      clip.frame_count * skeleton.joints.GetSize() *
+          sizeof(animation::JointPose),
+      " uncompressed bytes.");
+
+  for (auto& sample : clip.samples) {
+    sample.joint_poses.Destroy();
+  }
+
+  clip.samples.Destroy();
 }
 
 Array<resource::AnimationClipResource> LoadAnimationClips(
@@ -50,7 +50,7 @@ void PopulateSample(ModelExport& model_export,
                     const geometry::Skeleton& skeleton,
                     const AnimationChannelData& channel_data, u32 tick_delta,
                     animation::FrameIndex frame,
-                    animation::CompressedAnimationSample& sample);
+                    animation::AnimationSample& sample);
 void PopulateAnimationClip(ModelExport& model_export,
                            const aiAnimation* raw_animation,
                            const geometry::Skeleton& skeleton,
@@ -35,8 +35,9 @@ math::Mat4 GetTransform(const math::Mat4& current_transform,
   return current_transform * converted_transform;
 }
 
-void RegisterJoint(SkeletalModelExport& model_export, const aiNode* node,
-                   geometry::SkeletonJointIndex parent_index) {
+geometry::SkeletonJointIndex RegisterJoint(
+    SkeletalModelExport& model_export, const aiNode* node,
+    geometry::SkeletonJointIndex parent_index) {
   const auto* scene{model_export.scene};
   const auto* node_name{node->mName.C_Str()};
   const aiBone* raw_bone{nullptr};
@@ -69,9 +70,7 @@ void RegisterJoint(SkeletalModelExport& model_export, const aiNode* node,
     joint.bind_pose_inv = glm::inverse(ToMat4x4(global_bind_transform));
   }
 
-  for (u32 i{0}; i < node->mNumChildren; ++i) {
-    RegisterJoint(model_export, node->mChildren[i], joint_index);
-  }
+  return joint_index;
 }
 
 void PopulateSkeletonJoints(SkeletalModelExport& model_export) {
@@ -79,8 +78,30 @@ void PopulateSkeletonJoints(SkeletalModelExport& model_export) {
       Map<const schar*, geometry::SkeletonJointIndex>{model_export.allocator,
                                                       256};
 
-  RegisterJoint(model_export, model_export.scene->mRootNode,
-                geometry::kInvalidSkeletonJointIndex);
+  struct PendingJoint {
+    const aiNode* node{nullptr};
+    geometry::SkeletonJointIndex parent_index{
+        geometry::kInvalidSkeletonJointIndex};
+  };
+
+  // Joints are registered breadth first: parents come before their children,
+  // and the first joints are the closest to the root, which animation levels
+  // of detail rely on.
+  Array<PendingJoint> pending_joints{model_export.allocator};
+  pending_joints.PushBack(
+      {model_export.scene->mRootNode, geometry::kInvalidSkeletonJointIndex});
+
+  for (usize i{0}; i < pending_joints.GetSize(); ++i) {
+    const auto pending_joint{pending_joints[i]};
+    const auto joint_index{RegisterJoint(model_export, pending_joint.node,
+                                         pending_joint.parent_index)};
+
+    for (u32 j{0}; j < pending_joint.node->mNumChildren; ++j) {
+      pending_joints.PushBack({pending_joint.node->mChildren[j], joint_index});
+    }
+  }
+
+  pending_joints.Destroy();
 }
 
 void PopulateVertex(const aiMesh* raw_mesh, usize index,
@@ -36,8 +36,9 @@ resource::ResourceId GenerateMaterialId(const ModelExport& model_export,
                                         const aiMesh* raw_mesh);
 math::Mat4 GetTransform(const math::Mat4& current_transform,
                         const aiMatrix4x4& transform_to_combine);
-void RegisterJoint(SkeletalModelExport& model_export, const aiNode* node,
-                   geometry::SkeletonJointIndex parent_index);
+geometry::SkeletonJointIndex RegisterJoint(
+    SkeletalModelExport& model_export, const aiNode* node,
+    geometry::SkeletonJointIndex parent_index);
 void PopulateSkeletonJoints(SkeletalModelExport& model_export);
 void PopulateVertex(const aiMesh* raw_mesh, usize index,
                     geometry::Vertex& vertex);
@@ -0,0 +1,228 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Tested. /////////////////////////////////////////////////////////////////////
+#include "comet/animation/animation_compression.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// External. ///////////////////////////////////////////////////////////////////
+#include "catch.hpp"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/animation/animation_common.h"
+#include "comet/core/essentials.h"
+#include "comet/core/memory/allocator/platform_allocator.h"
+#include "comet/core/memory/memory.h"
+#include "comet/core/type/array.h"
+#include "comet/math/geometry.h"
+#include "comet/math/math_common.h"
+#include "comet/math/quaternion.h"
+#include "comet/math/vector.h"
+
+namespace comet {
+namespace comettests {
+namespace memory {
+enum TestsAnimationCompressionMemoryTag : comet::memory::MemoryTag {
+  kTestsMemoryTagAnimationCompression =
+      comet::memory::kEngineMemoryTagUserBase + 13
+};
+}  // namespace memory
+
+constexpr usize kAnimationCompressionTestJointCount{40};
+constexpr animation::FrameIndex kAnimationCompressionTestFrameCount{60};
+
+enum class AnimationCompressionTestMotion { Static, Linear, Smooth };
+
+// Like most skeletons, only the root joint moves: the other ones rotate.
+animation::JointPose GenerateAnimationCompressionTestPose(
+    AnimationCompressionTestMotion motion, usize joint_index,
+    animation::FrameIndex frame) {
+  const auto time{static_cast<f32>(frame) / 30.0f};
+  const auto phase{static_cast<f32>(joint_index) * 0.37f};
+  animation::JointPose pose{};
+  pose.translation = math::Vec3{0.0f, static_cast<f32>(joint_index), 0.0f};
+  pose.scale = 1.0f;
+
+  switch (motion) {
+    case AnimationCompressionTestMotion::Static:
+      pose.rotation = math::GetQuaternionRotation(
+          phase, math::GetNormalizedCopy(math::Vec3{1.0f, phase, 0.5f}));
+      break;
+    case AnimationCompressionTestMotion::Linear:
+      pose.rotation = math::Quat{1.0f, 0.0f, 0.0f, 0.0f};
+      pose.translation.z = time * 5.0f;
+      break;
+    case AnimationCompressionTestMotion::Smooth:
+      pose.rotation = math::GetQuaternionRotation(
+          math::Sin(time * 1.5f + phase) * 0.6f,
+          math::GetNormalizedCopy(math::Vec3{1.0f, phase, 0.5f}));
+
+      if (joint_index == 0) {
+        pose.translation.x = math::Cos(time * 3.0f) * 10.0f;
+        pose.translation.z = time * 5.0f;
+      }
+
+      break;
+  }
+
+  return pose;
+}
+
+void PopulateAnimationCompressionTestClip(
+    comet::memory::Allocator* allocator, AnimationCompressionTestMotion motion,
+    animation::AnimationClip& clip,
+    animation::CompressedAnimationClip& compressed_clip) {
+  clip.frames_per_second = 30;
+  clip.frame_count = kAnimationCompressionTestFrameCount;
+  clip.samples = Array<animation::AnimationSample>{allocator};
+  clip.samples.Resize(clip.frame_count);
+
+  for (animation::FrameIndex i{0}; i < clip.frame_count; ++i) {
+    auto& sample{clip.samples[i]};
+    sample.joint_poses = Array<animation::JointPose>{allocator};
+    sample.joint_poses.Resize(kAnimationCompressionTestJointCount);
+
+    for (usize j{0}; j < kAnimationCompressionTestJointCount; ++j) {
+      sample.joint_poses[j] =
+          GenerateAnimationCompressionTestPose(motion, j, i);
+    }
+  }
+
+  compressed_clip.tracks = Array<animation::AnimationTrack>{allocator};
+  compressed_clip.key_frames = Array<u16>{allocator};
+  compressed_clip.key_data = Array<u8>{allocator};
+  animation::CompressAnimationClip(clip, compressed_clip);
+}
+
+void DestroyAnimationCompressionTestClip(
+    animation::AnimationClip& clip,
+    animation::CompressedAnimationClip& compressed_clip) {
+  for (auto& sample : clip.samples) {
+    sample.joint_poses.Destroy();
+  }
+
+  clip.samples.Destroy();
+  compressed_clip.tracks.Destroy();
+  compressed_clip.key_frames.Destroy();
+  compressed_clip.key_data.Destroy();
+}
+
+bool IsAnimationCompressionTestClipWithinTolerance(
+    const animation::AnimationClip& clip,
+    const animation::CompressedAnimationClip& compressed_clip) {
+  const animation::AnimationCompressionDescr descr{};
+
+  for (usize i{0}; i < compressed_clip.joint_count; ++i) {
+    for (u8 j{0}; j < animation::kAnimationTrackTypeCount; ++j) {
+      const auto type{static_cast<animation::AnimationTrackType>(j)};
+
+      if (animation::GetAnimationTrackError(clip, compressed_clip, i, type) >
+          animation::GetAnimationTrackTolerance(descr, type)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+}  // namespace comettests
+}  // namespace comet
+
+TEST_CASE("Animation clip compression", "[comet::animation]") {
+  comet::memory::PlatformAllocator allocator{
+      comet::comettests::memory::kTestsMemoryTagAnimationCompression};
+  comet::animation::AnimationClip clip{};
+  comet::animation::CompressedAnimationClip compressed_clip{};
+
+  SECTION("Static tracks are stored once.") {
+    comet::comettests::PopulateAnimationCompressionTestClip(
+        &allocator, comet::comettests::AnimationCompressionTestMotion::Static,
+        clip, compressed_clip);
+    REQUIRE(compressed_clip.joint_count ==
+            comet::comettests::kAnimationCompressionTestJointCount);
+    REQUIRE(compressed_clip.key_frames.IsEmpty());
+
+    for (const auto& track : compressed_clip.tracks) {
+      REQUIRE(track.key_count == 0);
+    }
+
+    REQUIRE(comet::comettests::IsAnimationCompressionTestClipWithinTolerance(
+        clip, compressed_clip));
+  }
+
+  SECTION("Linear tracks only keep their ends.") {
+    comet::comettests::PopulateAnimationCompressionTestClip(
+        &allocator, comet::comettests::AnimationCompressionTestMotion::Linear,
+        clip, compressed_clip);
+
+    for (comet::usize i{0}; i < compressed_clip.joint_count; ++i) {
+      const auto& translation_track{comet::animation::GetAnimationTrack(
+          compressed_clip, i,
+          comet::animation::kAnimationTrackTypeTranslation)};
+      const auto& rotation_track{comet::animation::GetAnimationTrack(
+          compressed_clip, i, comet::animation::kAnimationTrackTypeRotation)};
+      REQUIRE(rotation_track.key_count == 0);
+#ifdef COMET_COMPRESS_ANIMATIONS
+      REQUIRE(translation_track.key_count == 2);
+#else
+      REQUIRE(translation_track.key_count ==
+              comet::comettests::kAnimationCompressionTestFrameCount);
+#endif  // COMET_COMPRESS_ANIMATIONS
+    }
+
+    REQUIRE(comet::comettests::IsAnimationCompressionTestClipWithinTolerance(
+        clip, compressed_clip));
+  }
+
+  SECTION("Smooth tracks are within tolerance.") {
+    comet::comettests::PopulateAnimationCompressionTestClip(
+        &allocator, comet::comettests::AnimationCompressionTestMotion::Smooth,
+        clip, compressed_clip);
+    REQUIRE(comet::comettests::IsAnimationCompressionTestClipWithinTolerance(
+        clip, compressed_clip));
+
+#ifdef COMET_COMPRESS_ANIMATIONS
+    // Compared with keeping every frame of every joint, with 16 bits for each
+    // of the 7 channels.
+    constexpr auto kSampledSize{
+        comet::comettests::kAnimationCompressionTestFrameCount *
+        comet::comettests::kAnimationCompressionTestJointCount * 7 *
+        sizeof(comet::u16)};
+    REQUIRE(comet::animation::GetCompressedAnimationClipMemorySize(
+                compressed_clip) *
+                3 <=
+            kSampledSize);
+
+    for (const auto& track : compressed_clip.tracks) {
+      REQUIRE(track.bit_count <= comet::animation::kMaxAnimationKeyBitCount);
+    }
+#endif  // COMET_COMPRESS_ANIMATIONS
+  }
+
+  comet::comettests::DestroyAnimationCompressionTestClip(clip,
+                                                         compressed_clip);
+}
+
+TEST_CASE("Animation key seeking", "[comet::animation]") {
+  const comet::u16 key_frames[]{0, 3, 4, 10, 20};
+  constexpr comet::u16 kKeyCount{5};
+
+  REQUIRE(comet::animation::FindAnimationKey(key_frames, kKeyCount, 0.0f) ==
+          0);
+  REQUIRE(comet::animation::FindAnimationKey(key_frames, kKeyCount, 2.9f) ==
+          0);
+  REQUIRE(comet::animation::FindAnimationKey(key_frames, kKeyCount, 3.0f) ==
+          1);
+  REQUIRE(comet::animation::FindAnimationKey(key_frames, kKeyCount, 9.5f) ==
+          2);
+  REQUIRE(comet::animation::FindAnimationKey(key_frames, kKeyCount, 19.0f) ==
+          3);
+  // Past the last key, the last segment is kept.
+  REQUIRE(comet::animation::FindAnimationKey(key_frames, kKeyCount, 20.0f) ==
+          3);
+}
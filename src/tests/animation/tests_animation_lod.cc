@@ -0,0 +1,210 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Tested. /////////////////////////////////////////////////////////////////////
+#include "comet/animation/animation_lod.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// External. ///////////////////////////////////////////////////////////////////
+#include "catch.hpp"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/animation/animation_common.h"
+#include "comet/animation/component/animation_component.h"
+#include "comet/animation/pose_blend.h"
+#include "comet/animation/pose_buffer.h"
+#include "comet/core/essentials.h"
+#include "comet/core/memory/allocator/platform_allocator.h"
+#include "comet/core/memory/memory.h"
+#include "comet/core/type/array.h"
+#include "comet/geometry/geometry_common.h"
+#include "comet/math/math_common.h"
+#include "comet/math/matrix.h"
+#include "comet/math/quaternion.h"
+#include "comet/math/vector.h"
+
+namespace comet {
+namespace comettests {
+namespace memory {
+enum TestsAnimationLodMemoryTag : comet::memory::MemoryTag {
+  kTestsMemoryTagAnimationLod = comet::memory::kEngineMemoryTagUserBase + 12
+};
+}  // namespace memory
+
+animation::JointPose GenerateAnimationLodTestPose(f32 translation_x) {
+  return animation::JointPose{math::Quat{1.0f, 0.0f, 0.0f, 0.0f},
+                              math::Vec3{translation_x, 0.0f, 0.0f}, 1.0f};
+}
+
+bool IsNear(f32 a, f32 b) { return math::Abs(a - b) <= 1e-4f; }
+
+// Mirrors the animation manager, which records evaluated poses at levels
+// which extrapolate.
+bool ProcessAnimationLodTestFrame(const animation::AnimationLodLevel* levels,
+                                  usize joint_count, u64 update_index,
+                                  animation::AnimationLodState& lod) {
+  const auto& level{levels[lod.lod_index]};
+  const auto lod_joint_count{animation::GetLodJointCount(level, joint_count)};
+  const auto is_evaluated{animation::IsLodPoseEvaluated(
+      level, lod_joint_count, update_index, lod)};
+
+  if (is_evaluated && level.update_interval > 1) {
+    lod.history_joint_count = lod_joint_count;
+
+    if (lod.history_count < 2) {
+      ++lod.history_count;
+    }
+  }
+
+  return is_evaluated;
+}
+}  // namespace comettests
+}  // namespace comet
+
+TEST_CASE("Animation LOD selection", "[comet::animation]") {
+  const comet::animation::AnimationLodLevel
+      levels[comet::animation::kAnimationLodLevelCount]{{0.0f, 1, 1.0f},
+                                                         {10.0f, 2, 1.0f},
+                                                         {20.0f, 4, 0.5f},
+                                                         {40.0f, 8, 0.1f}};
+
+  SECTION("Levels by distance.") {
+    REQUIRE(comet::animation::SelectAnimationLod(
+                levels, comet::animation::kAnimationLodLevelCount, 0.0f) == 0);
+    REQUIRE(comet::animation::SelectAnimationLod(
+                levels, comet::animation::kAnimationLodLevelCount, 9.9f) == 0);
+    REQUIRE(comet::animation::SelectAnimationLod(
+                levels, comet::animation::kAnimationLodLevelCount, 10.0f) == 1);
+    REQUIRE(comet::animation::SelectAnimationLod(
+                levels, comet::animation::kAnimationLodLevelCount, 25.0f) == 2);
+    REQUIRE(comet::animation::SelectAnimationLod(
+                levels, comet::animation::kAnimationLodLevelCount, 1e6f) == 3);
+  }
+
+  SECTION("Joint counts.") {
+    REQUIRE(comet::animation::GetLodJointCount(levels[0], 64) == 64);
+    REQUIRE(comet::animation::GetLodJointCount(levels[2], 64) == 32);
+    REQUIRE(comet::animation::GetLodJointCount(levels[2], 5) == 3);
+    // The root is always evaluated.
+    REQUIRE(comet::animation::GetLodJointCount(levels[3], 4) == 1);
+    REQUIRE(comet::animation::GetLodJointCount(levels[3], 0) == 0);
+  }
+}
+
+TEST_CASE("Animation LOD history", "[comet::animation]") {
+  // Level 1 evaluates every frame, and records no poses.
+  const comet::animation::AnimationLodLevel
+      levels[comet::animation::kAnimationLodLevelCount]{{0.0f, 1, 1.0f},
+                                                         {10.0f, 1, 1.0f},
+                                                         {20.0f, 4, 1.0f},
+                                                         {40.0f, 8, 1.0f}};
+  constexpr comet::usize kJointCount{16};
+  comet::animation::AnimationLodState lod{};
+  lod.lod_index = 2;
+  lod.previous_lod_index = 2;
+  comet::u64 update_index{1};
+
+  // The history is filled on the first frames, and then extrapolated from
+  // between evaluations.
+  REQUIRE(comet::comettests::ProcessAnimationLodTestFrame(levels, kJointCount,
+                                                          update_index++, lod));
+  REQUIRE(comet::comettests::ProcessAnimationLodTestFrame(levels, kJointCount,
+                                                          update_index++, lod));
+  REQUIRE(lod.history_count == 2);
+  REQUIRE(!comet::comettests::ProcessAnimationLodTestFrame(
+      levels, kJointCount, update_index++, lod));
+
+  SECTION("Level changes discard the history.") {
+    lod.lod_index = 1;
+    REQUIRE(comet::comettests::ProcessAnimationLodTestFrame(
+        levels, kJointCount, update_index++, lod));
+    REQUIRE(lod.history_count == 0);
+
+    // Back to level 2, on a frame which would otherwise be extrapolated from
+    // the poses recorded before level 1.
+    lod.lod_index = 2;
+    REQUIRE(update_index % levels[2].update_interval != 0);
+    REQUIRE(comet::comettests::ProcessAnimationLodTestFrame(
+        levels, kJointCount, update_index++, lod));
+    REQUIRE(comet::comettests::ProcessAnimationLodTestFrame(
+        levels, kJointCount, update_index++, lod));
+    REQUIRE(lod.history_count == 2);
+    REQUIRE(!comet::comettests::ProcessAnimationLodTestFrame(
+        levels, kJointCount, update_index++, lod));
+  }
+
+  SECTION("Levels which extrapolate discard the history of other ones.") {
+    lod.lod_index = 3;
+    REQUIRE(comet::comettests::ProcessAnimationLodTestFrame(
+        levels, kJointCount, update_index++, lod));
+    REQUIRE(lod.history_count == 1);
+  }
+}
+
+TEST_CASE("Animation LOD poses", "[comet::animation]") {
+  comet::memory::PlatformAllocator allocator{
+      comet::comettests::memory::kTestsMemoryTagAnimationLod};
+
+  comet::geometry::Skeleton skeleton{};
+  skeleton.joints = comet::Array<comet::geometry::SkeletonJoint>{&allocator};
+  skeleton.joints.Resize(4);
+
+  // Chain of joints, 1 unit apart along X.
+  for (comet::usize i{0}; i < skeleton.joints.GetSize(); ++i) {
+    auto& joint{skeleton.joints[i]};
+    joint.parent_index =
+        i == 0 ? comet::geometry::kInvalidSkeletonJointIndex
+               : static_cast<comet::geometry::SkeletonJointIndex>(i - 1);
+    joint.bind_pose_inv = comet::math::Mat4{1.0f};
+    joint.bind_pose_inv[3][0] = -static_cast<comet::f32>(i);
+  }
+
+  SECTION("Skeleton radius.") {
+    REQUIRE(comet::comettests::IsNear(
+        comet::animation::GetSkeletonRadius(skeleton), 3.0f));
+  }
+
+  SECTION("Reduced joint sets.") {
+    comet::animation::PoseBuffer pose{&allocator};
+    pose.Resize(2);
+    pose.SetJointPose(0,
+                      comet::comettests::GenerateAnimationLodTestPose(1.0f));
+    pose.SetJointPose(1,
+                      comet::comettests::GenerateAnimationLodTestPose(1.0f));
+    comet::animation::PopulateGlobalPose(skeleton, pose);
+
+    const auto* global_matrices{pose.GetGlobalMatrices()};
+    REQUIRE(comet::comettests::IsNear(global_matrices[0][3][0], 1.0f));
+    REQUIRE(comet::comettests::IsNear(global_matrices[1][3][0], 2.0f));
+    pose.Destroy();
+  }
+
+  SECTION("Extrapolation.") {
+    comet::animation::PoseBuffer a{&allocator};
+    comet::animation::PoseBuffer b{&allocator};
+    comet::animation::PoseBuffer out{&allocator};
+    a.Resize(1);
+    b.Resize(1);
+    out.Resize(1);
+    a.SetJointPose(0, comet::comettests::GenerateAnimationLodTestPose(0.0f));
+    b.SetJointPose(0, comet::comettests::GenerateAnimationLodTestPose(1.0f));
+
+    comet::animation::ExtrapolatePoses(a, 1.0, b, 2.0, 2.5, out);
+    REQUIRE(comet::comettests::IsNear(out.GetJointPose(0).translation.x, 1.5f));
+
+    // Extrapolation stops at twice the interval between both poses.
+    comet::animation::ExtrapolatePoses(a, 1.0, b, 2.0, 10.0, out);
+    REQUIRE(comet::comettests::IsNear(out.GetJointPose(0).translation.x, 2.0f));
+
+    a.Destroy();
+    b.Destroy();
+    out.Destroy();
+  }
+
+  skeleton.joints.Destroy();
+}
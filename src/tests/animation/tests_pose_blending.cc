@@ -0,0 +1,353 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Tested. /////////////////////////////////////////////////////////////////////
+#include "comet/animation/pose_blend.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <string>
+
+#include "catch.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/animation/animation_common.h"
+#include "comet/animation/animation_compression.h"
+#include "comet/animation/component/animation_component.h"
+#include "comet/animation/pose_buffer.h"
+#include "comet/core/essentials.h"
+#include "comet/core/memory/allocator/platform_allocator.h"
+#include "comet/core/memory/memory.h"
+#include "comet/core/type/array.h"
+#include "comet/geometry/geometry_common.h"
+#include "comet/math/math_common.h"
+#include "comet/math/quaternion.h"
+#include "comet/math/vector.h"
+#include "comet/resource/animation_resource.h"
+
+namespace comet {
+namespace comettests {
+namespace memory {
+enum TestsPoseBlendingMemoryTag : comet::memory::MemoryTag {
+  kTestsMemoryTagPoseBlending = comet::memory::kEngineMemoryTagUserBase + 11
+};
+}  // namespace memory
+
+constexpr usize kPoseBlendingBenchmarkCharacterCount{100};
+constexpr usize kPoseBlendingBenchmarkJointCount{64};
+constexpr animation::FrameIndex kPoseBlendingTestFrameCount{8};
+
+f32 GeneratePoseBlendingTestValue(usize index) {
+  return static_cast<f32>(static_cast<s32>((index * 7919) % 199) - 99) / 99.0f;
+}
+
+animation::JointPose GeneratePoseBlendingTestPose(usize index) {
+  const auto generate_value{[&index]() {
+    return GeneratePoseBlendingTestValue(index++);
+  }};
+
+  animation::JointPose pose{};
+  pose.rotation = math::Quat{generate_value(), generate_value(),
+                             generate_value(), generate_value()};
+  math::Normalize(pose.rotation);
+  pose.translation =
+      math::Vec3{generate_value(), generate_value(), generate_value()} *
+      100.0f;
+  pose.scale = 0.5f + math::Abs(generate_value()) * 0.5f;
+  return pose;
+}
+
+void PopulatePoseBlendingTestPose(usize joint_count, usize seed,
+                                  animation::PoseBuffer& pose) {
+  pose.Resize(joint_count);
+
+  for (usize i{0}; i < joint_count; ++i) {
+    pose.SetJointPose(i, GeneratePoseBlendingTestPose(seed + i * 8));
+  }
+}
+
+void PopulatePoseBlendingTestClip(comet::memory::Allocator* allocator,
+                                  usize joint_count, usize seed,
+                                  resource::AnimationClipResource& resource) {
+  animation::AnimationClip clip{};
+  clip.frames_per_second = 30;
+  clip.frame_count = kPoseBlendingTestFrameCount;
+  clip.is_loop = true;
+  clip.samples = Array<animation::AnimationSample>{allocator};
+  clip.samples.Resize(kPoseBlendingTestFrameCount);
+
+  for (usize i{0}; i < kPoseBlendingTestFrameCount; ++i) {
+    auto& sample{clip.samples[i]};
+    sample.joint_poses = Array<animation::JointPose>{allocator};
+    sample.joint_poses.Resize(joint_count);
+
+    for (usize j{0}; j < joint_count; ++j) {
+      sample.joint_poses[j] =
+          GeneratePoseBlendingTestPose(seed + (i * 64 + j) * 8);
+    }
+  }
+
+  auto& compressed_clip{resource.clip};
+  compressed_clip.tracks = Array<animation::AnimationTrack>{allocator};
+  compressed_clip.key_frames = Array<u16>{allocator};
+  compressed_clip.key_data = Array<u8>{allocator};
+  animation::CompressAnimationClip(clip, compressed_clip);
+
+  for (auto& sample : clip.samples) {
+    sample.joint_poses.Destroy();
+  }
+
+  clip.samples.Destroy();
+}
+
+void DestroyPoseBlendingTestClip(resource::AnimationClipResource& resource) {
+  resource.clip.tracks.Destroy();
+  resource.clip.key_frames.Destroy();
+  resource.clip.key_data.Destroy();
+}
+
+// Quaternions q and -q are the same rotation: blending can return either.
+bool AreJointPosesNear(const animation::JointPose& a,
+                       const animation::JointPose& b) {
+  constexpr auto kTolerance{1e-3f};
+  const auto rotation_dot{a.rotation.x * b.rotation.x +
+                          a.rotation.y * b.rotation.y +
+                          a.rotation.z * b.rotation.z +
+                          a.rotation.w * b.rotation.w};
+
+  return math::Abs(rotation_dot) >= 1.0f - kTolerance &&
+         math::Abs(a.translation.x - b.translation.x) <= kTolerance &&
+         math::Abs(a.translation.y - b.translation.y) <= kTolerance &&
+         math::Abs(a.translation.z - b.translation.z) <= kTolerance &&
+         math::Abs(a.scale - b.scale) <= kTolerance;
+}
+
+bool ArePosesNear(const animation::PoseBuffer& a,
+                  const animation::PoseBuffer& b) {
+  for (usize i{0}; i < a.GetJointCount(); ++i) {
+    if (!AreJointPosesNear(a.GetJointPose(i), b.GetJointPose(i))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+}  // namespace comettests
+}  // namespace comet
+
+TEST_CASE("Pose blending", "[comet::animation]") {
+  comet::memory::PlatformAllocator allocator{
+      comet::comettests::memory::kTestsMemoryTagPoseBlending};
+  constexpr comet::usize kJointCount{13};
+
+  comet::animation::PoseBuffer a{&allocator};
+  comet::comettests::PopulatePoseBlendingTestPose(kJointCount, 0, a);
+  comet::animation::PoseBuffer b{&allocator};
+  comet::comettests::PopulatePoseBlendingTestPose(kJointCount, 1000, b);
+  comet::animation::PoseBuffer out{&allocator};
+  out.Resize(kJointCount);
+
+  SECTION("Override blending.") {
+    comet::animation::BlendPoses(a, b, 0.0f, nullptr, out);
+    REQUIRE(comet::comettests::ArePosesNear(out, a));
+
+    comet::animation::BlendPoses(a, b, 1.0f, nullptr, out);
+    REQUIRE(comet::comettests::ArePosesNear(out, b));
+
+    comet::animation::AnimationMask mask{};
+    mask.joint_weights = comet::Array<comet::f32>{&allocator};
+    mask.joint_weights.Resize(kJointCount);
+    mask.joint_weights[3] = 1.0f;
+
+    comet::animation::BlendPoses(a, b, 1.0f, &mask, out);
+
+    for (comet::usize i{0}; i < kJointCount; ++i) {
+      const auto& expected{i == 3 ? b : a};
+      REQUIRE(comet::comettests::AreJointPosesNear(out.GetJointPose(i),
+                                                   expected.GetJointPose(i)));
+    }
+
+    mask.joint_weights.Destroy();
+  }
+
+  SECTION("Additive blending.") {
+    comet::animation::AddPoses(a, b, a, 1.0f, nullptr, out);
+    REQUIRE(comet::comettests::ArePosesNear(out, b));
+
+    comet::animation::AddPoses(a, b, a, 0.0f, nullptr, out);
+    REQUIRE(comet::comettests::ArePosesNear(out, a));
+
+    comet::animation::AddPoses(b, a, a, 1.0f, nullptr, out);
+    REQUIRE(comet::comettests::ArePosesNear(out, b));
+  }
+
+  SECTION("Masks.") {
+    comet::geometry::Skeleton skeleton{};
+    skeleton.joints = comet::Array<comet::geometry::SkeletonJoint>{&allocator};
+    skeleton.joints.Resize(4);
+    skeleton.joints[1].parent_index = 0;
+    skeleton.joints[2].parent_index = 1;
+    skeleton.joints[3].parent_index = 0;
+
+    comet::animation::AnimationMask mask{};
+    mask.joint_weights = comet::Array<comet::f32>{&allocator};
+    comet::animation::PopulateAnimationMask(skeleton, 1, mask, 0.5f);
+
+    REQUIRE(mask.joint_weights[0] == 0.0f);
+    REQUIRE(mask.joint_weights[1] == 0.5f);
+    REQUIRE(mask.joint_weights[2] == 0.5f);
+    REQUIRE(mask.joint_weights[3] == 0.0f);
+
+    mask.joint_weights.Destroy();
+    skeleton.joints.Destroy();
+  }
+
+  a.Destroy();
+  b.Destroy();
+  out.Destroy();
+}
+
+TEST_CASE("Animation evaluation", "[comet::animation]") {
+  comet::memory::PlatformAllocator allocator{
+      comet::comettests::memory::kTestsMemoryTagPoseBlending};
+  constexpr comet::usize kJointCount{13};
+  constexpr comet::f64 kTime{0.1};
+
+  comet::resource::AnimationClipResource base_clip{};
+  comet::comettests::PopulatePoseBlendingTestClip(&allocator, kJointCount, 0,
+                                                  base_clip);
+  comet::resource::AnimationClipResource layer_clip{};
+  comet::comettests::PopulatePoseBlendingTestClip(&allocator, kJointCount,
+                                                  5000, layer_clip);
+
+  comet::animation::PoseBuffer pose{&allocator};
+  pose.Resize(kJointCount);
+  comet::animation::PoseBuffer layer_scratch{&allocator};
+  layer_scratch.Resize(kJointCount);
+  comet::animation::PoseBuffer reference_scratch{&allocator};
+  reference_scratch.Resize(kJointCount);
+  comet::animation::PoseBuffer expected{&allocator};
+  expected.Resize(kJointCount);
+
+  comet::animation::AnimationComponent animation_cmp{};
+  animation_cmp.state.clip_resource = &base_clip;
+
+  SECTION("Base state.") {
+    comet::animation::EvaluateAnimation(animation_cmp, kTime, pose,
+                                        layer_scratch, reference_scratch);
+    comet::animation::DecompressClipAndExtractPose(base_clip.clip, kTime,
+                                                   expected);
+    REQUIRE(comet::comettests::ArePosesNear(pose, expected));
+  }
+
+  SECTION("Crossfade.") {
+    animation_cmp.previous_state.clip_resource = &layer_clip;
+    animation_cmp.crossfade_duration = 1.0f;
+
+    comet::animation::EvaluateAnimation(animation_cmp, 0.0, pose,
+                                        layer_scratch, reference_scratch);
+    comet::animation::DecompressClipAndExtractPose(layer_clip.clip, 0.0,
+                                                   expected);
+    REQUIRE(comet::comettests::ArePosesNear(pose, expected));
+  }
+
+  SECTION("Override layer.") {
+    animation_cmp.layer_count = 1;
+    animation_cmp.layers[0].state.clip_resource = &layer_clip;
+
+    comet::animation::EvaluateAnimation(animation_cmp, kTime, pose,
+                                        layer_scratch, reference_scratch);
+    comet::animation::DecompressClipAndExtractPose(layer_clip.clip, kTime,
+                                                   expected);
+    REQUIRE(comet::comettests::ArePosesNear(pose, expected));
+  }
+
+  SECTION("Additive layer on its reference.") {
+    animation_cmp.state.clip_resource = &layer_clip;
+    animation_cmp.layer_count = 1;
+    animation_cmp.layers[0].state.clip_resource = &layer_clip;
+    animation_cmp.layers[0].blend_mode =
+        comet::animation::AnimationBlendMode::Additive;
+
+    comet::animation::EvaluateAnimation(animation_cmp, 0.0, pose,
+                                        layer_scratch, reference_scratch);
+    comet::animation::DecompressClipAndExtractPose(layer_clip.clip, 0.0,
+                                                   expected);
+    REQUIRE(comet::comettests::ArePosesNear(pose, expected));
+  }
+
+  pose.Destroy();
+  layer_scratch.Destroy();
+  reference_scratch.Destroy();
+  expected.Destroy();
+  comet::comettests::DestroyPoseBlendingTestClip(base_clip);
+  comet::comettests::DestroyPoseBlendingTestClip(layer_clip);
+}
+
+TEST_CASE("Animation evaluation benchmark",
+          "[.][benchmark][comet::animation]") {
+  comet::memory::PlatformAllocator allocator{
+      comet::comettests::memory::kTestsMemoryTagPoseBlending};
+  constexpr auto kCharacterCount{
+      comet::comettests::kPoseBlendingBenchmarkCharacterCount};
+  constexpr auto kJointCount{
+      comet::comettests::kPoseBlendingBenchmarkJointCount};
+
+  comet::resource::AnimationClipResource
+      clips[comet::animation::kMaxAnimationLayerCount + 1]{};
+
+  for (comet::usize i{0}; i < comet::animation::kMaxAnimationLayerCount + 1;
+       ++i) {
+    comet::comettests::PopulatePoseBlendingTestClip(&allocator, kJointCount,
+                                                    i * 10000, clips[i]);
+  }
+
+  comet::animation::PoseBuffer pose{&allocator};
+  pose.Resize(kJointCount);
+  comet::animation::PoseBuffer layer_scratch{&allocator};
+  layer_scratch.Resize(kJointCount);
+  comet::animation::PoseBuffer reference_scratch{&allocator};
+  reference_scratch.Resize(kJointCount);
+
+  for (comet::usize layer_count{0};
+       layer_count <= comet::animation::kMaxAnimationLayerCount;
+       ++layer_count) {
+    comet::animation::AnimationComponent animation_cmp{};
+    animation_cmp.state.clip_resource = &clips[0];
+    animation_cmp.layer_count = static_cast<comet::u8>(layer_count);
+
+    for (comet::usize i{0}; i < layer_count; ++i) {
+      auto& layer{animation_cmp.layers[i]};
+      layer.state.clip_resource = &clips[i + 1];
+      layer.weight = 0.5f;
+      layer.blend_mode = i % 2 == 0
+                             ? comet::animation::AnimationBlendMode::Override
+                             : comet::animation::AnimationBlendMode::Additive;
+    }
+
+    BENCHMARK(std::to_string(kCharacterCount) + " characters x " +
+              std::to_string(layer_count) + " layers (" +
+              std::to_string(kJointCount) + " joints)") {
+      for (comet::usize i{0}; i < kCharacterCount; ++i) {
+        comet::animation::EvaluateAnimation(animation_cmp, 0.01 * i, pose,
+                                            layer_scratch, reference_scratch);
+      }
+
+      return pose.GetChannel(comet::animation::kJointPoseChannelScale)[0];
+    };
+  }
+
+  pose.Destroy();
+  layer_scratch.Destroy();
+  reference_scratch.Destroy();
+
+  for (auto& clip : clips) {
+    comet::comettests::DestroyPoseBlendingTestClip(clip);
+  }
+}
@@ -0,0 +1,374 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Tested. /////////////////////////////////////////////////////////////////////
+#include "comet/animation/animation_common.h"
+#include "comet/animation/animation_compression.h"
+#include "comet/animation/pose_buffer.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <string>
+
+#include "catch.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/essentials.h"
+#include "comet/core/memory/allocator/platform_allocator.h"
+#include "comet/core/memory/memory.h"
+#include "comet/core/type/array.h"
+#include "comet/math/geometry.h"
+#include "comet/math/math_common.h"
+#include "comet/math/math_interpolation.h"
+#include "comet/math/quaternion.h"
+#include "comet/math/vector.h"
+
+namespace comet {
+namespace comettests {
+namespace memory {
+enum TestsPoseSamplingMemoryTag : comet::memory::MemoryTag {
+  kTestsMemoryTagPoseSampling = comet::memory::kEngineMemoryTagUserBase + 10
+};
+}  // namespace memory
+
+constexpr usize kPoseSamplingBenchmarkCharacterCount{1000};
+constexpr usize kPoseSamplingBenchmarkJointCount{64};
+constexpr animation::FrameIndex kPoseSamplingTestFrameCount{24};
+
+using SampleJointPosesFunc = void (*)(const animation::CompressedAnimationClip&,
+                                      animation::FrameIndex,
+                                      animation::FrameIndex, f32,
+                                      animation::PoseBuffer&, u16*);
+
+animation::JointPose GeneratePoseSamplingTestPose(usize joint_index,
+                                                  animation::FrameIndex frame) {
+  const auto time{static_cast<f32>(frame) / 30.0f};
+  const auto phase{static_cast<f32>(joint_index) * 0.37f};
+
+  animation::JointPose pose{};
+  pose.rotation = math::GetQuaternionRotation(
+      math::Sin(time * 4.0f + phase) * 1.2f,
+      math::GetNormalizedCopy(math::Vec3{1.0f, phase, 0.5f}));
+  pose.translation = math::Vec3{math::Cos(time * 3.0f + phase) * 10.0f,
+                                static_cast<f32>(joint_index), time * 5.0f};
+  pose.scale = 1.0f;
+  return pose;
+}
+
+void PopulatePoseSamplingTestClip(
+    comet::memory::Allocator* allocator, usize joint_count,
+    animation::AnimationClip& clip,
+    animation::CompressedAnimationClip& compressed_clip) {
+  clip.frames_per_second = 30;
+  clip.frame_count = kPoseSamplingTestFrameCount;
+  clip.is_loop = true;
+  clip.samples = Array<animation::AnimationSample>{allocator};
+  clip.samples.Resize(clip.frame_count);
+
+  for (animation::FrameIndex i{0}; i < clip.frame_count; ++i) {
+    auto& sample{clip.samples[i]};
+    sample.joint_poses = Array<animation::JointPose>{allocator};
+    sample.joint_poses.Resize(joint_count);
+
+    for (usize j{0}; j < joint_count; ++j) {
+      sample.joint_poses[j] = GeneratePoseSamplingTestPose(j, i);
+    }
+  }
+
+  compressed_clip.tracks = Array<animation::AnimationTrack>{allocator};
+  compressed_clip.key_frames = Array<u16>{allocator};
+  compressed_clip.key_data = Array<u8>{allocator};
+  animation::CompressAnimationClip(clip, compressed_clip);
+}
+
+void DestroyPoseSamplingTestClip(
+    animation::AnimationClip& clip,
+    animation::CompressedAnimationClip& compressed_clip) {
+  for (auto& sample : clip.samples) {
+    sample.joint_poses.Destroy();
+  }
+
+  clip.samples.Destroy();
+  compressed_clip.tracks.Destroy();
+  compressed_clip.key_frames.Destroy();
+  compressed_clip.key_data.Destroy();
+}
+
+// Quaternions q and -q are the same rotation.
+bool AreJointPosesNear(const animation::JointPose& a,
+                       const animation::JointPose& b, f32 tolerance) {
+  const auto rotation_dot{a.rotation.x * b.rotation.x +
+                          a.rotation.y * b.rotation.y +
+                          a.rotation.z * b.rotation.z +
+                          a.rotation.w * b.rotation.w};
+  const auto sign{rotation_dot < 0.0f ? -1.0f : 1.0f};
+
+  return math::Abs(a.rotation.x - b.rotation.x * sign) <= tolerance &&
+         math::Abs(a.rotation.y - b.rotation.y * sign) <= tolerance &&
+         math::Abs(a.rotation.z - b.rotation.z * sign) <= tolerance &&
+         math::Abs(a.rotation.w - b.rotation.w * sign) <= tolerance &&
+         math::Abs(a.translation.x - b.translation.x) <= tolerance &&
+         math::Abs(a.translation.y - b.translation.y) <= tolerance &&
+         math::Abs(a.translation.z - b.translation.z) <= tolerance &&
+         math::Abs(a.scale - b.scale) <= tolerance;
+}
+
+bool ArePosesNear(const animation::PoseBuffer& a,
+                  const animation::PoseBuffer& b, f32 tolerance) {
+  for (usize i{0}; i < a.GetJointCount(); ++i) {
+    if (!AreJointPosesNear(a.GetJointPose(i), b.GetJointPose(i), tolerance)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+}  // namespace comettests
+}  // namespace comet
+
+TEST_CASE("Joint pose sampling", "[comet::animation]") {
+  comet::memory::PlatformAllocator allocator{
+      comet::comettests::memory::kTestsMemoryTagPoseSampling};
+  // Not a multiple of the lane count, to cover padding.
+  constexpr comet::usize kJointCount{37};
+  constexpr auto kAlpha{0.3f};
+  constexpr auto kSampleTolerance{1e-5f};
+
+  comet::animation::AnimationClip clip{};
+  comet::animation::CompressedAnimationClip compressed_clip{};
+  comet::comettests::PopulatePoseSamplingTestClip(&allocator, kJointCount,
+                                                  clip, compressed_clip);
+
+  comet::animation::PoseBuffer pose{&allocator};
+  pose.Resize(kJointCount);
+
+  comet::Array<comet::comettests::SampleJointPosesFunc> kernels{&allocator};
+  kernels.PushBack(comet::animation::ScalarSampleJointPoses);
+
+#ifdef COMET_ARCH_X86
+  kernels.PushBack(comet::animation::SSESampleJointPoses);
+#endif  // COMET_ARCH_X86
+
+  SECTION("Frames are within the compression tolerance.") {
+    // Translation has the largest default tolerance.
+    constexpr auto kTolerance{
+        comet::animation::kDefaultAnimationTranslationTolerance};
+
+    for (comet::animation::FrameIndex i{0}; i < clip.frame_count; ++i) {
+      comet::animation::PopulatePoseFromSample(compressed_clip, i, pose);
+
+      for (comet::usize j{0}; j < kJointCount; ++j) {
+        REQUIRE(comet::comettests::AreJointPosesNear(
+            pose.GetJointPose(j), clip.samples[i].joint_poses[j], kTolerance));
+      }
+    }
+  }
+
+  SECTION("Blended samples.") {
+    constexpr comet::animation::FrameIndex kFrame{5};
+
+    for (auto kernel : kernels) {
+      kernel(compressed_clip, kFrame, kFrame + 1, kAlpha, pose, nullptr);
+
+      for (comet::usize i{0}; i < kJointCount; ++i) {
+        REQUIRE(comet::comettests::AreJointPosesNear(
+            pose.GetJointPose(i),
+            comet::animation::SampleJointPose(compressed_clip, i,
+                                              kFrame + kAlpha),
+            kSampleTolerance));
+      }
+    }
+  }
+
+  SECTION("Loops blend the last frame with the first one.") {
+    const auto last_frame{clip.frame_count - 1};
+
+    for (auto kernel : kernels) {
+      kernel(compressed_clip, last_frame, 0, kAlpha, pose, nullptr);
+
+      for (comet::usize i{0}; i < kJointCount; ++i) {
+        const auto pose_a{comet::animation::SampleJointPose(
+            compressed_clip, i, static_cast<comet::f32>(last_frame))};
+        const auto pose_b{
+            comet::animation::SampleJointPose(compressed_clip, i, 0.0f)};
+        comet::animation::JointPose expected{};
+        expected.rotation =
+            comet::math::Nlerp(pose_a.rotation, pose_b.rotation, kAlpha);
+        expected.translation =
+            comet::math::Lerp(pose_a.translation, pose_b.translation, kAlpha);
+        expected.scale = comet::math::Lerp(pose_a.scale, pose_b.scale, kAlpha);
+        REQUIRE(comet::comettests::AreJointPosesNear(
+            pose.GetJointPose(i), expected, kSampleTolerance));
+      }
+    }
+  }
+
+  SECTION("Key cursors give the same poses as key searches.") {
+    comet::Array<comet::u16> key_cursors{&allocator};
+    key_cursors.Resize(compressed_clip.tracks.GetSize());
+    comet::animation::PoseBuffer expected_pose{&allocator};
+    expected_pose.Resize(kJointCount);
+
+    // Forward playback, with some skipped frames, then seeks backward.
+    constexpr comet::animation::FrameIndex kFrames[]{0, 1, 2, 5, 12, 22, 3, 0};
+
+    for (auto kernel : kernels) {
+      for (auto& key_cursor : key_cursors) {
+        key_cursor = 0;
+      }
+
+      for (auto frame : kFrames) {
+        kernel(compressed_clip, frame, frame + 1, kAlpha, pose,
+               key_cursors.GetData());
+        kernel(compressed_clip, frame, frame + 1, kAlpha, expected_pose,
+               nullptr);
+        REQUIRE(comet::comettests::ArePosesNear(pose, expected_pose, 0.0f));
+      }
+    }
+
+    expected_pose.Destroy();
+    key_cursors.Destroy();
+  }
+
+  kernels.Destroy();
+  pose.Destroy();
+  comet::comettests::DestroyPoseSamplingTestClip(clip, compressed_clip);
+}
+
+TEST_CASE("Animation key cursor seeking", "[comet::animation]") {
+  constexpr comet::u16 kKeyFrames[]{0, 4, 9, 15, 23};
+  constexpr auto kKeyCount{static_cast<comet::u16>(std::size(kKeyFrames))};
+  comet::u16 cursor{0};
+
+  SECTION("Seeks give the same keys as searches.") {
+    // Same key, next key, jump to the last key, past it, back, and jump.
+    constexpr comet::f32 kFrames[]{0.0f, 3.5f, 4.0f, 23.0f, 30.0f, 1.0f, 16.0f};
+
+    for (auto frame : kFrames) {
+      const auto key{comet::animation::SeekAnimationKey(kKeyFrames, kKeyCount,
+                                                        frame, cursor)};
+      REQUIRE(key == comet::animation::FindAnimationKey(kKeyFrames, kKeyCount,
+                                                        frame));
+      REQUIRE(cursor == key);
+    }
+  }
+
+  SECTION("Out of bounds cursors are clamped.") {
+    cursor = 42;
+    REQUIRE(comet::animation::SeekAnimationKey(kKeyFrames, kKeyCount, 30.0f,
+                                               cursor) == kKeyCount - 2);
+    REQUIRE(cursor == kKeyCount - 2);
+  }
+}
+
+TEST_CASE("Pose buffer pool", "[comet::animation]") {
+  comet::memory::PlatformAllocator allocator{
+      comet::comettests::memory::kTestsMemoryTagPoseSampling};
+  comet::animation::PoseBufferPool pool{&allocator};
+  pool.Initialize();
+
+  SECTION("Released buffers are reused.") {
+    auto* buffer_a{pool.Acquire(12)};
+    auto* buffer_b{pool.Acquire(70)};
+    REQUIRE(buffer_a != buffer_b);
+    REQUIRE(pool.GetBufferCount() == 2);
+    REQUIRE(buffer_b->GetJointCount() == 70);
+
+    pool.Release(buffer_b);
+    auto* buffer_c{pool.Acquire(5)};
+    REQUIRE(buffer_c == buffer_b);
+    REQUIRE(buffer_c->GetJointCount() == 5);
+    REQUIRE(pool.GetBufferCount() == 2);
+
+    pool.Release(buffer_a);
+    pool.Release(buffer_c);
+  }
+
+  pool.Destroy();
+}
+
+TEST_CASE("Joint pose sampling benchmark", "[.][benchmark][comet::animation]") {
+  comet::memory::PlatformAllocator allocator{
+      comet::comettests::memory::kTestsMemoryTagPoseSampling};
+  constexpr auto kCharacterCount{
+      comet::comettests::kPoseSamplingBenchmarkCharacterCount};
+  constexpr auto kJointCount{
+      comet::comettests::kPoseSamplingBenchmarkJointCount};
+  const auto suffix{" (" + std::to_string(kCharacterCount) + " characters, " +
+                    std::to_string(kJointCount) + " joints)"};
+
+  comet::animation::AnimationClip clip{};
+  comet::animation::CompressedAnimationClip compressed_clip{};
+  comet::comettests::PopulatePoseSamplingTestClip(&allocator, kJointCount,
+                                                  clip, compressed_clip);
+
+  comet::animation::PoseBuffer pose{&allocator};
+  pose.Resize(kJointCount);
+
+  // Every character has its own cursors, which stay on the same keys from one
+  // run to the next, as on forward playback.
+  const auto track_count{compressed_clip.tracks.GetSize()};
+  comet::Array<comet::u16> key_cursors{&allocator};
+  key_cursors.Resize(kCharacterCount * track_count);
+
+  for (auto& key_cursor : key_cursors) {
+    key_cursor = 0;
+  }
+
+  const auto get_frame{[&clip](comet::usize character_index) {
+    return static_cast<comet::animation::FrameIndex>(character_index %
+                                                     (clip.frame_count - 1));
+  }};
+
+  BENCHMARK("Scalar sampling" + suffix) {
+    for (comet::usize i{0}; i < kCharacterCount; ++i) {
+      const auto frame{get_frame(i)};
+      comet::animation::ScalarSampleJointPoses(compressed_clip, frame,
+                                               frame + 1, 0.3f, pose);
+    }
+
+    return pose.GetChannel(comet::animation::kJointPoseChannelScale)[0];
+  };
+
+  BENCHMARK("Sampling" + suffix) {
+    for (comet::usize i{0}; i < kCharacterCount; ++i) {
+      const auto frame{get_frame(i)};
+      comet::animation::SampleJointPoses(compressed_clip, frame, frame + 1,
+                                         0.3f, pose);
+    }
+
+    return pose.GetChannel(comet::animation::kJointPoseChannelScale)[0];
+  };
+
+  BENCHMARK("Scalar sampling with key cursors" + suffix) {
+    for (comet::usize i{0}; i < kCharacterCount; ++i) {
+      const auto frame{get_frame(i)};
+      comet::animation::ScalarSampleJointPoses(
+          compressed_clip, frame, frame + 1, 0.3f, pose,
+          key_cursors.GetData() + i * track_count);
+    }
+
+    return pose.GetChannel(comet::animation::kJointPoseChannelScale)[0];
+  };
+
+  BENCHMARK("Sampling with key cursors" + suffix) {
+    for (comet::usize i{0}; i < kCharacterCount; ++i) {
+      const auto frame{get_frame(i)};
+      comet::animation::SampleJointPoses(
+          compressed_clip, frame, frame + 1, 0.3f, pose,
+          key_cursors.GetData() + i * track_count);
+    }
+
+    return pose.GetChannel(comet::animation::kJointPoseChannelScale)[0];
+  };
+
+  key_cursors.Destroy();
+  pose.Destroy();
+  comet::comettests::DestroyPoseSamplingTestClip(clip, compressed_clip);
+}
@@ -0,0 +1,199 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Tested. /////////////////////////////////////////////////////////////////////
+#include "comet/core/algorithm/parallel_merge.h"
+#include "comet/core/algorithm/radix_sort.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <iterator>
+#include <string>
+
+#include "catch.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/algorithm/sort.h"
+#include "comet/core/essentials.h"
+#include "comet/core/frame/frame_allocator.h"
+#include "comet/core/memory/allocator/platform_allocator.h"
+#include "comet/core/memory/memory.h"
+#include "comet/core/type/array.h"
+
+namespace comet {
+namespace comettests {
+namespace memory {
+enum TestsRadixSortMemoryTag : comet::memory::MemoryTag {
+  kTestsMemoryTagRadixSort = comet::memory::kEngineMemoryTagUserBase + 8
+};
+}  // namespace memory
+
+// Same layout as render batch entries.
+struct RadixSortTestEntry {
+  u64 sort_key{0};
+  u32 index{0};
+};
+
+u64 GenerateRadixSortTestKey(usize index) {
+  auto key{static_cast<u64>(index) * 0x9e3779b97f4a7c15};
+  return key ^ (key >> 29);
+}
+
+void FillRadixSortTestEntries(Array<RadixSortTestEntry>& entries, usize count,
+                              u64 key_mask) {
+  entries.Resize(count);
+
+  for (usize i{0}; i < count; ++i) {
+    entries[i].sort_key = GenerateRadixSortTestKey(i) & key_mask;
+    entries[i].index = static_cast<u32>(i);
+  }
+}
+
+bool IsSortedAndStable(const Array<RadixSortTestEntry>& entries) {
+  for (usize i{1}; i < entries.GetSize(); ++i) {
+    const auto& previous{entries[i - 1]};
+    const auto& current{entries[i]};
+
+    if (previous.sort_key > current.sort_key ||
+        (previous.sort_key == current.sort_key &&
+         previous.index > current.index)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+u64 GetRadixSortTestKey(const RadixSortTestEntry& entry) {
+  return entry.sort_key;
+}
+
+bool CompareRadixSortTestEntries(const RadixSortTestEntry& a,
+                                 const RadixSortTestEntry& b) {
+  return a.sort_key < b.sort_key;
+}
+}  // namespace comettests
+}  // namespace comet
+
+TEST_CASE("Radix sort and parallel merge", "[comet]") {
+  comet::memory::PlatformAllocator allocator{
+      comet::comettests::memory::kTestsMemoryTagRadixSort};
+  // Scratch buffers come from the frame allocator of the calling thread.
+  comet::frame::AttachFrameAllocator(&allocator);
+  comet::Array<comet::comettests::RadixSortTestEntry> entries{&allocator};
+
+  SECTION("Sorts are stable, with or without duplicate keys.") {
+    constexpr comet::usize kCounts[]{0, 1, 100, 10000, 200000};
+    constexpr comet::u64 kKeyMasks[]{0xff, 0xffff0000, comet::kU64Max};
+
+    for (auto count : kCounts) {
+      for (auto key_mask : kKeyMasks) {
+        comet::comettests::FillRadixSortTestEntries(entries, count, key_mask);
+        comet::RadixSort(entries.GetData(), entries.GetData() + count,
+                         comet::comettests::GetRadixSortTestKey);
+        REQUIRE(comet::comettests::IsSortedAndStable(entries));
+
+        comet::comettests::FillRadixSortTestEntries(entries, count, key_mask);
+        comet::ParallelRadixSort(entries.GetData(), entries.GetData() + count,
+                                 comet::comettests::GetRadixSortTestKey);
+        REQUIRE(comet::comettests::IsSortedAndStable(entries));
+      }
+    }
+  }
+
+  SECTION("Signed keys.") {
+    comet::s32 values[]{5, -3, 0, comet::kS32Min, 42, -1, comet::kS32Max};
+    comet::RadixSort(values, values + std::size(values));
+    REQUIRE(std::is_sorted(values, values + std::size(values)));
+  }
+
+  SECTION("Parallel merge of sorted runs.") {
+    constexpr comet::usize kCount{150000};
+    comet::comettests::FillRadixSortTestEntries(entries, kCount, 0xffff);
+    auto* middle{entries.GetData() + kCount / 3};
+    comet::RadixSort(entries.GetData(), middle,
+                     comet::comettests::GetRadixSortTestKey);
+    comet::RadixSort(middle, entries.GetData() + kCount,
+                     comet::comettests::GetRadixSortTestKey);
+
+    comet::Array<comet::comettests::RadixSortTestEntry> merged{&allocator};
+    merged.Resize(kCount);
+    comet::ParallelMerge(entries.GetData(), kCount / 3, middle,
+                         kCount - kCount / 3, merged.GetData(),
+                         comet::comettests::CompareRadixSortTestEntries);
+    REQUIRE(comet::comettests::IsSortedAndStable(merged));
+  }
+
+  entries.Destroy();
+  comet::frame::DetachFrameAllocator();
+}
+
+TEST_CASE("Radix sort benchmark", "[.][benchmark][comet]") {
+  comet::memory::PlatformAllocator allocator{
+      comet::comettests::memory::kTestsMemoryTagRadixSort};
+  comet::frame::AttachFrameAllocator(&allocator);
+  constexpr comet::usize kCounts[]{10000, 100000, 1000000};
+
+  comet::Array<comet::comettests::RadixSortTestEntry> entries{&allocator};
+  comet::Array<comet::comettests::RadixSortTestEntry> scratch{&allocator};
+
+  for (auto count : kCounts) {
+    const auto suffix{" (" + std::to_string(count) + ")"};
+    scratch.Resize(count);
+
+    BENCHMARK_ADVANCED("Sort" + suffix)
+    (Catch::Benchmark::Chronometer meter) {
+      comet::comettests::FillRadixSortTestEntries(entries, count,
+                                                  comet::kU64Max);
+      meter.measure([&entries] {
+        comet::Sort(entries.begin(), entries.end(),
+                    comet::comettests::CompareRadixSortTestEntries);
+      });
+    };
+
+    BENCHMARK_ADVANCED("std::sort" + suffix)
+    (Catch::Benchmark::Chronometer meter) {
+      comet::comettests::FillRadixSortTestEntries(entries, count,
+                                                  comet::kU64Max);
+      meter.measure([&entries] {
+        std::sort(entries.GetData(), entries.GetData() + entries.GetSize(),
+                  comet::comettests::CompareRadixSortTestEntries);
+      });
+    };
+
+    BENCHMARK_ADVANCED("Radix sort" + suffix)
+    (Catch::Benchmark::Chronometer meter) {
+      comet::comettests::FillRadixSortTestEntries(entries, count,
+                                                  comet::kU64Max);
+      meter.measure([&entries, &scratch] {
+        comet::RadixSort(entries.GetData(),
+                         entries.GetData() + entries.GetSize(),
+                         scratch.GetData(),
+                         comet::comettests::GetRadixSortTestKey);
+      });
+    };
+
+    BENCHMARK_ADVANCED("Parallel radix sort" + suffix)
+    (Catch::Benchmark::Chronometer meter) {
+      comet::comettests::FillRadixSortTestEntries(entries, count,
+                                                  comet::kU64Max);
+      meter.measure([&entries, &scratch] {
+        comet::ParallelRadixSort(entries.GetData(),
+                                 entries.GetData() + entries.GetSize(),
+                                 scratch.GetData(),
+                                 comet::comettests::GetRadixSortTestKey);
+      });
+    };
+  }
+
+  scratch.Destroy();
+  entries.Destroy();
+  comet::frame::DetachFrameAllocator();
+}
@@ -0,0 +1,132 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Tested. /////////////////////////////////////////////////////////////////////
+#include "comet/core/concurrency/job/job.h"
+#include "comet/core/concurrency/job/scheduler.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <atomic>
+
+#include "catch.hpp"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/concurrency/job/job_utils.h"
+#include "comet/core/essentials.h"
+
+namespace comet {
+namespace comettests {
+constexpr usize kJobGraphFanOut{8};
+constexpr usize kJobGraphDepth{3};
+constexpr usize kJobGraphLeafCount{kJobGraphFanOut * kJobGraphFanOut *
+                                   kJobGraphFanOut};
+
+struct JobGraphNodeParams {
+  usize depth{0};
+  std::atomic<usize>* leaf_count{nullptr};
+};
+
+// Every inner node kicks its children and waits for them: the waiting fibers
+// are suspended until their last child is done.
+void OnJobGraphNode(job::JobParamsHandle params_handle) {
+  const auto* params{static_cast<const JobGraphNodeParams*>(params_handle)};
+
+  if (params->depth == kJobGraphDepth) {
+    params->leaf_count->fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  job::CounterGuard guard{};
+  JobGraphNodeParams child_params[kJobGraphFanOut];
+  job::JobDescr job_descrs[kJobGraphFanOut];
+
+  for (usize i{0}; i < kJobGraphFanOut; ++i) {
+    child_params[i].depth = params->depth + 1;
+    child_params[i].leaf_count = params->leaf_count;
+    job_descrs[i] = job::GenerateJobDescr(
+        job::JobPriority::Normal, OnJobGraphNode, &child_params[i],
+        job::JobStackSize::Normal, guard.GetCounter(), "job_graph_node");
+  }
+
+  job::Scheduler::Get().Kick(kJobGraphFanOut, job_descrs);
+  guard.Wait();
+}
+
+usize RunJobGraph() {
+  std::atomic<usize> leaf_count{0};
+  JobGraphNodeParams params{};
+  params.leaf_count = &leaf_count;
+
+  job::CounterGuard guard{};
+  job::Scheduler::Get().KickAndWait(job::GenerateJobDescr(
+      job::JobPriority::Normal, OnJobGraphNode, &params,
+      job::JobStackSize::Normal, guard.GetCounter(), "job_graph_root"));
+  return leaf_count.load();
+}
+
+struct CounterWaitTestParams {
+  job::Counter* counter{nullptr};
+  job::CounterCount target{0};
+  std::atomic<bool>* is_resumed{nullptr};
+};
+}  // namespace comettests
+}  // namespace comet
+
+TEST_CASE("Counter waits", "[comet::job]") {
+  SECTION("Deep fan-out/fan-in graphs complete.") {
+    for (comet::usize i{0}; i < 16; ++i) {
+      REQUIRE(comet::comettests::RunJobGraph() ==
+              comet::comettests::kJobGraphLeafCount);
+    }
+  }
+
+  SECTION("Waiters are resumed once their target is reached.") {
+    auto& scheduler{comet::job::Scheduler::Get()};
+    comet::job::CounterGuard waited_guard{};
+    auto* waited_counter{waited_guard.GetCounter()};
+
+    for (comet::usize i{0}; i < 3; ++i) {
+      waited_counter->Increment();
+    }
+
+    std::atomic<bool> is_resumed{false};
+    comet::comettests::CounterWaitTestParams params{};
+    params.counter = waited_counter;
+    params.target = 1;
+    params.is_resumed = &is_resumed;
+
+    comet::job::CounterGuard job_guard{};
+    scheduler.Kick(comet::job::GenerateJobDescr(
+        comet::job::JobPriority::Normal,
+        [](comet::job::JobParamsHandle params_handle) {
+          const auto* params{
+              static_cast<const comet::comettests::CounterWaitTestParams*>(
+                  params_handle)};
+          comet::job::CounterWaiter waiter{*params->counter, params->target};
+          params->is_resumed->store(true);
+        },
+        &params, comet::job::JobStackSize::Normal, job_guard.GetCounter(),
+        "counter_waiter"));
+
+    waited_counter->Decrement();
+    REQUIRE(!is_resumed.load());
+
+    waited_counter->Decrement();
+    job_guard.Wait();
+    REQUIRE(is_resumed.load());
+
+    waited_counter->Decrement();
+  }
+}
+
+TEST_CASE("Job graph benchmark", "[.][benchmark][comet::job]") {
+  BENCHMARK("Fan-out/fan-in of 512 jobs, 3 levels deep") {
+    return comet::comettests::RunJobGraph();
+  };
+}
@@ -0,0 +1,204 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Tested. /////////////////////////////////////////////////////////////////////
+#include "comet/core/concurrency/job/job_graph.h"
+#include "comet/core/concurrency/job/scheduler.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <atomic>
+
+#include "catch.hpp"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/concurrency/job/job.h"
+#include "comet/core/concurrency/job/job_utils.h"
+#include "comet/core/essentials.h"
+#include "comet/core/memory/allocator/platform_allocator.h"
+#include "comet/core/memory/memory.h"
+
+namespace comet {
+namespace comettests {
+namespace memory {
+enum TestsJobGraphMemoryTag : comet::memory::MemoryTag {
+  kTestsMemoryTagJobGraph = comet::memory::kEngineMemoryTagUserBase + 14
+};
+}  // namespace memory
+
+// Every job records the step at which it ran.
+struct JobStepParams {
+  std::atomic<usize>* step_counter{nullptr};
+  usize step{kInvalidIndex};
+};
+
+void OnJobStep(job::JobParamsHandle params_handle) {
+  auto* params{static_cast<JobStepParams*>(params_handle)};
+  params->step = params->step_counter->fetch_add(1);
+}
+
+void OnIOJobStep(job::IOJobParamsHandle params_handle) {
+  OnJobStep(params_handle);
+}
+
+job::JobDescr GenerateJobStepDescr(JobStepParams& params,
+                                   job::Counter* counter = nullptr) {
+  return job::GenerateJobDescr(job::JobPriority::Normal, OnJobStep, &params,
+                               job::JobStackSize::Normal, counter, "job_step");
+}
+}  // namespace comettests
+}  // namespace comet
+
+TEST_CASE("Job continuations", "[comet::job]") {
+  auto& scheduler{comet::job::Scheduler::Get()};
+  std::atomic<comet::usize> step_counter{0};
+
+  SECTION("Chained jobs run in order.") {
+    comet::comettests::JobStepParams params[3]{};
+    comet::job::CounterGuard guards[3]{};
+
+    for (auto& job_params : params) {
+      job_params.step_counter = &step_counter;
+    }
+
+    scheduler.Kick(comet::comettests::GenerateJobStepDescr(
+        params[0], guards[0].GetCounter()));
+    scheduler.KickAfter(comet::job::GenerateIOJobDescr(
+                            comet::comettests::OnIOJobStep, &params[1],
+                            guards[1].GetCounter()),
+                        guards[0].GetCounter());
+    scheduler.KickAfter(comet::comettests::GenerateJobStepDescr(
+                            params[2], guards[2].GetCounter()),
+                        guards[1].GetCounter());
+    guards[2].Wait();
+
+    REQUIRE(params[0].step == 0);
+    REQUIRE(params[1].step == 1);
+    REQUIRE(params[2].step == 2);
+  }
+
+  SECTION("Jobs run after all their predecessors.") {
+    constexpr comet::usize kPredecessorCount{
+        comet::job::kMaxJobPredecessorCount};
+    comet::comettests::JobStepParams params[kPredecessorCount + 1]{};
+    comet::job::CounterGuard guards[kPredecessorCount + 1]{};
+    comet::job::Counter* predecessors[kPredecessorCount]{};
+
+    for (auto& job_params : params) {
+      job_params.step_counter = &step_counter;
+    }
+
+    for (comet::usize i{0}; i < kPredecessorCount; ++i) {
+      predecessors[i] = guards[i].GetCounter();
+    }
+
+    // The continuation is registered before some of its predecessors are
+    // kicked: their counters are still at zero, so it must not wait for them.
+    for (comet::usize i{0}; i < kPredecessorCount / 2; ++i) {
+      scheduler.Kick(
+          comet::comettests::GenerateJobStepDescr(params[i], predecessors[i]));
+    }
+
+    scheduler.KickAfter(
+        comet::comettests::GenerateJobStepDescr(
+            params[kPredecessorCount], guards[kPredecessorCount].GetCounter()),
+        kPredecessorCount, predecessors);
+    guards[kPredecessorCount].Wait();
+
+    for (comet::usize i{0}; i < kPredecessorCount / 2; ++i) {
+      REQUIRE(params[i].step < params[kPredecessorCount].step);
+    }
+
+    for (comet::usize i{kPredecessorCount / 2}; i < kPredecessorCount; ++i) {
+      REQUIRE(params[i].step == comet::kInvalidIndex);
+    }
+  }
+}
+
+TEST_CASE("Job graphs", "[comet::job]") {
+  comet::memory::PlatformAllocator allocator{
+      comet::comettests::memory::kTestsMemoryTagJobGraph};
+  comet::job::JobGraph graph{&allocator};
+  std::atomic<comet::usize> step_counter{0};
+
+  // A -> (B, C) -> D.
+  comet::comettests::JobStepParams params[4]{};
+
+  for (auto& job_params : params) {
+    job_params.step_counter = &step_counter;
+    graph.AddNode(comet::comettests::GenerateJobStepDescr(job_params));
+  }
+
+  graph.AddDependency(0, 1);
+  graph.AddDependency(0, 2);
+  graph.AddDependency(1, 3);
+  graph.AddDependency(2, 3);
+  REQUIRE(graph.GetNodeCount() == 4);
+
+  SECTION("Graphs can be kicked several times.") {
+    for (comet::usize i{0}; i < 16; ++i) {
+      step_counter = 0;
+      graph.KickAndWait();
+
+      REQUIRE(!graph.IsRunning());
+      REQUIRE(params[0].step == 0);
+      REQUIRE(params[1].step < params[3].step);
+      REQUIRE(params[2].step < params[3].step);
+      REQUIRE(params[3].step == 3);
+    }
+  }
+
+  SECTION("Nodes can be added once the graph is done.") {
+    graph.KickAndWait();
+
+    comet::comettests::JobStepParams last_params{};
+    last_params.step_counter = &step_counter;
+    const auto last_id{
+        graph.AddNode(comet::comettests::GenerateJobStepDescr(last_params))};
+    graph.AddDependency(3, last_id);
+
+    step_counter = 0;
+    graph.KickAndWait();
+    REQUIRE(last_params.step == 4);
+  }
+
+  graph.Destroy();
+}
+
+TEST_CASE("Job graph re-kick benchmark", "[.][benchmark][comet::job]") {
+  constexpr comet::usize kStageCount{16};
+  constexpr comet::usize kJobCountPerStage{16};
+
+  comet::memory::PlatformAllocator allocator{
+      comet::comettests::memory::kTestsMemoryTagJobGraph};
+  comet::job::JobGraph graph{&allocator};
+  std::atomic<comet::usize> step_counter{0};
+  comet::comettests::JobStepParams params[kStageCount * kJobCountPerStage]{};
+
+  // Every job of a stage depends on a job of the previous one, so that the
+  // pipeline is as deep as it is wide.
+  for (comet::usize i{0}; i < kStageCount; ++i) {
+    for (comet::usize j{0}; j < kJobCountPerStage; ++j) {
+      auto& job_params{params[i * kJobCountPerStage + j]};
+      job_params.step_counter = &step_counter;
+      const auto node_id{
+          graph.AddNode(comet::comettests::GenerateJobStepDescr(job_params))};
+
+      if (i > 0) {
+        graph.AddDependency(node_id - kJobCountPerStage, node_id);
+      }
+    }
+  }
+
+  BENCHMARK("Re-kick a pipeline of 256 jobs, 16 stages deep") {
+    graph.KickAndWait();
+    return step_counter.load();
+  };
+
+  graph.Destroy();
+}
@@ -0,0 +1,138 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Tested. /////////////////////////////////////////////////////////////////////
+#include "comet/core/concurrency/job/parallel.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <atomic>
+
+#include "catch.hpp"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/essentials.h"
+
+namespace comet {
+namespace comettests {
+// Not a multiple of any grain size used below, so the last chunk is partial.
+constexpr usize kParallelTestBegin{3};
+constexpr usize kParallelTestCount{1000};
+constexpr usize kParallelTestEnd{kParallelTestBegin + kParallelTestCount};
+// 0 picks a grain size automatically.
+constexpr usize kParallelTestGrainSizes[]{0, 1, 7, 64, kParallelTestCount * 2};
+
+// Returns true if every index of the range was visited exactly once.
+bool IsEveryIndexVisitedOnce(usize grain_size) {
+  std::atomic<u32> visit_counts[kParallelTestCount]{};
+  std::atomic<bool> is_out_of_range{false};
+
+  job::ParallelFor({kParallelTestBegin, kParallelTestEnd}, grain_size,
+                   [&visit_counts, &is_out_of_range](usize index) {
+                     if (index < kParallelTestBegin ||
+                         index >= kParallelTestEnd) {
+                       is_out_of_range.store(true, std::memory_order_relaxed);
+                       return;
+                     }
+
+                     visit_counts[index - kParallelTestBegin].fetch_add(
+                         1, std::memory_order_relaxed);
+                   });
+
+  if (is_out_of_range.load()) {
+    return false;
+  }
+
+  for (const auto& visit_count : visit_counts) {
+    if (visit_count.load() != 1) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+u64 MapParallelTestIndex(usize index) {
+  return static_cast<u64>(index) * static_cast<u64>(index) + 1;
+}
+}  // namespace comettests
+}  // namespace comet
+
+TEST_CASE("Parallel for", "[comet::job]") {
+  SECTION("Empty ranges do not call the function.") {
+    std::atomic<comet::usize> call_count{0};
+    const auto func{[&call_count](comet::usize) {
+      call_count.fetch_add(1, std::memory_order_relaxed);
+    }};
+
+    comet::job::ParallelFor({0, 0}, 0, func);
+    comet::job::ParallelFor({10, 10}, 1, func);
+    comet::job::ParallelFor({10, 5}, 1, func);
+    REQUIRE(call_count.load() == 0);
+  }
+
+  SECTION("Every index is visited exactly once.") {
+    for (const auto grain_size : comet::comettests::kParallelTestGrainSizes) {
+      REQUIRE(comet::comettests::IsEveryIndexVisitedOnce(grain_size));
+    }
+  }
+}
+
+TEST_CASE("Parallel reduce", "[comet::job]") {
+  SECTION("Empty ranges return the identity.") {
+    std::atomic<comet::usize> call_count{0};
+    const auto map_func{[&call_count](comet::usize index) {
+      call_count.fetch_add(1, std::memory_order_relaxed);
+      return static_cast<comet::u64>(index);
+    }};
+    const auto reduce_func{
+        [](comet::u64 left, comet::u64 right) { return left + right; }};
+
+    REQUIRE(comet::job::ParallelReduce<comet::u64>({0, 0}, 0, 42, map_func,
+                                                   reduce_func) == 42);
+    REQUIRE(comet::job::ParallelReduce<comet::u64>({10, 5}, 1, 42, map_func,
+                                                   reduce_func) == 42);
+    REQUIRE(call_count.load() == 0);
+  }
+
+  SECTION("Results match a serial reduction.") {
+    comet::u64 serial_sum{0};
+    comet::u64 serial_max{0};
+
+    for (auto i{comet::comettests::kParallelTestBegin};
+         i < comet::comettests::kParallelTestEnd; ++i) {
+      const auto value{comet::comettests::MapParallelTestIndex(i)};
+      serial_sum += value;
+      serial_max = serial_max > value ? serial_max : value;
+    }
+
+    for (const auto grain_size : comet::comettests::kParallelTestGrainSizes) {
+      const comet::job::IndexRange range{comet::comettests::kParallelTestBegin,
+                                         comet::comettests::kParallelTestEnd};
+
+      const auto sum{comet::job::ParallelReduce<comet::u64>(
+          range, grain_size, 0, comet::comettests::MapParallelTestIndex,
+          [](comet::u64 left, comet::u64 right) { return left + right; })};
+      REQUIRE(sum == serial_sum);
+
+      const auto max{comet::job::ParallelReduce<comet::u64>(
+          range, grain_size, 0, comet::comettests::MapParallelTestIndex,
+          [](comet::u64 left, comet::u64 right) {
+            return left > right ? left : right;
+          })};
+      REQUIRE(max == serial_max);
+
+      // Partial results are combined in chunk order: keeping the right operand
+      // yields the last index.
+      const auto last{comet::job::ParallelReduce<comet::usize>(
+          range, grain_size, 0, [](comet::usize index) { return index; },
+          [](comet::usize, comet::usize right) { return right; })};
+      REQUIRE(last == comet::comettests::kParallelTestEnd - 1);
+    }
+  }
+}
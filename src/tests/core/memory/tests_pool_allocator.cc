@@ -0,0 +1,128 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Tested. /////////////////////////////////////////////////////////////////////
+#include "comet/core/memory/allocator/pool_allocator.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <atomic>
+
+#include "catch.hpp"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/concurrency/job/parallel.h"
+#include "comet/core/essentials.h"
+#include "comet/core/memory/allocator/platform_allocator.h"
+#include "comet/core/memory/memory.h"
+#include "comet/core/memory/memory_utils.h"
+#include "comet/core/type/array.h"
+
+namespace comet {
+namespace comettests {
+namespace memory {
+enum TestsPoolMemoryTag : comet::memory::MemoryTag {
+  kTestsMemoryTagPool = comet::memory::kEngineMemoryTagUserBase + 6
+};
+}  // namespace memory
+
+struct PoolTestObject {
+  u64 value{0};
+  u32 padding[5]{};
+};
+}  // namespace comettests
+}  // namespace comet
+
+TEST_CASE("Pool allocator", "[comet::memory]") {
+  using Object = comet::comettests::PoolTestObject;
+  comet::memory::PoolAllocator<Object> allocator{
+      comet::comettests::memory::kTestsMemoryTagPool};
+  allocator.Initialize();
+
+  SECTION("Slots are aligned to cache lines and do not overlap.") {
+    constexpr comet::usize kCount{4096};
+    Object* objects[kCount];
+
+    for (comet::usize i{0}; i < kCount; ++i) {
+      objects[i] = allocator.AllocateOneAndPopulate<Object>();
+      REQUIRE(comet::memory::IsAligned(objects[i],
+                                       comet::memory::kPoolSlotAlignment));
+      objects[i]->value = i;
+    }
+
+    for (comet::usize i{0}; i < kCount; ++i) {
+      REQUIRE(objects[i]->value == i);
+      allocator.Deallocate(objects[i]);
+    }
+  }
+
+  SECTION("Handles are invalidated on deallocation.") {
+    auto* object{allocator.AllocateOneAndPopulate<Object>()};
+    const auto handle{allocator.GetHandle(object)};
+    REQUIRE(allocator.TryGet(handle) == object);
+
+    allocator.Deallocate(object);
+    REQUIRE(allocator.TryGet(handle) == nullptr);
+
+    // The slot is reused, with another generation.
+    auto* other_object{allocator.AllocateOneAndPopulate<Object>()};
+    const auto other_handle{allocator.GetHandle(other_object)};
+    REQUIRE(other_object == object);
+    REQUIRE(other_handle != handle);
+    REQUIRE(allocator.TryGet(handle) == nullptr);
+    REQUIRE(allocator.TryGet(other_handle) == other_object);
+    REQUIRE(allocator.TryGet(comet::memory::kInvalidPoolHandle) == nullptr);
+
+    allocator.Deallocate(other_object);
+  }
+
+  SECTION("Concurrent allocations and deallocations.") {
+    constexpr comet::usize kJobCount{64};
+    constexpr comet::usize kAllocationCount{64};
+
+    comet::memory::PlatformAllocator platform_allocator{
+        comet::comettests::memory::kTestsMemoryTagPool};
+    comet::Array<Object*> objects{&platform_allocator};
+    objects.Resize(kJobCount * kAllocationCount);
+
+    // Every job writes values no other job writes: a slot handed out twice
+    // holds the value of the job which wrote last.
+    comet::job::ParallelFor(
+        {0, kJobCount}, 1, [&allocator, &objects](comet::usize job_index) {
+          for (comet::usize i{0}; i < kAllocationCount; ++i) {
+            const auto index{job_index * kAllocationCount + i};
+            objects[index] = allocator.AllocateOneAndPopulate<Object>();
+            objects[index]->value = index;
+          }
+        });
+
+    // All the jobs are done writing before any value is checked.
+    std::atomic<bool> is_overlapping{false};
+
+    comet::job::ParallelFor(
+        {0, kJobCount}, 1,
+        [&allocator, &objects, &is_overlapping](comet::usize job_index) {
+          for (comet::usize i{0}; i < kAllocationCount; ++i) {
+            const auto index{job_index * kAllocationCount + i};
+
+            if (objects[index]->value != index) {
+              is_overlapping.store(true, std::memory_order_relaxed);
+            }
+          }
+
+          for (comet::usize i{0}; i < kAllocationCount; ++i) {
+            allocator.Deallocate(objects[job_index * kAllocationCount + i]);
+          }
+        });
+
+    REQUIRE(!is_overlapping.load());
+    objects.Destroy();
+  }
+
+  allocator.Destroy();
+}
@@ -0,0 +1,164 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Tested. /////////////////////////////////////////////////////////////////////
+#include "comet/core/memory/allocator/size_class_allocator.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// External. ///////////////////////////////////////////////////////////////////
+#include "catch.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/concurrency/job/parallel.h"
+#include "comet/core/essentials.h"
+#include "comet/core/memory/allocator/allocator.h"
+#include "comet/core/memory/allocator/free_list_allocator.h"
+#include "comet/core/memory/allocator/platform_allocator.h"
+#include "comet/core/memory/memory.h"
+#include "comet/core/memory/memory_utils.h"
+
+namespace comet {
+namespace comettests {
+namespace memory {
+enum TestsSizeClassMemoryTag : comet::memory::MemoryTag {
+  kTestsMemoryTagSizeClass = comet::memory::kEngineMemoryTagUserBase + 3,
+  kTestsMemoryTagSizeClassFreeList,
+  kTestsMemoryTagSizeClassPlatform
+};
+}  // namespace memory
+
+constexpr usize kSizeClassTestJobCount{256};
+constexpr usize kSizeClassTestAllocationCount{128};
+
+usize GetSizeClassTestSize(usize index) { return 8 + (index * 24) % 480; }
+
+void StressAllocator(comet::memory::Allocator& allocator) {
+  job::ParallelFor({0, kSizeClassTestJobCount}, 1, [&allocator](usize) {
+    void* ptrs[kSizeClassTestAllocationCount];
+
+    for (usize i{0}; i < kSizeClassTestAllocationCount; ++i) {
+      ptrs[i] = allocator.AllocateAligned(GetSizeClassTestSize(i), 8);
+    }
+
+    for (auto* ptr : ptrs) {
+      allocator.Deallocate(ptr);
+    }
+  });
+}
+}  // namespace comettests
+}  // namespace comet
+
+TEST_CASE("Size class allocator", "[comet::memory]") {
+  comet::memory::FiberSizeClassAllocator allocator{
+      comet::comettests::memory::kTestsMemoryTagSizeClass};
+  allocator.Initialize();
+
+  SECTION("Allocations with various sizes and alignments.") {
+    constexpr comet::usize kSizes[]{1, 7, 24, 100, 1000, 4000, 5000, 100000};
+    constexpr comet::memory::Alignment kAligns[]{1, 8, 16, 64};
+
+    for (auto size : kSizes) {
+      for (auto align : kAligns) {
+        auto* ptr{static_cast<comet::u8*>(
+            allocator.AllocateAligned(size, align))};
+        REQUIRE(ptr != nullptr);
+        REQUIRE(comet::memory::IsAligned(ptr, align));
+
+        for (comet::usize i{0}; i < size; ++i) {
+          ptr[i] = static_cast<comet::u8>(i);
+        }
+
+        allocator.Deallocate(ptr);
+      }
+    }
+  }
+
+  SECTION("Live allocations do not overlap.") {
+    constexpr comet::usize kCount{1024};
+    comet::u32* ptrs[kCount];
+
+    for (comet::usize i{0}; i < kCount; ++i) {
+      ptrs[i] = allocator.AllocateOneAndPopulate<comet::u32>(
+          static_cast<comet::u32>(i));
+    }
+
+    for (comet::usize i{0}; i < kCount; ++i) {
+      REQUIRE(*ptrs[i] == i);
+      allocator.Deallocate(ptrs[i]);
+    }
+  }
+
+  SECTION("Deallocations from other threads.") {
+    constexpr comet::usize kCount{512};
+    void* ptrs[kCount];
+
+    for (auto& ptr : ptrs) {
+      ptr = allocator.AllocateAligned(64, 8);
+    }
+
+    comet::job::ParallelFor({0, kCount}, 16,
+                            [&ptrs, &allocator](comet::usize index) {
+                              allocator.Deallocate(ptrs[index]);
+                            });
+
+    // Objects deallocated remotely are taken back by their owner once its
+    // cache runs dry, before any new span is carved. A span holds fewer
+    // objects of this size class than kCount, so every address is reused
+    // within twice as many allocations.
+    void* new_ptrs[kCount * 2];
+    comet::usize reused_count{0};
+
+    for (auto& new_ptr : new_ptrs) {
+      new_ptr = allocator.AllocateAligned(64, 8);
+      REQUIRE(new_ptr != nullptr);
+
+      for (const auto* ptr : ptrs) {
+        if (new_ptr == ptr) {
+          ++reused_count;
+          break;
+        }
+      }
+    }
+
+    REQUIRE(reused_count == kCount);
+
+    for (auto* new_ptr : new_ptrs) {
+      allocator.Deallocate(new_ptr);
+    }
+  }
+
+  allocator.Destroy();
+}
+
+TEST_CASE("Size class allocator benchmark",
+          "[.][benchmark][comet::memory]") {
+  comet::memory::FiberSizeClassAllocator size_class_allocator{
+      comet::comettests::memory::kTestsMemoryTagSizeClass};
+  comet::memory::FiberFreeListAllocator free_list_allocator{
+      512, 4096, comet::comettests::memory::kTestsMemoryTagSizeClassFreeList};
+  comet::memory::PlatformAllocator platform_allocator{
+      comet::comettests::memory::kTestsMemoryTagSizeClassPlatform};
+  size_class_allocator.Initialize();
+  free_list_allocator.Initialize();
+
+  BENCHMARK("Size class allocator under fiber contention") {
+    comet::comettests::StressAllocator(size_class_allocator);
+  };
+
+  BENCHMARK("Free list allocator under fiber contention") {
+    comet::comettests::StressAllocator(free_list_allocator);
+  };
+
+  BENCHMARK("Platform allocator under fiber contention") {
+    comet::comettests::StressAllocator(platform_allocator);
+  };
+
+  free_list_allocator.Destroy();
+  size_class_allocator.Destroy();
+}
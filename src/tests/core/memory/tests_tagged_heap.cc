@@ -0,0 +1,176 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Tested. /////////////////////////////////////////////////////////////////////
+#include "comet/core/memory/tagged_heap.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <atomic>
+
+#include "catch.hpp"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/concurrency/job/parallel.h"
+#include "comet/core/conf/configuration_manager.h"
+#include "comet/core/conf/configuration_value.h"
+#include "comet/core/essentials.h"
+#include "comet/core/memory/memory.h"
+
+namespace comet {
+namespace comettests {
+namespace memory {
+enum TestsTaggedHeapMemoryTag : comet::memory::MemoryTag {
+  kTestsMemoryTagTaggedHeapA = comet::memory::kEngineMemoryTagUserBase + 16,
+  kTestsMemoryTagTaggedHeapB,
+  kTestsMemoryTagTaggedHeapC
+};
+}  // namespace memory
+
+// One block word and a partial tail word.
+constexpr usize kTaggedHeapTestBlockCount{100};
+
+// Blocks are allocated without any alignment, so pointers are shifted by the
+// same amount from the start of their first block.
+usize GetTaggedHeapTestBlockIndex(const void* first_block, const void* ptr) {
+  return static_cast<usize>(static_cast<const u8*>(ptr) -
+                            static_cast<const u8*>(first_block)) /
+         comet::memory::TaggedHeap::Get().GetBlockSize();
+}
+}  // namespace comettests
+}  // namespace comet
+
+TEST_CASE("Tagged heap", "[comet::memory]") {
+  using comet::comettests::GetTaggedHeapTestBlockIndex;
+  using comet::comettests::kTaggedHeapTestBlockCount;
+  constexpr auto kTagA{comet::comettests::memory::kTestsMemoryTagTaggedHeapA};
+  constexpr auto kTagB{comet::comettests::memory::kTestsMemoryTagTaggedHeapB};
+  constexpr auto kTagC{comet::comettests::memory::kTestsMemoryTagTaggedHeapC};
+
+  // A small heap makes the block layout predictable: its capacity is read on
+  // construction.
+  auto& configuration_manager{comet::conf::ConfigurationManager::Get()};
+  const auto previous_capacity{
+      configuration_manager.GetU64(comet::conf::kCoreTaggedHeapCapacity)};
+  const auto block_size{comet::memory::TaggedHeap::Get().GetBlockSize()};
+  configuration_manager.SetU64(comet::conf::kCoreTaggedHeapCapacity,
+                               kTaggedHeapTestBlockCount * block_size);
+  comet::memory::TaggedHeap heap{};
+  configuration_manager.SetU64(comet::conf::kCoreTaggedHeapCapacity,
+                               previous_capacity);
+  heap.Initialize();
+  REQUIRE(heap.GetBlockSize() == block_size);
+
+  SECTION("Runs of blocks can cross block words.") {
+    auto* first{heap.AllocateBlocks(60, kTagA)};
+    auto* crossing{heap.AllocateBlocks(10, kTagB)};
+    REQUIRE(GetTaggedHeapTestBlockIndex(first, crossing) == 60);
+
+    // Both ends of the run are usable.
+    static_cast<comet::u8*>(crossing)[0] = 0xAB;
+    static_cast<comet::u8*>(crossing)[10 * block_size - 2] = 0xCD;
+    REQUIRE(static_cast<comet::u8*>(crossing)[0] == 0xAB);
+
+    // The run is claimed again at the same place once released.
+    heap.DeallocateAll(kTagB);
+    auto* wider{heap.AllocateBlocks(20, kTagB)};
+    REQUIRE(GetTaggedHeapTestBlockIndex(first, wider) == 60);
+
+    heap.DeallocateAll(kTagA);
+    heap.DeallocateAll(kTagB);
+  }
+
+  SECTION("Blocks of the tail word are claimed up to the capacity.") {
+    auto* first{heap.AllocateBlocks(64, kTagA)};
+    constexpr auto kTailBlockCount{kTaggedHeapTestBlockCount - 64};
+
+    for (comet::usize i{0}; i < kTailBlockCount; ++i) {
+      auto* block{heap.AllocateBlock(kTagB)};
+      REQUIRE(GetTaggedHeapTestBlockIndex(first, block) == 64 + i);
+    }
+
+    // The whole tail fits in a single run.
+    heap.DeallocateAll(kTagB);
+    auto* tail{heap.AllocateBlocks(kTailBlockCount, kTagB)};
+    REQUIRE(GetTaggedHeapTestBlockIndex(first, tail) == 64);
+    static_cast<comet::u8*>(tail)[kTailBlockCount * block_size - 2] = 0xAB;
+
+    heap.DeallocateAll(kTagA);
+    heap.DeallocateAll(kTagB);
+  }
+
+  SECTION("Deallocating a tag only releases its blocks.") {
+    void* blocks[10];
+
+    for (comet::usize i{0}; i < 10; ++i) {
+      blocks[i] = heap.AllocateBlock(i % 2 == 0 ? kTagA : kTagB);
+    }
+
+    heap.DeallocateAll(kTagA);
+
+    // Released blocks are isolated: larger runs go past them.
+    auto* run{heap.AllocateBlocks(2, kTagC)};
+    REQUIRE(GetTaggedHeapTestBlockIndex(blocks[0], run) == 10);
+
+    // Only the blocks of the released tag are claimed again.
+    for (comet::usize i{0}; i < 10; i += 2) {
+      auto* block{heap.AllocateBlock(kTagC)};
+      REQUIRE(GetTaggedHeapTestBlockIndex(blocks[0], block) == i);
+    }
+
+    auto* block{heap.AllocateBlock(kTagC)};
+    REQUIRE(GetTaggedHeapTestBlockIndex(blocks[0], block) == 12);
+
+    heap.DeallocateAll(kTagB);
+    heap.DeallocateAll(kTagC);
+  }
+
+  SECTION("Concurrent claims are disjoint.") {
+    constexpr comet::usize kJobCount{32};
+    // Both runs of all the jobs fit in the heap: 32 * (1 + 2) blocks.
+    constexpr comet::usize kRunBlockCounts[]{1, 2};
+
+    // The heap is empty, so the first block is the start of its memory.
+    auto* origin{heap.AllocateBlock(kTagC)};
+    heap.DeallocateAll(kTagC);
+
+    std::atomic<bool> is_claimed[kTaggedHeapTestBlockCount]{};
+    std::atomic<bool> is_overlapping{false};
+
+    comet::job::ParallelFor(
+        {0, kJobCount}, 1,
+        [&heap, &kRunBlockCounts, origin, &is_claimed,
+         &is_overlapping](comet::usize job_index) {
+          const auto tag{job_index % 2 == 0 ? kTagA : kTagB};
+
+          for (const auto block_count : kRunBlockCounts) {
+            const auto index{GetTaggedHeapTestBlockIndex(
+                origin, heap.AllocateBlocks(block_count, tag))};
+
+            for (comet::usize i{index}; i < index + block_count; ++i) {
+              if (i >= kTaggedHeapTestBlockCount ||
+                  is_claimed[i].exchange(true, std::memory_order_relaxed)) {
+                is_overlapping.store(true, std::memory_order_relaxed);
+              }
+            }
+          }
+        });
+
+    REQUIRE(!is_overlapping.load());
+
+    heap.DeallocateAll(kTagA);
+    heap.DeallocateAll(kTagB);
+
+    // Every block was released.
+    auto* all{heap.AllocateBlocks(kTaggedHeapTestBlockCount, kTagC)};
+    REQUIRE(all == origin);
+    heap.DeallocateAll(kTagC);
+  }
+
+  heap.Destroy();
+}
@@ -0,0 +1,176 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Tested. /////////////////////////////////////////////////////////////////////
+#include "comet/core/type/flat_map.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <string>
+
+#include "catch.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/essentials.h"
+#include "comet/core/memory/allocator/platform_allocator.h"
+#include "comet/core/memory/memory.h"
+#include "comet/core/type/map.h"
+
+namespace comet {
+namespace comettests {
+namespace memory {
+enum TestsFlatMapMemoryTag : comet::memory::MemoryTag {
+  kTestsMemoryTagFlatMap = comet::memory::kEngineMemoryTagUserBase + 7
+};
+}  // namespace memory
+
+// Scatters keys the way entity IDs and string IDs would be.
+u64 GenerateFlatMapTestKey(usize index) {
+  return static_cast<u64>(index) * 2654435761 + 17;
+}
+
+template <typename TMap>
+void FillMap(TMap& map, usize count) {
+  for (usize i{0}; i < count; ++i) {
+    map.Set(GenerateFlatMapTestKey(i), static_cast<u64>(i));
+  }
+}
+
+template <typename TMap>
+u64 LookUpMap(const TMap& map, usize count) {
+  u64 sum{0};
+
+  for (usize i{0}; i < count; ++i) {
+    sum += *map.TryGet(GenerateFlatMapTestKey(i));
+  }
+
+  return sum;
+}
+
+template <typename TMap>
+void EraseMap(TMap& map, usize count) {
+  for (usize i{0}; i < count; ++i) {
+    map.Remove(GenerateFlatMapTestKey(i));
+  }
+}
+
+template <typename TMap>
+void BenchmarkMap(const std::string& label, comet::memory::Allocator& allocator,
+                  usize count) {
+  TMap lookup_map{&allocator};
+  FillMap(lookup_map, count);
+
+  BENCHMARK(label + " insert (" + std::to_string(count) + ")") {
+    TMap map{&allocator};
+    FillMap(map, count);
+    return map.GetEntryCount();
+  };
+
+  BENCHMARK(label + " lookup (" + std::to_string(count) + ")") {
+    return LookUpMap(lookup_map, count);
+  };
+
+  BENCHMARK_ADVANCED(label + " erase (" + std::to_string(count) + ")")
+  (Catch::Benchmark::Chronometer meter) {
+    TMap map{&allocator};
+    FillMap(map, count);
+    meter.measure([&map, count] { EraseMap(map, count); });
+  };
+}
+}  // namespace comettests
+}  // namespace comet
+
+TEST_CASE("Flat map operations", "[comet]") {
+  comet::memory::PlatformAllocator allocator{
+      comet::comettests::memory::kTestsMemoryTagFlatMap};
+  comet::FlatMap<comet::u64, comet::u64> map{&allocator};
+  constexpr comet::usize kCount{10000};
+
+  SECTION("Insertions and lookups.") {
+    comet::comettests::FillMap(map, kCount);
+    REQUIRE(map.GetEntryCount() == kCount);
+
+    for (comet::usize i{0}; i < kCount; ++i) {
+      const auto* value{
+          map.TryGet(comet::comettests::GenerateFlatMapTestKey(i))};
+      REQUIRE(value != nullptr);
+      REQUIRE(*value == i);
+    }
+
+    REQUIRE(map.TryGet(1) == nullptr);
+    REQUIRE(map.Emplace(comet::comettests::GenerateFlatMapTestKey(0), 42u)
+                .value == 0);
+    map.Set(comet::comettests::GenerateFlatMapTestKey(0), 42u);
+    REQUIRE(map.Get(comet::comettests::GenerateFlatMapTestKey(0)) == 42);
+  }
+
+  SECTION("Removals leave other entries reachable.") {
+    comet::comettests::FillMap(map, kCount);
+
+    for (comet::usize i{0}; i < kCount; i += 2) {
+      REQUIRE(map.Remove(comet::comettests::GenerateFlatMapTestKey(i)));
+    }
+
+    REQUIRE(map.GetEntryCount() == kCount / 2);
+    REQUIRE(!map.Remove(comet::comettests::GenerateFlatMapTestKey(0)));
+
+    for (comet::usize i{1}; i < kCount; i += 2) {
+      REQUIRE(map.IsContained(comet::comettests::GenerateFlatMapTestKey(i)));
+    }
+
+    comet::usize iterated_count{0};
+
+    for (const auto& pair : map) {
+      REQUIRE(pair.value % 2 == 1);
+      ++iterated_count;
+    }
+
+    REQUIRE(iterated_count == kCount / 2);
+  }
+
+  SECTION("Tombstones are reused.") {
+    const auto capacity{map.GetCapacity()};
+
+    for (comet::usize i{0}; i < kCount; ++i) {
+      map.Set(comet::comettests::GenerateFlatMapTestKey(i), i);
+      map.Remove(comet::comettests::GenerateFlatMapTestKey(i));
+    }
+
+    REQUIRE(map.IsEmpty());
+    REQUIRE(map.GetCapacity() == capacity);
+  }
+
+  SECTION("Removal with a predicate, copy and clear.") {
+    comet::comettests::FillMap(map, kCount);
+    const auto removed_count{
+        map.RemoveIf([](comet::u64, comet::u64 value) { return value < 10; })};
+    REQUIRE(removed_count == 10);
+
+    auto copy{map};
+    REQUIRE(copy == map);
+
+    map.Clear();
+    REQUIRE(map.IsEmpty());
+    REQUIRE(map.begin() == map.end());
+    REQUIRE(copy.GetEntryCount() == kCount - 10);
+  }
+}
+
+TEST_CASE("Flat map benchmark", "[.][benchmark][comet]") {
+  comet::memory::PlatformAllocator allocator{
+      comet::comettests::memory::kTestsMemoryTagFlatMap};
+  constexpr comet::usize kCounts[]{1000, 100000, 1000000};
+
+  for (auto count : kCounts) {
+    comet::comettests::BenchmarkMap<comet::FlatMap<comet::u64, comet::u64>>(
+        "Flat map", allocator, count);
+    comet::comettests::BenchmarkMap<comet::Map<comet::u64, comet::u64>>(
+        "Map", allocator, count);
+  }
+}
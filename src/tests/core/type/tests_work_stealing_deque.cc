@@ -0,0 +1,177 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Tested. /////////////////////////////////////////////////////////////////////
+#include "comet/core/type/work_stealing_deque.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <atomic>
+#include <thread>
+
+#include "catch.hpp"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/essentials.h"
+#include "comet/core/memory/allocator/platform_allocator.h"
+#include "comet/core/memory/memory.h"
+
+namespace comet {
+namespace comettests {
+namespace memory {
+enum TestsWorkStealingMemoryTag : comet::memory::MemoryTag {
+  kTestsMemoryTagWorkStealing = comet::memory::kEngineMemoryTagUserBase + 2
+};
+}  // namespace memory
+
+comet::memory::PlatformAllocator work_stealing_allocator{
+    memory::kTestsMemoryTagWorkStealing};
+
+constexpr usize kWorkStealingStressItemCount{1 << 16};
+constexpr usize kWorkStealingStressThiefCount{4};
+// Small enough for the owner to fill it from time to time.
+constexpr usize kWorkStealingStressCapacity{64};
+
+// How many times each item was taken, by the owner or by thieves.
+std::atomic<u32> work_stealing_take_counts[kWorkStealingStressItemCount]{};
+}  // namespace comettests
+}  // namespace comet
+
+TEST_CASE("Work-stealing deque creation with specific capacity", "[comet]") {
+  const comet::usize capacity{16};
+  comet::LockFreeWorkStealingDeque<comet::u32> deque{
+      &comet::comettests::work_stealing_allocator, capacity};
+
+  SECTION("Properties after creation with specific capacity.") {
+    REQUIRE(deque.GetCapacity() == capacity);
+    REQUIRE(deque.GetSize() == 0);
+    REQUIRE(deque.IsEmpty());
+    REQUIRE(!deque.TryPop().has_value());
+    REQUIRE(!deque.TrySteal().has_value());
+  }
+}
+
+TEST_CASE("Work-stealing deque operations in single thread", "[comet]") {
+  const comet::usize capacity{4};
+  comet::LockFreeWorkStealingDeque<comet::u32> deque{
+      &comet::comettests::work_stealing_allocator, capacity};
+
+  for (comet::u32 i{0}; i < capacity; ++i) {
+    REQUIRE(deque.TryPush(i));
+  }
+
+  SECTION("Push operations when full.") {
+    REQUIRE(deque.GetSize() == capacity);
+    REQUIRE(!deque.TryPush(42));
+  }
+
+  SECTION("Pop operations are LIFO.") {
+    REQUIRE(deque.TryPop().value() == 3);
+    REQUIRE(deque.TryPop().value() == 2);
+    REQUIRE(deque.GetSize() == 2);
+  }
+
+  SECTION("Steal operations are FIFO.") {
+    REQUIRE(deque.TrySteal().value() == 0);
+    REQUIRE(deque.TrySteal().value() == 1);
+    REQUIRE(deque.GetSize() == 2);
+  }
+
+  SECTION("Mixed operations.") {
+    REQUIRE(deque.TrySteal().value() == 0);
+    REQUIRE(deque.TryPush(4));
+    REQUIRE(deque.TryPop().value() == 4);
+    REQUIRE(deque.TryPop().value() == 3);
+    REQUIRE(deque.TrySteal().value() == 1);
+    REQUIRE(deque.TryPop().value() == 2);
+    REQUIRE(deque.IsEmpty());
+    REQUIRE(!deque.TryPop().has_value());
+    REQUIRE(!deque.TrySteal().has_value());
+  }
+}
+
+TEST_CASE("Work-stealing deque operations with thieves", "[comet]") {
+  comet::LockFreeWorkStealingDeque<comet::u32> deque{
+      &comet::comettests::work_stealing_allocator,
+      comet::comettests::kWorkStealingStressCapacity};
+  auto& take_counts{comet::comettests::work_stealing_take_counts};
+
+  for (auto& take_count : take_counts) {
+    take_count.store(0, std::memory_order_relaxed);
+  }
+
+  std::atomic<bool> is_done{false};
+  std::thread thieves[comet::comettests::kWorkStealingStressThiefCount]{};
+
+  for (auto& thief : thieves) {
+    thief = std::thread{[&deque, &take_counts, &is_done] {
+      while (!is_done.load(std::memory_order_acquire)) {
+        const auto element{deque.TrySteal()};
+
+        if (element.has_value()) {
+          take_counts[*element].fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    }};
+  }
+
+  const auto pop{[&deque, &take_counts] {
+    const auto element{deque.TryPop()};
+
+    if (element.has_value()) {
+      take_counts[*element].fetch_add(1, std::memory_order_relaxed);
+    }
+  }};
+
+  // The owner keeps the deque almost empty, so that popping the last element
+  // often races against thieves.
+  constexpr auto kItemCount{comet::comettests::kWorkStealingStressItemCount};
+  comet::u32 next_element{0};
+
+  for (comet::usize round{0}; next_element < kItemCount; ++round) {
+    const auto push_count{1 + round % 4};
+
+    for (comet::usize i{0}; i < push_count && next_element < kItemCount; ++i) {
+      if (!deque.TryPush(next_element)) {
+        // Case: deque is full.
+        pop();
+        continue;
+      }
+
+      ++next_element;
+    }
+
+    const auto pop_count{1 + round % 3};
+
+    for (comet::usize i{0}; i < pop_count; ++i) {
+      pop();
+    }
+  }
+
+  while (!deque.IsEmpty()) {
+    pop();
+  }
+
+  is_done.store(true, std::memory_order_release);
+
+  for (auto& thief : thieves) {
+    thief.join();
+  }
+
+  // No element is lost or taken twice.
+  comet::usize invalid_count{0};
+
+  for (const auto& take_count : take_counts) {
+    if (take_count.load(std::memory_order_relaxed) != 1) {
+      ++invalid_count;
+    }
+  }
+
+  REQUIRE(invalid_count == 0);
+  REQUIRE(deque.IsEmpty());
+}
@@ -15,9 +15,44 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 // External. ///////////////////////////////////////////////////////////////////
+#include <atomic>
+
 #include "catch.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
 ////////////////////////////////////////////////////////////////////////////////
 
+#include "comet/core/concurrency/job/parallel.h"
+#include "comet/core/essentials.h"
+#include "comet/core/frame/frame_allocator.h"
+#include "comet/core/memory/allocator/platform_allocator.h"
+#include "comet/core/memory/memory.h"
+#include "comet/core/type/array.h"
+
+namespace comet {
+namespace comettests {
+namespace memory {
+enum TestsEntityMemoryTag : comet::memory::MemoryTag {
+  kTestsMemoryTagEntity = comet::memory::kEngineMemoryTagUserBase + 15
+};
+}  // namespace memory
+
+entity::EntityId SpawnDummyEntity(usize index) {
+  auto& entity_manager{entity::EntityManager::Get()};
+  const auto entity_id{entity_manager.Generate()};
+  const auto points{static_cast<u16>(index)};
+
+  if (index % 2 == 0) {
+    entity_manager.AddComponents(entity_id, DummyTransformComponent{},
+                                 DummyHpComponent{points, points});
+  } else {
+    entity_manager.AddComponents(entity_id, DummyHpComponent{points, points});
+  }
+
+  return entity_id;
+}
+}  // namespace comettests
+}  // namespace comet
+
 TEST_CASE("Components management", "[comet::entity]") {
   auto& entity_manager{comet::entity::EntityManager::Get()};
   const comet::entity::EntityId entity_id1{entity_manager.Generate()};
@@ -324,5 +359,433 @@ TEST_CASE("Components management", "[comet::entity]") {
     REQUIRE(is_entity_id1);
     REQUIRE(is_entity_id2);
     REQUIRE(is_entity_id3);
+
+    comet::usize chunk_entity_count{0};
+
+    entity_manager.EachChunk<comet::comettests::DummyTransformComponent>(
+        [&](comet::usize count, const comet::entity::EntityId* entity_ids,
+            comet::comettests::DummyTransformComponent* transform_cmps) {
+          for (comet::usize i{0}; i < count; ++i) {
+            REQUIRE(entity_manager
+                        .GetComponent<
+                            comet::comettests::DummyTransformComponent>(
+                            entity_ids[i]) == &transform_cmps[i]);
+
+            if (entity_ids[i] == entity_id1 || entity_ids[i] == entity_id2 ||
+                entity_ids[i] == entity_id3) {
+              ++chunk_entity_count;
+            }
+          }
+        });
+
+    REQUIRE(chunk_entity_count == 2);
+  }
+
+  SECTION("Query operations.") {
+    comet::entity::EntityQuery query{};
+    entity_manager.RegisterQuery<comet::comettests::DummyTransformComponent>(
+        query);
+
+    const auto count_entities{[&]() {
+      comet::usize count{0};
+
+      query.Each([&](auto entity_id) {
+        if (entity_id == entity_id1 || entity_id == entity_id2 ||
+            entity_id == entity_id3) {
+          ++count;
+        }
+      });
+
+      return count;
+    }};
+
+    REQUIRE(query.IsRegistered());
+    REQUIRE(count_entities() == 0);
+
+    entity_manager.AddComponents(entity_id1,
+                                 comet::comettests::DummyTransformComponent{});
+    entity_manager.DispatchComponentChanges();
+
+    REQUIRE(count_entities() == 1);
+
+    entity_manager.AddComponents(entity_id2,
+                                 comet::comettests::DummyTransformComponent{},
+                                 comet::comettests::DummyMeshComponent{},
+                                 comet::comettests::DummyHpComponent{});
+    entity_manager.DispatchComponentChanges();
+
+    REQUIRE(count_entities() == 2);
+
+    entity_manager
+        .RemoveComponents<comet::comettests::DummyTransformComponent>(
+            entity_id1);
+    entity_manager.DispatchComponentChanges();
+
+    REQUIRE(count_entities() == 1);
+
+    entity_manager.AddComponents(entity_id1,
+                                 comet::comettests::DummyTransformComponent{});
+    entity_manager.DispatchComponentChanges();
+
+    REQUIRE(count_entities() == 2);
+
+    entity_manager.UnregisterQuery(query);
+    REQUIRE(!query.IsRegistered());
+  }
+}
+
+TEST_CASE("Deferred structural changes", "[comet::entity]") {
+  auto& entity_manager{comet::entity::EntityManager::Get()};
+  comet::memory::PlatformAllocator allocator{
+      comet::comettests::memory::kTestsMemoryTagEntity};
+  constexpr comet::usize kEntityCount{4096};
+  comet::Array<comet::entity::EntityId> entity_ids{&allocator};
+  entity_ids.Resize(kEntityCount);
+
+  // Every worker records its own changes.
+  comet::job::ParallelFor({0, kEntityCount}, 64,
+                          [&entity_ids](comet::usize index) {
+                            entity_ids[index] =
+                                comet::comettests::SpawnDummyEntity(index);
+                          });
+
+  entity_manager.DispatchComponentChanges();
+
+  SECTION("Changes recorded from several workers are applied.") {
+    for (comet::usize i{0}; i < kEntityCount; ++i) {
+      const auto entity_id{entity_ids[i]};
+      REQUIRE(entity_manager.IsEntity(entity_id));
+
+      const auto* hp{
+          entity_manager.GetComponent<comet::comettests::DummyHpComponent>(
+              entity_id)};
+      REQUIRE(hp != nullptr);
+      REQUIRE(hp->hit_points == static_cast<comet::u16>(i));
+      REQUIRE(
+          (entity_manager
+               .GetComponent<comet::comettests::DummyTransformComponent>(
+                   entity_id) != nullptr) == (i % 2 == 0));
+    }
+  }
+
+  SECTION("Changes recorded for an entity are applied in order.") {
+    // The second entity has no transform: adding it, then removing it, must
+    // cancel out.
+    const auto entity_id{entity_ids[1]};
+    entity_manager.RemoveComponents<comet::comettests::DummyHpComponent>(
+        entity_id);
+    entity_manager.AddComponents(entity_id,
+                                 comet::comettests::DummyTransformComponent{});
+    entity_manager.RemoveComponents<comet::comettests::DummyTransformComponent>(
+        entity_id);
+    entity_manager.DispatchComponentChanges();
+
+    REQUIRE(entity_manager.IsEntity(entity_id));
+    REQUIRE(entity_manager.GetComponent<comet::comettests::DummyHpComponent>(
+                entity_id) == nullptr);
+    REQUIRE(
+        entity_manager.GetComponent<comet::comettests::DummyTransformComponent>(
+            entity_id) == nullptr);
+  }
+
+  SECTION("Remaining entities keep their components.") {
+    // The last rows are removed too, so that they cannot be used to fill the
+    // holes left by the others.
+    for (comet::usize i{0}; i < kEntityCount; ++i) {
+      if (i % 3 == 0 || i + 8 >= kEntityCount) {
+        entity_manager.Destroy(entity_ids[i]);
+      } else if (i % 4 == 0) {
+        entity_manager
+            .RemoveComponents<comet::comettests::DummyTransformComponent>(
+                entity_ids[i]);
+      }
+    }
+
+    entity_manager.DispatchComponentChanges();
+
+    for (comet::usize i{0}; i < kEntityCount; ++i) {
+      const auto entity_id{entity_ids[i]};
+
+      if (i % 3 == 0 || i + 8 >= kEntityCount) {
+        REQUIRE(!entity_manager.IsEntity(entity_id));
+        entity_ids[i] = comet::entity::kInvalidEntityId;
+        continue;
+      }
+
+      const auto* hp{
+          entity_manager.GetComponent<comet::comettests::DummyHpComponent>(
+              entity_id)};
+      REQUIRE(hp != nullptr);
+      REQUIRE(hp->hit_points == static_cast<comet::u16>(i));
+      REQUIRE(
+          (entity_manager
+               .GetComponent<comet::comettests::DummyTransformComponent>(
+                   entity_id) != nullptr) == (i % 2 == 0 && i % 4 != 0));
+    }
+  }
+
+  for (auto entity_id : entity_ids) {
+    if (entity_id != comet::entity::kInvalidEntityId) {
+      entity_manager.Destroy(entity_id);
+    }
   }
+
+  entity_manager.DispatchComponentChanges();
+  entity_ids.Destroy();
+}
+
+TEST_CASE("Archetype chunks", "[comet::entity]") {
+  auto& entity_manager{comet::entity::EntityManager::Get()};
+  comet::memory::PlatformAllocator allocator{
+      comet::comettests::memory::kTestsMemoryTagEntity};
+  constexpr comet::usize kEntityCount{4096};
+  comet::Array<comet::entity::EntityId> entity_ids{&allocator};
+  entity_ids.Reserve(kEntityCount);
+
+  for (comet::usize i{0}; i < kEntityCount; ++i) {
+    const auto points{static_cast<comet::u16>(i)};
+    entity_ids.PushBack(entity_manager.Generate());
+    entity_manager.AddComponents(
+        entity_ids.GetLast(), comet::comettests::DummyHpComponent{points, 0});
+  }
+
+  entity_manager.DispatchComponentChanges();
+
+  comet::entity::EntityQuery query{};
+  entity_manager.RegisterQuery<comet::comettests::DummyHpComponent>(query);
+
+  SECTION("Rows are split across chunks.") {
+    comet::usize chunk_count{0};
+    comet::usize row_count{0};
+
+    for (const auto* archetype : query.GetArchetypes()) {
+      REQUIRE(archetype->chunk_capacity > 0);
+      REQUIRE(archetype->capacity ==
+              archetype->chunks.GetSize() * archetype->chunk_capacity);
+
+      for (const auto* chunk : archetype->chunks) {
+        REQUIRE(reinterpret_cast<comet::uptr>(chunk) %
+                    comet::entity::kArchetypeChunkAlignment ==
+                0);
+      }
+    }
+
+    query.EachChunk<comet::comettests::DummyHpComponent>(
+        [&](comet::usize count, const comet::entity::EntityId* chunk_ids,
+            comet::comettests::DummyHpComponent* hps) {
+          REQUIRE(count > 0);
+
+          for (comet::usize i{0}; i < count; ++i) {
+            REQUIRE(entity_manager
+                        .GetComponent<comet::comettests::DummyHpComponent>(
+                            chunk_ids[i]) == &hps[i]);
+          }
+
+          ++chunk_count;
+          row_count += count;
+        });
+
+    REQUIRE(chunk_count > 1);
+    REQUIRE(row_count == kEntityCount);
+  }
+
+  SECTION("Chunks are processed in parallel.") {
+    std::atomic<comet::usize> row_count{0};
+
+    query.ParallelEachChunk<comet::comettests::DummyHpComponent>(
+        [&row_count](comet::usize count, const comet::entity::EntityId*,
+                     comet::comettests::DummyHpComponent* hps) {
+          for (comet::usize i{0}; i < count; ++i) {
+            hps[i].shield_points = hps[i].hit_points + 1;
+          }
+
+          row_count.fetch_add(count);
+        });
+
+    REQUIRE(row_count.load() == kEntityCount);
+
+    for (comet::usize i{0}; i < kEntityCount; ++i) {
+      const auto* hp{
+          entity_manager.GetComponent<comet::comettests::DummyHpComponent>(
+              entity_ids[i])};
+      REQUIRE(hp->shield_points == static_cast<comet::u16>(i + 1));
+    }
+  }
+
+  SECTION("Components are not moved when archetypes grow.") {
+    const auto* hp{
+        entity_manager.GetComponent<comet::comettests::DummyHpComponent>(
+            entity_ids[0])};
+
+    for (comet::usize i{0}; i < kEntityCount; ++i) {
+      entity_ids.PushBack(entity_manager.Generate());
+      entity_manager.AddComponents(entity_ids.GetLast(),
+                                   comet::comettests::DummyHpComponent{});
+    }
+
+    entity_manager.DispatchComponentChanges();
+
+    REQUIRE(entity_manager.GetComponent<comet::comettests::DummyHpComponent>(
+                entity_ids[0]) == hp);
+    REQUIRE(hp->hit_points == 0);
+  }
+
+  entity_manager.UnregisterQuery(query);
+
+  for (auto entity_id : entity_ids) {
+    entity_manager.Destroy(entity_id);
+  }
+
+  entity_manager.DispatchComponentChanges();
+  entity_ids.Destroy();
+}
+
+TEST_CASE("Change detection", "[comet::entity]") {
+  auto& entity_manager{comet::entity::EntityManager::Get()};
+  comet::memory::PlatformAllocator allocator{
+      comet::comettests::memory::kTestsMemoryTagEntity};
+  constexpr comet::usize kEntityCount{4096};
+  comet::Array<comet::entity::EntityId> entity_ids{&allocator};
+  entity_ids.Reserve(kEntityCount + 1);
+
+  for (comet::usize i{0}; i < kEntityCount; ++i) {
+    entity_ids.PushBack(entity_manager.Generate());
+    entity_manager.AddComponents(entity_ids.GetLast(),
+                                 comet::comettests::DummyHpComponent{});
+  }
+
+  entity_manager.DispatchComponentChanges();
+
+  comet::entity::EntityQuery query{};
+  entity_manager.RegisterQuery<comet::comettests::DummyHpComponent>(query);
+
+  comet::usize visited_row_count{0};
+  bool is_changed_entity_visited{false};
+  const auto changed_entity_id{entity_ids[kEntityCount / 2]};
+
+  const auto each_changed_chunk{[&](comet::entity::ChangeVersion since) {
+    visited_row_count = 0;
+    is_changed_entity_visited = false;
+
+    return query.EachChangedChunk<comet::comettests::DummyHpComponent>(
+        since, [&](comet::usize count, const comet::entity::EntityId* chunk_ids,
+                   comet::comettests::DummyHpComponent*) {
+          visited_row_count += count;
+
+          for (comet::usize i{0}; i < count; ++i) {
+            if (chunk_ids[i] == changed_entity_id) {
+              is_changed_entity_visited = true;
+            }
+          }
+        });
+  }};
+
+  // Simulates a system which already ran after the rows were added: writes
+  // made right before an advance are also reported by the next run.
+  entity_manager.AdvanceChangeVersion();
+  const auto since{entity_manager.AdvanceChangeVersion()};
+
+  SECTION("Unchanged chunks are skipped.") {
+    entity_manager
+        .GetComponent<comet::comettests::DummyHpComponent>(changed_entity_id)
+        ->hit_points = 1;
+
+    REQUIRE(each_changed_chunk(since) == kEntityCount);
+    REQUIRE(visited_row_count == 0);
+  }
+
+  SECTION("Mutable accesses mark their chunk.") {
+    entity_manager
+        .GetMutableComponent<comet::comettests::DummyHpComponent>(
+            changed_entity_id)
+        ->hit_points = 1;
+
+    const auto skipped_row_count{each_changed_chunk(since)};
+    REQUIRE(is_changed_entity_visited);
+    REQUIRE(visited_row_count > 0);
+    REQUIRE(visited_row_count < kEntityCount);
+    REQUIRE(skipped_row_count + visited_row_count == kEntityCount);
+
+    // Changes may race with the advance of the next run, which reports them
+    // again. Later runs skip them.
+    REQUIRE(each_changed_chunk(entity_manager.AdvanceChangeVersion()) ==
+            skipped_row_count);
+    REQUIRE(each_changed_chunk(entity_manager.AdvanceChangeVersion()) ==
+            kEntityCount);
+  }
+
+  SECTION("Writes racing with an advance are reported.") {
+    // The write happens after the advance, but read the version before it.
+    const auto version{entity_manager.AdvanceChangeVersion()};
+    comet::entity::MarkComponentChanged(
+        entity_manager.GetComponent<comet::comettests::DummyHpComponent>(
+            changed_entity_id),
+        version);
+
+    REQUIRE(each_changed_chunk(version) < kEntityCount);
+    REQUIRE(is_changed_entity_visited);
+
+    // It is only skipped once the system ran after the version it was
+    // stamped with.
+    REQUIRE(each_changed_chunk(entity_manager.AdvanceChangeVersion()) ==
+            kEntityCount);
+  }
+
+  SECTION("New rows are marked.") {
+    entity_ids.PushBack(entity_manager.Generate());
+    entity_manager.AddComponents(entity_ids.GetLast(),
+                                 comet::comettests::DummyHpComponent{});
+    entity_manager.DispatchComponentChanges();
+
+    REQUIRE(each_changed_chunk(since) < kEntityCount + 1);
+    REQUIRE(visited_row_count > 0);
+  }
+
+  entity_manager.UnregisterQuery(query);
+
+  for (auto entity_id : entity_ids) {
+    entity_manager.Destroy(entity_id);
+  }
+
+  entity_manager.DispatchComponentChanges();
+  entity_ids.Destroy();
+}
+
+TEST_CASE("Entity spawning benchmark", "[.][benchmark][comet::entity]") {
+  auto& entity_manager{comet::entity::EntityManager::Get()};
+  comet::memory::PlatformAllocator allocator{
+      comet::comettests::memory::kTestsMemoryTagEntity};
+  static constexpr comet::usize kEntityCount{100000};
+  comet::Array<comet::entity::EntityId> entity_ids{&allocator};
+
+  BENCHMARK_ADVANCED("Spawn 100k entities from all workers")
+  (Catch::Benchmark::Chronometer meter) {
+    entity_ids.Resize(kEntityCount * meter.runs());
+
+    meter.measure([&entity_manager, &entity_ids](int run) {
+      const auto offset{static_cast<comet::usize>(run) * kEntityCount};
+
+      comet::job::ParallelFor({0, kEntityCount}, 256,
+                              [&entity_ids, offset](comet::usize index) {
+                                entity_ids[offset + index] =
+                                    comet::comettests::SpawnDummyEntity(index);
+                              });
+
+      entity_manager.DispatchComponentChanges();
+      return entity_ids[offset];
+    });
+
+    for (auto entity_id : entity_ids) {
+      entity_manager.Destroy(entity_id);
+    }
+
+    entity_manager.DispatchComponentChanges();
+
+    // No frame goes by between runs: clear the frame allocator manually.
+    static_cast<comet::frame::FiberFrameAllocator&>(
+        comet::frame::GetFrameAllocator())
+        .Clear();
+  };
+
+  entity_ids.Destroy();
 }
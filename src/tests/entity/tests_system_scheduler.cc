@@ -0,0 +1,223 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Tested. /////////////////////////////////////////////////////////////////////
+#include "comet/entity/system_scheduler.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "catch.hpp"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/concurrency/job/scheduler.h"
+#include "comet/core/essentials.h"
+#include "comet/core/frame/frame_packet.h"
+#include "tests/entity/tests_entity.h"
+
+namespace comet {
+namespace comettests {
+// Every system records the step at which it ran.
+struct SystemStepParams {
+  std::atomic<usize>* step_counter{nullptr};
+  usize step{kInvalidIndex};
+  usize run_count{0};
+};
+
+void OnSystemStep(frame::FramePacket*, entity::SystemParamsHandle handle) {
+  auto* params{static_cast<SystemStepParams*>(handle)};
+  params->step = params->step_counter->fetch_add(1);
+  ++params->run_count;
+}
+
+// Every system waits for the others to start, which can only happen if they
+// run concurrently. The wait is bounded so that a serialized schedule fails
+// instead of hanging.
+struct SystemRendezvousParams {
+  std::atomic<usize>* started_count{nullptr};
+  usize expected_count{0};
+  bool is_overlapping{false};
+};
+
+void OnSystemRendezvous(frame::FramePacket*,
+                        entity::SystemParamsHandle handle) {
+  auto* params{static_cast<SystemRendezvousParams*>(handle)};
+  params->started_count->fetch_add(1);
+  const auto deadline{std::chrono::steady_clock::now() +
+                      std::chrono::seconds(1)};
+
+  while (params->started_count->load() < params->expected_count) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return;
+    }
+
+    std::this_thread::yield();
+  }
+
+  params->is_overlapping = true;
+}
+
+// Every system records the size of the schedule published while it runs.
+struct SystemScheduleParams {
+  usize schedule_size{kInvalidIndex};
+};
+
+void OnSystemScheduleRead(frame::FramePacket*,
+                          entity::SystemParamsHandle handle) {
+  auto* params{static_cast<SystemScheduleParams*>(handle)};
+  params->schedule_size =
+      entity::SystemScheduler::Get().GetLastSchedule().GetSize();
+}
+}  // namespace comettests
+}  // namespace comet
+
+TEST_CASE("System scheduling", "[comet::entity]") {
+  using comet::comettests::DummyHpComponent;
+  using comet::comettests::DummyMeshComponent;
+  using comet::comettests::DummyTransformComponent;
+  using comet::entity::Read;
+  using comet::entity::Write;
+
+  auto& system_scheduler{comet::entity::SystemScheduler::Get()};
+  system_scheduler.Initialize();
+  std::atomic<comet::usize> step_counter{0};
+  comet::comettests::SystemStepParams params[3]{};
+
+  for (auto& system_params : params) {
+    system_params.step_counter = &step_counter;
+  }
+
+  SECTION("Conflicting systems run in registration order.") {
+    system_scheduler.Register<Read<>, Write<DummyHpComponent>>(
+        "write_hp", comet::comettests::OnSystemStep, &params[0]);
+    system_scheduler.Register<Read<DummyHpComponent>, Write<>>(
+        "read_hp", comet::comettests::OnSystemStep, &params[1]);
+    system_scheduler.Register<Read<>, Write<DummyHpComponent>>(
+        "write_hp_again", comet::comettests::OnSystemStep, &params[2]);
+    system_scheduler.Update(nullptr);
+
+    REQUIRE(params[0].step == 0);
+    REQUIRE(params[1].step == 1);
+    REQUIRE(params[2].step == 2);
+
+    const auto schedule{system_scheduler.GetLastSchedule()};
+    REQUIRE(schedule.GetSize() == 3);
+    REQUIRE(schedule[0].level == 0);
+    REQUIRE(schedule[0].dependency_count == 0);
+    REQUIRE(schedule[1].level == 1);
+    REQUIRE(schedule[1].dependency_count == 1);
+    REQUIRE(schedule[2].level == 2);
+    REQUIRE(schedule[2].dependency_count == 2);
+    REQUIRE(schedule[0].end_time_ns <= schedule[1].start_time_ns);
+    REQUIRE(schedule[1].end_time_ns <= schedule[2].start_time_ns);
+  }
+
+  SECTION("Independent systems may overlap.") {
+    std::atomic<comet::usize> started_count{0};
+    comet::comettests::SystemRendezvousParams rendezvous_params[2]{};
+
+    for (auto& system_params : rendezvous_params) {
+      system_params.started_count = &started_count;
+      system_params.expected_count = 2;
+    }
+
+    // Shared reads do not conflict.
+    system_scheduler
+        .Register<Read<DummyTransformComponent>, Write<DummyHpComponent>>(
+            "write_hp", comet::comettests::OnSystemRendezvous,
+            &rendezvous_params[0]);
+    system_scheduler
+        .Register<Read<DummyTransformComponent>, Write<DummyMeshComponent>>(
+            "write_mesh", comet::comettests::OnSystemRendezvous,
+            &rendezvous_params[1]);
+    system_scheduler.Update(nullptr);
+
+    const auto schedule{system_scheduler.GetLastSchedule()};
+    REQUIRE(schedule.GetSize() == 2);
+    REQUIRE(schedule[0].level == 0);
+    REQUIRE(schedule[0].dependency_count == 0);
+    REQUIRE(schedule[1].level == 0);
+    REQUIRE(schedule[1].dependency_count == 0);
+    REQUIRE(started_count.load() == 2);
+
+    // Overlapping requires at least two workers to run the systems.
+    if (comet::job::Scheduler::Get().GetFiberWorkerCount() >= 2) {
+      REQUIRE(rendezvous_params[0].is_overlapping);
+      REQUIRE(rendezvous_params[1].is_overlapping);
+    }
+  }
+
+  SECTION("Explicit dependencies are honored.") {
+    const auto hp_system_id{
+        system_scheduler.Register<Read<>, Write<DummyHpComponent>>(
+            "write_hp", comet::comettests::OnSystemStep, &params[0])};
+    system_scheduler.Register<Read<>, Write<DummyMeshComponent>>(
+        "write_mesh", comet::comettests::OnSystemStep, &params[1],
+        {hp_system_id});
+    system_scheduler.Update(nullptr);
+
+    REQUIRE(params[0].step == 0);
+    REQUIRE(params[1].step == 1);
+
+    const auto schedule{system_scheduler.GetLastSchedule()};
+    REQUIRE(schedule.GetSize() == 2);
+    REQUIRE(schedule[0].level == 0);
+    REQUIRE(schedule[1].level == 1);
+    REQUIRE(schedule[1].dependency_count == 1);
+    REQUIRE(schedule[0].end_time_ns <= schedule[1].start_time_ns);
+  }
+
+  SECTION("The graph is rebuilt after a new registration.") {
+    system_scheduler.Register<Read<>, Write<DummyHpComponent>>(
+        "write_hp", comet::comettests::OnSystemStep, &params[0]);
+    system_scheduler.Update(nullptr);
+
+    REQUIRE(params[0].run_count == 1);
+    REQUIRE(system_scheduler.GetLastSchedule().GetSize() == 1);
+
+    step_counter = 0;
+    system_scheduler.Register<Read<DummyHpComponent>, Write<>>(
+        "read_hp", comet::comettests::OnSystemStep, &params[1]);
+    system_scheduler.Update(nullptr);
+
+    REQUIRE(params[0].run_count == 2);
+    REQUIRE(params[1].run_count == 1);
+    REQUIRE(params[0].step == 0);
+    REQUIRE(params[1].step == 1);
+
+    const auto schedule{system_scheduler.GetLastSchedule()};
+    REQUIRE(system_scheduler.GetSystemCount() == 2);
+    REQUIRE(schedule.GetSize() == 2);
+    REQUIRE(schedule[1].level == 1);
+    REQUIRE(schedule[1].dependency_count == 1);
+  }
+
+  SECTION("The schedule is published once the update is done.") {
+    comet::comettests::SystemScheduleParams schedule_params{};
+    system_scheduler.Register<Read<>, Write<DummyHpComponent>>(
+        "read_schedule", comet::comettests::OnSystemScheduleRead,
+        &schedule_params);
+    system_scheduler.Update(nullptr);
+
+    // Running systems only see the schedule of the previous update.
+    REQUIRE(schedule_params.schedule_size == 0);
+
+    const auto schedule{system_scheduler.GetLastSchedule()};
+    REQUIRE(schedule.GetSize() == 1);
+    REQUIRE(schedule[0].start_time_ns != 0);
+    REQUIRE(schedule[0].start_time_ns <= schedule[0].end_time_ns);
+
+    system_scheduler.Update(nullptr);
+    REQUIRE(schedule_params.schedule_size == 1);
+  }
+
+  system_scheduler.Shutdown();
+}
@@ -0,0 +1,313 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Tested. /////////////////////////////////////////////////////////////////////
+#include "comet/math/geometry.h"
+#include "comet/math/matrix.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <chrono>
+#include <string>
+
+#include "catch.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/essentials.h"
+#include "comet/core/memory/allocator/platform_allocator.h"
+#include "comet/core/memory/memory.h"
+#include "comet/core/processor.h"
+#include "comet/core/type/array.h"
+#include "comet/math/math_common.h"
+#include "comet/math/quaternion.h"
+#include "comet/math/vector.h"
+
+namespace comet {
+namespace comettests {
+namespace memory {
+enum TestsMatrixBatchMemoryTag : comet::memory::MemoryTag {
+  kTestsMemoryTagMatrixBatch = comet::memory::kEngineMemoryTagUserBase + 9
+};
+}  // namespace memory
+
+constexpr usize kMatrixBatchBenchmarkCount{10000};
+
+using MultiplyMatricesFunc = void (*)(const math::Mat4*, const math::Mat4*,
+                                      usize, math::Mat4*, usize);
+
+f32 GenerateMatrixBatchTestValue(usize index) {
+  return static_cast<f32>(static_cast<s32>((index * 7919) % 199) - 99) / 50.0f;
+}
+
+struct MatrixBatchTestData {
+  Array<math::Mat4> a{};
+  Array<math::Mat4> b{};
+  Array<math::Mat4> out{};
+  Array<math::Mat4> expected{};
+  Array<math::Vec3> translations{};
+  Array<math::Quat> rotations{};
+  Array<f32> scales{};
+  Array<f32> transform_channels{};
+
+  MatrixBatchTestData(comet::memory::Allocator* allocator, usize count)
+      : a{allocator},
+        b{allocator},
+        out{allocator},
+        expected{allocator},
+        translations{allocator},
+        rotations{allocator},
+        scales{allocator},
+        transform_channels{allocator} {
+    a.Resize(count);
+    b.Resize(count);
+    out.Resize(count);
+    expected.Resize(count);
+    translations.Resize(count);
+    rotations.Resize(count);
+    scales.Resize(count);
+    transform_channels.Resize(count * 8);
+    usize seed{0};
+    const auto generate_value{
+        [&seed]() { return GenerateMatrixBatchTestValue(seed++); }};
+
+    for (usize i{0}; i < count; ++i) {
+      for (usize column{0}; column < 4; ++column) {
+        for (usize row{0}; row < 4; ++row) {
+          a[i][column][row] = generate_value();
+          b[i][column][row] = generate_value();
+        }
+      }
+
+      translations[i] =
+          math::Vec3{generate_value(), generate_value(), generate_value()};
+      rotations[i] = math::Quat{generate_value(), generate_value(),
+                                generate_value(), generate_value()};
+      math::Normalize(rotations[i]);
+      scales[i] = 1.0f + math::Abs(generate_value());
+
+      // Same transforms, as structure of arrays.
+      transform_channels[i] = translations[i].x;
+      transform_channels[count + i] = translations[i].y;
+      transform_channels[count * 2 + i] = translations[i].z;
+      transform_channels[count * 3 + i] = rotations[i].x;
+      transform_channels[count * 4 + i] = rotations[i].y;
+      transform_channels[count * 5 + i] = rotations[i].z;
+      transform_channels[count * 6 + i] = rotations[i].w;
+      transform_channels[count * 7 + i] = scales[i];
+    }
+  }
+
+  ~MatrixBatchTestData() {
+    a.Destroy();
+    b.Destroy();
+    out.Destroy();
+    expected.Destroy();
+    translations.Destroy();
+    rotations.Destroy();
+    scales.Destroy();
+    transform_channels.Destroy();
+  }
+
+  math::TransformChannels GetTransformChannels() const {
+    const auto count{scales.GetSize()};
+    const auto* channels{transform_channels.GetData()};
+    math::TransformChannels transforms{};
+    transforms.translations_x = channels;
+    transforms.translations_y = channels + count;
+    transforms.translations_z = channels + count * 2;
+    transforms.rotations_x = channels + count * 3;
+    transforms.rotations_y = channels + count * 4;
+    transforms.rotations_z = channels + count * 5;
+    transforms.rotations_w = channels + count * 6;
+    transforms.scales = channels + count * 7;
+    return transforms;
+  }
+};
+
+bool AreMatricesNear(const math::Mat4& a, const math::Mat4& b) {
+  for (usize column{0}; column < 4; ++column) {
+    for (usize row{0}; row < 4; ++row) {
+      if (math::Abs(a[column][row] - b[column][row]) > 1e-4f) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+bool AreMatricesNear(const Array<math::Mat4>& a, const Array<math::Mat4>& b) {
+  for (usize i{0}; i < a.GetSize(); ++i) {
+    if (!AreMatricesNear(a[i], b[i])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Catch reports durations only: throughputs are reported separately.
+template <typename Kernel>
+void ReportMatrixThroughput(const std::string& label, usize matrix_count,
+                            Kernel&& kernel) {
+  constexpr usize kIterationCount{100};
+  const auto start{std::chrono::steady_clock::now()};
+
+  for (usize i{0}; i < kIterationCount; ++i) {
+    kernel();
+  }
+
+  const std::chrono::duration<f64> duration{std::chrono::steady_clock::now() -
+                                            start};
+  const auto throughput{static_cast<f64>(matrix_count * kIterationCount) /
+                        duration.count()};
+  WARN(label << ": " << static_cast<u64>(throughput) << " matrices/s");
+}
+}  // namespace comettests
+}  // namespace comet
+
+TEST_CASE("Matrix batch kernels", "[comet::math]") {
+  comet::memory::PlatformAllocator allocator{
+      comet::comettests::memory::kTestsMemoryTagMatrixBatch};
+  // Not a multiple of the SIMD widths, to cover remainders.
+  constexpr comet::usize kCount{37};
+  comet::comettests::MatrixBatchTestData data{&allocator, kCount};
+
+  SECTION("Multiplication.") {
+    for (comet::usize i{0}; i < kCount; ++i) {
+      data.expected[i] = data.a[i] * data.b[i];
+    }
+
+    comet::math::ScalarMultiplyMatrices(data.a.GetData(), data.b.GetData(),
+                                        sizeof(comet::math::Mat4),
+                                        data.out.GetData(), kCount);
+    REQUIRE(comet::comettests::AreMatricesNear(data.out, data.expected));
+
+#ifdef COMET_ARCH_X86
+    comet::math::SSEMultiplyMatrices(data.a.GetData(), data.b.GetData(),
+                                     sizeof(comet::math::Mat4),
+                                     data.out.GetData(), kCount);
+    REQUIRE(comet::comettests::AreMatricesNear(data.out, data.expected));
+
+    if (comet::IsAVXSupported()) {
+      comet::math::AVXMultiplyMatrices(data.a.GetData(), data.b.GetData(),
+                                       sizeof(comet::math::Mat4),
+                                       data.out.GetData(), kCount);
+      REQUIRE(comet::comettests::AreMatricesNear(data.out, data.expected));
+    }
+#endif  // COMET_ARCH_X86
+
+    comet::math::MultiplyMatrices(data.a.GetData(), data.b.GetData(),
+                                  data.out.GetData(), kCount);
+    REQUIRE(comet::comettests::AreMatricesNear(data.out, data.expected));
+
+    auto matrix{data.a[0]};
+    comet::math::MultiplyMatrix(matrix, data.b[0], matrix);
+    REQUIRE(comet::comettests::AreMatricesNear(matrix, data.expected[0]));
+  }
+
+  SECTION("Strided multiplication.") {
+    struct Joint {
+      comet::u16 index{0};
+      comet::math::Mat4 matrix{};
+    };
+
+    comet::Array<Joint> joints{&allocator};
+    joints.Resize(kCount);
+
+    for (comet::usize i{0}; i < kCount; ++i) {
+      joints[i].matrix = data.b[i];
+      data.expected[i] = data.a[i] * data.b[i];
+    }
+
+    comet::math::MultiplyMatrices(data.a.GetData(), &joints[0].matrix,
+                                  sizeof(Joint), data.out.GetData(), kCount);
+    REQUIRE(comet::comettests::AreMatricesNear(data.out, data.expected));
+    joints.Destroy();
+  }
+
+  SECTION("Transform composition.") {
+    for (comet::usize i{0}; i < kCount; ++i) {
+      data.expected[i] = comet::math::ComposeTransform(
+          data.translations[i], data.rotations[i], data.scales[i]);
+    }
+
+    comet::math::ComposeTransforms(data.GetTransformChannels(),
+                                   data.out.GetData(), kCount);
+    REQUIRE(comet::comettests::AreMatricesNear(data.out, data.expected));
+  }
+}
+
+TEST_CASE("Matrix batch kernels benchmark", "[.][benchmark][comet::math]") {
+  comet::memory::PlatformAllocator allocator{
+      comet::comettests::memory::kTestsMemoryTagMatrixBatch};
+  constexpr auto kCount{comet::comettests::kMatrixBatchBenchmarkCount};
+  comet::comettests::MatrixBatchTestData data{&allocator, kCount};
+  const auto suffix{" (" + std::to_string(kCount) + " matrices)"};
+
+  struct MultiplyKernel {
+    const char* label{nullptr};
+    comet::comettests::MultiplyMatricesFunc func{nullptr};
+  };
+
+  comet::Array<MultiplyKernel> kernels{&allocator};
+  kernels.PushBack(MultiplyKernel{"Scalar multiplication",
+                                  comet::math::ScalarMultiplyMatrices});
+
+#ifdef COMET_ARCH_X86
+  kernels.PushBack(
+      MultiplyKernel{"SSE multiplication", comet::math::SSEMultiplyMatrices});
+
+  if (comet::IsAVXSupported()) {
+    kernels.PushBack(MultiplyKernel{"AVX multiplication",
+                                    comet::math::AVXMultiplyMatrices});
+  }
+#endif  // COMET_ARCH_X86
+
+  for (const auto& kernel : kernels) {
+    const auto run{[&data, &kernel] {
+      kernel.func(data.a.GetData(), data.b.GetData(),
+                  sizeof(comet::math::Mat4), data.out.GetData(), kCount);
+    }};
+
+    BENCHMARK(kernel.label + suffix) {
+      run();
+      return data.out[0][0][0];
+    };
+
+    comet::comettests::ReportMatrixThroughput(kernel.label, kCount, run);
+  }
+
+  const auto run_scalar_composition{[&data] {
+    comet::math::ScalarComposeTransforms(data.GetTransformChannels(),
+                                         data.out.GetData(), kCount);
+  }};
+
+  BENCHMARK("Scalar composition" + suffix) {
+    run_scalar_composition();
+    return data.out[0][0][0];
+  };
+
+  comet::comettests::ReportMatrixThroughput("Scalar composition", kCount,
+                                            run_scalar_composition);
+
+  const auto run_composition{[&data] {
+    comet::math::ComposeTransforms(data.GetTransformChannels(),
+                                   data.out.GetData(), kCount);
+  }};
+
+  BENCHMARK("Composition" + suffix) {
+    run_composition();
+    return data.out[0][0][0];
+  };
+
+  comet::comettests::ReportMatrixThroughput("Composition", kCount,
+                                            run_composition);
+  kernels.Destroy();
+}
@@ -0,0 +1,216 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Tested. /////////////////////////////////////////////////////////////////////
+#include "comet/physics/transform_hierarchy.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// External. ///////////////////////////////////////////////////////////////////
+#include "catch.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/memory/allocator/platform_allocator.h"
+#include "comet/core/memory/memory.h"
+#include "comet/entity/entity_manager.h"
+#include "comet/math/geometry.h"
+#include "comet/math/vector.h"
+#include "comet/physics/component/transform_component.h"
+#include "comet/physics/transform.h"
+
+namespace comet {
+namespace comettests {
+entity::EntityId GenerateTransformNode(entity::EntityId root_entity_id,
+                                       entity::EntityId parent_entity_id,
+                                       const math::Vec3& translation) {
+  auto& entity_manager{entity::EntityManager::Get()};
+  const auto entity_id{entity_manager.Generate()};
+
+  physics::TransformComponent transform_cmp{};
+  transform_cmp.is_dirty = true;
+  transform_cmp.root_entity_id =
+      root_entity_id == entity::kInvalidEntityId ? entity_id : root_entity_id;
+  transform_cmp.parent_entity_id = parent_entity_id;
+  transform_cmp.local = math::Translate(math::Mat4{1.0f}, translation);
+  transform_cmp.global = math::Mat4{1.0f};
+
+  if (root_entity_id == entity::kInvalidEntityId) {
+    physics::TransformRootComponent root_cmp{};
+    root_cmp.is_child_dirty = true;
+    entity_manager.AddComponents(entity_id, root_cmp, transform_cmp);
+  } else {
+    entity_manager.AddComponents(entity_id, transform_cmp);
+  }
+
+  return entity_id;
+}
+
+f32 GetGlobalX(entity::EntityId entity_id) {
+  return entity::EntityManager::Get()
+      .GetComponent<physics::TransformComponent>(entity_id)
+      ->global[3][0];
+}
+}  // namespace comettests
+}  // namespace comet
+
+TEST_CASE("Transform hierarchy propagation", "[comet::physics]") {
+  auto& entity_manager{comet::entity::EntityManager::Get()};
+  comet::memory::PlatformAllocator allocator{
+      comet::memory::kEngineMemoryTagEntity};
+  comet::physics::TransformHierarchy hierarchy{&allocator};
+
+  const auto root_id{comet::comettests::GenerateTransformNode(
+      comet::entity::kInvalidEntityId, comet::entity::kInvalidEntityId,
+      {1.0f, 0.0f, 0.0f})};
+  entity_manager.DispatchComponentChanges();
+
+  const auto child_id1{comet::comettests::GenerateTransformNode(
+      root_id, root_id, {2.0f, 0.0f, 0.0f})};
+  const auto child_id2{comet::comettests::GenerateTransformNode(
+      root_id, root_id, {4.0f, 0.0f, 0.0f})};
+  entity_manager.DispatchComponentChanges();
+
+  const auto grandchild_id{comet::comettests::GenerateTransformNode(
+      root_id, child_id1, {8.0f, 0.0f, 0.0f})};
+  entity_manager.DispatchComponentChanges();
+
+  hierarchy.Rebuild();
+
+  REQUIRE(hierarchy.GetTreeCount() >= 1);
+  REQUIRE(hierarchy.GetNodeCount() >= 4);
+
+  SECTION("Full propagation.") {
+    const auto stats{hierarchy.Update(nullptr)};
+    REQUIRE(stats.skipped_row_count == 0);
+
+    REQUIRE(comet::comettests::GetGlobalX(root_id) == 1.0f);
+    REQUIRE(comet::comettests::GetGlobalX(child_id1) == 3.0f);
+    REQUIRE(comet::comettests::GetGlobalX(child_id2) == 5.0f);
+    REQUIRE(comet::comettests::GetGlobalX(grandchild_id) == 11.0f);
+    REQUIRE(!entity_manager
+                 .GetComponent<comet::physics::TransformRootComponent>(root_id)
+                 ->is_child_dirty);
+  }
+
+  SECTION("Dirty propagation.") {
+    hierarchy.Update(nullptr);
+
+    auto* child_cmp1{
+        entity_manager.GetComponent<comet::physics::TransformComponent>(
+            child_id1)};
+    comet::physics::SetLocalTransform(
+        child_cmp1,
+        comet::math::Translate(comet::math::Mat4{1.0f}, {16.0f, 0.0f, 0.0f}));
+
+    const auto stats{hierarchy.Update(nullptr)};
+    REQUIRE(stats.updated_tree_count >= 1);
+    REQUIRE(stats.updated_row_count == 2);
+
+    REQUIRE(comet::comettests::GetGlobalX(root_id) == 1.0f);
+    REQUIRE(comet::comettests::GetGlobalX(child_id1) == 17.0f);
+    REQUIRE(comet::comettests::GetGlobalX(child_id2) == 5.0f);
+    REQUIRE(comet::comettests::GetGlobalX(grandchild_id) == 25.0f);
+  }
+
+  SECTION("Unchanged trees are skipped.") {
+    // Writes made right before an update are also visited by the next one, as
+    // they may race with it.
+    hierarchy.Update(nullptr);
+    hierarchy.Update(nullptr);
+
+    // Flags changed without marking the components are not picked up.
+    auto* child_cmp2{
+        entity_manager.GetComponent<comet::physics::TransformComponent>(
+            child_id2)};
+    child_cmp2->local =
+        comet::math::Translate(comet::math::Mat4{1.0f}, {32.0f, 0.0f, 0.0f});
+    child_cmp2->is_dirty = true;
+    entity_manager.GetComponent<comet::physics::TransformRootComponent>(root_id)
+        ->is_child_dirty = true;
+
+    auto stats{hierarchy.Update(nullptr)};
+    REQUIRE(stats.updated_tree_count == 0);
+    REQUIRE(stats.skipped_row_count == stats.row_count);
+    REQUIRE(comet::comettests::GetGlobalX(child_id2) == 5.0f);
+
+    entity_manager.MarkChanged(child_cmp2);
+    entity_manager.GetMutableComponent<comet::physics::TransformRootComponent>(
+        root_id);
+
+    stats = hierarchy.Update(nullptr);
+    REQUIRE(stats.updated_row_count == 1);
+    REQUIRE(comet::comettests::GetGlobalX(child_id2) == 33.0f);
+  }
+
+  hierarchy.Destroy();
+  entity_manager.Destroy(grandchild_id);
+  entity_manager.Destroy(child_id2);
+  entity_manager.Destroy(child_id1);
+  entity_manager.Destroy(root_id);
+  entity_manager.DispatchComponentChanges();
+}
+
+TEST_CASE("Transform hierarchy benchmark", "[.][benchmark][comet::physics]") {
+  constexpr comet::usize kTreeCount{100};
+  constexpr comet::usize kNodeCountPerTree{1000};
+  constexpr comet::usize kChildCountPerNode{4};
+
+  auto& entity_manager{comet::entity::EntityManager::Get()};
+  comet::memory::PlatformAllocator allocator{
+      comet::memory::kEngineMemoryTagEntity};
+  comet::physics::TransformHierarchy hierarchy{&allocator};
+  comet::Array<comet::entity::EntityId> entity_ids{&allocator};
+  entity_ids.Reserve(kTreeCount * kNodeCountPerTree);
+
+  for (comet::usize i{0}; i < kTreeCount; ++i) {
+    const auto root_id{comet::comettests::GenerateTransformNode(
+        comet::entity::kInvalidEntityId, comet::entity::kInvalidEntityId,
+        {1.0f, 0.0f, 0.0f})};
+    entity_ids.PushBack(root_id);
+    const auto tree_offset{entity_ids.GetSize() - 1};
+
+    for (comet::usize j{1}; j < kNodeCountPerTree; ++j) {
+      const auto parent_id{
+          entity_ids[tree_offset + (j - 1) / kChildCountPerNode]};
+      entity_ids.PushBack(comet::comettests::GenerateTransformNode(
+          root_id, parent_id, {1.0f, 0.0f, 0.0f}));
+    }
+
+    entity_manager.DispatchComponentChanges();
+  }
+
+  hierarchy.Rebuild();
+  REQUIRE(hierarchy.GetNodeCount() == kTreeCount * kNodeCountPerTree);
+
+  hierarchy.Update(nullptr);
+
+  // Moving the roots propagates to every node.
+  BENCHMARK("Full update of 100k nodes") {
+    for (comet::usize i{0}; i < kTreeCount; ++i) {
+      const auto root_id{entity_ids[i * kNodeCountPerTree]};
+      entity_manager.GetComponent<comet::physics::TransformComponent>(root_id)
+          ->is_dirty = true;
+      entity_manager
+          .GetMutableComponent<comet::physics::TransformRootComponent>(
+              root_id)
+          ->is_child_dirty = true;
+    }
+
+    hierarchy.Update(nullptr);
+    return hierarchy.GetNodeCount();
+  };
+
+  hierarchy.Destroy();
+
+  for (auto entity_id : entity_ids) {
+    entity_manager.Destroy(entity_id);
+  }
+
+  entity_manager.DispatchComponentChanges();
+  entity_ids.Destroy();
+}
@@ -0,0 +1,161 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Tested. /////////////////////////////////////////////////////////////////////
+#include "comet/resource/resource.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// External. ///////////////////////////////////////////////////////////////////
+#include "catch.hpp"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/essentials.h"
+#include "comet/core/file_system/file_system.h"
+#include "comet/core/memory/allocator/platform_allocator.h"
+#include "comet/core/type/array.h"
+#include "comet/core/type/tstring.h"
+
+namespace comet {
+namespace comettests {
+const auto* resource_test_dir{COMET_TCHAR("comettests_tests_resource")};
+
+struct ResourceTestDescr {
+  u64 value{0};
+  u64 data_size{0};
+};
+
+resource::ResourceFile GenerateMappedTestResourceFile(
+    memory::Allocator* allocator, usize data_size,
+    resource::CompressionMode compression_mode) {
+  resource::ResourceFile file{};
+  file.resource_id = 7;
+  file.resource_type_id = 42;
+  file.compression_mode = compression_mode;
+  file.descr = Array<u8>{allocator};
+  file.data = Array<u8>{allocator};
+
+  ResourceTestDescr descr{};
+  descr.value = 1337;
+  descr.data_size = data_size;
+  resource::PackPodResourceDescr(descr, file);
+
+  // Repeating pattern, so that compression actually shrinks the data.
+  Array<u8> data{allocator};
+  data.Resize(data_size);
+
+  for (usize i{0}; i < data_size; ++i) {
+    data[i] = static_cast<u8>(i % 13);
+  }
+
+  resource::PackResourceData(data, file);
+  return file;
+}
+
+bool AreBytesEqual(const u8* a, const u8* b, usize size) {
+  for (usize i{0}; i < size; ++i) {
+    if (a[i] != b[i]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void CheckMappedResourceFile(const resource::ResourceFile& mapped_file,
+                             const resource::ResourceFile& original_file,
+                             memory::Allocator* allocator) {
+  REQUIRE(mapped_file.in_place_bytes != nullptr);
+  REQUIRE(IsMapped(mapped_file.mapped_file));
+  REQUIRE(mapped_file.resource_type_id == original_file.resource_type_id);
+  REQUIRE(mapped_file.compression_mode == original_file.compression_mode);
+  REQUIRE(mapped_file.descr_size == original_file.descr_size);
+  REQUIRE(mapped_file.data_size == original_file.data_size);
+  REQUIRE(mapped_file.packed_descr_size == original_file.packed_descr_size);
+  REQUIRE(mapped_file.packed_data_size == original_file.packed_data_size);
+  REQUIRE(resource::GetResourceFileSize(mapped_file) ==
+          mapped_file.mapped_file.size);
+
+  // The file is read in place.
+  REQUIRE(mapped_file.descr.IsEmpty());
+  REQUIRE(mapped_file.data.IsEmpty());
+
+  REQUIRE(AreBytesEqual(resource::GetPackedDescr(mapped_file),
+                        resource::GetPackedDescr(original_file),
+                        original_file.packed_descr_size));
+  REQUIRE(AreBytesEqual(resource::GetPackedData(mapped_file),
+                        resource::GetPackedData(original_file),
+                        original_file.packed_data_size));
+
+  ResourceTestDescr mapped_descr{};
+  resource::UnpackPodResourceDescr(mapped_file, mapped_descr);
+  ResourceTestDescr original_descr{};
+  resource::UnpackPodResourceDescr(original_file, original_descr);
+  REQUIRE(mapped_descr.value == original_descr.value);
+  REQUIRE(mapped_descr.data_size == original_descr.data_size);
+
+  Array<u8> mapped_buffer{allocator};
+  const auto* mapped_data{
+      resource::ViewResourceData(mapped_file, mapped_buffer)};
+  Array<u8> original_buffer{allocator};
+  const auto* original_data{
+      resource::ViewResourceData(original_file, original_buffer)};
+  REQUIRE(AreBytesEqual(mapped_data, original_data, original_file.data_size));
+}
+}  // namespace comettests
+}  // namespace comet
+
+TEST_CASE("Resource file mapping", "[comet::resource]") {
+  comet::memory::PlatformAllocator allocator{
+      comet::memory::kEngineMemoryTagResource};
+  const auto tmp_dir{comet::GetCurrentDirectory() /
+                     comet::comettests::resource_test_dir};
+  comet::Remove(tmp_dir, true);
+  comet::CreateDirectory(tmp_dir, true);
+  const auto file_path{tmp_dir / COMET_TCHAR("test_resource")};
+
+  SECTION("Uncompressed file.") {
+    auto original_file{comet::comettests::GenerateMappedTestResourceFile(
+        &allocator, 4096, comet::resource::CompressionMode::None)};
+    REQUIRE(comet::resource::SaveResourceFile(file_path, original_file));
+
+    comet::resource::ResourceFile mapped_file{};
+    REQUIRE(comet::resource::MapResourceFile(file_path, mapped_file));
+    comet::comettests::CheckMappedResourceFile(mapped_file, original_file,
+                                               &allocator);
+
+    comet::resource::UnmapResourceFile(mapped_file);
+    REQUIRE(mapped_file.in_place_bytes == nullptr);
+    REQUIRE(!comet::IsMapped(mapped_file.mapped_file));
+  }
+
+  SECTION("Compressed file.") {
+    auto original_file{comet::comettests::GenerateMappedTestResourceFile(
+        &allocator, 4096, comet::resource::CompressionMode::Lz4)};
+    REQUIRE(original_file.packed_data_size < original_file.data_size);
+    REQUIRE(comet::resource::SaveResourceFile(file_path, original_file));
+
+    comet::resource::ResourceFile mapped_file{};
+    REQUIRE(comet::resource::MapResourceFile(file_path, mapped_file));
+    comet::comettests::CheckMappedResourceFile(mapped_file, original_file,
+                                               &allocator);
+
+    comet::resource::UnmapResourceFile(mapped_file);
+    REQUIRE(mapped_file.in_place_bytes == nullptr);
+    REQUIRE(!comet::IsMapped(mapped_file.mapped_file));
+  }
+
+  SECTION("Missing file.") {
+    comet::resource::ResourceFile mapped_file{};
+    REQUIRE(!comet::resource::MapResourceFile(
+        tmp_dir / COMET_TCHAR("missing_resource"), mapped_file));
+    REQUIRE(mapped_file.in_place_bytes == nullptr);
+    REQUIRE(!comet::IsMapped(mapped_file.mapped_file));
+  }
+
+  comet::Remove(tmp_dir, true);
+}
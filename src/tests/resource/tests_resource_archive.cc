@@ -0,0 +1,283 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Tested. /////////////////////////////////////////////////////////////////////
+#include "comet/resource/resource_archive.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// External. ///////////////////////////////////////////////////////////////////
+#include "catch.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/c_string.h"
+#include "comet/core/essentials.h"
+#include "comet/core/file_system/file_system.h"
+#include "comet/core/memory/allocator/platform_allocator.h"
+#include "comet/core/memory/memory.h"
+#include "comet/core/type/array.h"
+#include "comet/core/type/tstring.h"
+#include "comet/resource/resource.h"
+
+#ifdef COMET_LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#endif  // COMET_LINUX
+
+namespace comet {
+namespace comettests {
+const auto* resource_archive_test_dir{
+    COMET_TCHAR("comettests_tests_resource_archive")};
+
+struct ResourceArchiveTestDescr {
+  u64 value{0};
+  u64 data_size{0};
+};
+
+resource::ResourceFile GenerateTestResourceFile(
+    memory::Allocator* allocator, resource::ResourceId resource_id,
+    usize data_size, resource::CompressionMode compression_mode) {
+  resource::ResourceFile file{};
+  file.resource_id = resource_id;
+  file.resource_type_id = 42;
+  file.compression_mode = compression_mode;
+  file.descr = Array<u8>{allocator};
+  file.data = Array<u8>{allocator};
+
+  ResourceArchiveTestDescr descr{};
+  descr.value = resource_id;
+  descr.data_size = data_size;
+  resource::PackPodResourceDescr(descr, file);
+
+  Array<u8> data{allocator};
+  data.Resize(data_size);
+
+  for (usize i{0}; i < data_size; ++i) {
+    data[i] = static_cast<u8>((resource_id + i) % 251);
+  }
+
+  resource::PackResourceData(data, file);
+  return file;
+}
+
+TString GenerateTestResourcePath(CTStringView dir_path,
+                                 resource::ResourceId resource_id) {
+  constexpr auto kBufferLen{GetCharCount<resource::ResourceId>() + 1};
+  tchar buffer[kBufferLen];
+  usize len;
+  ConvertToStr(resource_id, buffer, kBufferLen, &len);
+  return dir_path / buffer;
+}
+
+bool IsTestResourceFileValid(const resource::ResourceFile& file,
+                             resource::ResourceId resource_id,
+                             memory::Allocator* allocator) {
+  ResourceArchiveTestDescr descr{};
+  resource::UnpackPodResourceDescr(file, descr);
+
+  if (descr.value != resource_id) {
+    return false;
+  }
+
+  Array<u8> buffer{allocator};
+  const auto* data{resource::ViewResourceData(file, buffer)};
+
+  if (file.data_size != descr.data_size) {
+    return false;
+  }
+
+  for (usize i{0}; i < descr.data_size; ++i) {
+    if (data[i] != static_cast<u8>((resource_id + i) % 251)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+usize LoadLooseTestResources(CTStringView dir_path, usize resource_count,
+                             usize data_size) {
+  usize checksum{0};
+
+  for (usize i{0}; i < resource_count; ++i) {
+    const auto resource_id{static_cast<resource::ResourceId>(i + 1)};
+    resource::ResourceFile file{};
+    resource::MapResourceFile(GenerateTestResourcePath(dir_path, resource_id),
+                              file);
+    checksum += resource::GetPackedData(file)[data_size - 1];
+    resource::UnmapResourceFile(file);
+  }
+
+  return checksum;
+}
+
+usize LoadArchivedTestResources(CTStringView archive_path,
+                                usize resource_count, usize data_size) {
+  usize checksum{0};
+  resource::ResourceArchive archive{};
+  archive.Open(archive_path);
+
+  for (usize i{0}; i < resource_count; ++i) {
+    const auto resource_id{static_cast<resource::ResourceId>(i + 1)};
+    resource::ResourceFile file{};
+    archive.TryGetResourceFile(resource_id, file);
+    checksum += resource::GetPackedData(file)[data_size - 1];
+  }
+
+  return checksum;
+}
+
+#ifdef COMET_LINUX
+// Drops the file from the page cache, so that the next read hits the disk.
+// Dirty pages cannot be evicted: they are written back first.
+bool EvictFromPageCache(CTStringView path) {
+  const auto fd{open(path.GetCTStr(), O_RDONLY)};
+
+  if (fd == -1) {
+    return false;
+  }
+
+  const auto is_evicted{fdatasync(fd) == 0 &&
+                        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0};
+  close(fd);
+  return is_evicted;
+}
+#endif  // COMET_LINUX
+}  // namespace comettests
+}  // namespace comet
+
+TEST_CASE("Resource archive", "[comet::resource]") {
+  comet::memory::PlatformAllocator allocator{
+      comet::memory::kEngineMemoryTagResource};
+  const auto tmp_dir{comet::GetCurrentDirectory() /
+                     comet::comettests::resource_archive_test_dir};
+  comet::Remove(tmp_dir, true);
+  comet::CreateDirectory(tmp_dir, true);
+  const auto archive_path{tmp_dir / COMET_TCHAR("test.pak")};
+
+  constexpr comet::resource::ResourceId kResourceIds[]{17, 3, 1024, 256, 5};
+
+  {
+    comet::resource::ResourceArchiveWriter writer{&allocator};
+    REQUIRE(writer.Open(archive_path));
+
+    for (comet::usize i{0}; i < std::size(kResourceIds); ++i) {
+      auto file{comet::comettests::GenerateTestResourceFile(
+          &allocator, kResourceIds[i], 1000 * i + 1,
+          i % 2 == 0 ? comet::resource::CompressionMode::Lz4
+                     : comet::resource::CompressionMode::None)};
+      writer.Add(file);
+    }
+
+    REQUIRE(writer.Close());
+  }
+
+  comet::resource::ResourceArchive archive{};
+  REQUIRE(archive.Open(archive_path));
+  REQUIRE(archive.GetEntryCount() == std::size(kResourceIds));
+
+  SECTION("Lookup operations.") {
+    for (auto resource_id : kResourceIds) {
+      const auto* entry{archive.TryGetEntry(resource_id)};
+      REQUIRE(entry != nullptr);
+      REQUIRE(entry->resource_id == resource_id);
+      REQUIRE(entry->offset % comet::resource::kResourceArchiveAlignment == 0);
+
+      comet::resource::ResourceFile file{};
+      REQUIRE(archive.TryGetResourceFile(resource_id, file));
+      REQUIRE(file.resource_id == resource_id);
+      REQUIRE(file.resource_type_id == 42);
+      REQUIRE(comet::comettests::IsTestResourceFileValid(file, resource_id,
+                                                         &allocator));
+    }
+
+    REQUIRE(archive.TryGetEntry(4) == nullptr);
+    REQUIRE(archive.TryGetEntry(2048) == nullptr);
+  }
+
+  archive.Close();
+  REQUIRE(!archive.IsOpen());
+  comet::Remove(tmp_dir, true);
+}
+
+TEST_CASE("Resource archive benchmark", "[.][benchmark][comet::resource]") {
+  static constexpr comet::usize kResourceCount{1000};
+  static constexpr comet::usize kResourceDataSize{16384};
+
+  comet::memory::PlatformAllocator allocator{
+      comet::memory::kEngineMemoryTagResource};
+  const auto tmp_dir{comet::GetCurrentDirectory() /
+                     comet::comettests::resource_archive_test_dir};
+  comet::Remove(tmp_dir, true);
+  comet::CreateDirectory(tmp_dir, true);
+  const auto archive_path{tmp_dir / COMET_TCHAR("benchmark.pak")};
+
+  comet::resource::ResourceArchiveWriter writer{&allocator};
+  REQUIRE(writer.Open(archive_path));
+
+  for (comet::usize i{0}; i < kResourceCount; ++i) {
+    const auto resource_id{static_cast<comet::resource::ResourceId>(i + 1)};
+    auto file{comet::comettests::GenerateTestResourceFile(
+        &allocator, resource_id, kResourceDataSize,
+        comet::resource::CompressionMode::None)};
+    REQUIRE(comet::resource::SaveResourceFile(
+        comet::comettests::GenerateTestResourcePath(tmp_dir, resource_id),
+        file));
+    writer.Add(file);
+  }
+
+  REQUIRE(writer.Close());
+
+#ifdef COMET_LINUX
+  // Every sample evicts the files before loading them. Loading 1000 files
+  // from disk is slow enough for Catch2 to run a single iteration per sample,
+  // which is checked below: each measured iteration then reads from a cold
+  // page cache.
+  // On other platforms, cold numbers require evicting the page cache manually
+  // (e.g., by rebooting) and only looking at the first sample.
+  BENCHMARK_ADVANCED("Load 1000 loose resource files (cold)")
+  (Catch::Benchmark::Chronometer meter) {
+    CHECK(meter.runs() == 1);
+
+    for (comet::usize i{0}; i < kResourceCount; ++i) {
+      const auto resource_id{static_cast<comet::resource::ResourceId>(i + 1)};
+      REQUIRE(comet::comettests::EvictFromPageCache(
+          comet::comettests::GenerateTestResourcePath(tmp_dir, resource_id)));
+    }
+
+    meter.measure([&tmp_dir] {
+      return comet::comettests::LoadLooseTestResources(tmp_dir, kResourceCount,
+                                                       kResourceDataSize);
+    });
+  };
+
+  BENCHMARK_ADVANCED("Load 1000 archived resources (cold)")
+  (Catch::Benchmark::Chronometer meter) {
+    CHECK(meter.runs() == 1);
+    REQUIRE(comet::comettests::EvictFromPageCache(archive_path));
+
+    meter.measure([&archive_path] {
+      return comet::comettests::LoadArchivedTestResources(
+          archive_path, kResourceCount, kResourceDataSize);
+    });
+  };
+#endif  // COMET_LINUX
+
+  // The page cache is warmed up by the first iterations.
+  BENCHMARK("Load 1000 loose resource files (warm)") {
+    return comet::comettests::LoadLooseTestResources(tmp_dir, kResourceCount,
+                                                     kResourceDataSize);
+  };
+
+  BENCHMARK("Load 1000 archived resources (warm)") {
+    return comet::comettests::LoadArchivedTestResources(
+        archive_path, kResourceCount, kResourceDataSize);
+  };
+
+  comet::Remove(tmp_dir, true);
+}
@@ -0,0 +1,290 @@
+// Copyright 2026 m4jr0. All Rights Reserved.
+// Use of this source code is governed by the MIT
+// license that can be found in the LICENSE file.
+
+// Precompiled. ////////////////////////////////////////////////////////////////
+#include "comet_pch.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// Tested. /////////////////////////////////////////////////////////////////////
+#include "comet/resource/handler/resource_handler.h"
+////////////////////////////////////////////////////////////////////////////////
+
+// External. ///////////////////////////////////////////////////////////////////
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "catch.hpp"
+////////////////////////////////////////////////////////////////////////////////
+
+#include "comet/core/concurrency/job/scheduler.h"
+#include "comet/core/essentials.h"
+#include "comet/core/file_system/file_system.h"
+#include "comet/core/memory/allocator/platform_allocator.h"
+#include "comet/core/memory/memory.h"
+#include "comet/core/type/array.h"
+#include "comet/core/type/tstring.h"
+#include "comet/resource/handler/resource_handler_utils.h"
+#include "comet/resource/resource.h"
+
+namespace comet {
+namespace comettests {
+const auto* resource_handler_test_dir{
+    COMET_TCHAR("comettests_tests_resource_handler")};
+
+struct DummyResource : resource::Resource {
+  static constexpr resource::ResourceTypeId kResourceTypeId{1337};
+
+  u64 value{0};
+};
+
+struct DummyResourceDescr {
+  resource::ResourceId id{resource::kInvalidResourceId};
+  u64 value{0};
+};
+
+class DummyResourceHandler : public resource::ResourceHandler<DummyResource> {
+ public:
+  DummyResourceHandler(const resource::ResourceHandlerDescr& descr)
+      : resource::ResourceHandler<DummyResource>{descr} {}
+
+  DummyResourceHandler(const DummyResourceHandler&) = delete;
+  DummyResourceHandler(DummyResourceHandler&&) = delete;
+  DummyResourceHandler& operator=(const DummyResourceHandler&) = delete;
+  DummyResourceHandler& operator=(DummyResourceHandler&&) = delete;
+  virtual ~DummyResourceHandler() = default;
+
+  resource::ResourceFile Pack(
+      const DummyResource& resource,
+      resource::CompressionMode compression_mode) override {
+    resource::ResourceFile file{};
+    file.resource_id = resource.id;
+    file.resource_type_id = DummyResource::kResourceTypeId;
+    file.compression_mode = compression_mode;
+    file.descr = Array<u8>{byte_allocator_};
+    file.data = Array<u8>{byte_allocator_};
+
+    DummyResourceDescr descr{};
+    descr.id = resource.id;
+    descr.value = resource.value;
+    resource::PackPodResourceDescr(descr, file);
+
+    Array<u8> data{byte_allocator_};
+    data.Resize(sizeof(resource.value));
+    memory::CopyMemory(data.GetData(), &resource.value, sizeof(resource.value));
+    resource::PackResourceData(data, file);
+    return file;
+  }
+
+  void Unpack(const resource::ResourceFile& file,
+              resource::ResourceLifeSpan life_span,
+              DummyResource* resource) override {
+    // Lets tests keep loads pending for as long as they need.
+    while (is_blocked_.load()) {
+      std::this_thread::yield();
+    }
+
+    DummyResourceDescr descr{};
+    resource::UnpackPodResourceDescr(file, descr);
+    resource->id = descr.id;
+    resource->type_id = DummyResource::kResourceTypeId;
+    resource->value = descr.value;
+    resource->life_span = life_span;
+    unpack_count_.fetch_add(1);
+  }
+
+  void Save(resource::ResourceId id, u64 value) {
+    DummyResource resource{};
+    resource.id = id;
+    resource.value = value;
+    const auto file{Pack(resource, resource::CompressionMode::None)};
+    REQUIRE(resource::SaveResourceFile(
+        resource::internal::GenerateTlsResourceAbsPath(root_path_, id), file));
+  }
+
+  DummyResource* GetFallback() { return &fallback_; }
+
+  void SetBlocked(bool is_blocked) { is_blocked_.store(is_blocked); }
+
+  usize GetUnpackCount() const { return unpack_count_.load(); }
+
+ protected:
+  void InitializeDefaults() override {
+    using Defaults = resource::internal::DefaultResources<DummyResource>;
+    fallback_.id = Defaults::kFallbackResourceId_;
+    fallback_.type_id = DummyResource::kResourceTypeId;
+    fallback_.life_span = resource::ResourceLifeSpan::Global;
+    defaults_.Set(&fallback_);
+  }
+
+ private:
+  DummyResource fallback_{};
+  std::atomic<bool> is_blocked_{false};
+  std::atomic<usize> unpack_count_{0};
+};
+
+struct ResourceLoadCallbackParams {
+  std::atomic<usize> call_count{0};
+};
+
+void OnResourceLoad(resource::ResourceLoadCallbackHandle handle) {
+  static_cast<ResourceLoadCallbackParams*>(handle)->call_count.fetch_add(1);
+}
+
+u64 GenerateDummyResourceValue(resource::ResourceId id) { return id * 3 + 1; }
+}  // namespace comettests
+}  // namespace comet
+
+TEST_CASE("Asynchronous resource loading", "[comet::resource]") {
+  comet::memory::PlatformAllocator allocator{
+      comet::memory::kEngineMemoryTagResource};
+  const auto tmp_dir{comet::GetCurrentDirectory() /
+                     comet::comettests::resource_handler_test_dir};
+  comet::Remove(tmp_dir, true);
+  comet::CreateDirectory(tmp_dir, true);
+
+  comet::resource::ResourceHandlerDescr handler_descr{};
+  handler_descr.root_path = tmp_dir;
+  handler_descr.ptr_allocator = &allocator;
+  handler_descr.byte_allocator = &allocator;
+  comet::comettests::DummyResourceHandler handler{handler_descr};
+  handler.Initialize();
+
+  constexpr comet::resource::ResourceId kResourceIds[]{17, 3, 1024, 256, 5};
+
+  for (auto resource_id : kResourceIds) {
+    handler.Save(resource_id,
+                 comet::comettests::GenerateDummyResourceValue(resource_id));
+  }
+
+  comet::comettests::ResourceLoadCallbackParams callback_params{};
+  comet::resource::ResourceLoadDescr load_descr{};
+  load_descr.callback = comet::comettests::OnResourceLoad;
+  load_descr.callback_handle = &callback_params;
+
+  SECTION("Resources are stored in request order.") {
+    comet::resource::ResourceLoadRequest<comet::comettests::DummyResource>
+        request{&allocator};
+    handler.LoadAsync(kResourceIds, std::size(kResourceIds), request,
+                      load_descr);
+    request.Wait();
+
+    REQUIRE(request.IsDone());
+    REQUIRE(request.GetSize() == std::size(kResourceIds));
+    REQUIRE(callback_params.call_count.load() == 1);
+    REQUIRE(handler.GetUnpackCount() == std::size(kResourceIds));
+
+    for (comet::usize i{0}; i < std::size(kResourceIds); ++i) {
+      const auto* resource{request.GetResource(i)};
+      REQUIRE(resource != nullptr);
+      REQUIRE(resource->id == kResourceIds[i]);
+      REQUIRE(resource->value ==
+              comet::comettests::GenerateDummyResourceValue(kResourceIds[i]));
+    }
+  }
+
+  SECTION("Cached and missing resources are mixed.") {
+    constexpr comet::resource::ResourceId kMissingResourceId{4};
+    auto* cached_resource{handler.Load(kResourceIds[0])};
+    REQUIRE(cached_resource->id == kResourceIds[0]);
+    REQUIRE(handler.GetUnpackCount() == 1);
+
+    const comet::resource::ResourceId ids[]{kResourceIds[0], kMissingResourceId,
+                                            kResourceIds[1]};
+    comet::resource::ResourceLoadRequest<comet::comettests::DummyResource>
+        request{&allocator};
+    handler.LoadAsync(ids, std::size(ids), request, load_descr);
+    request.Wait();
+
+    REQUIRE(callback_params.call_count.load() == 1);
+    // The cached resource is not loaded again.
+    REQUIRE(handler.GetUnpackCount() == 2);
+    REQUIRE(request.GetResource(0) == cached_resource);
+    REQUIRE(request.GetResource(1) == handler.GetFallback());
+    REQUIRE(request.GetResource(2)->id == kResourceIds[1]);
+  }
+
+  SECTION("Cached resources are set immediately.") {
+    auto* cached_resource{handler.Load(kResourceIds[2])};
+    comet::resource::ResourceLoadRequest<comet::comettests::DummyResource>
+        request{&allocator};
+    handler.LoadAsync(kResourceIds[2], request, load_descr);
+
+    // Nothing is kicked: the request is done before LoadAsync returns.
+    REQUIRE(request.IsDone());
+    REQUIRE(callback_params.call_count.load() == 1);
+    REQUIRE(request.GetResource(0) == cached_resource);
+  }
+
+  SECTION("Requests share a counter.") {
+    comet::job::CounterGuard guard{};
+    load_descr.counter = guard.GetCounter();
+    comet::comettests::ResourceLoadCallbackParams other_callback_params{};
+    auto other_load_descr{load_descr};
+    other_load_descr.callback_handle = &other_callback_params;
+
+    comet::resource::ResourceLoadRequest<comet::comettests::DummyResource>
+        request{&allocator};
+    comet::resource::ResourceLoadRequest<comet::comettests::DummyResource>
+        other_request{&allocator};
+    handler.SetBlocked(true);
+    handler.LoadAsync(kResourceIds, 3, request, load_descr);
+    handler.LoadAsync(kResourceIds + 3, 2, other_request, other_load_descr);
+
+    // Both requests are pending until the loads are unblocked.
+    REQUIRE(!guard.GetCounter()->IsZero());
+    REQUIRE(callback_params.call_count.load() == 0);
+    REQUIRE(other_callback_params.call_count.load() == 0);
+
+    handler.SetBlocked(false);
+    guard.Wait();
+
+    REQUIRE(request.IsDone());
+    REQUIRE(other_request.IsDone());
+    REQUIRE(callback_params.call_count.load() == 1);
+    REQUIRE(other_callback_params.call_count.load() == 1);
+    REQUIRE(handler.GetUnpackCount() == std::size(kResourceIds));
+
+    // Waiting again does not fire the callbacks twice.
+    request.Wait();
+    other_request.Wait();
+    REQUIRE(callback_params.call_count.load() == 1);
+    REQUIRE(other_callback_params.call_count.load() == 1);
+  }
+
+  SECTION("Requests wait for pending loads when destroyed.") {
+    handler.SetBlocked(true);
+    std::thread unblocker{};
+
+    {
+      comet::resource::ResourceLoadRequest<comet::comettests::DummyResource>
+          request{&allocator};
+      handler.LoadAsync(kResourceIds, std::size(kResourceIds), request,
+                        load_descr);
+      REQUIRE(!request.IsDone());
+
+      // Unblocks the loads once the request is being destroyed.
+      unblocker = std::thread{[&handler] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        handler.SetBlocked(false);
+      }};
+    }
+
+    unblocker.join();
+
+    // The jobs reference the request: it is only destroyed once they are
+    // done.
+    REQUIRE(callback_params.call_count.load() == 1);
+    REQUIRE(handler.GetUnpackCount() == std::size(kResourceIds));
+
+    for (auto resource_id : kResourceIds) {
+      REQUIRE(handler.Load(resource_id)->id == resource_id);
+    }
+
+    REQUIRE(handler.GetUnpackCount() == std::size(kResourceIds));
+  }
+
+  handler.Destroy();
+  comet::Remove(tmp_dir, true);
+}